@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace onnxruntime {
+
+/**
+   A sequence of maps that all have the same keys, such as the output of ZipMap, stored column-wise:
+   one key table shared by every row and a contiguous row-major [rows, keys] block of values.
+   Producing it costs one copy of the values instead of one std::map per row.
+   The std::vector<std::map> form of the same data is only built on demand by AsMaps().
+*/
+template <typename TKey, typename TVal>
+class ColumnarMapSequence {
+ public:
+  using key_type = TKey;
+  using mapped_type = TVal;
+  using value_type = std::map<TKey, TVal>;
+
+  ColumnarMapSequence() = default;
+
+  /**
+     Sets the key table and sizes the values for num_rows rows. The previous values are discarded.
+  */
+  void Reset(std::shared_ptr<const std::vector<TKey>> keys, size_t num_rows) {
+    keys_ = std::move(keys);
+    num_rows_ = num_rows;
+    values_.resize(num_rows_ * NumKeys());
+    maps_.reset();
+  }
+
+  size_t size() const noexcept { return num_rows_; }
+
+  size_t NumKeys() const noexcept { return keys_ ? keys_->size() : 0; }
+
+  const std::vector<TKey>& Keys() const {
+    static const std::vector<TKey> no_keys;
+    return keys_ ? *keys_ : no_keys;
+  }
+
+  /** The value of key k in row r is Values()[r * NumKeys() + k]. */
+  const TVal* Values() const noexcept { return values_.data(); }
+
+  TVal* MutableValues() {
+    maps_.reset();
+    return values_.data();
+  }
+
+  /** Builds the map of a single row. */
+  value_type Row(size_t row) const {
+    value_type map;
+    const std::vector<TKey>& keys = Keys();
+    const TVal* row_values = values_.data() + row * keys.size();
+    for (size_t k = 0; k < keys.size(); ++k) {
+      map[keys[k]] = row_values[k];
+    }
+    return map;
+  }
+
+  /**
+     Returns the rows as maps, built on the first call and kept until the values change.
+     Not safe to call concurrently with itself or with MutableValues().
+  */
+  const std::vector<value_type>& AsMaps() const {
+    if (!maps_) {
+      auto maps = std::make_unique<std::vector<value_type>>();
+      maps->reserve(num_rows_);
+      for (size_t row = 0; row < num_rows_; ++row) {
+        maps->push_back(Row(row));
+      }
+      maps_ = std::move(maps);
+    }
+    return *maps_;
+  }
+
+ private:
+  std::shared_ptr<const std::vector<TKey>> keys_;
+  size_t num_rows_ = 0;
+  std::vector<TVal> values_;
+  mutable std::unique_ptr<std::vector<value_type>> maps_;
+};
+
+}  // namespace onnxruntime
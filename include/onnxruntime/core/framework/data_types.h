@@ -11,6 +11,8 @@
 
 #include "core/common/common.h"
 #include "core/common/exceptions.h"
+#include "core/framework/columnar_map_sequence.h"
+#include "core/framework/packed_string_tensor.h"
 
 namespace ONNX_NAMESPACE {
 class TypeProto;
@@ -35,6 +37,10 @@ using VectorDouble = std::vector<double>;
 using VectorMapStringToFloat = std::vector<MapStringToFloat>;
 using VectorMapInt64ToFloat = std::vector<MapInt64ToFloat>;
 
+//columnar forms of the sequences of maps, see columnar_map_sequence.h
+using ColumnarMapStringToFloat = ColumnarMapSequence<std::string, float>;
+using ColumnarMapInt64ToFloat = ColumnarMapSequence<int64_t, float>;
+
 class DataTypeImpl;
 class TensorTypeBase;
 
@@ -512,6 +518,24 @@ class OpaqueType : public NonTensorType<T> {
   }
 };
 
+/**
+ * \brief PackedStringTensorType. The type of a PackedStringTensor,
+ *        the packed form of a string tensor.
+ *
+ * \details It describes the same ONNX type as tensor(string) but it is
+ *          not a tensor type: kernels get it with Input<PackedStringTensor>
+ *          and only the ones declared with KernelDefBuilder::PackedStrings do.
+ */
+class PackedStringTensorType : public NonTensorType<PackedStringTensor> {
+ public:
+  static MLDataType Type();
+
+  bool IsCompatible(const ONNX_NAMESPACE::TypeProto& type_proto) const override;
+
+ private:
+  PackedStringTensorType();
+};
+
 template <typename T>
 class NonOnnxType : public DataTypeImpl {
  private:
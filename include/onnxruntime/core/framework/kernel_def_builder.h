@@ -58,6 +58,10 @@ class KernelDef {
     return alias_map_;
   }
 
+  const std::vector<std::pair<int, int>>& PackedStrings() const {
+    return packed_strings_map_;
+  }
+
   OrtMemType InputMemoryType(size_t input_index) const {
     auto it = input_memory_type_args_.find(input_index);
     if (it == input_memory_type_args_.end())
@@ -108,6 +112,9 @@ class KernelDef {
   // An element <i, j> means that output j is an alias of input i.
   std::vector<std::pair<int, int>> alias_map_;
 
+  // An element <i, j> means that input i and output j may be PackedStringTensor values.
+  std::vector<std::pair<int, int>> packed_strings_map_;
+
   // The memory types of inputs/outputs of this kernel
   MemTypeMap input_memory_type_args_;
   MemTypeMap output_memory_type_args_;
@@ -191,6 +198,16 @@ class KernelDefBuilder {
   KernelDefBuilder& Alias(const std::vector<std::pair<int, int>>& aliases);
   KernelDefBuilder& Alias(int input_index, int output_index);
 
+  /**
+     String inputs and outputs the kernel also reads and writes in the packed form (see PackedStringTensor).
+     For a pair <i, j>, the planner may make input i and output j PackedStringTensor values
+     when every kernel that reads them supports that form.
+     Either form may still be given as input i; output j is packed if OpKernelContext::OutputPackedStrings
+     returns a value, otherwise it is a Tensor.
+  */
+  KernelDefBuilder& PackedStrings(const std::vector<std::pair<int, int>>& packed_strings);
+  KernelDefBuilder& PackedStrings(int input_index, int output_index);
+
   /**
      Specify that this kernel requires an input arg
      in certain memory type (instead of the default, device memory).
@@ -99,6 +99,10 @@ class OpKernelContext {
   // Return nullptr if the output is an unused optional output.
   Tensor* Output(int index, const TensorShape& shape);
 
+  // Return the packed form of string output 'index' if the session planned it that way or the caller asked
+  // for it (see KernelDefBuilder::PackedStrings), otherwise nullptr and the output is a Tensor.
+  PackedStringTensor* OutputPackedStrings(int index);
+
   const logging::Logger& Logger() const {
     return *logger_;
   }
@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/status.h"
+#include "core/framework/tensor_shape.h"
+
+namespace onnxruntime {
+
+/**
+   A string tensor stored as one contiguous byte buffer and the offset and length of every element in it,
+   instead of one std::string per element.
+   Values sharing a buffer only differ in their element table, so selecting elements (Identity, Gather, Slice)
+   doesn't copy any string data, and importing or exporting the whole tensor is a single copy of the buffer.
+   The buffer is immutable once set; it is shared with the values the elements are selected into.
+*/
+class PackedStringTensor final {
+ public:
+  struct Element {
+    size_t offset;
+    size_t length;
+  };
+
+  PackedStringTensor() = default;
+
+  /**
+     Copies the s_len bytes of s into a new buffer. offsets holds the start of each of the shape.Size() elements,
+     the last element ends at s_len. This is the layout written by CopyTo.
+     Fails and leaves the value unchanged if the offsets are decreasing or out of bounds.
+  */
+  common::Status Assign(const TensorShape& shape, const char* s, size_t s_len, const size_t* offsets);
+
+  /**
+     Packs shape.Size() strings into a new buffer: strings[indices[i]] for each element i,
+     or strings[i] if indices is nullptr.
+  */
+  void Assign(const TensorShape& shape, const std::string* strings, const int64_t* indices = nullptr);
+
+  /**
+     Sets the buffer and the element table as they are. Every element must be within the buffer.
+  */
+  void Reset(const TensorShape& shape, std::shared_ptr<const std::string> buffer, std::vector<Element> elements);
+
+  /**
+     Sets the elements to the shape.Size() elements of source at the given indices, in that order.
+     The buffer of source is shared, not copied. source may be *this.
+  */
+  void Select(const PackedStringTensor& source, const TensorShape& shape, const int64_t* indices);
+
+  const TensorShape& Shape() const noexcept { return shape_; }
+
+  /** Number of elements. */
+  size_t Size() const noexcept { return elements_.size(); }
+
+  const char* ElementData(size_t i) const { return buffer_->data() + elements_[i].offset; }
+
+  size_t ElementLength(size_t i) const { return elements_[i].length; }
+
+  std::string ElementString(size_t i) const { return std::string(ElementData(i), ElementLength(i)); }
+
+  /** Total length of the elements. */
+  size_t DataLength() const;
+
+  /**
+     Copies the elements back to back to s, which holds DataLength() bytes, and writes the start of each of them
+     to offsets, which holds Size() entries. A single copy when the elements are consecutive in the buffer.
+  */
+  void CopyTo(char* s, size_t* offsets) const;
+
+  /** Assigns the elements to Size() strings. */
+  void CopyTo(std::string* strings) const;
+
+ private:
+  TensorShape shape_;
+  std::shared_ptr<const std::string> buffer_;
+  std::vector<Element> elements_;
+};
+
+}  // namespace onnxruntime
@@ -20,6 +20,18 @@ struct OrtRunOptions {
   */
   bool cache_feeds_fetches_info = false;
 
+  /**
+  Return the outputs that ZipMap produces as columnar map sequences (one key table and a [rows, keys] block of
+  values) instead of std::vector<std::map>. Only applies to ZipMap outputs that no other node consumes.
+  */
+  bool columnar_map_sequences = false;
+
+  /**
+  Return the string outputs of Identity, Gather and Slice as PackedStringTensor values (one buffer and the
+  offset and length of each element) instead of string tensors. Only applies to outputs no other node consumes.
+  */
+  bool packed_string_tensors = false;
+
   /// set to 'true' to terminate any currently executing Run() calls that are using this
   /// OrtRunOptions instance. the individual calls will exit gracefully and return an error status.
   bool terminate = false;
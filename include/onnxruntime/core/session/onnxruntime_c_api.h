@@ -228,6 +228,10 @@ ORT_API(void, OrtSetSessionLogVerbosityLevel, _In_ OrtSessionOptions* options, u
 // How many threads in the session thread pool.
 ORT_API(int, OrtSetSessionThreadPoolSize, _In_ OrtSessionOptions* options, int session_thread_pool_size);
 
+// How many threads, including the caller of OrtRun, a kernel that splits its own work (e.g. LSTM, GRU) may use.
+// By default all sessions share one pool sized to the hardware concurrency.
+ORT_API(int, OrtSetIntraOpThreadPoolSize, _In_ OrtSessionOptions* options, int intra_op_thread_pool_size);
+
 /**
   * To use additional providers, you must build ORT with the extra providers enabled. Then call one of these
   * functions to enable them in the session:
@@ -270,10 +274,17 @@ ORT_API(OrtRunOptions*, OrtCreateRunOptions);
 ORT_API_STATUS(OrtRunOptionsSetRunLogVerbosityLevel, _In_ OrtRunOptions*, unsigned int);
 ORT_API_STATUS(OrtRunOptionsSetRunTag, _In_ OrtRunOptions*, _In_ const char* run_tag);
 ORT_API(void, OrtRunOptionsSetCacheFeedsFetchesInfoEnabled, _In_ OrtRunOptions* options, int bool_value);
+// Return sequences of maps produced by ZipMap in columnar form, see OrtGetColumnarMapSequenceValues.
+ORT_API(void, OrtRunOptionsSetColumnarMapSequencesEnabled, _In_ OrtRunOptions* options, int bool_value);
+// Return the string outputs that can be produced in that form as packed string tensors,
+// see OrtCreatePackedStringTensorAsOrtValue.
+ORT_API(void, OrtRunOptionsSetPackedStringTensorsEnabled, _In_ OrtRunOptions* options, int bool_value);
 
 ORT_API(unsigned int, OrtRunOptionsGetRunLogVerbosityLevel, _In_ OrtRunOptions*);
 ORT_API(const char*, OrtRunOptionsGetRunTag, _In_ OrtRunOptions*);
 ORT_API(int, OrtRunOptionsGetCacheFeedsFetchesInfoEnabled, _In_ OrtRunOptions*);
+ORT_API(int, OrtRunOptionsGetColumnarMapSequencesEnabled, _In_ OrtRunOptions*);
+ORT_API(int, OrtRunOptionsGetPackedStringTensorsEnabled, _In_ OrtRunOptions*);
 
 // Set a flag so that any running OrtRun* calls that are using this instance of OrtRunOptions
 // will exit as soon as possible if the flag is true.
@@ -302,7 +313,7 @@ ORT_API_STATUS(OrtCreateTensorWithDataAsOrtValue, _In_ const OrtAllocatorInfo* i
 ORT_API_STATUS(OrtGetTensorMutableData, _Inout_ OrtValue* value, _Out_ void** out);
 
 /**
- * \Return 1 iff an OrtValue is a tensor, 0 otherwise
+ * \Return 1 iff an OrtValue is a tensor or a packed string tensor, 0 otherwise
  */
 ORT_API(int, OrtIsTensor, _In_ const OrtValue* value);
 
@@ -312,6 +323,15 @@ ORT_API(int, OrtIsTensor, _In_ const OrtValue* value);
  * \param s_len length of s
  */
 ORT_API_STATUS(OrtFillStringTensor, _In_ OrtValue* value, _In_ const char* const* s, size_t s_len);
+/**
+ * Fills a string tensor from one contiguous buffer, the layout returned by OrtGetStringTensorContent.
+ * \param s string contents. Each string is NOT null-terminated.
+ * \param s_len total data length
+ * \param offsets start of each string in s, the last string ends at s_len
+ * \param offsets_len length of offsets, at least the number of elements of the tensor
+ */
+ORT_API_STATUS(OrtFillStringTensorFromBuffer, _In_ OrtValue* value, _In_ const void* s, size_t s_len,
+               _In_ const size_t* offsets, size_t offsets_len);
 /**
  * \param value A tensor created from OrtCreateTensor... function.
  * \param len total data length, not including the trailing '\0' chars.
@@ -513,6 +533,61 @@ ORT_API_STATUS(OrtGetValueCount, const OrtValue* value, size_t* out);
 ORT_API_STATUS(OrtCreateValue, OrtValue** const in, int num_values, enum ONNXType value_type,
                OrtValue** out);
 
+/**
+   * Columnar sequences of maps.
+   * With OrtRunOptionsSetColumnarMapSequencesEnabled, the seq(map(string, float)) and seq(map(int64, float))
+   * outputs of ZipMap are returned as one key table shared by all the maps and a row-major [rows, keys]
+   * block of values. OrtGetValueCount and OrtGetValue still work on such values and build the map of the
+   * requested element on the fly.
+   */
+
+/**
+   * Returns 1 in *out if value is a columnar sequence of maps, 0 otherwise.
+   */
+ORT_API_STATUS(OrtIsColumnarMapSequence, const OrtValue* value, _Out_ int* out);
+
+/**
+   * Returns the keys shared by all the maps of a columnar sequence as a 1-D tensor of strings or int64.
+   * \param out Should be freed by calling OrtReleaseValue
+   */
+ORT_API_STATUS(OrtGetColumnarMapSequenceKeys, const OrtValue* value, _Inout_ OrtAllocator* allocator,
+               _Out_ OrtValue** out);
+
+/**
+   * Returns the values of a columnar sequence without copying them: the value of key k in map r is
+   * (*values)[r * (*num_keys) + k]. The pointer stays valid as long as the OrtValue.
+   */
+ORT_API_STATUS(OrtGetColumnarMapSequenceValues, const OrtValue* value, _Out_ const float** values,
+               _Out_ size_t* num_rows, _Out_ size_t* num_keys);
+
+/**
+   * Packed string tensors.
+   * A string tensor held as one buffer and the offset and length of each element, instead of one string
+   * object per element. Identity, Gather and Slice read and write it without copying any string data.
+   * It can be fed for any string input; with OrtRunOptionsSetPackedStringTensorsEnabled, the string outputs
+   * of these ops that no other node reads are returned in that form.
+   * OrtGetValueType, OrtGetTypeInfo, OrtGetTensorShapeAndType, OrtGetStringTensorDataLength and
+   * OrtGetStringTensorContent treat it as a string tensor; OrtGetTensorMutableData fails on it.
+   */
+
+/**
+   * Creates a packed string tensor with a single copy of s.
+   * \param s string contents. Each string is NOT null-terminated.
+   * \param s_len total data length
+   * \param offsets start of each string in s, the last string ends at s_len.
+   *   This is the layout returned by OrtGetStringTensorContent.
+   * \param offsets_len length of offsets, at least the number of elements of the tensor
+   * \param out Should be freed by calling OrtReleaseValue
+   */
+ORT_API_STATUS(OrtCreatePackedStringTensorAsOrtValue, _In_ const size_t* shape, size_t shape_len,
+               _In_ const void* s, size_t s_len, _In_ const size_t* offsets, size_t offsets_len,
+               _Out_ OrtValue** out);
+
+/**
+   * Returns 1 in *out if value is a packed string tensor, 0 otherwise.
+   */
+ORT_API_STATUS(OrtIsPackedStringTensor, const OrtValue* value, _Out_ int* out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -107,6 +107,9 @@ class SessionOptionsWrapper {
   void SetSessionThreadPoolSize(int session_thread_pool_size) {
     OrtSetSessionThreadPoolSize(value.get(), session_thread_pool_size);
   }
+  void SetIntraOpThreadPoolSize(int intra_op_thread_pool_size) {
+    OrtSetIntraOpThreadPoolSize(value.get(), intra_op_thread_pool_size);
+  }
 
   SessionOptionsWrapper clone() const {
     OrtSessionOptions* p = OrtCloneSessionOptions(value.get());
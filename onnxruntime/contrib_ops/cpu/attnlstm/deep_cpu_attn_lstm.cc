@@ -72,6 +72,9 @@ template <typename T>
 Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
   auto& logger = context.Logger();
 
+  int num_threads;
+  ThreadPool& ttp = GetIntraOpThreadPool(context, num_threads);
+
   // original lstm processing
   const Tensor& X = *context.Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size], input will concat with attention of previous state
   const Tensor& W = *context.Input<Tensor>(1);  // weights. [num_directions, 4*hidden_size, input_size + attention_size],
@@ -200,6 +203,14 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
     }
   }
 
+  // with OpenMP the GEMMs already fan out over the OpenMP threads, and a team per direction would oversubscribe them.
+#if defined(USE_MLAS) && !defined(USE_OPENMP)
+  const bool parallel_directions = direction_ == Direction::kBidirectional && num_threads > 1;
+#else
+  const bool parallel_directions = false;
+#endif
+  const int direction_threads = parallel_directions ? num_threads / 2 : num_threads;
+
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
     gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
@@ -248,7 +259,7 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
         activation_funcs_.Entries()[0],
         activation_funcs_.Entries()[1],
         activation_funcs_.Entries()[2],
-        clip_, ttp_);
+        clip_, ttp, direction_threads);
 
     auto bam = std::make_unique<BahdanauAttention<T>>(
         alloc, logger, batch_size, max_memory_step, memory_depth, query_depth, am_attn_size, false);
@@ -270,10 +281,22 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
         activation_funcs_.Entries()[3],
         activation_funcs_.Entries()[4],
         activation_funcs_.Entries()[5],
-        clip_, ttp_);
-
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
-    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+        clip_, ttp, direction_threads);
+
+    // each direction has its own attention mechanism, so the two can run concurrently
+    auto compute_direction = [&](int i) {
+      if (i == 0)
+        fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+      else
+        bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+    };
+
+    if (parallel_directions) {
+      ExecuteLambdaInParallel("Processing directions", compute_direction, 2, 1, ttp, logger);
+    } else {
+      compute_direction(0);
+      compute_direction(1);
+    }
 
   } else {
     auto fam = std::make_unique<BahdanauAttention<T>>(
@@ -296,7 +319,7 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
         activation_funcs_.Entries()[0],
         activation_funcs_.Entries()[1],
         activation_funcs_.Entries()[2],
-        clip_, ttp_);
+        clip_, ttp, direction_threads);
 
     fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
   }
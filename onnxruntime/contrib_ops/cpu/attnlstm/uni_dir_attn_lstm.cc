@@ -45,11 +45,8 @@ UniDirectionalAttnLstm<T>::UniDirectionalAttnLstm(AllocatorPtr allocator,
                                                   const ActivationFuncs::Entry& activation_func_g,
                                                   const ActivationFuncs::Entry& activation_func_h,
                                                   const float clip,
-#ifdef USE_EIGEN_THREADPOOL
-                                                  Eigen::NonBlockingThreadPool& ttp)
-#else
-                                                  TaskThreadPool& ttp)
-#endif
+                                                  ThreadPool& ttp,
+                                                  int num_threads)
     : allocator_(allocator),
       logger_(logger),
       seq_length_(seq_length),
@@ -80,7 +77,7 @@ UniDirectionalAttnLstm<T>::UniDirectionalAttnLstm(AllocatorPtr allocator,
   attention_size_ = attention_wrapper_.GetAttentionSize();
   attention_context_size_ = attention_wrapper_.GetAttentionContextSize();
 
-  SetNumThreads();
+  SetNumThreads(num_threads);
   AllocateBuffers();
   InitializeBuffers(initial_hidden_state, initial_cell_state);
 
@@ -475,8 +472,8 @@ void UniDirectionalAttnLstm<T>::GateComputations(span_T_iter& out, span_T_iter&
 }
 
 template <typename T>
-void UniDirectionalAttnLstm<T>::SetNumThreads() {
-  int threads = std::thread::hardware_concurrency() - 1;
+void UniDirectionalAttnLstm<T>::SetNumThreads(int num_threads) {
+  int threads = num_threads;
 
   if (threads < 1)
     threads = 1;
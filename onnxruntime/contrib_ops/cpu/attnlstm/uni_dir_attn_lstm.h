@@ -24,6 +24,7 @@ using ::onnxruntime::IAllocatorUniquePtr;
 using ::onnxruntime::contrib::detail::ActivationInfo;
 using ::onnxruntime::rnn::detail::ActivationFuncs;
 using ::onnxruntime::rnn::detail::Direction;
+using ::onnxruntime::rnn::detail::ThreadPool;
 
 namespace rnn {
 namespace detail {
@@ -51,11 +52,8 @@ class UniDirectionalAttnLstm {
                          const ActivationFuncs::Entry& activation_func_g,
                          const ActivationFuncs::Entry& activation_func_h,
                          const float clip,
-#ifdef USE_EIGEN_THREADPOOL
-                         Eigen::NonBlockingThreadPool& ttp);
-#else
-                         TaskThreadPool& ttp);
-#endif
+                         ThreadPool& ttp,
+                         int num_threads);
 
   void Compute(const gsl::span<const T>& inputs,
                const gsl::span<const int>& sequence_lengths,
@@ -76,7 +74,7 @@ class UniDirectionalAttnLstm {
   using span_T_const_iter = typename gsl::span<T>::const_iterator;
   using span_T_iter = typename gsl::span<T>::iterator;
 
-  void SetNumThreads();
+  void SetNumThreads(int num_threads);
 
   void GateComputations(span_T_iter& out, span_T_iter& out_end,
                         span_T_iter& C_prev, span_T_iter& C_prev_end,  // Ct-1 value not 'ct'. using 'C' for clarity
@@ -155,11 +153,7 @@ class UniDirectionalAttnLstm {
 
   AttentionWrapper<T>& attention_wrapper_;
 
-#ifdef USE_EIGEN_THREADPOOL
-  Eigen::NonBlockingThreadPool& ttp_;
-#else
-  TaskThreadPool& ttp_;
-#endif
+  ThreadPool& ttp_;
 };
 
 }  // namespace detail
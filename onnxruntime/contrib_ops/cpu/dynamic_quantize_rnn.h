@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cpu/rnn/deep_cpu_gru.h"
+#include "core/providers/cpu/rnn/deep_cpu_lstm.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// LSTM and GRU with W and R quantized to 8 bits when the kernel is created, and the GEMMs run on the integer GEMM.
+class DynamicQuantizeLSTM final : public DeepCpuLstmOp {
+ public:
+  DynamicQuantizeLSTM(const OpKernelInfo& info) : DeepCpuLstmOp(info, true) {}
+};
+
+class DynamicQuantizeGRU final : public DeepCpuGruOp {
+ public:
+  DynamicQuantizeGRU(const OpKernelInfo& info) : DeepCpuGruOp(info, true) {}
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -6,6 +6,8 @@
 */
 
 #pragma once
+#include <algorithm>
+#include <limits>
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
@@ -65,14 +67,8 @@ class MaxpoolWithMask : public OpKernel, public PoolBase {
             int64_t hstart = ph * stride_h() - pads[0];
             int64_t hend = std::min(hstart + kernel_shape[0], height);
             hstart = std::max(hstart, static_cast<int64_t>(0));
-            float Yh = std::numeric_limits<float>::lowest();
-            for (int64_t h = hstart; h < hend; ++h) {
-              if (h >= 0 && m_d[h] == 0) break;  // if mask == 0, stop
-              if (x_d[h] > Yh) {
-                Yh = x_d[h];
-              }
-            }
-            y_d[ph] = Yh;
+            // stop at the first element with mask == 0
+            y_d[ph] = MaskedRowMax(x_d, m_d, hstart, hstart, hend, std::numeric_limits<float>::lowest());
           }
         }
 
@@ -103,13 +99,11 @@ class MaxpoolWithMask : public OpKernel, public PoolBase {
               const int64_t pool_index = ph * pooled_width + pw;
               float Yh = std::numeric_limits<float>::lowest();
               for (int64_t h = hstart; h < hend; ++h) {
-                for (int64_t w = wstart; w < wend; ++w) {
-                  const int64_t input_index = h * width + w;
-                  if (input_index > 0 && m_d[input_index] == 0) break;  // if mask == 0, break
-                  if (x_d[input_index] > Yh) {
-                    Yh = x_d[input_index];
-                  }
-                }
+                // each row stops at its first element with mask == 0. the mask of element 0 is not checked.
+                const int64_t row_begin = h * width + wstart;
+                const int64_t row_end = h * width + wend;
+                const int64_t check_begin = row_begin == 0 ? std::min<int64_t>(1, row_end) : row_begin;
+                Yh = MaskedRowMax(x_d, m_d, row_begin, check_begin, row_end, Yh);
               }
               y_d[pool_index] = Yh;
             }
@@ -147,13 +141,11 @@ class MaxpoolWithMask : public OpKernel, public PoolBase {
                 float Yh = std::numeric_limits<float>::lowest();
                 for (int64_t h = hstart; h < hend; ++h) {
                   for (int64_t w = wstart; w < wend; ++w) {
-                    for (int64_t d = dstart; d < dend; ++d) {
-                      const int64_t input_index = h * width * depth + w * depth + d;
-                      if (input_index > 0 && m_d[input_index] == 0) break;  // if mask == 0, break
-                      if (x_d[input_index] > Yh) {
-                        Yh = x_d[input_index];
-                      }
-                    }
+                    // each row stops at its first element with mask == 0. the mask of element 0 is not checked.
+                    const int64_t row_begin = h * width * depth + w * depth + dstart;
+                    const int64_t row_end = h * width * depth + w * depth + dend;
+                    const int64_t check_begin = row_begin == 0 ? std::min<int64_t>(1, row_end) : row_begin;
+                    Yh = MaskedRowMax(x_d, m_d, row_begin, check_begin, row_end, Yh);
                   }
                 }
                 y_d[pool_index] = Yh;
@@ -169,6 +161,28 @@ class MaxpoolWithMask : public OpKernel, public PoolBase {
 
     return Status::OK();
   }
+
+ private:
+  // Returns the maximum of Yh and x[begin, end), stopping at the first element from check_begin on whose mask is 0.
+  // The mask is scanned first so the loop taking the maximum has no early exit. NaN values are skipped.
+  static float MaskedRowMax(const float* x, const int32_t* m, int64_t begin, int64_t check_begin, int64_t end,
+                            float Yh) {
+    if (end <= begin) {
+      return Yh;
+    }
+
+    const int64_t stop = std::find(m + check_begin, m + end, 0) - m;
+    if (stop == begin) {
+      return Yh;
+    }
+
+    for (int64_t i = begin; i < stop; ++i) {
+      if (x[i] > Yh) {
+        Yh = x[i];
+      }
+    }
+    return Yh;
+  }
 };
 
 }  // namespace contrib
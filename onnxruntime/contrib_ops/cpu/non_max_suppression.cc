@@ -12,7 +12,8 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #include "contrib_ops/cpu/non_max_suppression.h"
-#include <queue>
+#include <algorithm>
+#include <vector>
 
 namespace onnxruntime {
 namespace contrib {
@@ -26,8 +27,10 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
         .TypeConstraint("T2", DataTypeImpl::GetTensorType<int32_t>()),
     NonMaxSuppression<float>);
 
+namespace {
+
 template <typename T>
-void NonMaxSuppression<T>::MaxMin(const T& lhs, const T& rhs, T& min, T& max) const {
+void MaxMin(const T& lhs, const T& rhs, T& min, T& max) {
   if (lhs >= rhs) {
     min = rhs;
     max = lhs;
@@ -37,40 +40,131 @@ void NonMaxSuppression<T>::MaxMin(const T& lhs, const T& rhs, T& min, T& max) co
   }
 }
 
+// Corners and areas of the selected boxes, one array per value so the IOU of a candidate with all of them is
+// computed in blocks the compiler can vectorize.
 template <typename T>
-bool NonMaxSuppression<T>::SuppressByIOU(const T* boxes_data, int32_t box_index1, int32_t box_index2) const {
-  T x1_min, y1_min, x1_max, y1_max, x2_min, y2_min, x2_max, y2_max;
-  // boxes data [y1, x1, y2, x2],
-  MaxMin(boxes_data[4 * box_index1 + 1], boxes_data[4 * box_index1 + 3], x1_min, x1_max);
-  MaxMin(boxes_data[4 * box_index1 + 0], boxes_data[4 * box_index1 + 2], y1_min, y1_max);
-  MaxMin(boxes_data[4 * box_index2 + 1], boxes_data[4 * box_index2 + 3], x2_min, x2_max);
-  MaxMin(boxes_data[4 * box_index2 + 0], boxes_data[4 * box_index2 + 2], y2_min, y2_max);
-
-  const T intersection_x_min = std::max(x1_min, x2_min);
-  const T intersection_y_min = std::max(y1_min, y2_min);
-  const T intersection_x_max = std::min(x1_max, x2_max);
-  const T intersection_y_max = std::min(y1_max, y2_max);
-
-  const T intersection_area = std::max(intersection_x_max - intersection_x_min, static_cast<T>(0.0)) *
-                              std::max(intersection_y_max - intersection_y_min, static_cast<T>(0.0));
-
-  if (intersection_area <= static_cast<T>(0.0)) {
-    return false;
+class SelectedBoxes {
+ public:
+  explicit SelectedBoxes(size_t capacity) {
+    x_min_.reserve(capacity);
+    y_min_.reserve(capacity);
+    x_max_.reserve(capacity);
+    y_max_.reserve(capacity);
+    area_.reserve(capacity);
   }
 
-  const T area1 = (x1_max - x1_min) * (y1_max - y1_min);
-  const T area2 = (x2_max - x2_min) * (y2_max - y2_min);
-  const T union_area = area1 + area2 - intersection_area;
+  void Add(T x_min, T y_min, T x_max, T y_max, T area) {
+    x_min_.push_back(x_min);
+    y_min_.push_back(y_min);
+    x_max_.push_back(x_max);
+    y_max_.push_back(y_max);
+    area_.push_back(area);
+  }
+
+  // true if the IOU of the box with any selected box exceeds iou_threshold.
+  // the box and all the selected boxes have a positive area, so the union area is positive too.
+  bool Suppress(T x_min, T y_min, T x_max, T y_max, T area, T iou_threshold) const {
+    constexpr size_t kBlockSize = 16;
+    const size_t num_selected = area_.size();
+
+    // full blocks are checked without exiting early so the inner loop vectorizes
+    size_t i = 0;
+    for (; i + kBlockSize <= num_selected; i += kBlockSize) {
+      int suppress = 0;
+      for (size_t j = i; j < i + kBlockSize; ++j) {
+        suppress |= IntersectionOverUnion(j, x_min, y_min, x_max, y_max, area) > iou_threshold;
+      }
+
+      if (suppress) {
+        return true;
+      }
+    }
+
+    for (; i < num_selected; ++i) {
+      if (IntersectionOverUnion(i, x_min, y_min, x_max, y_max, area) > iou_threshold) {
+        return true;
+      }
+    }
 
-  if (area1 <= static_cast<T>(0.0) || area2 <= static_cast<T>(0.0) || union_area <= static_cast<T>(0.0)) {
     return false;
   }
 
-  const T intersection_over_union = intersection_area / union_area;
+ private:
+  T IntersectionOverUnion(size_t i, T x_min, T y_min, T x_max, T y_max, T area) const {
+    const T intersection_area = std::max(std::min(x_max_[i], x_max) - std::max(x_min_[i], x_min),
+                                         static_cast<T>(0.0)) *
+                                std::max(std::min(y_max_[i], y_max) - std::max(y_min_[i], y_min),
+                                         static_cast<T>(0.0));
+    const T union_area = area_[i] + area - intersection_area;
+    return intersection_area / union_area;
+  }
+
+  std::vector<T> x_min_;
+  std::vector<T> y_min_;
+  std::vector<T> x_max_;
+  std::vector<T> y_max_;
+  std::vector<T> area_;
+};
+
+}  // namespace
+
+template <typename T>
+int64_t SelectBoxesWithNonMaxSuppression(const T* boxes, const T* scores, int64_t num_boxes, int64_t max_output_size,
+                                         float iou_threshold, float score_threshold, int32_t* selected_indices) {
+  struct ScoreIndexPair {
+    T score;
+    int32_t index;
+  };
+
+  // Filter by score_threshold and sort the candidates once
+  std::vector<ScoreIndexPair> candidates;
+  candidates.reserve(num_boxes);
+  for (int32_t i = 0; i < num_boxes; ++i) {
+    if (static_cast<float>(scores[i]) > score_threshold) {
+      candidates.push_back({scores[i], i});
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end(), [](const ScoreIndexPair& lhs, const ScoreIndexPair& rhs) {
+    return lhs.score > rhs.score || (lhs.score == rhs.score && lhs.index < rhs.index);
+  });
+
+  // a box without a positive area has no IOU with any other box, so it is selected but never needs to be checked
+  // against, and is not added to selected_boxes.
+  SelectedBoxes<T> selected_boxes(static_cast<size_t>(std::min<int64_t>(max_output_size, candidates.size())));
+  const T threshold = static_cast<T>(iou_threshold);
+  int64_t num_selected = 0;
 
-  return intersection_over_union > iou_threshold_;
+  for (const auto& candidate : candidates) {
+    if (num_selected == max_output_size) {
+      break;
+    }
+
+    // boxes data [y1, x1, y2, x2],
+    const T* box = boxes + 4 * candidate.index;
+    T x_min, y_min, x_max, y_max;
+    MaxMin(box[1], box[3], x_min, x_max);
+    MaxMin(box[0], box[2], y_min, y_max);
+    const T area = (x_max - x_min) * (y_max - y_min);
+    const bool has_area = area > static_cast<T>(0.0);
+
+    if (has_area && selected_boxes.Suppress(x_min, y_min, x_max, y_max, area, threshold)) {
+      continue;
+    }
+
+    selected_indices[num_selected++] = candidate.index;
+    if (has_area) {
+      selected_boxes.Add(x_min, y_min, x_max, y_max, area);
+    }
+  }
+
+  return num_selected;
 }
 
+template int64_t SelectBoxesWithNonMaxSuppression<float>(const float* boxes, const float* scores, int64_t num_boxes,
+                                                         int64_t max_output_size, float iou_threshold,
+                                                         float score_threshold, int32_t* selected_indices);
+
 template <typename T>
 Status NonMaxSuppression<T>::Compute(OpKernelContext* ctx) const {
   const Tensor* boxes = ctx->Input<Tensor>(0);
@@ -97,46 +191,10 @@ Status NonMaxSuppression<T>::Compute(OpKernelContext* ctx) const {
   const T* boxes_data = boxes->Data<T>();
   const T* scores_data = scores->Data<T>();
 
-  struct ScoreIndexPair {
-    T score;
-    int32_t index;
-  };
-
-  auto LessCompare = [](const ScoreIndexPair& lhs, const ScoreIndexPair& rhs) {
-    return lhs.score < rhs.score;
-  };
-
-  // Filter by score_threshold_
-  std::priority_queue<ScoreIndexPair, std::deque<ScoreIndexPair>, decltype(LessCompare)> sorted_scores_with_index(LessCompare);
-  for (int32_t i = 0; i < num_boxes; ++i) {
-    if (static_cast<float>(scores_data[i]) > score_threshold_) {
-      sorted_scores_with_index.emplace(ScoreIndexPair({scores_data[i], i}));
-    }
-  }
-
-  int num_of_selected = 0;
   std::vector<int32_t> selected_index(max_output_size_, 0);
-  ScoreIndexPair next_top_score;
-
-  // Get the next box with top score, filter by iou_threshold_
-  while (num_of_selected < max_output_size_ && !sorted_scores_with_index.empty()) {
-    next_top_score = sorted_scores_with_index.top();
-    sorted_scores_with_index.pop();
-
-    bool selected = true;
-    // Check with existing boxes, suppress if exceed the IOU (Intersection Over Union) threshold
-    for (int i = num_of_selected - 1; i >= 0; --i) {
-      if (SuppressByIOU(boxes_data, selected_index[i], next_top_score.index)) {
-        selected = false;
-        break;
-      }
-    }
-
-    if (selected) {
-      selected_index[num_of_selected] = next_top_score.index;
-      ++num_of_selected;
-    }
-  }
+  const int64_t num_of_selected = SelectBoxesWithNonMaxSuppression(boxes_data, scores_data, num_boxes,
+                                                                   max_output_size_, iou_threshold_,
+                                                                   score_threshold_, selected_index.data());
 
   int64_t num_to_copy = pad_to_max_output_size_ == 1 ? max_output_size_ : num_of_selected;
   TensorShape output_shape({num_to_copy});
@@ -147,7 +205,7 @@ Status NonMaxSuppression<T>::Compute(OpKernelContext* ctx) const {
   TensorShape valid_outputs_shape({1});
   Tensor* valid_outputs = ctx->Output(1, valid_outputs_shape);
   if (valid_outputs) {
-    valid_outputs->MutableData<int32_t>()[0] = num_of_selected;
+    valid_outputs->MutableData<int32_t>()[0] = static_cast<int32_t>(num_of_selected);
   }
 
   return Status::OK();
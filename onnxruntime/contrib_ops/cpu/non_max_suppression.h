@@ -23,15 +23,20 @@ class NonMaxSuppression final : public OpKernel {
 
   Status Compute(OpKernelContext* context) const override;
 
-private:
-  bool SuppressByIOU(const T* boxes_data, int32_t box_index1, int32_t box_index2) const;
-  void MaxMin(const T& lhs, const T& rhs, T& min, T& max) const;
-
 private :
   int64_t max_output_size_;
   float iou_threshold_;
   float score_threshold_;
   int64_t pad_to_max_output_size_;
 };
+
+// Selects up to max_output_size of the boxes with a score above score_threshold, in descending score order
+// (lower box index first for equal scores), skipping any box whose IOU with an already selected box exceeds
+// iou_threshold. boxes is [num_boxes, 4] with [y1, x1, y2, x2] per box. The indices of the selected boxes are
+// written to selected_indices, and the number selected is returned.
+template <typename T>
+int64_t SelectBoxesWithNonMaxSuppression(const T* boxes, const T* scores, int64_t num_boxes, int64_t max_output_size,
+                                         float iou_threshold, float score_threshold, int32_t* selected_indices);
+
 }  // namespace contrib
 }  // namespace onnxruntime
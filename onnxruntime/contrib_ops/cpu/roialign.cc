@@ -64,7 +64,7 @@ void pre_calc_for_bilinear_interpolate(
     T bin_size_w,
     int64_t roi_bin_grid_h,
     int64_t roi_bin_grid_w,
-    std::vector<PreCalc<T>>& pre_calc) {
+    PreCalc<T>* pre_calc) {
   int64_t pre_calc_index = 0;
   for (int64_t ph = 0; ph < pooled_height; ph++) {
     for (int64_t pw = 0; pw < pooled_width; pw++) {
@@ -146,6 +146,24 @@ void pre_calc_for_bilinear_interpolate(
   }
 }
 
+// the geometry of an ROI, the size of its bilinear interpolation table and where that table starts in the buffer
+// of the block of ROIs it is processed in
+template <typename T>
+struct ROISampling {
+  int64_t batch_ind;
+  T roi_start_h;
+  T roi_start_w;
+  T bin_size_h;
+  T bin_size_w;
+  int64_t roi_bin_grid_h;
+  int64_t roi_bin_grid_w;
+  size_t pre_calc_size;
+  size_t pre_calc_offset;
+};
+
+// the tables of a block of ROIs are kept at once. an ROI with a larger table than this gets a block of its own.
+const size_t kMaxBlockPreCalcSize = 1 << 16;
+
 template <typename T>
 void ROIAlignForward(
     int64_t nthreads,
@@ -162,15 +180,15 @@ void ROIAlignForward(
     T* top_data,
     const std::string& mode) {
   int64_t n_rois = nthreads / channels / pooled_width / pooled_height;
+  const bool avg_mode = mode == "avg";
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int n = 0; n < n_rois; n++) {
-    int64_t index_n = n * channels * pooled_width * pooled_height;
-
+  // the indices and weights only depend on the ROI, so they are calculated once for every ROI
+  // and shared by all its channels. this is the key point of optimization.
+  std::vector<ROISampling<T>> roi_sampling(n_rois);
+  for (int64_t n = 0; n < n_rois; n++) {
     const T* offset_bottom_rois = bottom_rois + n * roi_cols;
-    const T roi_batch_ind = offset_bottom_rois[0];
+    ROISampling<T>& sampling = roi_sampling[n];
+    sampling.batch_ind = static_cast<int64_t>(offset_bottom_rois[0]);
     offset_bottom_rois++;
 
     // Do not using rounding; this implementation detail is critical
@@ -182,42 +200,80 @@ void ROIAlignForward(
     // Force malformed ROIs to be 1x1
     T roi_width = std::max(roi_end_w - roi_start_w, (T)1.);
     T roi_height = std::max(roi_end_h - roi_start_h, (T)1.);
-    T bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
-    T bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
+
+    sampling.roi_start_h = roi_start_h;
+    sampling.roi_start_w = roi_start_w;
+    sampling.bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
+    sampling.bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
 
     // We use roi_bin_grid to sample the grid and mimic integral
-    int64_t roi_bin_grid_h = (sampling_ratio > 0)
-                                 ? sampling_ratio
-                                 : static_cast<int64_t>(ceil(roi_height / pooled_height));  // e.g., = 2
-    int64_t roi_bin_grid_w =
+    sampling.roi_bin_grid_h = (sampling_ratio > 0)
+                                  ? sampling_ratio
+                                  : static_cast<int64_t>(ceil(roi_height / pooled_height));  // e.g., = 2
+    sampling.roi_bin_grid_w =
         (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(ceil(roi_width / pooled_width));
 
-    // We do average (integral) pooling inside a bin
-    const int64_t count = roi_bin_grid_h * roi_bin_grid_w;  // e.g. = 4
-
-    // we want to precalculate indices and weights shared by all channels,
-    // this is the key point of optimization
-    std::vector<PreCalc<T>> pre_calc(
-        roi_bin_grid_h * roi_bin_grid_w * pooled_width * pooled_height);
-    pre_calc_for_bilinear_interpolate(
-        height,
-        width,
-        pooled_height,
-        pooled_width,
-        roi_bin_grid_h,
-        roi_bin_grid_w,
-        roi_start_h,
-        roi_start_w,
-        bin_size_h,
-        bin_size_w,
-        roi_bin_grid_h,
-        roi_bin_grid_w,
-        pre_calc);
-
-    for (int64_t c = 0; c < channels; c++) {
-      int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-      const T* offset_bottom_data =
-          bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
+    sampling.pre_calc_size = static_cast<size_t>(sampling.roi_bin_grid_h * sampling.roi_bin_grid_w *
+                                                 pooled_width * pooled_height);
+  }
+
+  // the tables are built for a block of ROIs at a time so the memory they take stays bounded however many ROIs
+  // there are, while a block still holds enough ROIs to keep all threads busy in both parallel loops.
+  std::vector<PreCalc<T>> pre_calc;
+  for (int64_t block_begin = 0; block_begin < n_rois;) {
+    int64_t block_end = block_begin;
+    size_t block_pre_calc_size = 0;
+    do {
+      roi_sampling[block_end].pre_calc_offset = block_pre_calc_size;
+      block_pre_calc_size += roi_sampling[block_end].pre_calc_size;
+      block_end++;
+    } while (block_end < n_rois &&
+             block_pre_calc_size + roi_sampling[block_end].pre_calc_size <= kMaxBlockPreCalcSize);
+
+    pre_calc.resize(block_pre_calc_size);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int64_t n = block_begin; n < block_end; n++) {
+      const ROISampling<T>& sampling = roi_sampling[n];
+      pre_calc_for_bilinear_interpolate(
+          height,
+          width,
+          pooled_height,
+          pooled_width,
+          sampling.roi_bin_grid_h,
+          sampling.roi_bin_grid_w,
+          sampling.roi_start_h,
+          sampling.roi_start_w,
+          sampling.bin_size_h,
+          sampling.bin_size_w,
+          sampling.roi_bin_grid_h,
+          sampling.roi_bin_grid_w,
+          pre_calc.data() + sampling.pre_calc_offset);
+    }
+
+    // every (roi, channel) pair writes its own output plane, so they can be processed in any order.
+    // splitting the work on both keeps all threads busy when there are only a few ROIs.
+    const int64_t block_begin_roi_channel = block_begin * channels;
+    const int64_t block_end_roi_channel = block_end * channels;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int64_t n_c = block_begin_roi_channel; n_c < block_end_roi_channel; n_c++) {
+      const int64_t n = n_c / channels;
+      const int64_t c = n_c % channels;
+      const ROISampling<T>& sampling = roi_sampling[n];
+      const int64_t roi_bin_grid_h = sampling.roi_bin_grid_h;
+      const int64_t roi_bin_grid_w = sampling.roi_bin_grid_w;
+
+      // We do average (integral) pooling inside a bin
+      const int64_t count = roi_bin_grid_h * roi_bin_grid_w;  // e.g. = 4
+
+      int64_t index_n_c = n_c * pooled_width * pooled_height;
+      const T* offset_bottom_data = bottom_data + (sampling.batch_ind * channels + c) * height * width;
+      const PreCalc<T>* roi_pre_calc = pre_calc.data() + sampling.pre_calc_offset;
       int64_t pre_calc_index = 0;
 
       for (int64_t ph = 0; ph < pooled_height; ph++) {
@@ -225,10 +281,10 @@ void ROIAlignForward(
           int64_t index = index_n_c + ph * pooled_width + pw;
 
           T output_val = 0.;
-          if (mode == "avg") {  // avg pooling
+          if (avg_mode) {  // avg pooling
             for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
               for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                PreCalc<T> pc = pre_calc[pre_calc_index];
+                const PreCalc<T>& pc = roi_pre_calc[pre_calc_index];
                 output_val += pc.w1 * offset_bottom_data[pc.pos1] +
                               pc.w2 * offset_bottom_data[pc.pos2] +
                               pc.w3 * offset_bottom_data[pc.pos3] +
@@ -242,7 +298,7 @@ void ROIAlignForward(
             bool max_flag = false;
             for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
               for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                PreCalc<T> pc = pre_calc[pre_calc_index];
+                const PreCalc<T>& pc = roi_pre_calc[pre_calc_index];
                 if (!max_flag) {
                   output_val = pc.w1 * offset_bottom_data[pc.pos1];
                   max_flag = true;
@@ -260,8 +316,10 @@ void ROIAlignForward(
           top_data[index] = output_val;
         }  // for pw
       }    // for ph
-    }      // for c
-  }        // for n
+    }      // for n_c
+
+    block_begin = block_end;
+  }  // for block_begin
 }
 }  // namespace
 
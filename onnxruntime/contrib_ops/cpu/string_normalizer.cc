@@ -5,14 +5,16 @@
 #include "onnx/defs/schema.h"
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
+#include "core/providers/cpu/ml/hash_index.h"
 
 #ifdef _MSC_VER
 #include <locale.h>
 #endif
 
+#include <algorithm>
 #include <codecvt>
+#include <cstring>
 #include <locale>
-#include <functional>
 #include <unordered_set>
 
 namespace onnxruntime {
@@ -103,54 +105,176 @@ const std::string default_locale("en_US.UTF-8");
 
 #endif
 
-template <class ForwardIter>
-Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
-                      const Locale& loc,
-                      std::wstring_convert<std::codecvt_utf8<wchar_t>>& converter,
-                      size_t N, size_t C,
-                      StringNormalizer::CaseAction caseaction) {
-  std::vector<int64_t> output_dims;
-  if (N == 1) {
-    output_dims.push_back(1);
+using Converter = std::wstring_convert<std::codecvt_utf8<wchar_t>>;
+
+// ASCII strings are processed 8 bytes at a time in a 64-bit word
+constexpr uint64_t kBytesOne = 0x0101010101010101ULL;
+constexpr uint64_t kBytesHigh = 0x8080808080808080ULL;
+
+inline bool IsAscii(const char* s, size_t len) {
+  size_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    uint64_t word;
+    memcpy(&word, s + i, 8);
+    if (word & kBytesHigh) return false;
+  }
+  for (; i < len; ++i) {
+    if (static_cast<unsigned char>(s[i]) & 0x80) return false;
   }
+  return true;
+}
 
-  // Empty output case
-  if (C == 0) {
-    output_dims.push_back(1);
-    TensorShape output_shape(output_dims);
-    // This will create one empty string
-    ctx->Output(0, output_shape);
-    return Status::OK();
+// Flips the case bit of the bytes of an ASCII word in [first, last]
+inline uint64_t AsciiChangeCase(uint64_t word, char first, char last) {
+  // the high bit of a byte is set by the first addition if it is >= first
+  // and by the second if it is > last, ASCII bytes do not carry into the next byte
+  const uint64_t ge_first = word + kBytesOne * (0x80 - first);
+  const uint64_t gt_last = word + kBytesOne * (0x80 - last - 1);
+  const uint64_t in_range = ge_first & ~gt_last & kBytesHigh;
+  return word ^ (in_range >> 2);
+}
+
+// Changes the case of an ASCII string in place
+inline void AsciiChangeCase(StringNormalizer::CaseAction caseaction, char* s, size_t len) {
+  assert(caseaction != StringNormalizer::NONE);
+  const char first = caseaction == StringNormalizer::LOWER ? 'A' : 'a';
+  const char last = caseaction == StringNormalizer::LOWER ? 'Z' : 'z';
+  size_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    uint64_t word;
+    memcpy(&word, s + i, 8);
+    word = AsciiChangeCase(word, first, last);
+    memcpy(s + i, &word, 8);
+  }
+  if (i < len) {
+    uint64_t word = 0;
+    memcpy(&word, s + i, len - i);
+    word = AsciiChangeCase(word, first, last);
+    memcpy(s + i, &word, len - i);
   }
+}
 
-  output_dims.push_back(C);
+// Checks that the locale does not change the case of ASCII characters in
+// any other way, e.g. the dotless i of Turkish locales.
+bool LocaleMatchesAsciiCase(const Locale& loc) {
+  std::wstring ascii;
+  for (wchar_t ch = 1; ch < 0x80; ++ch) {
+    ascii.push_back(ch);
+  }
+  for (auto caseaction : {StringNormalizer::LOWER, StringNormalizer::UPPER}) {
+    std::wstring wstr(ascii);
+    loc.ChangeCase(caseaction, wstr);
+    std::string str(ascii.begin(), ascii.end());
+    AsciiChangeCase(caseaction, &str[0], str.size());
+    if (!std::equal(wstr.begin(), wstr.end(), str.begin(),
+                    [](wchar_t w, char c) { return w == static_cast<unsigned char>(c); })) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  TensorShape output_shape(output_dims);
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
+// Writes s with its case changed to out. ASCII strings do not go through the locale
+// if ascii_case is set. Returns false if s contains invalid utf8 chars.
+bool ChangeCase(const Locale& loc, bool ascii_case, Converter& converter,
+                StringNormalizer::CaseAction caseaction, const std::string& s, std::string& out) {
+  assert(caseaction != StringNormalizer::NONE);
+  if (ascii_case && IsAscii(s.data(), s.size())) {
+    out.assign(s);
+    AsciiChangeCase(caseaction, &out[0], out.size());
+    return true;
+  }
+  std::wstring wstr = converter.from_bytes(s);
+  if (wstr == wconv_error) {
+    return false;
+  }
+  // In place transform
+  loc.ChangeCase(caseaction, wstr);
+  out = converter.to_bytes(wstr);
+  return true;
+}
 
-  size_t output_idx = 0;
-  while (first != end) {
-    auto& s = *first;
-    if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
-      std::wstring wstr = converter.from_bytes(s);
-      if (wstr == wconv_error) {
-        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                      "Input contains invalid utf8 chars at: " + static_cast<const std::string&>(s));
+/**
+Two level perfect hash table of the stopwords: the words are hashed into buckets and
+each bucket of k words has its own table of k * k slots with a seed that puts them in
+different slots, so a lookup probes a single slot. Built once when the kernel is created.
+*/
+class StopwordTable {
+ public:
+  explicit StopwordTable(const std::vector<std::string>& words) : offsets_(1, 0) {
+    ORT_ENFORCE(words.size() < static_cast<size_t>(std::numeric_limits<int32_t>::max()), "Too many stopwords.");
+    size_t num_buckets = 1;
+    while (num_buckets < words.size()) num_buckets *= 2;
+    mask_ = num_buckets - 1;
+
+    std::vector<uint64_t> hashes(words.size());
+    std::vector<std::vector<int32_t>> bucket_words(num_buckets);
+    for (size_t w = 0; w < words.size(); ++w) {
+      chars_.insert(chars_.end(), words[w].begin(), words[w].end());
+      offsets_.push_back(chars_.size());
+      hashes[w] = ml::HashIndexHash(words[w].data(), words[w].size());
+      bucket_words[hashes[w] & mask_].push_back(static_cast<int32_t>(w));
+    }
+
+    buckets_.resize(num_buckets);
+    std::vector<int32_t> bucket_slots;
+    for (size_t b = 0; b < num_buckets; ++b) {
+      const auto& members = bucket_words[b];
+      Bucket& bucket = buckets_[b];
+      bucket.offset = slots_.size();
+      bucket.size = members.size() * members.size();
+      if (members.empty()) continue;
+      // expected to succeed within two seeds
+      const uint64_t kMaxSeed = 1024;
+      for (bucket.seed = 1;; ++bucket.seed) {
+        ORT_ENFORCE(bucket.seed < kMaxSeed, "Failed to build the stopword table.");
+        bucket_slots.assign(bucket.size, -1);
+        bool placed = true;
+        for (int32_t w : members) {
+          int32_t& slot = bucket_slots[Slot(bucket, hashes[w])];
+          if (slot >= 0) {
+            placed = false;
+            break;
+          }
+          slot = w;
+        }
+        if (placed) break;
       }
-      // In place transform
-      loc.ChangeCase(caseaction, wstr);
-      *(output_data + output_idx) = converter.to_bytes(wstr);
-    } else {
-      assert(caseaction == StringNormalizer::NONE);
-      // Simple copy or move if the iterator points to a non-const string
-      *(output_data + output_idx) = std::move(s);
+      slots_.insert(slots_.end(), bucket_slots.begin(), bucket_slots.end());
     }
-    ++output_idx;
-    ++first;
   }
-  return Status::OK();
-}
+
+  bool Contains(const char* data, size_t size) const {
+    const uint64_t hash = ml::HashIndexHash(data, size);
+    const Bucket& bucket = buckets_[hash & mask_];
+    if (bucket.size == 0) return false;
+    const int32_t w = slots_[bucket.offset + Slot(bucket, hash)];
+    if (w < 0) return false;
+    const size_t begin = offsets_[w];
+    return offsets_[w + 1] - begin == size && (size == 0 || memcmp(chars_.data() + begin, data, size) == 0);
+  }
+
+  bool Contains(const std::string& s) const { return Contains(s.data(), s.size()); }
+
+ private:
+  struct Bucket {
+    size_t offset = 0;
+    size_t size = 0;
+    uint64_t seed = 0;
+  };
+
+  static size_t Slot(const Bucket& bucket, uint64_t hash) {
+    return static_cast<size_t>(ml::HashIndexMix(hash ^ (bucket.seed * 0x9e3779b97f4a7c15ULL)) % bucket.size);
+  }
+
+  std::vector<Bucket> buckets_;
+  size_t mask_ = 0;
+  // word index per slot or -1
+  std::vector<int32_t> slots_;
+  std::vector<char> chars_;
+  std::vector<size_t> offsets_;
+};
+
 }  // namespace string_normalizer
 
 using namespace string_normalizer;
@@ -158,7 +282,8 @@ using namespace string_normalizer;
 StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
                                                                is_case_sensitive_(true),
                                                                casechangeaction_(NONE),
-                                                               compare_caseaction_(NONE) {
+                                                               compare_caseaction_(NONE),
+                                                               ascii_case_(false) {
   int64_t iscasesensitive = 0;
   Status status = info.GetAttr("is_case_sensitive", &iscasesensitive);
   ORT_ENFORCE(status.IsOK(), "attribute is_case_sensitive is not set");
@@ -183,25 +308,28 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
   }
 
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
-  Locale locale(locale_name_);
-  std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
+  locale_ = std::make_unique<Locale>(locale_name_);
+  ascii_case_ = LocaleMatchesAsciiCase(*locale_);
+  Converter converter(conv_error, wconv_error);
 
   std::vector<std::string> swords = info.GetAttrsOrDefault<std::string>("stopwords");
-  for (const auto& sw : swords) {
+  std::unordered_set<std::string> unique_words;
+  for (auto& sw : swords) {
     ORT_ENFORCE(!sw.empty(), "Empty stopwords not allowed");
-    if (is_case_sensitive_) {
-      auto p = stopwords_.insert(sw);
-      ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
-    } else {
-      std::wstring wstr = converter.from_bytes(sw);
-      ORT_ENFORCE(wstr != wconv_error, "Stopword contains invalid utf8 chars");
-      locale.ChangeCase(compare_caseaction_, wstr);
-      auto p = wstopwords_.insert(wstr);
-      ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
+    if (!is_case_sensitive_) {
+      bool result = ChangeCase(*locale_, ascii_case_, converter, compare_caseaction_, sw, sw);
+      ORT_ENFORCE(result, "Stopword contains invalid utf8 chars");
     }
+    auto p = unique_words.insert(sw);
+    ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
+  }
+  if (!swords.empty()) {
+    stopwords_ = std::make_unique<StopwordTable>(swords);
   }
 }
 
+StringNormalizer::~StringNormalizer() = default;
+
 Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   using namespace string_normalizer;
 
@@ -229,71 +357,94 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
                   "Input dimensions are either[C > 0] or [1][C > 0] allowed");
   }
 
-  Status status;
-  Locale locale(locale_name_);
-  std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
   auto const input_data = X->template Data<std::string>();
-  using StrRef = std::reference_wrapper<const std::string>;
-  if (is_case_sensitive_) {
-    if (!stopwords_.empty()) {
-      std::vector<StrRef> filtered_strings;
-      filtered_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        if (0 == stopwords_.count(s)) {
-          filtered_strings.push_back(std::cref(s));
-        }
-        ++first;
-      }
-      status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale, converter,
-                              N, filtered_strings.size(), casechangeaction_);
-    } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, casechangeaction_);
+  const int64_t count = static_cast<int64_t>(C);
+  std::vector<char> invalid_utf8(C, 0);
+  auto check_utf8 = [&]() {
+    auto invalid = std::find(invalid_utf8.cbegin(), invalid_utf8.cend(), 1);
+    if (invalid != invalid_utf8.cend()) {
+      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                    "Input contains invalid utf8 chars at: " + input_data[invalid - invalid_utf8.cbegin()]);
     }
-  } else {
-    if (!wstopwords_.empty()) {
-      // Filter input. When no case action is required
-      // we simply store original string references.
-      // Otherwise, we store converted strings.
-      std::vector<StrRef> filtered_orignal_strings;
-      std::vector<std::string> filtered_cased_strings;
-      filtered_orignal_strings.reserve(C);
-      filtered_cased_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        std::wstring wstr = converter.from_bytes(s);
-        if (wstr == wconv_error) {
-          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                        "Input contains invalid utf8 chars at: " + s);
-        }
-        locale.ChangeCase(compare_caseaction_, wstr);
-        if (0 == wstopwords_.count(wstr)) {
-          if (casechangeaction_ == NONE) {
-            filtered_orignal_strings.push_back(std::cref(s));
-          } else {
-            filtered_cased_strings.push_back(converter.to_bytes(wstr));
-          }
+    return Status::OK();
+  };
+
+  // Filter the input. When the compare is not case sensitive the strings in
+  // compare case are kept, they are the output if the case changes.
+  std::vector<char> keep(C, 1);
+  std::vector<std::string> cased;
+  if (stopwords_ != nullptr) {
+    if (!is_case_sensitive_) {
+      cased.resize(C);
+    }
+#ifdef USE_OPENMP
+#pragma omp parallel
+#endif
+    {
+      Converter converter(conv_error, wconv_error);
+#ifdef USE_OPENMP
+#pragma omp for
+#endif
+      for (int64_t i = 0; i < count; ++i) {
+        if (is_case_sensitive_) {
+          keep[i] = !stopwords_->Contains(input_data[i]);
+        } else if (ChangeCase(*locale_, ascii_case_, converter, compare_caseaction_, input_data[i], cased[i])) {
+          keep[i] = !stopwords_->Contains(cased[i]);
+        } else {
+          invalid_utf8[i] = 1;
         }
-        ++first;
       }
+    }
+    ORT_RETURN_IF_ERROR(check_utf8());
+  }
+
+  std::vector<int64_t> kept;
+  kept.reserve(C);
+  for (int64_t i = 0; i < count; ++i) {
+    if (keep[i]) kept.push_back(i);
+  }
+
+  std::vector<int64_t> output_dims;
+  if (N == 1) {
+    output_dims.push_back(1);
+  }
+
+  // Empty output case
+  if (kept.empty()) {
+    output_dims.push_back(1);
+    TensorShape output_shape(output_dims);
+    // This will create one empty string
+    ctx->Output(0, output_shape);
+    return Status::OK();
+  }
+
+  output_dims.push_back(kept.size());
+  TensorShape output_shape(output_dims);
+  auto output_tensor = ctx->Output(0, output_shape);
+  auto const output_data = output_tensor->template MutableData<std::string>();
+
+  const int64_t output_count = static_cast<int64_t>(kept.size());
+#ifdef USE_OPENMP
+#pragma omp parallel
+#endif
+  {
+    Converter converter(conv_error, wconv_error);
+#ifdef USE_OPENMP
+#pragma omp for
+#endif
+    for (int64_t o = 0; o < output_count; ++o) {
+      const int64_t i = kept[o];
       if (casechangeaction_ == NONE) {
-        status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, converter,
-                                N, filtered_orignal_strings.size(), NONE);
-      } else {
-        status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, converter,
-                                N, filtered_cased_strings.size(), NONE);
+        output_data[o] = input_data[i];
+      } else if (!cased.empty()) {
+        // compare case is the output case
+        output_data[o] = std::move(cased[i]);
+      } else if (!ChangeCase(*locale_, ascii_case_, converter, casechangeaction_, input_data[i], output_data[o])) {
+        invalid_utf8[i] = 1;
       }
-    } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, casechangeaction_);
     }
   }
-  return status;
+  return check_utf8();
 }
 }  // namespace contrib
 }  // namespace onnxruntime
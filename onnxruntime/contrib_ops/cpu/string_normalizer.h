@@ -5,13 +5,17 @@
 
 #include "core/framework/op_kernel.h"
 
-#include <locale>
+#include <memory>
 #include <string>
-#include <unordered_set>
 
 namespace onnxruntime {
 namespace contrib {
 
+namespace string_normalizer {
+class Locale;
+class StopwordTable;
+}  // namespace string_normalizer
+
 class StringNormalizer : public OpKernel {
  public:
   enum CaseAction {
@@ -21,7 +25,7 @@ class StringNormalizer : public OpKernel {
   };
 
   explicit StringNormalizer(const OpKernelInfo& info);
-  ~StringNormalizer() = default;
+  ~StringNormalizer() override;
 
   Status Compute(OpKernelContext* ctx) const override;
 
@@ -30,9 +34,11 @@ class StringNormalizer : public OpKernel {
   CaseAction casechangeaction_;
   CaseAction compare_caseaction_;  // used for case-insensitive compare
   std::string locale_name_;
-  // Either if these are populated but not both
-  std::unordered_set<std::string> stopwords_;
-  std::unordered_set<std::wstring> wstopwords_;
+  std::unique_ptr<string_normalizer::Locale> locale_;
+  // the locale changes the case of ASCII characters the same way as AsciiChangeCase
+  bool ascii_case_;
+  // utf8 stopwords, in compare_caseaction_ case if not case sensitive. Null if there are none.
+  std::unique_ptr<string_normalizer::StopwordTable> stopwords_;
 };
 
 }  // namespace contrib
@@ -10,8 +10,8 @@
 #include "core/common/utf8_util.h"
 #include "re2/re2.h"
 
-#include <codecvt>
-#include <locale>
+#include <algorithm>
+#include <vector>
 
 namespace onnxruntime {
 namespace contrib {
@@ -26,15 +26,16 @@ class Tokenizer final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  Status CharTokenize(OpKernelContext* context, size_t N, size_t C,
-                      const std::vector<int64_t>& input_dims) const;
+  // A token is a byte offset and a byte length within its input string
+  using Token = std::pair<size_t, size_t>;
+
+  // The row functions return false if the string is not valid utf8
+  bool CharTokenize(const std::string& s, std::vector<Token>& tokens) const;
 
-  Status SeparatorTokenize(OpKernelContext* context, size_t N, size_t C,
-                           const std::vector<int64_t>& input_dims) const;
+  bool SeparatorTokenize(const std::string& s, std::vector<Token>& tokens,
+                         std::vector<int32_t>& best_match) const;
 
-  Status ExpressionTokenize(OpKernelContext* ctx,
-                            size_t N, size_t C,
-                            const std::vector<int64_t>& input_dims) const;
+  bool ExpressionTokenize(const std::string& s, std::vector<Token>& tokens) const;
 
   bool mark_;
   std::string pad_value_;
@@ -60,171 +61,125 @@ namespace tokenizer_details {
 const char start_text = 0x2;
 const char end_text = 0x3;
 
-const std::string conv_error("Conversion Error");
-const std::wstring wconv_error(L"Conversion Error");
-
-// Use a Trie like structure for searching multiple strings
-// at once but convert it to a ternary tree for saving space.
-// We insert separators in the same order they are specified.
-// Template parameter is a CharT which can be a char/wchar_t
-// or anything else that supports operator ><,== as long as
-// this is not a variable length sequence. We convert utf8 to utf16
-// before inserting.
-// Value is a supplementary information useful for search hit
-// and is present in the nodes that terminate the whole search pattern
-template <class CharT, class Value>
-class TernarySearchTree {
- private:
-  struct Node {
-    std::unique_ptr<Node> left_;
-    std::unique_ptr<Node> mid_;
-    std::unique_ptr<Node> right_;
-    CharT c_;  // character
-    Value value_;
-    bool has_val_;
-
-    explicit Node(CharT c) : c_(c), value_(), has_val_(false) {
-    }
-    ~Node() = default;
-  };
-
-  struct GetState {
-    const CharT* const str_;
-    const size_t len_;
-    size_t depth_;
-    const Value* result_;
-  };
-
+// Aho-Corasick automaton over the utf8 bytes of the separators, compiled into
+// a dense transition table so that a string is scanned once, one table lookup per byte.
+// A separator that is valid utf8 can only match at a character boundary of a valid utf8
+// string, so matching bytes gives the same matches as matching characters.
+// Separators are numbered in the order they are added, a lower number has priority.
+class SeparatorAutomaton {
  public:
-  TernarySearchTree() = default;
-  ~TernarySearchTree() = default;
+  SeparatorAutomaton() : transitions_(kAlphabet, kNone), pattern_(1, kNone), fail_(1, 0), output_(1, kNone) {}
 
   /**
-  * Returns a ptr to an associated value and nullptr on search miss.
-  * Must use default constructed state.
+  * Returns false on duplicates.
   */
-  const Value* get(const CharT* str, size_t len) const {
-    if (len == 0) {
-      return nullptr;
+  bool Add(const std::string& separator) {
+    assert(!separator.empty());
+    int32_t state = 0;
+    for (unsigned char c : separator) {
+      int32_t& next = transitions_[state * kAlphabet + c];
+      if (next == kNone) {
+        next = static_cast<int32_t>(pattern_.size());
+        transitions_.resize(transitions_.size() + kAlphabet, kNone);
+        pattern_.push_back(kNone);
+        fail_.push_back(0);
+        output_.push_back(kNone);
+      }
+      state = transitions_[state * kAlphabet + c];
     }
-    GetState get_state{str, len, 0, nullptr};
-    get(root_.get(), get_state);
-    return get_state.result_;
-  }
-
-  /**
-  * Returns true if successful and false on empty strings
-  * and duplicates.
-  */
-  bool put(const CharT* str, size_t len, const Value& v) {
-    if (len < 1) {
-      assert(false);
+    if (pattern_[state] != kNone) {
       return false;
     }
-    Node* new_root = put(root_.get(), str, len, v, 0);
-    if (new_root != nullptr) {
-      root_.release();
-      root_.reset(new_root);
-      return true;
-    }
-    return false;
+    pattern_[state] = static_cast<int32_t>(lengths_.size());
+    lengths_.push_back(separator.size());
+    return true;
   }
 
- private:
-  void update_state(const Node* node, GetState& state) const {
-    if (node->has_val_) {
-      if (state.result_ == nullptr) {
-        state.result_ = &node->value_;
-      } else if (node->value_ < *state.result_) {
-        state.result_ = &node->value_;
+  // Fills in the failure transitions, must be called once after all the separators are added.
+  void Build() {
+    std::vector<int32_t> queue;
+    queue.reserve(pattern_.size());
+    for (size_t c = 0; c < kAlphabet; ++c) {
+      int32_t& next = transitions_[c];
+      if (next == kNone) {
+        next = 0;
+      } else {
+        queue.push_back(next);
       }
     }
-  }
-  void get(const Node* node, GetState& state) const {
-    if (node == nullptr) {
-      return;
-    }
-    assert(state.depth_ < state.len_);
-    CharT c = state.str_[state.depth_];
-    if (c < node->c_) {
-      get(node->left_.get(), state);
-      return;
-    } else if (c > node->c_) {
-      get(node->right_.get(), state);
-      return;
-    } else if (state.depth_ < (state.len_ - 1)) {
-      // Check if we have a match at this node
-      update_state(node, state);
-      if (node->mid_ != nullptr) {
-        ++state.depth_;
-        get(node->mid_.get(), state);
+    // breadth first so that the failure state of a state is complete before the state itself
+    for (size_t q = 0; q < queue.size(); ++q) {
+      const int32_t state = queue[q];
+      const int32_t fail = fail_[state];
+      for (size_t c = 0; c < kAlphabet; ++c) {
+        int32_t& next = transitions_[state * kAlphabet + c];
+        const int32_t fail_next = transitions_[fail * kAlphabet + c];
+        if (next == kNone) {
+          next = fail_next;
+        } else {
+          fail_[next] = fail_next;
+          output_[next] = pattern_[fail_next] != kNone ? fail_next : output_[fail_next];
+          queue.push_back(next);
+        }
       }
-      return;
     }
-    update_state(node, state);
   }
 
-  Node* put(Node* node, const CharT* str, size_t len, const Value& v, size_t depth) {
-    CharT c = str[depth];
-
-    std::unique_ptr<Node> new_node;
-    if (node == nullptr) {
-      new_node.reset(new Node(c));
-    }
-
-    Node* new_link = nullptr;
-    Node* n = (node != nullptr) ? node : new_node.get();
-    if (c < n->c_) {
-      new_link = put(n->left_.get(), str, len, v, depth);
-      if (new_link != nullptr) {
-        n->left_.release();
-        n->left_.reset(new_link);
-      }
-    } else if (c > n->c_) {
-      new_link = put(n->right_.get(), str, len, v, depth);
-      if (new_link != nullptr) {
-        n->right_.release();
-        n->right_.reset(new_link);
-      }
-    } else if (depth < (len - 1)) {
-      new_link = put(n->mid_.get(), str, len, v, depth + 1);
-      if (new_link != nullptr) {
-        n->mid_.release();
-        n->mid_.reset(new_link);
-      }
-    } else {
-      if (!n->has_val_) {
-        n->value_ = v;
-        n->has_val_ = true;
-        new_link = n;
+  /**
+  * For every byte position of s where at least one separator starts, sets best_match to the
+  * separator with the highest priority that starts there, and to kNone everywhere else.
+  */
+  void Match(const char* s, size_t len, std::vector<int32_t>& best_match) const {
+    best_match.assign(len, kNone);
+    int32_t state = 0;
+    for (size_t i = 0; i < len; ++i) {
+      state = transitions_[state * kAlphabet + static_cast<unsigned char>(s[i])];
+      // all the separators that end here
+      for (int32_t hit = pattern_[state] != kNone ? state : output_[state]; hit != kNone; hit = output_[hit]) {
+        const int32_t separator = pattern_[hit];
+        int32_t& best = best_match[i + 1 - lengths_[separator]];
+        if (best == kNone || separator < best) {
+          best = separator;
+        }
       }
     }
-    if (new_link != nullptr) {
-      new_node.release();
-      return n;
-    }
-    return nullptr;
   }
-  std::unique_ptr<Node> root_;
+
+  size_t Length(int32_t separator) const { return lengths_[separator]; }
+
+  static constexpr int32_t kNone = -1;
+
+ private:
+  static constexpr size_t kAlphabet = 256;
+  // [state][byte] -> state
+  std::vector<int32_t> transitions_;
+  // separator that ends at the state, or kNone
+  std::vector<int32_t> pattern_;
+  std::vector<int32_t> fail_;
+  // next state on the failure chain where a separator ends, or kNone
+  std::vector<int32_t> output_;
+  // byte length of each separator
+  std::vector<size_t> lengths_;
 };
 
-// We store the length of the original pattern within the
-// Ternary Tree. This allows us to cut out the length of the matching
-// separator from the original string.
-struct SearchValue {
-  size_t w_len;
-  int priority_;
-  bool operator<(const SearchValue& o) const {
-    return priority_ < o.priority_;
+constexpr int32_t SeparatorAutomaton::kNone;
+constexpr size_t SeparatorAutomaton::kAlphabet;
+
+// Number of utf8 characters in valid utf8 bytes
+inline size_t utf8_chars(const char* s, size_t len) {
+  size_t chars = 0;
+  for (size_t i = 0; i < len; ++i) {
+    chars += (static_cast<unsigned char>(s[i]) & 0xC0) != 0x80;
   }
-};
+  return chars;
+}
 
 }  // namespace tokenizer_details
 
 using namespace tokenizer_details;
 
 struct Tokenizer::SearchData {
-  TernarySearchTree<wchar_t, SearchValue> tst_;
+  SeparatorAutomaton automaton_;
 };
 
 Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
@@ -262,16 +217,16 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
   if (!char_tokenezation_) {
     if (!separators.empty()) {
       std::unique_ptr<SearchData> sd(std::make_unique<SearchData>());
-      std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
-      int priority = 0;  // earlier search patterns get priority
+      // earlier search patterns get priority
       for (const auto& sep : separators) {
         ORT_ENFORCE(!sep.empty(), "No empty separators allowed");
-        std::wstring wsep = converter.from_bytes(sep);
-        ORT_ENFORCE(wsep != wconv_error, "Separator strings contains invalid utf8 chars");
-        bool result = sd->tst_.put(wsep.c_str(), wsep.length(), {wsep.length(), priority});
+        size_t sep_chars = 0;
+        ORT_ENFORCE(utf8_validate(reinterpret_cast<const unsigned char*>(sep.data()), sep.size(), sep_chars),
+                    "Separator strings contains invalid utf8 chars");
+        bool result = sd->automaton_.Add(sep);
         ORT_ENFORCE(result, "duplicate separator detected");
-        ++priority;
       }
+      sd->automaton_.Build();
       search_data_.swap(sd);
     } else {
       // Use tokenexp
@@ -287,337 +242,123 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
   }
 }
 
-Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
-                               const std::vector<int64_t>& input_dims) const {
-  // With char tokenzation we get as many tokens as the number of
-  // utf8 characters in the string. So for every string we calculate its character(utf8) length
-  // add padding and add start/end test separators if necessary
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    size_t tokens = 0;  // length in utf8 chars
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       tokens)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
-    }
-    if (mark_) {
-      tokens += 2;  // Start/end markers as separate tokens
-    }
-    max_tokens = std::max(max_tokens, tokens);
-    ++curr_input;
+bool Tokenizer::CharTokenize(const std::string& s, std::vector<Token>& tokens) const {
+  // With char tokenzation we get as many tokens as the number of utf8 characters in the string
+  size_t chars = 0;
+  if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(), chars)) {
+    return false;
   }
-
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to apparently empty strings input.
-  if ((max_tokens - mark_ * 2) == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
+  tokens.reserve(chars);
+  const size_t str_len = s.size();
+  for (size_t token_idx = 0; token_idx < str_len;) {
+    size_t tlen = 0;
+    bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
+    assert(result);
+    (void)result;
+    assert(token_idx + tlen <= str_len);
+    tokens.emplace_back(token_idx, tlen);
+    token_idx += tlen;
   }
+  return true;
+}
 
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-  size_t output_index = 0;
-  curr_input = input_data;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    size_t tokens = 0;
-    const size_t str_len = s.size();
-    for (size_t token_idx = 0; token_idx < str_len;) {
-      size_t tlen = 0;
-      bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
-      assert(result);
-      (void)result;
-      assert(token_idx + tlen <= str_len);
-      *(output_data + output_index) = s.substr(token_idx, tlen);
-      ++output_index;
-      token_idx += tlen;
-      ++tokens;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    // Padding strings
-    assert(tokens + (mark_ * 2) <= max_tokens);
-    const size_t pads = max_tokens - (mark_ * 2) - tokens;
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-    ++curr_input;
+bool Tokenizer::SeparatorTokenize(const std::string& s, std::vector<Token>& tokens,
+                                  std::vector<int32_t>& best_match) const {
+  size_t chars = 0;
+  if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(), chars)) {
+    return false;
   }
-  return Status::OK();
-}
 
-Status Tokenizer::SeparatorTokenize(OpKernelContext* ctx,
-                                    size_t N, size_t C,
-                                    const std::vector<int64_t>& input_dims) const {
-  struct Match {
-    int priority_;
-    size_t offset_;
-    size_t size_;
-    // create a conflict for overlapping matches
-    // thus if they overlap neither is less than the other
-    // and they are considered equal
-    bool operator<(const Match& o) const {
-      return (offset_ + size_) <= o.offset_;
+  const SeparatorAutomaton& automaton = search_data_->automaton_;
+  automaton.Match(s.data(), s.size(), best_match);
+
+  // Walk the match starts in order. A match that overlaps the previously kept one
+  // replaces it only if its separator has a higher priority, so if overlapping matches
+  // are of the same pattern the earlier match naturally wins.
+  size_t offset = 0;  // end of the previous kept match
+  size_t kept_offset = 0;
+  size_t kept_end = 0;
+  int32_t kept = SeparatorAutomaton::kNone;
+  auto emit = [&](size_t match_offset) {
+    // the token before a kept match
+    assert(match_offset >= offset);
+    const size_t sz = match_offset - offset;
+    if (sz > 0 && utf8_chars(s.data() + offset, sz) >= size_t(mincharnum_)) {
+      tokens.emplace_back(offset, sz);
     }
   };
-
-  std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
-  // Scan all strings and attempt to find separators in them
-  // collect all the output tokens here
-  size_t max_tokens = 0;
-  std::vector<std::vector<std::wstring>> tokenized_strings;
-  tokenized_strings.reserve(N * C);
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    std::wstring wstr = converter.from_bytes(s);
-    if (wstr == wconv_error) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Invalid utf8 chars in the input: " + s);
-    }
-
-    std::set<Match> matches;
-    const wchar_t* ws = wstr.c_str();
-    size_t len_remaining = wstr.length();
-    size_t offset = 0;
-    while (len_remaining > 0) {
-      const auto* val = search_data_->tst_.get(ws, len_remaining);
-      if (val != nullptr) {
-        auto p = matches.insert({val->priority_, offset, val->w_len});
-        while (!p.second && val->priority_ < p.first->priority_) {
-          // if overlapping matches of the same pattern(priority), then
-          // the earlier match naturally wins
-          matches.erase(p.first);
-          p = matches.insert({val->priority_, offset, val->w_len});
-        }
+  for (size_t pos = 0, len = s.size(); pos < len; ++pos) {
+    const int32_t separator = best_match[pos];
+    if (separator == SeparatorAutomaton::kNone) {
+      continue;
+    }
+    if (kept != SeparatorAutomaton::kNone && pos < kept_end) {
+      if (separator < kept) {
+        kept = separator;
+        kept_offset = pos;
+        kept_end = pos + automaton.Length(separator);
       }
-      ++ws;
-      ++offset;
-      --len_remaining;
+      continue;
     }
-
-    // Tokenize
-    tokenized_strings.emplace_back();
-    auto& row_tokens = tokenized_strings.back();
-    row_tokens.reserve(matches.size() + 1);
-    ws = wstr.c_str();
-    offset = 0;
-    for (const auto& m : matches) {
-      assert(m.offset_ >= offset);
-      size_t sz = (m.offset_ - offset);
-      if (sz > 0 && sz >= size_t(mincharnum_)) {
-        row_tokens.emplace_back(ws, sz);
-      }
-      offset = m.offset_ + m.size_;
-      ws = wstr.c_str() + offset;
-    }
-    assert(offset <= wstr.length());
-    if (offset < wstr.length()) {
-      row_tokens.emplace_back(ws, wstr.length() - offset);
+    if (kept != SeparatorAutomaton::kNone) {
+      emit(kept_offset);
+      offset = kept_end;
     }
-
-    size_t tokens = row_tokens.size();
-    if (mark_) {
-      tokens += 2;  // Start/end markers as separate tokens
-    }
-    max_tokens = std::max(max_tokens, tokens);
-    ++curr_input;
+    kept = separator;
+    kept_offset = pos;
+    kept_end = pos + automaton.Length(separator);
   }
-
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to either empty input
-  // everything is a separator
-  if ((max_tokens - mark_ * 2) == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
+  if (kept != SeparatorAutomaton::kNone) {
+    emit(kept_offset);
+    offset = kept_end;
   }
-
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  size_t output_index = 0;
-  for (auto& row : tokenized_strings) {
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (auto& token : row) {
-      *(output_data + output_index) = converter.to_bytes(token);
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
+  assert(offset <= s.size());
+  if (offset < s.size()) {
+    tokens.emplace_back(offset, s.size() - offset);
   }
-  return Status::OK();
+  return true;
 }
 
-Status Tokenizer::ExpressionTokenize(OpKernelContext* ctx,
-                                     size_t N, size_t C,
-                                     const std::vector<int64_t>& input_dims) const {
+bool Tokenizer::ExpressionTokenize(const std::string& s, std::vector<Token>& tokens) const {
   using namespace re2;
-  // Represents a token that will be output after
-  // first is the index, second is the size;
-  using Token = std::pair<size_t, size_t>;
-  std::vector<std::vector<Token>> tokens;
-  tokens.reserve(N * C);
-
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-
   // We do not constraint the search to match
   // on the beginning or end of the string
   const RE2::Anchor anchor = RE2::UNANCHORED;
 
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    tokens.emplace_back();
-    auto& row = tokens.back();
-
-    StringPiece text(s);
-    const auto end_pos = s.length();
-    size_t start_pos = 0;
-    StringPiece submatch;
-
-    bool match = true;
-    while (match) {
-      match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
-      if (match) {
-        // Record  pos/len
-        assert(submatch.data() != nullptr);
-        size_t match_pos = submatch.data() - s.data();
-        assert(match_pos >= start_pos);
-        auto token_len = match_pos - start_pos;
-        if (token_len > 0) {
-          row.emplace_back(start_pos, token_len);
-        }
-        // Update starting position
-        // Guard against empty string match
-        auto match_len = submatch.length();
-        if (match_len > 0) {
-          start_pos = match_pos + match_len;
-        } else {
-          start_pos = match_pos + 1;
-        }
+  StringPiece text(s);
+  const auto end_pos = s.length();
+  size_t start_pos = 0;
+  StringPiece submatch;
+
+  bool match = true;
+  while (match) {
+    match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+    if (match) {
+      // Record  pos/len
+      assert(submatch.data() != nullptr);
+      size_t match_pos = submatch.data() - s.data();
+      assert(match_pos >= start_pos);
+      auto token_len = match_pos - start_pos;
+      if (token_len > 0) {
+        tokens.emplace_back(start_pos, token_len);
+      }
+      // Update starting position
+      // Guard against empty string match
+      auto match_len = submatch.length();
+      if (match_len > 0) {
+        start_pos = match_pos + match_len;
       } else {
-        // record trailing token
-        auto trailing_len = end_pos - start_pos;
-        if (trailing_len > 0) {
-          row.emplace_back(start_pos, trailing_len);
-        }
+        start_pos = match_pos + 1;
+      }
+    } else {
+      // record trailing token
+      auto trailing_len = end_pos - start_pos;
+      if (trailing_len > 0) {
+        tokens.emplace_back(start_pos, trailing_len);
       }
     }
-    size_t tokens_num = row.size();
-    if (mark_) {
-      tokens_num += 2;  // Start/end markers as separate tokens
-    }
-    max_tokens = std::max(max_tokens, tokens_num);
-    ++curr_input;
-  }
-  // Check for empty output
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to either empty input
-  // everything is a separator
-  if ((max_tokens - mark_ * 2) == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
-  }
-
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  curr_input = input_data;
-  size_t output_index = 0;
-  for (const auto& row : tokens) {
-    assert(curr_input != last);
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    const char* data = curr_input->data();
-    for (const auto& token : row) {
-#ifdef _DEBUG
-      auto s_len = curr_input->length();
-      assert(token.second > 0);
-      assert(token.first < s_len);
-      assert(token.first + token.second <= s_len);
-#endif
-      (output_data + output_index)->assign(data + token.first, token.second);
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-    ++curr_input;
   }
-
-  return Status::OK();
+  return true;
 }
 
 Status Tokenizer::Compute(OpKernelContext* ctx) const {
@@ -651,17 +392,90 @@ Status Tokenizer::Compute(OpKernelContext* ctx) const {
                   "Input dimensions are either [C] or [N][C] allowed");
   }
 
-  Status s;
-  if (char_tokenezation_) {
-    s = CharTokenize(ctx, N, C, input_dims);
-  } else {
-    if (regex_ != nullptr) {
-      s = ExpressionTokenize(ctx, N, C, input_dims);
-    } else {
-      s = SeparatorTokenize(ctx, N, C, input_dims);
+  // Tokens are collected as offsets into the input strings, the rows are independent
+  const int64_t rows = static_cast<int64_t>(N * C);
+  auto const input_data = X->template Data<std::string>();
+  std::vector<std::vector<Token>> tokens(N * C);
+  std::vector<char> invalid_utf8(N * C, 0);
+#ifdef USE_OPENMP
+#pragma omp parallel
+#endif
+  {
+    std::vector<int32_t> best_match;  // per thread scratch
+#ifdef USE_OPENMP
+#pragma omp for
+#endif
+    for (int64_t row = 0; row < rows; ++row) {
+      bool valid;
+      if (char_tokenezation_) {
+        valid = CharTokenize(input_data[row], tokens[row]);
+      } else if (regex_ != nullptr) {
+        valid = ExpressionTokenize(input_data[row], tokens[row]);
+      } else {
+        valid = SeparatorTokenize(input_data[row], tokens[row], best_match);
+      }
+      invalid_utf8[row] = !valid;
     }
   }
-  return s;
+
+  size_t max_tokens = 0;
+  for (int64_t row = 0; row < rows; ++row) {
+    if (invalid_utf8[row]) {
+      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                    "Input string contains invalid utf8 chars: " + input_data[row]);
+    }
+    size_t tokens_num = tokens[row].size();
+    if (mark_) {
+      tokens_num += 2;  // Start/end markers as separate tokens
+    }
+    max_tokens = std::max(max_tokens, tokens_num);
+  }
+
+  std::vector<int64_t> output_dims(input_dims);
+  // Check if we have no output due to either empty input
+  // everything is a separator
+  if ((max_tokens - mark_ * 2) == 0) {
+    output_dims.push_back(0);
+    TensorShape output_shape(output_dims);
+    ctx->Output(0, output_shape);
+    return Status::OK();
+  }
+
+  output_dims.push_back(max_tokens);
+  TensorShape output_shape(output_dims);
+
+  auto output_tensor = ctx->Output(0, output_shape);
+  auto const output_data = output_tensor->template MutableData<std::string>();
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int64_t row = 0; row < rows; ++row) {
+    std::string* output = output_data + row * max_tokens;
+    if (mark_) {
+      output->assign(&start_text, 1);
+      ++output;
+    }
+    // Output tokens for this row
+    const char* data = input_data[row].data();
+    for (const auto& token : tokens[row]) {
+      assert(token.second > 0);
+      assert(token.first + token.second <= input_data[row].length());
+      output->assign(data + token.first, token.second);
+      ++output;
+    }
+    if (mark_) {
+      output->assign(&end_text, 1);
+      ++output;
+    }
+    const size_t pads = max_tokens - (mark_ * 2) - tokens[row].size();
+    for (size_t p = 0; p < pads; ++p) {
+      *output = pad_value_;
+      ++output;
+    }
+    assert(output <= output_data + (row + 1) * max_tokens);
+  }
+  return Status::OK();
 }
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/framework/allocation_planner.h"
 #include <list>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 #include <sstream>
 #include "core/common/exceptions.h"
@@ -149,6 +150,9 @@ class PlannerImpl {
   // they became free (more recently freed earlier in the list).
   std::list<FreeBufferInfo> freelist_;
 
+  // ml-values planned as PackedStringTensor instead of a string Tensor
+  std::unordered_set<MLValueIndex> packed_string_values_;
+
   MLValueIndex Index(const MLValueName& name) {
     MLValueIndex result;
     auto status = mlvalue_name_idx_map_.GetIdx(name, result);
@@ -169,6 +173,12 @@ class PlannerImpl {
     return AllocPlan(Index(name));
   }
 
+  bool IsPackedStrings(MLValueIndex n) const { return packed_string_values_.count(n) != 0; }
+
+  MLDataType PlannedType(MLValueIndex n, const onnxruntime::NodeArg& arg) const {
+    return IsPackedStrings(n) ? DataTypeImpl::GetType<PackedStringTensor>() : utils::GetMLDataType(arg);
+  }
+
   // Initialize state for a given ml-value at its definition site:
   void ProcessDef(MLValueIndex id, const onnxruntime::NodeArg* p_def_site) {
     MLValueInfo& info = ml_value_info_.at(id);
@@ -208,7 +218,8 @@ class PlannerImpl {
         // we _must_ reuse this input to satisfy aliasing requirement: (e.g., for reshape)
         if ((0 <= pair.first) && (static_cast<size_t>(pair.first) < input_args.size())) {
           auto p_input_arg = input_args[pair.first];
-          if (p_input_arg->Exists()) {
+          // a packed input has no Tensor buffer to alias
+          if (p_input_arg->Exists() && !IsPackedStrings(Index(p_input_arg->Name()))) {
             *reusable_input = Index(p_input_arg->Name());
             return true;
           }
@@ -224,7 +235,7 @@ class PlannerImpl {
           if (p_input_arg->Exists()) {
             auto input_arg_index = Index(p_input_arg->Name());
             auto original = Buffer(input_arg_index);
-            if (1 == UseCount(original)) {
+            if (1 == UseCount(original) && !IsPackedStrings(original)) {
               if (SameSize(*p_input_arg, *p_output_arg)) {
                 // we can reuse this input since it is its last use and permitted for in-place update
                 *reusable_input = input_arg_index;  // or original; both should be okay
@@ -301,6 +312,7 @@ class PlannerImpl {
 
     for (auto it = freelist_.begin(); it != freelist_.end(); ++it) {
       auto reusable = it->ml_value;
+      if (IsPackedStrings(reusable)) continue;
       auto p_node_arg = ml_value_info_.at(reusable).p_def_site;
       auto& available_allocator_info = AllocPlan(p_node_arg->Name()).location;
       if (!(available_allocator_info == required_allocator_info)) continue;
@@ -459,6 +471,79 @@ class PlannerImpl {
     return Status::OK();
   }
 
+  // Plan the string tensors that are only read by kernel inputs declared with KernelDefBuilder::PackedStrings
+  // as PackedStringTensor, if they are graph inputs or written by such a kernel output.
+  // Graph outputs, initializers and values read by a subgraph keep the Tensor form.
+  Status ComputePackedStringValues() {
+    auto is_string_tensor = [](const onnxruntime::NodeArg& arg) {
+      const TypeProto* type = arg.TypeAsProto();
+      return type != nullptr && type->value_case() == TypeProto::ValueCase::kTensorType &&
+             type->tensor_type().elem_type() == TensorProto_DataType_STRING;
+    };
+
+    // candidate -> whether every reader so far supports the packed form
+    std::unordered_map<MLValueIndex, bool> candidates;
+    for (auto graph_input : graph_viewer_.GetInputs()) {
+      if (is_string_tensor(*graph_input)) {
+        candidates[Index(graph_input->Name())] = true;
+      }
+    }
+
+    auto& execution_plan = plan_.execution_plan;
+    std::vector<const KernelDef*> kernel_defs(execution_plan.size());
+    for (size_t i = 0; i < execution_plan.size(); ++i) {
+      auto pnode = graph_viewer_.GetNode(execution_plan[i].node_index);
+      const KernelCreateInfo* kernel_create_info = nullptr;
+      ORT_RETURN_IF_ERROR(kernel_registry_.SearchKernelRegistry(*pnode, &kernel_create_info));
+      kernel_defs[i] = kernel_create_info->kernel_def.get();
+      auto& outputs = pnode->OutputDefs();
+      for (auto pair : kernel_defs[i]->PackedStrings()) {
+        if (0 <= pair.second && static_cast<size_t>(pair.second) < outputs.size() &&
+            outputs[pair.second]->Exists() && is_string_tensor(*outputs[pair.second])) {
+          candidates[Index(outputs[pair.second]->Name())] = true;
+        }
+      }
+    }
+
+    if (candidates.empty()) return Status::OK();
+
+    auto reject = [&candidates](MLValueIndex index) {
+      auto entry = candidates.find(index);
+      if (entry != candidates.end()) entry->second = false;
+    };
+
+    for (size_t i = 0; i < execution_plan.size(); ++i) {
+      auto pnode = graph_viewer_.GetNode(execution_plan[i].node_index);
+      const auto& packed_strings = kernel_defs[i]->PackedStrings();
+      ORT_RETURN_IF_ERROR(onnxruntime::Node::ForEachWithIndex(
+          pnode->InputDefs(), [this, &packed_strings, &reject](const onnxruntime::NodeArg& def, size_t index) {
+            bool packed = std::any_of(packed_strings.begin(), packed_strings.end(),
+                                      [index](const std::pair<int, int>& pair) {
+                                        return pair.first == static_cast<int>(index);
+                                      });
+            if (!packed) reject(Index(def.Name()));
+            return Status::OK();
+          }));
+      for (auto node_input : pnode->ImplicitInputDefs()) {
+        if (node_input->Exists()) reject(Index(node_input->Name()));
+      }
+    }
+
+    for (auto graph_output : graph_viewer_.GetOutputs()) {
+      reject(Index(graph_output->Name()));
+    }
+
+    for (const auto& pair : graph_viewer_.GetAllInitializedTensors()) {
+      reject(Index(pair.first));
+    }
+
+    for (auto& candidate : candidates) {
+      if (candidate.second) packed_string_values_.insert(candidate.first);
+    }
+
+    return Status::OK();
+  }
+
   Status ComputeReusePlan() {
     std::vector<SequentialExecutionPlan::NodeExecutionPlan>& execution_plan{plan_.execution_plan};
 
@@ -468,7 +553,7 @@ class PlannerImpl {
       auto input_index = Index(node_arg->Name());
       AllocPlanPerValue& thisplan = AllocPlan(input_index);
       thisplan.alloc_kind = AllocKind::kPreExisting;
-      thisplan.value_type = utils::GetMLDataType(*node_arg);
+      thisplan.value_type = PlannedType(input_index, *node_arg);
     };
 
     // inputs of the graph:
@@ -495,12 +580,12 @@ class PlannerImpl {
       for (auto node_output : pnode->OutputDefs()) {
         if (!node_output->Exists()) continue;
         auto current = Index(node_output->Name());
-        AllocPlan(current).value_type = utils::GetMLDataType(*node_output);
+        AllocPlan(current).value_type = PlannedType(current, *node_output);
         MLValueIndex reused;
         if (std::find(graph_outputs.begin(), graph_outputs.end(), node_output) != graph_outputs.end()) {
           // node_output is graph's output, so we can't reuse intermedia buffer
           AllocPlan(current).alloc_kind = AllocKind::kAllocateOutput;
-        } else if (IsNonTensor(*node_output)) {
+        } else if (IsNonTensor(*node_output) || IsPackedStrings(current)) {
           // we do not try sharing-optimization for non-tensors
           AllocPlan(current).alloc_kind = AllocKind::kAllocate;
         } else if (FindReusableInput(*pnode, output_arg_num, &reused)) {
@@ -601,6 +686,9 @@ Status PlannerImpl::CreatePlan() {
   // compute use counts for all ml-values
   ORT_RETURN_IF_ERROR(ComputeUseCounts());
 
+  // pick the string values that are planned in the packed form
+  ORT_RETURN_IF_ERROR(ComputePackedStringValues());
+
   // determine sharing/reuse among ml-values
   ORT_RETURN_IF_ERROR(ComputeReusePlan());
 
@@ -460,6 +460,33 @@ ORT_REGISTER_SEQ(VectorDouble);
 ORT_REGISTER_SEQ(VectorMapStringToFloat);
 ORT_REGISTER_SEQ(VectorMapInt64ToFloat);
 
+// The columnar forms describe the same ONNX types as the two above and are deliberately left out of
+// RegisterAllProtos so that TypeFromProto keeps resolving seq(map(...)) to the std::vector form.
+ORT_REGISTER_SEQ(ColumnarMapStringToFloat);
+ORT_REGISTER_SEQ(ColumnarMapInt64ToFloat);
+
+/// PackedStringTensorType
+PackedStringTensorType::PackedStringTensorType() {
+  mutable_type_proto().mutable_tensor_type()->set_elem_type(TensorProto_DataType_STRING);
+}
+
+bool PackedStringTensorType::IsCompatible(const ONNX_NAMESPACE::TypeProto& type_proto) const {
+  return type_proto.value_case() == TypeProto::ValueCase::kTensorType &&
+         data_types_internal::IsCompatible(GetTypeProto()->tensor_type(), type_proto.tensor_type());
+}
+
+MLDataType PackedStringTensorType::Type() {
+  static PackedStringTensorType packed_string_tensor_type;
+  return &packed_string_tensor_type;
+}
+
+// Like the columnar forms, the packed form of a string tensor is left out of RegisterAllProtos
+// so that TypeFromProto keeps resolving tensor(string) to Tensor.
+template <>
+MLDataType DataTypeImpl::GetType<PackedStringTensor>() {
+  return PackedStringTensorType::Type();
+}
+
 // Used for Tensor Proto registrations
 #define REGISTER_TENSOR_PROTO(TYPE, reg_fn)                  \
   {                                                          \
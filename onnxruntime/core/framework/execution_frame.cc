@@ -3,6 +3,7 @@
 
 #include "core/framework/execution_frame.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "core/framework/mem_pattern_planner.h"
@@ -23,7 +24,7 @@ IExecutionFrame::IExecutionFrame(const std::vector<int>& feed_mlvalue_idxs,
                                  const std::vector<MLValue>& fetches,
                                  const MLValueNameIdxMap& mlvalue_idx_map,
                                  const NodeIndexInfo& node_index_info)
-    : node_index_info_{node_index_info}, fetch_mlvalue_idxs_{fetch_mlvalue_idxs} {
+    : node_index_info_{node_index_info}, feed_mlvalue_idxs_{feed_mlvalue_idxs}, fetch_mlvalue_idxs_{fetch_mlvalue_idxs} {
   ORT_ENFORCE(feeds.size() == feed_mlvalue_idxs.size());
   ORT_ENFORCE(fetches.empty() || fetches.size() == fetch_mlvalue_idxs.size());
 
@@ -32,6 +33,19 @@ IExecutionFrame::IExecutionFrame(const std::vector<int>& feed_mlvalue_idxs,
 
 IExecutionFrame::~IExecutionFrame() = default;
 
+void IExecutionFrame::Reset(const std::vector<MLValue>& feeds,
+                            const std::unordered_map<int, MLValue>& initializers,
+                            const std::vector<MLValue>& fetches,
+                            const MLValueNameIdxMap& mlvalue_idx_map) {
+  ORT_ENFORCE(feeds.size() == feed_mlvalue_idxs_.size());
+  ORT_ENFORCE(fetches.empty() || fetches.size() == fetch_mlvalue_idxs_.size());
+
+  // keep the vector, so only the values themselves are released
+  std::fill(all_values_.begin(), all_values_.end(), MLValue());
+
+  Init(feed_mlvalue_idxs_, feeds, initializers, fetch_mlvalue_idxs_, fetches, mlvalue_idx_map);
+}
+
 // Return nullptr if index map to an value that is an unused optional input/output
 const MLValue* IExecutionFrame::GetNodeInputOrOutputMLValue(int index) const {
   int mlvalue_idx = GetNodeIdxToMLValueIdx(index);
@@ -71,6 +85,11 @@ Status IExecutionFrame::GetOrCreateNodeOutputMLValue(int index, const TensorShap
   return status;
 }
 
+MLDataType IExecutionFrame::GetNodeInputOrOutputPlannedType(int index) const {
+  int mlvalue_idx = GetNodeIdxToMLValueIdx(index);
+  return mlvalue_idx != NodeIndexInfo::kInvalidEntry ? GetPlannedTypeImpl(mlvalue_idx) : nullptr;
+}
+
 AllocatorPtr IExecutionFrame::GetAllocator(const OrtAllocatorInfo& info) const {
   return GetAllocatorImpl(info);
 }
@@ -183,10 +202,21 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs,
     }
   }
 
+  InitializeMemoryPatterns(feeds);
+}
+
+ExecutionFrame::~ExecutionFrame() = default;
+
+void ExecutionFrame::InitializeMemoryPatterns(const std::vector<MLValue>& feeds) {
+  mem_patterns_ = nullptr;
+  planner_ = nullptr;
+  buffers_.clear();
+  feed_shapes_.clear();
+
   // If the session enable memory pattern optimization
   // and we have execution plan generated, try to setup
   // memory pattern optimization.
-  if (session_state.GetExecutionPlan()) {
+  if (session_state_.GetExecutionPlan()) {
     std::vector<TensorShape> input_shapes;
     bool all_tensors = true;
     for (const auto& feed : feeds) {
@@ -200,10 +230,10 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs,
 
     // if there are some traditional ml value type in inputs disable the memory pattern optimization.
     if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(input_shapes);
+      mem_patterns_ = session_state_.GetMemoryPatternGroup(input_shapes);
       // if no existing patterns, generate one in this executionframe
       if (!mem_patterns_) {
-        planner_ = std::make_unique<MLValuePatternPlanner>(*session_state.GetExecutionPlan());
+        planner_ = std::make_unique<MLValuePatternPlanner>(*session_state_.GetExecutionPlan());
       } else {
         // pre-allocate the big chunk requested in memory pattern.
         // all the internal kernel's input/output tensors will be allocated on these buffer.
@@ -215,12 +245,42 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs,
                              : nullptr;
           buffers_[mem_patterns_->locations[i]] = BufferUniquePtr(buffer, alloc);
         }
+
+        feed_shapes_ = std::move(input_shapes);
       }
     }
   }
 }
 
-ExecutionFrame::~ExecutionFrame() = default;
+bool ExecutionFrame::MemoryPatternMatches(const std::vector<MLValue>& feeds) const {
+  if (!mem_patterns_ || feeds.size() != feed_shapes_.size()) {
+    return false;
+  }
+
+  for (size_t i = 0, end = feeds.size(); i < end; ++i) {
+    if (!feeds[i].IsTensor() || feeds[i].Get<Tensor>().Shape() != feed_shapes_[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+Status ExecutionFrame::Reset(const std::vector<MLValue>& feeds, const std::vector<MLValue>& fetches) {
+  // release the values first as some of them may be in the memory pattern buffers
+  IExecutionFrame::Reset(feeds, session_state_.GetInitializedTensors(), fetches,
+                         session_state_.GetMLValueNameIdxMap());
+
+  custom_allocators_.clear();
+
+  // a planner traced the previous execution and its pattern is cached in the session state now,
+  // so look it up again in that case too.
+  if (!MemoryPatternMatches(feeds)) {
+    InitializeMemoryPatterns(feeds);
+  }
+
+  return Status::OK();
+}
 
 Status ExecutionFrame::AllocateMLValueTensorSelfOwnBuffer(MLValue& mlvalue,
                                                           int mlvalue_index,
@@ -409,6 +469,11 @@ AllocatorPtr ExecutionFrame::GetAllocatorImpl(const OrtAllocatorInfo& info) cons
   return utils::GetAllocator(session_state_, info);
 }
 
+MLDataType ExecutionFrame::GetPlannedTypeImpl(int mlvalue_idx) const {
+  const SequentialExecutionPlan* p_seq_exec_plan = session_state_.GetExecutionPlan();
+  return p_seq_exec_plan ? p_seq_exec_plan->allocation_plan.at(mlvalue_idx).value_type : nullptr;
+}
+
 // This method is not thread safe!
 // Return S_OK and nullptr if index map to an value that is an unused optional input/output
 Status ExecutionFrame::CreateNodeOutputMLValueImpl(MLValue& mlvalue, int mlvalue_idx, const TensorShape* shape) {
@@ -51,6 +51,10 @@ class IExecutionFrame {
   // Shape is required for tensors but not traditional ML values.
   Status GetOrCreateNodeOutputMLValue(int index, const TensorShape* shape, MLValue*& p_mlvalue);
 
+  // Return the type an input or output is planned to have, or nullptr if the frame has no allocation plan
+  // or the index maps to an unused optional input/output.
+  MLDataType GetNodeInputOrOutputPlannedType(int index) const;
+
   /**
    * write the output values to the 'fetches' vector
    * Don't access the values after SessionState is destroyed 
@@ -62,6 +66,13 @@ class IExecutionFrame {
   Status ReleaseMLValue(int mlvalue_idx);
 
  protected:
+  // release all values from the previous execution and set up the feeds, initializers and fetches for the next one.
+  // the feed and fetch indexes are the ones the frame was created with.
+  void Reset(const std::vector<MLValue>& feeds,
+             const std::unordered_map<int, MLValue>& initializers,
+             const std::vector<MLValue>& fetches,
+             const MLValueNameIdxMap& mlvalue_idx_map);
+
   // get the mlvalue_idx from NodeIndexInfo
   int GetNodeIdxToMLValueIdx(int index) const;
 
@@ -90,6 +101,7 @@ class IExecutionFrame {
   }
 
   virtual AllocatorPtr GetAllocatorImpl(const OrtAllocatorInfo& info) const = 0;
+  virtual MLDataType GetPlannedTypeImpl(int /*mlvalue_idx*/) const { return nullptr; }
   virtual Status CreateNodeOutputMLValueImpl(MLValue& mlvalue, int mlvalue_idx, const TensorShape* shape) = 0;
 
   const NodeIndexInfo& node_index_info_;
@@ -98,6 +110,7 @@ class IExecutionFrame {
   // Input and Output values are passed in by executors
   std::vector<MLValue> all_values_;
 
+  const std::vector<int> feed_mlvalue_idxs_;
   const std::vector<int> fetch_mlvalue_idxs_;
 };
 
@@ -132,6 +145,12 @@ class ExecutionFrame final : public IExecutionFrame {
 
   Status GeneratePatterns(MemoryPatternGroup* out) const;
 
+  // Prepare the frame for another execution of the graph with new feeds and fetches, so a caller executing the
+  // same graph repeatedly (e.g. the subgraph of a Scan or Loop) doesn't create a frame per execution.
+  // The buffers of the memory pattern are kept if the feeds have the same shapes as in the previous execution.
+  // Custom fetch allocators only apply to the execution the frame was created for.
+  Status Reset(const std::vector<MLValue>& feeds, const std::vector<MLValue>& fetches);
+
   bool HasMemoryPatternPlanner() const {
     return planner_ != nullptr;
   }
@@ -140,6 +159,7 @@ class ExecutionFrame final : public IExecutionFrame {
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ExecutionFrame);
 
   AllocatorPtr GetAllocatorImpl(const OrtAllocatorInfo& info) const override;
+  MLDataType GetPlannedTypeImpl(int mlvalue_idx) const override;
   Status ReleaseMLValueImpl(int mlvalue_idx) override;
   Status CreateNodeOutputMLValueImpl(MLValue& mlvalue, int mlvalue_idx, const TensorShape* shape) override;
 
@@ -165,6 +185,13 @@ class ExecutionFrame final : public IExecutionFrame {
 
   const AllocPlanPerValue& GetAllocationPlan(int mlvalue_idx);
 
+  // look up the memory pattern for the shapes of the feeds and allocate its buffers,
+  // or set up the planner to trace this execution if there is no pattern yet.
+  void InitializeMemoryPatterns(const std::vector<MLValue>& feeds);
+
+  // true if the memory pattern in use was created for feeds with these shapes
+  bool MemoryPatternMatches(const std::vector<MLValue>& feeds) const;
+
   const SessionState& session_state_;
 
   // map of index to custom allocator
@@ -181,5 +208,8 @@ class ExecutionFrame final : public IExecutionFrame {
 
   // Big chunks on different locations that will be used by mem_pattern.
   std::map<OrtAllocatorInfo, BufferUniquePtr> buffers_;
+
+  // shapes of the feeds mem_patterns_ was looked up with
+  std::vector<TensorShape> feed_shapes_;
 };
 }  // namespace onnxruntime
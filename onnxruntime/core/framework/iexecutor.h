@@ -43,7 +43,7 @@ class IExecutor {
                                  const std::vector<int>& fetch_mlvalue_idxs,
                                  std::vector<MLValue>& fetches,
                                  // optional custom allocators. key is index in fetches
-                                 const std::unordered_map<size_t, CustomAllocator> fetch_allocators,
+                                 const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
                                  const logging::Logger& logger) = 0;
 };
 }  // namespace onnxruntime
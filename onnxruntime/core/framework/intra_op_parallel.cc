@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/intra_op_parallel.h"
+
+#include <thread>
+
+#include "core/framework/op_kernel_context_internal.h"
+
+namespace onnxruntime {
+
+IntraOpThreadPool& GetIntraOpThreadPool(OpKernelContext& context, int& num_threads) {
+  auto* ctx_internal = static_cast<OpKernelContextInternal*>(&context);
+  num_threads = ctx_internal->GetIntraOpNumThreads();
+
+  auto* session_pool = ctx_internal->GetIntraOpThreadPool();
+  if (session_pool != nullptr)
+    return *session_pool;
+
+  static const int hardware_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+  // intentionally leaked so no worker thread is joined during static destruction at process or library unload.
+  // the calling thread always takes part in the work, so one thread less than the hardware offers is enough.
+#ifdef USE_EIGEN_THREADPOOL
+  static IntraOpThreadPool* shared_pool = new IntraOpThreadPool(std::max(1, hardware_threads - 1));
+#else
+  static IntraOpThreadPool* shared_pool =
+      new IntraOpThreadPool(static_cast<size_t>(std::max(1, hardware_threads - 1)));
+#endif
+
+  if (num_threads <= 0)
+    num_threads = hardware_threads;
+
+  return *shared_pool;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/platform/ort_mutex.h"
+
+#ifdef USE_EIGEN_THREADPOOL
+#include <unsupported/Eigen/CXX11/ThreadPool>
+#else
+#include "core/common/task_thread_pool.h"
+#endif
+
+namespace onnxruntime {
+class OpKernelContext;
+
+#ifdef USE_EIGEN_THREADPOOL
+using IntraOpThreadPool = Eigen::NonBlockingThreadPool;
+#else
+using IntraOpThreadPool = TaskThreadPool;
+#endif
+
+// Returns the pool a kernel runs its parallel work on during the current Compute call, and sets num_threads to how
+// many threads (including the calling one) the call may keep busy. That is the session's intra-op pool if it
+// configured one, otherwise a pool shared by all kernels in the process.
+IntraOpThreadPool& GetIntraOpThreadPool(OpKernelContext& context, int& num_threads);
+
+// Runs lambda(i) for i = 0, step, 2 * step, ... < max.
+// The calling thread processes chunks itself and the pool threads only help, claiming chunks from a shared counter.
+// A caller therefore never waits on a chunk nobody has started, so a pool can be shared between kernels and sessions,
+// and a lambda can call ExecuteLambdaInParallel on the same pool without risking a deadlock.
+template <typename TLambda>
+void ExecuteLambdaInParallel(const std::string& name, TLambda lambda, int max, int step,
+                             IntraOpThreadPool& ttp,
+                             const ::onnxruntime::logging::Logger& logger) {
+  // #define NOTHREADS to execute the lambdas directly and in order if you need to do that to debug
+
+#ifdef NOTHREADS
+  ORT_UNUSED_PARAMETER(ttp);
+  ORT_UNUSED_PARAMETER(logger);
+
+  for (int i = 0; i < max; i += step) {
+    (void)name;
+    std::bind(lambda, i)();
+  }
+#else
+  if (step < 1)
+    step = 1;
+
+  const int num_tasks = max / step + (max % step > 0 ? 1 : 0);
+  if (num_tasks <= 1) {
+    if (num_tasks == 1)
+      lambda(0);
+    return;
+  }
+
+  // shared with the helpers, as one may only get to run after all chunks were claimed and the caller returned.
+  // lambda itself is only touched for a claimed chunk, which the caller waits for.
+  struct SharedState {
+    std::atomic<int> next{0};
+    int pending;
+    std::exception_ptr error;
+    OrtMutex mutex;
+    OrtCondVar done;
+  };
+
+  auto state = std::make_shared<SharedState>();
+  state->pending = num_tasks;
+
+  auto run_chunks = [state, &lambda, num_tasks, step]() {
+    for (int task = state->next++; task < num_tasks; task = state->next++) {
+      std::exception_ptr error;
+      try {
+        lambda(task * step);
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      std::lock_guard<OrtMutex> lock(state->mutex);
+      if (error && !state->error)
+        state->error = error;
+      if (--state->pending == 0)
+        state->done.notify_all();
+    }
+  };
+
+  // every helper keeps claiming chunks until none are left, so there is no point in queuing more helpers than
+  // the pool has threads.
+  const int num_helpers = std::min(num_tasks - 1, ttp.NumThreads());
+  for (int i = 0; i < num_helpers; ++i) {
+#ifdef USE_EIGEN_THREADPOOL
+    ttp.Schedule(run_chunks);
+#else
+    ttp.RunTask(std::packaged_task<void()>{run_chunks});
+#endif
+  }
+
+  run_chunks();
+
+  std::unique_lock<OrtMutex> lock(state->mutex);
+  state->done.wait(lock, [&state]() { return state->pending == 0; });
+
+  if (state->error) {
+    try {
+      std::rethrow_exception(state->error);
+    } catch (const std::exception& ex) {
+      LOGS(logger, ERROR) << name << " - exception running tasks: " << ex.what();
+      throw;
+    }
+  }
+#endif  // else part of #ifdef NOTHREADS
+}
+
+}  // namespace onnxruntime
@@ -155,4 +155,14 @@ KernelDefBuilder& KernelDefBuilder::Alias(int input_index, int output_index) {
   return *this;
 }
 
+KernelDefBuilder& KernelDefBuilder::PackedStrings(const std::vector<std::pair<int, int>>& packed_strings) {
+  kernel_def_->packed_strings_map_ = packed_strings;
+  return *this;
+}
+
+KernelDefBuilder& KernelDefBuilder::PackedStrings(int input_index, int output_index) {
+  kernel_def_->packed_strings_map_.emplace_back(input_index, output_index);
+  return *this;
+}
+
 }  // namespace onnxruntime
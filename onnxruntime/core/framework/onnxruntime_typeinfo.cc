@@ -11,6 +11,7 @@
 using onnxruntime::BFloat16;
 using onnxruntime::DataTypeImpl;
 using onnxruntime::MLFloat16;
+using onnxruntime::PackedStringTensor;
 using onnxruntime::Tensor;
 using onnxruntime::TensorShape;
 
@@ -36,7 +37,8 @@ OrtStatus* OrtTypeInfo::FromDataTypeImpl(const onnxruntime::DataTypeImpl* input,
     *out = new OrtTypeInfo(ONNX_TYPE_UNKNOWN, nullptr);
     return nullptr;
   }
-  if (input == DataTypeImpl::GetType<Tensor>()) {
+  // a PackedStringTensor is a string tensor to the callers of the C API
+  if (input == DataTypeImpl::GetType<Tensor>() || input == DataTypeImpl::GetType<PackedStringTensor>()) {
     OrtTensorTypeAndShapeInfo* info = nullptr;
     if (tensor_data_type != nullptr) {
       OrtStatus* st = GetTensorShapeAndType(shape, tensor_data_type, &info);
@@ -49,7 +51,7 @@ OrtStatus* OrtTypeInfo::FromDataTypeImpl(const onnxruntime::DataTypeImpl* input,
     *out = new OrtTypeInfo(ONNX_TYPE_MAP, nullptr);
     return nullptr;
   }
-  if (input == DataTypeImpl::GetType<onnxruntime::VectorString>() || input == DataTypeImpl::GetType<onnxruntime::VectorFloat>() || input == DataTypeImpl::GetType<onnxruntime::VectorInt64>() || input == DataTypeImpl::GetType<onnxruntime::VectorDouble>() || input == DataTypeImpl::GetType<onnxruntime::VectorMapStringToFloat>() || input == DataTypeImpl::GetType<onnxruntime::VectorMapInt64ToFloat>()) {
+  if (input == DataTypeImpl::GetType<onnxruntime::VectorString>() || input == DataTypeImpl::GetType<onnxruntime::VectorFloat>() || input == DataTypeImpl::GetType<onnxruntime::VectorInt64>() || input == DataTypeImpl::GetType<onnxruntime::VectorDouble>() || input == DataTypeImpl::GetType<onnxruntime::VectorMapStringToFloat>() || input == DataTypeImpl::GetType<onnxruntime::VectorMapInt64ToFloat>() || input == DataTypeImpl::GetType<onnxruntime::ColumnarMapStringToFloat>() || input == DataTypeImpl::GetType<onnxruntime::ColumnarMapInt64ToFloat>()) {
     *out = new OrtTypeInfo(ONNX_TYPE_SEQUENCE, nullptr);
     return nullptr;
   }
@@ -37,6 +37,22 @@ Tensor* OpKernelContext::Output(int index, const TensorShape& shape) {
   return p_ml_value ? p_ml_value->GetMutable<Tensor>() : nullptr;
 }
 
+PackedStringTensor* OpKernelContext::OutputPackedStrings(int index) {
+  if (index < 0 || index >= OutputCount())
+    return nullptr;
+
+  auto output_arg_index = GetOutputArgIndex(index);
+  const MLValue* p_ml_value = execution_frame_->GetNodeInputOrOutputMLValue(output_arg_index);
+  if (p_ml_value == nullptr)
+    return nullptr;
+
+  // a value the caller provided for a graph output has the form it asked for
+  MLDataType packed_type = DataTypeImpl::GetType<PackedStringTensor>();
+  MLDataType type = p_ml_value->IsAllocated() ? p_ml_value->Type()
+                                              : execution_frame_->GetNodeInputOrOutputPlannedType(output_arg_index);
+  return type == packed_type ? Output<PackedStringTensor>(index) : nullptr;
+}
+
 int OpKernelContext::NumVariadicInputs(size_t arg_num) const {
   auto& arg_counts = kernel_->Node().InputArgCount();
 
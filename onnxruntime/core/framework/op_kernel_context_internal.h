@@ -53,6 +53,13 @@ class OpKernelContextInternal : public OpKernelContext {
 
   const bool& GetTerminateFlag() const noexcept { return terminate_flag_; }
 
+#ifdef USE_EIGEN_THREADPOOL
+  Eigen::NonBlockingThreadPool* GetIntraOpThreadPool() const { return session_state_.GetIntraOpThreadPool(); }
+#else
+  TaskThreadPool* GetIntraOpThreadPool() const { return session_state_.GetIntraOpThreadPool(); }
+#endif
+  int GetIntraOpNumThreads() const { return session_state_.GetIntraOpNumThreads(); }
+
  private:
   const SessionState& session_state_;
   const std::vector<NodeArg*>& implicit_inputs_;
@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/packed_string_tensor.h"
+
+#include <cstring>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+common::Status PackedStringTensor::Assign(const TensorShape& shape, const char* s, size_t s_len,
+                                          const size_t* offsets) {
+  const auto len = static_cast<size_t>(shape.Size());
+  std::vector<Element> elements(len);
+  for (size_t i = 0; i != len; ++i) {
+    const size_t end = i + 1 != len ? offsets[i + 1] : s_len;
+    if (offsets[i] > end || end > s_len) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "offsets are not increasing or out of bounds");
+    }
+    elements[i] = {offsets[i], end - offsets[i]};
+  }
+  Reset(shape, std::make_shared<const std::string>(s, s_len), std::move(elements));
+  return Status::OK();
+}
+
+void PackedStringTensor::Assign(const TensorShape& shape, const std::string* strings, const int64_t* indices) {
+  const auto len = static_cast<size_t>(shape.Size());
+  std::vector<Element> elements(len);
+  size_t total = 0;
+  for (size_t i = 0; i != len; ++i) {
+    const std::string& s = strings[indices ? indices[i] : i];
+    elements[i] = {total, s.size()};
+    total += s.size();
+  }
+  auto buffer = std::make_shared<std::string>();
+  buffer->reserve(total);
+  for (size_t i = 0; i != len; ++i) {
+    buffer->append(strings[indices ? indices[i] : i]);
+  }
+  Reset(shape, std::move(buffer), std::move(elements));
+}
+
+void PackedStringTensor::Reset(const TensorShape& shape, std::shared_ptr<const std::string> buffer,
+                               std::vector<Element> elements) {
+  ORT_ENFORCE(shape.Size() >= 0 && static_cast<size_t>(shape.Size()) == elements.size(),
+              "Shape ", shape, " doesn't match the number of elements ", elements.size());
+  shape_ = shape;
+  buffer_ = std::move(buffer);
+  elements_ = std::move(elements);
+}
+
+void PackedStringTensor::Select(const PackedStringTensor& source, const TensorShape& shape, const int64_t* indices) {
+  const auto len = static_cast<size_t>(shape.Size());
+  std::vector<Element> elements(len);
+  for (size_t i = 0; i != len; ++i) {
+    elements[i] = source.elements_[indices[i]];
+  }
+  Reset(shape, source.buffer_, std::move(elements));
+}
+
+size_t PackedStringTensor::DataLength() const {
+  size_t total = 0;
+  for (const auto& element : elements_) {
+    total += element.length;
+  }
+  return total;
+}
+
+void PackedStringTensor::CopyTo(char* s, size_t* offsets) const {
+  if (elements_.empty()) return;
+  size_t total = 0;
+  bool consecutive = true;
+  for (size_t i = 0, end = elements_.size(); i != end; ++i) {
+    offsets[i] = total;
+    total += elements_[i].length;
+    consecutive = consecutive && elements_[i].offset == elements_[0].offset + offsets[i];
+  }
+  if (consecutive) {
+    memcpy(s, buffer_->data() + elements_[0].offset, total);
+    return;
+  }
+  for (size_t i = 0, end = elements_.size(); i != end; ++i) {
+    memcpy(s + offsets[i], buffer_->data() + elements_[i].offset, elements_[i].length);
+  }
+}
+
+void PackedStringTensor::CopyTo(std::string* strings) const {
+  for (size_t i = 0, end = elements_.size(); i != end; ++i) {
+    strings[i].assign(ElementData(i), ElementLength(i));
+  }
+}
+
+}  // namespace onnxruntime
@@ -29,7 +29,7 @@ class ParallelExecutor : public IExecutor {
                          const std::vector<MLValue>& feeds,
                          const std::vector<int>& fetch_mlvalue_idxs,
                          std::vector<MLValue>& fetches,
-                         const std::unordered_map<size_t, CustomAllocator> fetch_allocators,
+                         const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
                          const logging::Logger& logger) override;
 
  private:
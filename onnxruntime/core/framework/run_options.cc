@@ -26,6 +26,14 @@ ORT_API(void, OrtRunOptionsSetCacheFeedsFetchesInfoEnabled, _In_ OrtRunOptions*
   options->cache_feeds_fetches_info = bool_value != 0;
 }
 
+ORT_API(void, OrtRunOptionsSetColumnarMapSequencesEnabled, _In_ OrtRunOptions* options, int bool_value) {
+  options->columnar_map_sequences = bool_value != 0;
+}
+
+ORT_API(void, OrtRunOptionsSetPackedStringTensorsEnabled, _In_ OrtRunOptions* options, int bool_value) {
+  options->packed_string_tensors = bool_value != 0;
+}
+
 ORT_API(unsigned int, OrtRunOptionsGetRunLogVerbosityLevel, _In_ OrtRunOptions* options) {
   return options->run_log_verbosity_level;
 }
@@ -38,6 +46,14 @@ ORT_API(int, OrtRunOptionsGetCacheFeedsFetchesInfoEnabled, _In_ OrtRunOptions* o
   return options->cache_feeds_fetches_info;
 }
 
+ORT_API(int, OrtRunOptionsGetColumnarMapSequencesEnabled, _In_ OrtRunOptions* options) {
+  return options->columnar_map_sequences;
+}
+
+ORT_API(int, OrtRunOptionsGetPackedStringTensorsEnabled, _In_ OrtRunOptions* options) {
+  return options->packed_string_tensors;
+}
+
 ORT_API(void, OrtRunOptionsSetTerminate, _In_ OrtRunOptions* options, bool value) {
   options->terminate = value;
 }
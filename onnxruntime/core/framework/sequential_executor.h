@@ -14,6 +14,8 @@
 #include "core/graph/graph_viewer.h"
 
 namespace onnxruntime {
+class ExecutionFrame;
+
 class SequentialExecutor : public IExecutor {
  public:
   SequentialExecutor(const bool& terminate_flag = false) : terminate_flag_{terminate_flag} {}
@@ -23,9 +25,17 @@ class SequentialExecutor : public IExecutor {
                          const std::vector<MLValue>& feeds,
                          const std::vector<int>& fetch_mlvalue_idxs,
                          std::vector<MLValue>& fetches,
-                         const std::unordered_map<size_t, CustomAllocator> fetch_allocators,
+                         const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
                          const logging::Logger& logger) override;
 
+  // Execute with a frame the caller set up with 'feeds' and 'fetches', and may reuse for later executions
+  // after ExecutionFrame::Reset.
+  common::Status ExecuteWithFrame(const SessionState& session_state,
+                                  ExecutionFrame& frame,
+                                  const std::vector<MLValue>& feeds,
+                                  std::vector<MLValue>& fetches,
+                                  const logging::Logger& logger);
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SequentialExecutor);
   const bool& terminate_flag_;
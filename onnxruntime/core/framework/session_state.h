@@ -176,6 +176,21 @@ class SessionState {
   void SetThreadPool(TaskThreadPool* p_pool) { thread_pool_ = p_pool; }
 #endif
 
+  /// Pool for kernels that split the work of a single node across threads, and how many threads (including the
+  /// caller) such a kernel may use. A nullptr pool with num_threads of 0 means the session left the choice to the
+  /// kernel; a nullptr pool with num_threads of 1 means the kernel should run on the calling thread only.
+#ifdef USE_EIGEN_THREADPOOL
+  Eigen::NonBlockingThreadPool* GetIntraOpThreadPool() const { return intra_op_thread_pool_; }
+  void SetIntraOpThreadPool(Eigen::NonBlockingThreadPool* p_pool, int num_threads) {
+#else
+  TaskThreadPool* GetIntraOpThreadPool() const { return intra_op_thread_pool_; }
+  void SetIntraOpThreadPool(TaskThreadPool* p_pool, int num_threads) {
+#endif
+    intra_op_thread_pool_ = p_pool;
+    intra_op_num_threads_ = num_threads;
+  }
+  int GetIntraOpNumThreads() const { return intra_op_num_threads_; }
+
   bool ExportDll() const { return export_fused_dll_; }
   void SetExportDllFlag(bool flag) { export_fused_dll_ = flag; }
 
@@ -236,6 +251,13 @@ class SessionState {
   TaskThreadPool* thread_pool_ = nullptr;
 #endif
 
+#ifdef USE_EIGEN_THREADPOOL
+  Eigen::NonBlockingThreadPool* intra_op_thread_pool_ = nullptr;
+#else
+  TaskThreadPool* intra_op_thread_pool_ = nullptr;
+#endif
+  int intra_op_num_threads_ = 0;
+
   bool export_fused_dll_ = false;
   FuncManager fused_funcs_mgr_;
 
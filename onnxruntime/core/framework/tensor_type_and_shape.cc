@@ -13,6 +13,7 @@
 using onnxruntime::BFloat16;
 using onnxruntime::DataTypeImpl;
 using onnxruntime::MLFloat16;
+using onnxruntime::PackedStringTensor;
 using onnxruntime::Tensor;
 
 struct OrtTensorTypeAndShapeInfo {
@@ -137,6 +138,10 @@ ORT_API_STATUS_IMPL(OrtGetTensorShapeAndType, _In_ const OrtValue* value,
                     _Out_ OrtTensorTypeAndShapeInfo** out) {
   API_IMPL_BEGIN
   auto v = reinterpret_cast<const ::onnxruntime::MLValue*>(value);
+  if (v->Type() == DataTypeImpl::GetType<PackedStringTensor>()) {
+    const auto& packed = v->Get<PackedStringTensor>();
+    return GetTensorShapeAndType(&packed.Shape(), DataTypeImpl::GetType<std::string>(), out);
+  }
   const onnxruntime::Tensor& tensor = v->Get<onnxruntime::Tensor>();
   return GetTensorShapeAndType(&tensor.Shape(), tensor.DataType(), out);
   API_IMPL_END
@@ -177,5 +182,9 @@ ORT_API_STATUS_IMPL(OrtGetTypeInfo, _In_ const OrtValue* value, struct OrtTypeIn
     const onnxruntime::TensorShape& shape = tensor.Shape();
     return OrtTypeInfo::FromDataTypeImpl(type, &shape, tensor.DataType(), out);
   }
+  if (type == DataTypeImpl::GetType<PackedStringTensor>()) {
+    const auto& packed = v->Get<PackedStringTensor>();
+    return OrtTypeInfo::FromDataTypeImpl(type, &packed.Shape(), DataTypeImpl::GetType<std::string>(), out);
+  }
   return OrtTypeInfo::FromDataTypeImpl(type, nullptr, nullptr, out);
 }
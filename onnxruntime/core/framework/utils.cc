@@ -528,6 +528,34 @@ common::Status ExecuteGraphWithCachedInfo(const SessionState& session_state,
   return Status::OK();
 }
 
+common::Status ExecuteSubgraphWithCachedInfo(const SessionState& session_state,
+                                             const FeedsFetchesManager& feeds_fetches_manager,
+                                             const std::vector<MLValue>& feeds,
+                                             std::vector<MLValue>& fetches,
+                                             std::unique_ptr<ExecutionFrame>& frame,
+                                             const bool& terminate_flag,
+                                             const logging::Logger& logger) {
+  if (feeds_fetches_manager.GetDeviceCopyChecks().status != DeviceCopyCheck::NoCopy) {
+    frame = nullptr;
+    return ExecuteGraphWithCachedInfo(session_state, feeds_fetches_manager, feeds, fetches, {},
+                                      /*sequential_execution*/ true, terminate_flag, logger);
+  }
+
+  const auto& feeds_fetches_info = feeds_fetches_manager.GetFeedsFetchesInfo();
+
+  if (frame) {
+    ORT_RETURN_IF_ERROR(frame->Reset(feeds, fetches));
+  } else {
+    frame = std::make_unique<ExecutionFrame>(feeds_fetches_info.feeds_mlvalue_idxs, feeds,
+                                             feeds_fetches_info.fetches_mlvalue_idxs, fetches,
+                                             std::unordered_map<size_t, IExecutor::CustomAllocator>{},
+                                             session_state);
+  }
+
+  SequentialExecutor executor(terminate_flag);
+  return executor.ExecuteWithFrame(session_state, *frame, feeds, fetches, logger);
+}
+
 // execute graph and update feeds_fetches_manager with cached copy info if cache_copy_info is true
 common::Status ExecuteGraph(const SessionState& session_state,
                             FeedsFetchesManager& feeds_fetches_manager,
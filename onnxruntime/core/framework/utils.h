@@ -11,6 +11,7 @@
 #include "core/framework/session_state.h"
 
 namespace onnxruntime {
+class ExecutionFrame;
 class ExecutionProviders;
 class FeedsFetchesManager;
 class Graph;
@@ -65,6 +66,18 @@ common::Status ExecuteGraphWithCachedInfo(const SessionState& session_state,
                                           const bool& terminate_flag,
                                           const logging::Logger& logger);
 
+// ExecuteGraphWithCachedInfo for a subgraph that a control flow operator executes repeatedly.
+// 'frame' holds the ExecutionFrame between calls: the first call creates it, and later calls reset it with the new
+// feeds and fetches, so there is no frame or memory pattern buffer to set up per iteration.
+// Uses the sequential executor. Falls back to ExecuteGraphWithCachedInfo if device copies are needed.
+common::Status ExecuteSubgraphWithCachedInfo(const SessionState& session_state,
+                                             const FeedsFetchesManager& feeds_fetches_manager,
+                                             const std::vector<MLValue>& feeds,
+                                             std::vector<MLValue>& fetches,
+                                             std::unique_ptr<ExecutionFrame>& frame,
+                                             const bool& terminate_flag,
+                                             const logging::Logger& logger);
+
 #define DispatchOnTensorType(tensor_type, function, ...)      \
   if (tensor_type == DataTypeImpl::GetType<float>())          \
     function<float>(__VA_ARGS__);                             \
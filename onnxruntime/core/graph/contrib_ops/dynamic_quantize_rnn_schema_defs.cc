@@ -0,0 +1,236 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "dynamic_quantize_rnn_schema_defs.h"
+
+#include "core/graph/constants.h"
+#include "core/graph/op.h"
+
+namespace ONNX_NAMESPACE {
+void RNNShapeInference(InferenceContext& ctx);
+}
+
+namespace onnxruntime {
+namespace contrib {
+
+using ::ONNX_NAMESPACE::AttributeProto;
+using ::ONNX_NAMESPACE::OPTIONAL;
+using ::ONNX_NAMESPACE::OpSchema;
+
+static const char* DynamicQuantizeLSTM_ver1_doc = R"DOC(
+Computes an one-layer LSTM exactly as the ONNX LSTM operator does, with the matrix multiplications by W and R
+run on 8-bit integers.
+
+W and R must be initializers. They are quantized once when the kernel is created, symmetrically with one scale
+per output column of each gate. X and the hidden state are quantized asymmetrically to uint8 for each
+multiplication, with the scale and zero point taken from their range at that time. The int32 results are scaled
+back to float before the bias, the peepholes and the activations are applied in float.
+
+The outputs differ from LSTM by the quantization error, so this operator is meant for models which were
+validated with it.
+)DOC";
+
+static const char* DynamicQuantizeGRU_ver1_doc = R"DOC(
+Computes an one-layer GRU exactly as the ONNX GRU operator does, with the matrix multiplications by W and R
+run on 8-bit integers.
+
+W and R must be initializers. They are quantized once when the kernel is created, symmetrically with one scale
+per output column of each gate. X and the hidden state are quantized asymmetrically to uint8 for each
+multiplication, with the scale and zero point taken from their range at that time. The int32 results are scaled
+back to float before the bias and the activations are applied in float.
+
+The outputs differ from GRU by the quantization error, so this operator is meant for models which were
+validated with it.
+)DOC";
+
+// the attributes, inputs and outputs shared with the ONNX RNN operators
+static OpSchema& RNNDocGenerator(OpSchema& op_schema, const char* activations_doc) {
+  return op_schema
+      .SetDomain(kMSDomain)
+      .Attr(
+          "direction",
+          "Specify if the RNN is forward, reverse, or bidirectional. Must be one of "
+          "forward (default), reverse, or bidirectional.",
+          AttributeProto::STRING,
+          std::string("forward"))
+      .Attr(
+          "hidden_size",
+          "Number of neurons in the hidden layer",
+          AttributeProto::INT,
+          OPTIONAL)
+      .Attr(
+          "activations",
+          activations_doc,
+          AttributeProto::STRINGS,
+          OPTIONAL)
+      .Attr(
+          "activation_alpha",
+          "Optional scaling values used by some activation functions. The values are consumed "
+          "in the order of activation functions, for example (f, g, h) in LSTM. Default values "
+          "are the same as of corresponding ONNX operators.For example with LeakyRelu, the "
+          "default alpha is 0.01.",
+          AttributeProto::FLOATS,
+          OPTIONAL)
+      .Attr(
+          "activation_beta",
+          "Optional scaling values used by some activation functions. The values are consumed in "
+          "the order of activation functions, for example (f, g, h) in LSTM. Default values are "
+          "the same as of corresponding ONNX operators.",
+          AttributeProto::FLOATS,
+          OPTIONAL)
+      .Attr(
+          "clip",
+          "Cell clip threshold. Clipping bounds the elements of a tensor in the range of "
+          "[-threshold, +threshold] and is applied to the input of activations. No clip if not "
+          "specified.",
+          AttributeProto::FLOAT,
+          OPTIONAL)
+      .Input(
+          0,
+          "X",
+          "The input sequences packed (and potentially padded) into one 3-D tensor "
+          "with the shape of `[seq_length, batch_size, input_size]`.",
+          "T")
+      .Input(
+          4,
+          "sequence_lens",
+          "Optional tensor specifying lengths of the sequences in a batch. If not "
+          "specified - assumed all sequences in the batch to have length `seq_length`. "
+          "It has shape `[batch_size]`.",
+          "T1",
+          OpSchema::Optional)
+      .Input(
+          5,
+          "initial_h",
+          "Optional initial value of the hidden. If not specified - assumed to be 0. "
+          "It has shape `[num_directions, batch_size, hidden_size]`.",
+          "T",
+          OpSchema::Optional)
+      .Output(
+          0,
+          "Y",
+          "A tensor that concats all the intermediate output values of the hidden. "
+          "It has shape `[seq_length, num_directions, batch_size, hidden_size]`. ",
+          "T",
+          OpSchema::Optional)
+      .Output(
+          1,
+          "Y_h",
+          "The last output value of the hidden. It has shape "
+          "`[num_directions, batch_size, hidden_size]`.",
+          "T",
+          OpSchema::Optional)
+      .TypeConstraint(
+          "T",
+          {"tensor(float)"},
+          "Constrain input and output types to float tensors.")
+      .TypeConstraint(
+          "T1",
+          {"tensor(int32)"},
+          "Constrain seq_lens to integer tensor.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::RNNShapeInference);
+}
+
+OpSchema& RegisterDynamicQuantizeLSTMOpSchema(OpSchema&& op_schema) {
+  RNNDocGenerator(op_schema,
+                  "A list of 3 (or 6 if bidirectional) activation functions "
+                  "for input, output, forget, cell, and hidden. The activation functions must "
+                  "be one of the activation functions specified in the ONNX LSTM operator. "
+                  "Optional: See the equations for default if not specified.");
+  return op_schema
+      .Attr(
+          "input_forget",
+          "Couple the input and forget gates if 1.",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
+      .Input(
+          1,
+          "W",
+          "The weight tensor for the gates. Concatenation of `W[iofc]` and "
+          "`WB[iofc]` (if bidirectional) along dimension 0. The tensor has shape "
+          "`[num_directions, 4*hidden_size, input_size]`. Must be an initializer.",
+          "T")
+      .Input(
+          2,
+          "R",
+          "The recurrence weight tensor. Concatenation of `R[iofc]` and "
+          "`RB[iofc]` (if bidirectional) along dimension 0. This tensor has shape "
+          "`[num_directions, 4*hidden_size, hidden_size]`. Must be an initializer.",
+          "T")
+      .Input(
+          3,
+          "B",
+          "The bias tensor for input gate. Concatenation of `[Wb[iofc], Rb[iofc]]`, "
+          "and `[WBb[iofc], RBb[iofc]]` (if bidirectional) along dimension 0. This "
+          "tensor has shape `[num_directions, 8*hidden_size]`. Optional: If not "
+          "specified - assumed to be 0.",
+          "T",
+          OpSchema::Optional)
+      .Input(
+          6,
+          "initial_c",
+          "Optional initial value of the cell. If not specified - assumed "
+          "to be 0. It has shape `[num_directions, batch_size, hidden_size]`.",
+          "T",
+          OpSchema::Optional)
+      .Input(
+          7,
+          "P",
+          "The weight tensor for peepholes. Concatenation of `P[iof]` and "
+          "`PB[iof]` (if bidirectional) along dimension 0. It has shape "
+          "`[num_directions, 3*hidde_size]`. Optional: If not specified - "
+          "assumed to be 0.",
+          "T",
+          OpSchema::Optional)
+      .Output(
+          2,
+          "Y_c",
+          "The last output value of the cell. It has shape "
+          "`[num_directions, batch_size, hidden_size]`.",
+          "T",
+          OpSchema::Optional)
+      .SetDoc(DynamicQuantizeLSTM_ver1_doc);
+}
+
+OpSchema& RegisterDynamicQuantizeGRUOpSchema(OpSchema&& op_schema) {
+  RNNDocGenerator(op_schema,
+                  "A list of 2 (or 4 if bidirectional) activation functions "
+                  "for update, reset, and hidden gates. The activation functions must be one "
+                  "of the activation functions specified in the ONNX GRU operator. "
+                  "Optional: See the equations for default if not specified.");
+  return op_schema
+      .Attr(
+          "linear_before_reset",
+          "When computing the output of the hidden gate, "
+          "apply the linear transformation before multiplying by the output of the "
+          "reset gate.",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
+      .Input(
+          1,
+          "W",
+          "The weight tensor for the gates. Concatenation of `W[zrh]` and `WB[zrh]` "
+          "(if bidirectional) along dimension 0. This tensor has shape "
+          "`[num_directions, 3*hidden_size, input_size]`. Must be an initializer.",
+          "T")
+      .Input(
+          2,
+          "R",
+          "The recurrence weight tensor. Concatenation of `R[zrh]` and `RB[zrh]` "
+          "(if bidirectional) along dimension 0. This tensor has shape "
+          "`[num_directions, 3*hidden_size, hidden_size]`. Must be an initializer.",
+          "T")
+      .Input(
+          3,
+          "B",
+          "The bias tensor for the gates. Concatenation of `[Wb[zrh], Rb[zrh]]` and "
+          "`[WBb[zrh], RBb[zrh]]` (if bidirectional) along dimension 0. This tensor "
+          "has shape `[num_directions, 6*hidden_size]`. Optional: If not specified "
+          "- assumed to be 0",
+          "T",
+          OpSchema::Optional)
+      .SetDoc(DynamicQuantizeGRU_ver1_doc);
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
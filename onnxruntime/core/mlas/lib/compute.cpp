@@ -0,0 +1,624 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute.cpp
+
+Abstract:
+
+    This module implements routines to compute the exponential, logarithm and
+    error functions and the softmax of the rows of a matrix.
+
+    The implementation below targets the base instruction set (typically SSE2
+    or NEON). The kernels in compute.h are also built for newer instruction
+    sets (such as AVX2/FMA3 and AVX512F) and are selected at runtime through
+    the platform dispatch table.
+
+--*/
+
+#include "mlasi.h"
+#include "compute.h"
+
+#include <cmath>
+
+//
+// Define the number of elements to process per thread before using another
+// thread to perform additional work.
+//
+
+#define MLAS_SOFTMAX_THREAD_ELEMENTS                (16 * 1024)
+
+//
+// Bundles the floating point constants for use by the kernels.
+//
+
+const MLAS_COMPUTE_CONSTANTS MlasComputeConstants = {
+    -104.0f,
+    88.7762626647950f,
+    1.44269504088896341f,
+    12582912.0f,
+    -0.693359375f,
+    2.12194440e-4f,
+    1.9875691500E-4f,
+    1.3981999507E-3f,
+    8.3334519073E-3f,
+    4.1665795894E-2f,
+    1.6666665459E-1f,
+    5.0000001201E-1f,
+    127,
+    1.17549435e-38f,
+    8388608.0f,
+    0x007fffff,
+    0x3f000000,
+    0.707106781186547524f,
+    7.0376836292E-2f,
+    -1.1514610310E-1f,
+    1.1676998740E-1f,
+    -1.2420140846E-1f,
+    1.4249322787E-1f,
+    -1.6668057665E-1f,
+    2.0000714765E-1f,
+    -2.4999993993E-1f,
+    3.3333331174E-1f,
+    0.921875f,
+    3.925f,
+    -5.990852951072156e-4f,
+    4.993180278688669e-3f,
+    -2.6766616851091385e-2f,
+    0.1128181591629982f,
+    -0.37612494826316833f,
+    1.1283791065216064f,
+    -1.4297280358732678e-05f,
+    3.3459995756857097e-04f,
+    -3.559321630746126e-03f,
+    2.309717796742916e-02f,
+    -0.10439120978116989f,
+    -0.6376895904541016f,
+    -1.1269112825393677f,
+    -4.7126380377449095e-04f,
+    int32_t(0x80000000),
+    std::numeric_limits<float>::infinity(),
+    -std::numeric_limits<float>::infinity(),
+    std::numeric_limits<float>::quiet_NaN(),
+};
+
+//
+// Define the vector operations for the base instruction set.
+//
+
+struct MLAS_COMPUTE_OPS_FLOAT32X4 {
+
+    typedef MLAS_FLOAT32X4 FloatType;
+    typedef MLAS_INT32X4 IntType;
+    typedef MLAS_FLOAT32X4 MaskType;
+
+    static constexpr size_t Width = 4;
+
+    static FloatType Load(const float* Buffer) { return MlasLoadFloat32x4(Buffer); }
+    static void Store(float* Buffer, FloatType Vector) { MlasStoreFloat32x4(Buffer, Vector); }
+    static FloatType Broadcast(float Value) { return MlasBroadcastFloat32x4(Value); }
+    static FloatType Add(FloatType v1, FloatType v2) { return MlasAddFloat32x4(v1, v2); }
+    static FloatType Subtract(FloatType v1, FloatType v2) { return MlasSubtractFloat32x4(v1, v2); }
+    static FloatType Multiply(FloatType v1, FloatType v2) { return MlasMultiplyFloat32x4(v1, v2); }
+    static FloatType MultiplyAdd(FloatType v1, FloatType v2, FloatType v3) { return MlasMultiplyAddFloat32x4(v1, v2, v3); }
+    static FloatType Maximum(FloatType v1, FloatType v2) { return MlasMaximumFloat32x4(v1, v2); }
+    static FloatType Minimum(FloatType v1, FloatType v2) { return MlasMinimumFloat32x4(v1, v2); }
+    static MaskType CompareLessThan(FloatType v1, FloatType v2) { return MlasCompareLessThanFloat32x4(v1, v2); }
+    static MaskType CompareEqual(FloatType v1, FloatType v2) { return MlasCompareEqualFloat32x4(v1, v2); }
+    static MaskType CompareGreaterThanOrEqual(FloatType v1, FloatType v2) { return MlasCompareGreaterThanOrEqualFloat32x4(v1, v2); }
+    static FloatType Select(MaskType Mask, FloatType v1, FloatType v2) { return MlasSelectFloat32x4(Mask, v1, v2); }
+    static float ReduceAdd(FloatType Vector) { return MlasReduceAddFloat32x4(Vector); }
+    static float ReduceMaximum(FloatType Vector) { return MlasReduceMaximumFloat32x4(Vector); }
+
+    static IntType BroadcastInt(int32_t Value) { return MlasBroadcastInt32x4(Value); }
+    static IntType AddInt(IntType v1, IntType v2) { return MlasAddInt32x4(v1, v2); }
+    static IntType SubtractInt(IntType v1, IntType v2) { return MlasSubtractInt32x4(v1, v2); }
+    static IntType AndInt(IntType v1, IntType v2) { return MlasAndInt32x4(v1, v2); }
+    static IntType OrInt(IntType v1, IntType v2) { return MlasOrInt32x4(v1, v2); }
+    template<unsigned ShiftCount> static IntType ShiftLeftInt(IntType Vector) { return MlasShiftLeftInt32x4<ShiftCount>(Vector); }
+    template<unsigned ShiftCount> static IntType ShiftRightInt(IntType Vector) { return MlasShiftRightInt32x4<ShiftCount>(Vector); }
+    static IntType ReinterpretAsInt(FloatType Vector) { return MlasReinterpretAsInt32x4(Vector); }
+    static FloatType ReinterpretAsFloat(IntType Vector) { return MlasReinterpretAsFloat32x4(Vector); }
+    static FloatType CastToFloat(IntType Vector) { return MlasCastToFloat32x4(Vector); }
+};
+
+void
+MLASCALL
+MlasExpKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasComputeUnaryKernel<MLAS_COMPUTE_OPS_FLOAT32X4,
+        MlasComputeExpVector<MLAS_COMPUTE_OPS_FLOAT32X4>>(Input, Output, N);
+}
+
+void
+MLASCALL
+MlasLogKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the natural logarithm.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasComputeUnaryKernel<MLAS_COMPUTE_OPS_FLOAT32X4,
+        MlasComputeLogVector<MLAS_COMPUTE_OPS_FLOAT32X4>>(Input, Output, N);
+}
+
+void
+MLASCALL
+MlasErfKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the error function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasComputeUnaryKernel<MLAS_COMPUTE_OPS_FLOAT32X4,
+        MlasComputeErfVector<MLAS_COMPUTE_OPS_FLOAT32X4>>(Input, Output, N);
+}
+
+float
+MLASCALL
+MlasComputeSumExpKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for computing the sum of the
+    exponentials of a row for the softmax routine.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Optionally supplies the output buffer to receive the
+        exponentials.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the value added to each element before
+        computing the exponential.
+
+Return Value:
+
+    Returns the sum of the exponentials.
+
+--*/
+{
+    return MlasComputeSumExpRow<MLAS_COMPUTE_OPS_FLOAT32X4>(Input, Output, N, NegativeMaximum);
+}
+
+float
+MLASCALL
+MlasReduceMaximumKernel(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for finding the maximum value
+    of a row for the softmax routine.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the maximum value.
+
+--*/
+{
+    return MlasReduceMaximumRow<MLAS_COMPUTE_OPS_FLOAT32X4>(Input, N);
+}
+
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ExpKernelRoutine(Input, Output, N);
+#else
+    MlasExpKernel(Input, Output, N);
+#endif
+}
+
+void
+MLASCALL
+MlasComputeLog(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the natural logarithm.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.LogKernelRoutine(Input, Output, N);
+#else
+    MlasLogKernel(Input, Output, N);
+#endif
+}
+
+void
+MLASCALL
+MlasComputeErf(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the error function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ErfKernelRoutine(Input, Output, N);
+#else
+    MlasErfKernel(Input, Output, N);
+#endif
+}
+
+//
+// Define the parameters to execute segments of a softmax operation on worker
+// threads.
+//
+
+struct MLAS_SOFTMAX_WORK_BLOCK {
+    const float* Input;
+    float* Output;
+    size_t N;
+    size_t D;
+    size_t RowsPerThread;
+    bool LogSoftmax;
+};
+
+void
+MlasComputeSoftmaxRows(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax of a range of rows on the
+    current thread.
+
+Arguments:
+
+    Input - Supplies the input matrix.
+
+    Output - Supplies the output matrix.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns of each row.
+
+    LogSoftmax - Supplies true to compute the log softmax, else false to
+        compute the softmax.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N > 0) {
+
+#if defined(MLAS_TARGET_AMD64)
+        float Maximum = MlasPlatform.ReduceMaximumKernelRoutine(Input, D);
+#else
+        float Maximum = MlasReduceMaximumKernel(Input, D);
+#endif
+
+        float NegativeMaximum = -Maximum;
+
+        //
+        // For softmax, the exponentials are written to the output and then
+        // scaled in place. For log softmax, only the sum is needed and the
+        // output is computed directly from the input.
+        //
+
+#if defined(MLAS_TARGET_AMD64)
+        float Accumulation = MlasPlatform.ComputeSumExpKernelRoutine(Input,
+            LogSoftmax ? nullptr : Output, D, NegativeMaximum);
+#else
+        float Accumulation = MlasComputeSumExpKernel(Input,
+            LogSoftmax ? nullptr : Output, D, NegativeMaximum);
+#endif
+
+        size_t d = D;
+
+        if (LogSoftmax) {
+
+            float Bias = NegativeMaximum - std::log(Accumulation);
+
+            MLAS_FLOAT32X4 BiasVector = MlasBroadcastFloat32x4(Bias);
+
+            const float* s = Input;
+            float* o = Output;
+
+            while (d >= 4) {
+                MlasStoreFloat32x4(o, MlasAddFloat32x4(MlasLoadFloat32x4(s), BiasVector));
+                s += 4;
+                o += 4;
+                d -= 4;
+            }
+
+            while (d > 0) {
+                *o++ = *s++ + Bias;
+                d -= 1;
+            }
+
+        } else {
+
+            float Scale = 1.0f / Accumulation;
+
+            MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+            float* o = Output;
+
+            while (d >= 4) {
+                MlasStoreFloat32x4(o, MlasMultiplyFloat32x4(MlasLoadFloat32x4(o), ScaleVector));
+                o += 4;
+                d -= 4;
+            }
+
+            while (d > 0) {
+                *o++ *= Scale;
+                d -= 1;
+            }
+        }
+
+        Input += D;
+        Output += D;
+        N -= 1;
+    }
+}
+
+void
+MlasComputeSoftmaxThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    softmax operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_SOFTMAX_WORK_BLOCK* WorkBlock = (MLAS_SOFTMAX_WORK_BLOCK*)Context;
+
+    const size_t N = WorkBlock->N;
+    const size_t n = WorkBlock->RowsPerThread * Index;
+
+    if (n < N) {
+
+        const size_t D = WorkBlock->D;
+        const size_t CountN = (std::min)(N - n, WorkBlock->RowsPerThread);
+
+        MlasComputeSoftmaxRows(WorkBlock->Input + n * D, WorkBlock->Output + n * D,
+            CountN, D, WorkBlock->LogSoftmax);
+    }
+}
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax of each row of the input
+    matrix. Each row is normalized by its maximum value before computing the
+    exponentials, so the results do not overflow.
+
+Arguments:
+
+    Input - Supplies the input matrix.
+
+    Output - Supplies the output matrix.
+
+    N - Supplies the number of rows of the matrix.
+
+    D - Supplies the number of columns of the matrix.
+
+    LogSoftmax - Supplies true to compute the log softmax, else false to
+        compute the softmax.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (N == 0 || D == 0) {
+        return;
+    }
+
+    const size_t Elements = N * D;
+
+    int32_t TargetThreadCount;
+
+    if (Elements < size_t(MLAS_SOFTMAX_THREAD_ELEMENTS) * MLAS_MAXIMUM_THREAD_COUNT) {
+        TargetThreadCount = int32_t(Elements / MLAS_SOFTMAX_THREAD_ELEMENTS) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) > N) {
+        TargetThreadCount = int32_t(N);
+    }
+
+    if (TargetThreadCount == 1) {
+        MlasComputeSoftmaxRows(Input, Output, N, D, LogSoftmax);
+        return;
+    }
+
+    MLAS_SOFTMAX_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+    WorkBlock.RowsPerThread = (N + TargetThreadCount - 1) / TargetThreadCount;
+    WorkBlock.LogSoftmax = LogSoftmax;
+
+    MlasExecuteThreaded(MlasComputeSoftmaxThreaded, &WorkBlock,
+        int32_t((N + WorkBlock.RowsPerThread - 1) / WorkBlock.RowsPerThread));
+}
@@ -0,0 +1,576 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute.h
+
+Abstract:
+
+    This module contains the element-wise transcendental kernels (exp, log and
+    erf) and the row kernels used by the softmax routine.
+
+    The kernels are written once against a vector operations class that is
+    supplied as a template argument. Each instruction set extension provides
+    its own operations class in a translation unit compiled with the matching
+    compiler flags, so the same algorithm is built for the base instruction
+    set (SSE2 or NEON) as well as for AVX2/FMA3 and AVX512F.
+
+    The operations class provides:
+
+        FloatType, IntType, MaskType - the vector types.
+
+        Width - the number of single precision elements in FloatType.
+
+        Load, Store, Broadcast, Add, Subtract, Multiply, MultiplyAdd, Maximum,
+        Minimum, And, Or, CompareLessThan, CompareEqual,
+        CompareGreaterThanOrEqual, Select, ReduceAdd, ReduceMaximum.
+
+        BroadcastInt, AddInt, SubtractInt, AndInt, OrInt, ShiftLeftInt,
+        ShiftRightInt, ReinterpretAsInt, ReinterpretAsFloat, CastToFloat.
+
+    The exp and log kernels use the range reduction and polynomial
+    coefficients found in Cephes. The erf kernel uses a minimax style
+    polynomial below 0.921875 and the form 1 - exp(poly(|x|)) above.
+
+--*/
+
+#pragma once
+
+//
+// Bundles the floating point constants for use by the kernels.
+//
+
+struct MLAS_COMPUTE_CONSTANTS {
+    float ExpLowerRange;
+    float ExpUpperRange;
+    float Log2e;
+    float RoundingBias;
+    float Ln2High;
+    float Ln2Low;
+    float ExpP0;
+    float ExpP1;
+    float ExpP2;
+    float ExpP3;
+    float ExpP4;
+    float ExpP5;
+    int32_t ExponentBias;
+    float MinimumNormal;
+    float DenormalScale;
+    int32_t MantissaMask;
+    int32_t HalfExponent;
+    float SqrtHalf;
+    float LogP0;
+    float LogP1;
+    float LogP2;
+    float LogP3;
+    float LogP4;
+    float LogP5;
+    float LogP6;
+    float LogP7;
+    float LogP8;
+    float ErfSplitBoundary;
+    float ErfUpperRange;
+    float ErfSmallP0;
+    float ErfSmallP1;
+    float ErfSmallP2;
+    float ErfSmallP3;
+    float ErfSmallP4;
+    float ErfSmallP5;
+    float ErfLargeP0;
+    float ErfLargeP1;
+    float ErfLargeP2;
+    float ErfLargeP3;
+    float ErfLargeP4;
+    float ErfLargeP5;
+    float ErfLargeP6;
+    float ErfLargeP7;
+    int32_t SignMask;
+    float PositiveInfinity;
+    float NegativeInfinity;
+    float NaN;
+};
+
+extern const MLAS_COMPUTE_CONSTANTS MlasComputeConstants;
+
+template<typename Ops>
+inline
+typename Ops::FloatType
+MlasComputeExpVector(
+    typename Ops::FloatType Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function of a vector.
+
+    The input is reduced to r = x - n*ln(2) with n = round(x/ln(2)). The
+    exponential of r is approximated by a polynomial and then scaled by 2^n.
+    The scale is applied in two halves so that results near the boundaries of
+    the single precision range do not overflow the exponent field before the
+    multiply.
+
+Arguments:
+
+    Value - Supplies the input vector.
+
+Return Value:
+
+    Returns the exponential of each element.
+
+--*/
+{
+    typedef typename Ops::FloatType FloatType;
+    typedef typename Ops::IntType IntType;
+
+    //
+    // Clamp the input to the range that produces a finite or zero result.
+    // The operand order preserves NaN inputs.
+    //
+
+    Value = Ops::Maximum(Ops::Broadcast(MlasComputeConstants.ExpLowerRange), Value);
+    Value = Ops::Minimum(Ops::Broadcast(MlasComputeConstants.ExpUpperRange), Value);
+
+    //
+    // Round x/ln(2) to the nearest integer by adding a bias that pushes the
+    // fraction bits out of the mantissa. The low bits of the biased value are
+    // then the integer result.
+    //
+
+    const FloatType RoundingBias = Ops::Broadcast(MlasComputeConstants.RoundingBias);
+
+    FloatType Biased = Ops::MultiplyAdd(Value, Ops::Broadcast(MlasComputeConstants.Log2e), RoundingBias);
+    FloatType n = Ops::Subtract(Biased, RoundingBias);
+
+    FloatType r = Ops::MultiplyAdd(n, Ops::Broadcast(MlasComputeConstants.Ln2High), Value);
+    r = Ops::MultiplyAdd(n, Ops::Broadcast(MlasComputeConstants.Ln2Low), r);
+
+    FloatType p = Ops::Broadcast(MlasComputeConstants.ExpP0);
+    p = Ops::MultiplyAdd(p, r, Ops::Broadcast(MlasComputeConstants.ExpP1));
+    p = Ops::MultiplyAdd(p, r, Ops::Broadcast(MlasComputeConstants.ExpP2));
+    p = Ops::MultiplyAdd(p, r, Ops::Broadcast(MlasComputeConstants.ExpP3));
+    p = Ops::MultiplyAdd(p, r, Ops::Broadcast(MlasComputeConstants.ExpP4));
+    p = Ops::MultiplyAdd(p, r, Ops::Broadcast(MlasComputeConstants.ExpP5));
+
+    FloatType rSquared = Ops::Multiply(r, r);
+    p = Ops::MultiplyAdd(p, rSquared, Ops::Add(r, Ops::Broadcast(1.0f)));
+
+    //
+    // Build the two halves of the 2^n scale factor directly in the exponent
+    // field.
+    //
+
+    IntType Exponent = Ops::SubtractInt(Ops::ReinterpretAsInt(Biased), Ops::ReinterpretAsInt(RoundingBias));
+    IntType Exponent1 = Ops::template ShiftRightInt<1>(Exponent);
+    IntType Exponent2 = Ops::SubtractInt(Exponent, Exponent1);
+
+    const IntType ExponentBias = Ops::BroadcastInt(MlasComputeConstants.ExponentBias);
+
+    FloatType Scale1 = Ops::ReinterpretAsFloat(Ops::template ShiftLeftInt<23>(Ops::AddInt(Exponent1, ExponentBias)));
+    FloatType Scale2 = Ops::ReinterpretAsFloat(Ops::template ShiftLeftInt<23>(Ops::AddInt(Exponent2, ExponentBias)));
+
+    return Ops::Multiply(Ops::Multiply(p, Scale1), Scale2);
+}
+
+template<typename Ops>
+inline
+typename Ops::FloatType
+MlasComputeLogVector(
+    typename Ops::FloatType Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the natural logarithm of a vector.
+
+    The input is split into x = m * 2^e with m in [sqrt(1/2), sqrt(2)), and
+    log(m) is approximated by a polynomial in (m - 1).
+
+Arguments:
+
+    Value - Supplies the input vector.
+
+Return Value:
+
+    Returns the natural logarithm of each element.
+
+--*/
+{
+    typedef typename Ops::FloatType FloatType;
+    typedef typename Ops::IntType IntType;
+    typedef typename Ops::MaskType MaskType;
+
+    //
+    // Scale denormal inputs into the normal range and account for the scale
+    // in the exponent below.
+    //
+
+    MaskType DenormalMask = Ops::CompareLessThan(Value, Ops::Broadcast(MlasComputeConstants.MinimumNormal));
+
+    FloatType x = Ops::Select(DenormalMask,
+        Ops::Multiply(Value, Ops::Broadcast(MlasComputeConstants.DenormalScale)), Value);
+    FloatType ExponentAdjust = Ops::Select(DenormalMask, Ops::Broadcast(23.0f), Ops::Broadcast(0.0f));
+
+    IntType Bits = Ops::ReinterpretAsInt(x);
+
+    FloatType e = Ops::CastToFloat(Ops::SubtractInt(Ops::template ShiftRightInt<23>(Bits),
+        Ops::BroadcastInt(MlasComputeConstants.ExponentBias - 1)));
+    e = Ops::Subtract(e, ExponentAdjust);
+
+    FloatType m = Ops::ReinterpretAsFloat(Ops::OrInt(Ops::AndInt(Bits,
+        Ops::BroadcastInt(MlasComputeConstants.MantissaMask)), Ops::BroadcastInt(MlasComputeConstants.HalfExponent)));
+
+    //
+    // The mantissa is now in [0.5, 1). Fold the lower half of the range so
+    // that the polynomial is evaluated over [sqrt(1/2) - 1, sqrt(2) - 1).
+    //
+
+    const FloatType One = Ops::Broadcast(1.0f);
+
+    MaskType SmallMask = Ops::CompareLessThan(m, Ops::Broadcast(MlasComputeConstants.SqrtHalf));
+
+    e = Ops::Subtract(e, Ops::Select(SmallMask, One, Ops::Broadcast(0.0f)));
+    m = Ops::Subtract(Ops::Add(m, Ops::Select(SmallMask, m, Ops::Broadcast(0.0f))), One);
+
+    FloatType z = Ops::Multiply(m, m);
+
+    FloatType p = Ops::Broadcast(MlasComputeConstants.LogP0);
+    p = Ops::MultiplyAdd(p, m, Ops::Broadcast(MlasComputeConstants.LogP1));
+    p = Ops::MultiplyAdd(p, m, Ops::Broadcast(MlasComputeConstants.LogP2));
+    p = Ops::MultiplyAdd(p, m, Ops::Broadcast(MlasComputeConstants.LogP3));
+    p = Ops::MultiplyAdd(p, m, Ops::Broadcast(MlasComputeConstants.LogP4));
+    p = Ops::MultiplyAdd(p, m, Ops::Broadcast(MlasComputeConstants.LogP5));
+    p = Ops::MultiplyAdd(p, m, Ops::Broadcast(MlasComputeConstants.LogP6));
+    p = Ops::MultiplyAdd(p, m, Ops::Broadcast(MlasComputeConstants.LogP7));
+    p = Ops::MultiplyAdd(p, m, Ops::Broadcast(MlasComputeConstants.LogP8));
+
+    FloatType y = Ops::Multiply(Ops::Multiply(p, m), z);
+    y = Ops::MultiplyAdd(e, Ops::Broadcast(-MlasComputeConstants.Ln2Low), y);
+    y = Ops::MultiplyAdd(z, Ops::Broadcast(-0.5f), y);
+
+    FloatType Result = Ops::Add(m, y);
+    Result = Ops::MultiplyAdd(e, Ops::Broadcast(-MlasComputeConstants.Ln2High), Result);
+
+    //
+    // Handle the special cases: log(0) is -inf, log(+inf) is +inf and the
+    // logarithm of a negative value or NaN is NaN.
+    //
+
+    const FloatType Zero = Ops::Broadcast(0.0f);
+    const FloatType PositiveInfinity = Ops::Broadcast(MlasComputeConstants.PositiveInfinity);
+
+    Result = Ops::Select(Ops::CompareEqual(Value, PositiveInfinity), PositiveInfinity, Result);
+    Result = Ops::Select(Ops::CompareGreaterThanOrEqual(Value, Zero), Result,
+        Ops::Broadcast(MlasComputeConstants.NaN));
+    Result = Ops::Select(Ops::CompareEqual(Value, Zero),
+        Ops::Broadcast(MlasComputeConstants.NegativeInfinity), Result);
+
+    return Result;
+}
+
+template<typename Ops>
+inline
+typename Ops::FloatType
+MlasComputeErfVector(
+    typename Ops::FloatType Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the error function of a vector.
+
+Arguments:
+
+    Value - Supplies the input vector.
+
+Return Value:
+
+    Returns the error function of each element.
+
+--*/
+{
+    typedef typename Ops::FloatType FloatType;
+    typedef typename Ops::IntType IntType;
+
+    const IntType SignMask = Ops::BroadcastInt(MlasComputeConstants.SignMask);
+
+    IntType Bits = Ops::ReinterpretAsInt(Value);
+    IntType SignBits = Ops::AndInt(Bits, SignMask);
+
+    FloatType AbsValue = Ops::ReinterpretAsFloat(Ops::SubtractInt(Bits, SignBits));
+
+    //
+    // erf(x) = x * P(x^2) for small values.
+    //
+
+    FloatType SmallSquared = Ops::Multiply(AbsValue, AbsValue);
+
+    FloatType Small = Ops::Broadcast(MlasComputeConstants.ErfSmallP0);
+    Small = Ops::MultiplyAdd(Small, SmallSquared, Ops::Broadcast(MlasComputeConstants.ErfSmallP1));
+    Small = Ops::MultiplyAdd(Small, SmallSquared, Ops::Broadcast(MlasComputeConstants.ErfSmallP2));
+    Small = Ops::MultiplyAdd(Small, SmallSquared, Ops::Broadcast(MlasComputeConstants.ErfSmallP3));
+    Small = Ops::MultiplyAdd(Small, SmallSquared, Ops::Broadcast(MlasComputeConstants.ErfSmallP4));
+    Small = Ops::MultiplyAdd(Small, SmallSquared, Ops::Broadcast(MlasComputeConstants.ErfSmallP5));
+    Small = Ops::Multiply(Small, AbsValue);
+
+    //
+    // erf(x) = 1 - exp(P(x)) for larger values.
+    //
+
+    FloatType Large = Ops::Broadcast(MlasComputeConstants.ErfLargeP0);
+    Large = Ops::MultiplyAdd(Large, AbsValue, Ops::Broadcast(MlasComputeConstants.ErfLargeP1));
+    Large = Ops::MultiplyAdd(Large, AbsValue, Ops::Broadcast(MlasComputeConstants.ErfLargeP2));
+    Large = Ops::MultiplyAdd(Large, AbsValue, Ops::Broadcast(MlasComputeConstants.ErfLargeP3));
+    Large = Ops::MultiplyAdd(Large, AbsValue, Ops::Broadcast(MlasComputeConstants.ErfLargeP4));
+    Large = Ops::MultiplyAdd(Large, AbsValue, Ops::Broadcast(MlasComputeConstants.ErfLargeP5));
+    Large = Ops::MultiplyAdd(Large, AbsValue, Ops::Broadcast(MlasComputeConstants.ErfLargeP6));
+    Large = Ops::MultiplyAdd(Large, AbsValue, Ops::Broadcast(MlasComputeConstants.ErfLargeP7));
+
+    const FloatType One = Ops::Broadcast(1.0f);
+
+    Large = Ops::Subtract(One, MlasComputeExpVector<Ops>(Large));
+
+    FloatType Result = Ops::Select(Ops::CompareLessThan(AbsValue,
+        Ops::Broadcast(MlasComputeConstants.ErfSplitBoundary)), Small, Large);
+    Result = Ops::Select(Ops::CompareGreaterThanOrEqual(AbsValue,
+        Ops::Broadcast(MlasComputeConstants.ErfUpperRange)), One, Result);
+
+    return Ops::ReinterpretAsFloat(Ops::OrInt(Ops::ReinterpretAsInt(Result), SignBits));
+}
+
+//
+// Loads a partial vector into a buffer padded with the supplied value.
+//
+
+template<typename Ops>
+inline
+typename Ops::FloatType
+MlasComputeLoadPartialVector(
+    const float* Input,
+    size_t N,
+    float* Buffer,
+    float PadValue
+    )
+{
+    for (size_t i = 0; i < Ops::Width; i++) {
+        Buffer[i] = (i < N) ? Input[i] : PadValue;
+    }
+
+    return Ops::Load(Buffer);
+}
+
+template<typename Ops, typename Ops::FloatType (*ComputeVector)(typename Ops::FloatType)>
+void
+MlasComputeUnaryKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine applies a vector function to each element of the input
+    buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= Ops::Width) {
+
+        Ops::Store(Output, ComputeVector(Ops::Load(Input)));
+
+        Input += Ops::Width;
+        Output += Ops::Width;
+        N -= Ops::Width;
+    }
+
+    if (N > 0) {
+
+        float Buffer[Ops::Width];
+
+        typename Ops::FloatType Value = MlasComputeLoadPartialVector<Ops>(Input, N, Buffer, 0.0f);
+
+        Ops::Store(Buffer, ComputeVector(Value));
+
+        for (size_t i = 0; i < N; i++) {
+            Output[i] = Buffer[i];
+        }
+    }
+}
+
+template<typename Ops>
+float
+MlasReduceMaximumRow(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine finds the maximum value of the input buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the maximum value.
+
+--*/
+{
+    typedef typename Ops::FloatType FloatType;
+
+    const float NegativeInfinity = MlasComputeConstants.NegativeInfinity;
+
+    FloatType Maximum0 = Ops::Broadcast(NegativeInfinity);
+    FloatType Maximum1 = Maximum0;
+    FloatType Maximum2 = Maximum0;
+    FloatType Maximum3 = Maximum0;
+
+    while (N >= Ops::Width * 4) {
+
+        Maximum0 = Ops::Maximum(Maximum0, Ops::Load(Input));
+        Maximum1 = Ops::Maximum(Maximum1, Ops::Load(Input + Ops::Width));
+        Maximum2 = Ops::Maximum(Maximum2, Ops::Load(Input + Ops::Width * 2));
+        Maximum3 = Ops::Maximum(Maximum3, Ops::Load(Input + Ops::Width * 3));
+
+        Input += Ops::Width * 4;
+        N -= Ops::Width * 4;
+    }
+
+    while (N >= Ops::Width) {
+
+        Maximum0 = Ops::Maximum(Maximum0, Ops::Load(Input));
+
+        Input += Ops::Width;
+        N -= Ops::Width;
+    }
+
+    if (N > 0) {
+
+        float Buffer[Ops::Width];
+
+        Maximum1 = Ops::Maximum(Maximum1,
+            MlasComputeLoadPartialVector<Ops>(Input, N, Buffer, NegativeInfinity));
+    }
+
+    Maximum0 = Ops::Maximum(Ops::Maximum(Maximum0, Maximum1), Ops::Maximum(Maximum2, Maximum3));
+
+    return Ops::ReduceMaximum(Maximum0);
+}
+
+template<typename Ops>
+float
+MlasComputeSumExpRow(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential of each element of the input buffer
+    after adding the supplied bias and returns the sum of the results.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Optionally supplies the output buffer to receive the results.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the value added to each element before
+        computing the exponential, normally the negated maximum of the input
+        to avoid overflow.
+
+Return Value:
+
+    Returns the sum of the exponentials.
+
+--*/
+{
+    typedef typename Ops::FloatType FloatType;
+
+    const FloatType Bias = Ops::Broadcast(NegativeMaximum);
+
+    FloatType Accumulator0 = Ops::Broadcast(0.0f);
+    FloatType Accumulator1 = Accumulator0;
+
+    while (N >= Ops::Width * 2) {
+
+        FloatType Value0 = MlasComputeExpVector<Ops>(Ops::Add(Ops::Load(Input), Bias));
+        FloatType Value1 = MlasComputeExpVector<Ops>(Ops::Add(Ops::Load(Input + Ops::Width), Bias));
+
+        Accumulator0 = Ops::Add(Accumulator0, Value0);
+        Accumulator1 = Ops::Add(Accumulator1, Value1);
+
+        if (Output != nullptr) {
+            Ops::Store(Output, Value0);
+            Ops::Store(Output + Ops::Width, Value1);
+            Output += Ops::Width * 2;
+        }
+
+        Input += Ops::Width * 2;
+        N -= Ops::Width * 2;
+    }
+
+    while (N >= Ops::Width) {
+
+        FloatType Value = MlasComputeExpVector<Ops>(Ops::Add(Ops::Load(Input), Bias));
+
+        Accumulator0 = Ops::Add(Accumulator0, Value);
+
+        if (Output != nullptr) {
+            Ops::Store(Output, Value);
+            Output += Ops::Width;
+        }
+
+        Input += Ops::Width;
+        N -= Ops::Width;
+    }
+
+    float Accumulator = Ops::ReduceAdd(Ops::Add(Accumulator0, Accumulator1));
+
+    if (N > 0) {
+
+        float Buffer[Ops::Width];
+
+        FloatType Value = MlasComputeLoadPartialVector<Ops>(Input, N, Buffer, 0.0f);
+
+        Ops::Store(Buffer, MlasComputeExpVector<Ops>(Ops::Add(Value, Bias)));
+
+        for (size_t i = 0; i < N; i++) {
+            Accumulator += Buffer[i];
+            if (Output != nullptr) {
+                Output[i] = Buffer[i];
+            }
+        }
+    }
+
+    return Accumulator;
+}
@@ -0,0 +1,134 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute_avx2.cpp
+
+Abstract:
+
+    This module implements the exponential, logarithm, error function and
+    softmax row kernels for processors supporting AVX2 and FMA3.
+
+    This module must be compiled with the compiler flags to enable AVX2 and
+    FMA3 code generation.
+
+--*/
+
+#include "mlasi.h"
+#include "compute.h"
+
+//
+// Define the vector operations for AVX2/FMA3.
+//
+
+struct MLAS_COMPUTE_OPS_AVX2 {
+
+    typedef __m256 FloatType;
+    typedef __m256i IntType;
+    typedef __m256 MaskType;
+
+    static constexpr size_t Width = 8;
+
+    static FloatType Load(const float* Buffer) { return _mm256_loadu_ps(Buffer); }
+    static void Store(float* Buffer, FloatType Vector) { _mm256_storeu_ps(Buffer, Vector); }
+    static FloatType Broadcast(float Value) { return _mm256_set1_ps(Value); }
+    static FloatType Add(FloatType v1, FloatType v2) { return _mm256_add_ps(v1, v2); }
+    static FloatType Subtract(FloatType v1, FloatType v2) { return _mm256_sub_ps(v1, v2); }
+    static FloatType Multiply(FloatType v1, FloatType v2) { return _mm256_mul_ps(v1, v2); }
+    static FloatType MultiplyAdd(FloatType v1, FloatType v2, FloatType v3) { return _mm256_fmadd_ps(v1, v2, v3); }
+    static FloatType Maximum(FloatType v1, FloatType v2) { return _mm256_max_ps(v1, v2); }
+    static FloatType Minimum(FloatType v1, FloatType v2) { return _mm256_min_ps(v1, v2); }
+    static MaskType CompareLessThan(FloatType v1, FloatType v2) { return _mm256_cmp_ps(v1, v2, _CMP_LT_OQ); }
+    static MaskType CompareEqual(FloatType v1, FloatType v2) { return _mm256_cmp_ps(v1, v2, _CMP_EQ_OQ); }
+    static MaskType CompareGreaterThanOrEqual(FloatType v1, FloatType v2) { return _mm256_cmp_ps(v1, v2, _CMP_GE_OQ); }
+    static FloatType Select(MaskType Mask, FloatType v1, FloatType v2) { return _mm256_blendv_ps(v2, v1, Mask); }
+
+    static float ReduceAdd(FloatType Vector)
+    {
+        __m128 v = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+        v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 0x55));
+        return _mm_cvtss_f32(v);
+    }
+
+    static float ReduceMaximum(FloatType Vector)
+    {
+        __m128 v = _mm_max_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+        v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_max_ss(v, _mm_shuffle_ps(v, v, 0x55));
+        return _mm_cvtss_f32(v);
+    }
+
+    static IntType BroadcastInt(int32_t Value) { return _mm256_set1_epi32(Value); }
+    static IntType AddInt(IntType v1, IntType v2) { return _mm256_add_epi32(v1, v2); }
+    static IntType SubtractInt(IntType v1, IntType v2) { return _mm256_sub_epi32(v1, v2); }
+    static IntType AndInt(IntType v1, IntType v2) { return _mm256_and_si256(v1, v2); }
+    static IntType OrInt(IntType v1, IntType v2) { return _mm256_or_si256(v1, v2); }
+    template<unsigned ShiftCount> static IntType ShiftLeftInt(IntType Vector) { return _mm256_slli_epi32(Vector, ShiftCount); }
+    template<unsigned ShiftCount> static IntType ShiftRightInt(IntType Vector) { return _mm256_srai_epi32(Vector, ShiftCount); }
+    static IntType ReinterpretAsInt(FloatType Vector) { return _mm256_castps_si256(Vector); }
+    static FloatType ReinterpretAsFloat(IntType Vector) { return _mm256_castsi256_ps(Vector); }
+    static FloatType CastToFloat(IntType Vector) { return _mm256_cvtepi32_ps(Vector); }
+};
+
+void
+MLASCALL
+MlasExpKernelFma3(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    MlasComputeUnaryKernel<MLAS_COMPUTE_OPS_AVX2,
+        MlasComputeExpVector<MLAS_COMPUTE_OPS_AVX2>>(Input, Output, N);
+}
+
+void
+MLASCALL
+MlasLogKernelFma3(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    MlasComputeUnaryKernel<MLAS_COMPUTE_OPS_AVX2,
+        MlasComputeLogVector<MLAS_COMPUTE_OPS_AVX2>>(Input, Output, N);
+}
+
+void
+MLASCALL
+MlasErfKernelFma3(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    MlasComputeUnaryKernel<MLAS_COMPUTE_OPS_AVX2,
+        MlasComputeErfVector<MLAS_COMPUTE_OPS_AVX2>>(Input, Output, N);
+}
+
+float
+MLASCALL
+MlasComputeSumExpKernelFma3(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    )
+{
+    return MlasComputeSumExpRow<MLAS_COMPUTE_OPS_AVX2>(Input, Output, N, NegativeMaximum);
+}
+
+float
+MLASCALL
+MlasReduceMaximumKernelFma3(
+    const float* Input,
+    size_t N
+    )
+{
+    return MlasReduceMaximumRow<MLAS_COMPUTE_OPS_AVX2>(Input, N);
+}
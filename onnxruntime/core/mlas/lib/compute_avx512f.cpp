@@ -0,0 +1,120 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute_avx512f.cpp
+
+Abstract:
+
+    This module implements the exponential, logarithm, error function and
+    softmax row kernels for processors supporting AVX512F.
+
+    This module must be compiled with the compiler flags to enable AVX512F
+    code generation.
+
+--*/
+
+#include "mlasi.h"
+#include "compute.h"
+
+//
+// Define the vector operations for AVX512F.
+//
+
+struct MLAS_COMPUTE_OPS_AVX512F {
+
+    typedef __m512 FloatType;
+    typedef __m512i IntType;
+    typedef __mmask16 MaskType;
+
+    static constexpr size_t Width = 16;
+
+    static FloatType Load(const float* Buffer) { return _mm512_loadu_ps(Buffer); }
+    static void Store(float* Buffer, FloatType Vector) { _mm512_storeu_ps(Buffer, Vector); }
+    static FloatType Broadcast(float Value) { return _mm512_set1_ps(Value); }
+    static FloatType Add(FloatType v1, FloatType v2) { return _mm512_add_ps(v1, v2); }
+    static FloatType Subtract(FloatType v1, FloatType v2) { return _mm512_sub_ps(v1, v2); }
+    static FloatType Multiply(FloatType v1, FloatType v2) { return _mm512_mul_ps(v1, v2); }
+    static FloatType MultiplyAdd(FloatType v1, FloatType v2, FloatType v3) { return _mm512_fmadd_ps(v1, v2, v3); }
+    static FloatType Maximum(FloatType v1, FloatType v2) { return _mm512_max_ps(v1, v2); }
+    static FloatType Minimum(FloatType v1, FloatType v2) { return _mm512_min_ps(v1, v2); }
+    static MaskType CompareLessThan(FloatType v1, FloatType v2) { return _mm512_cmp_ps_mask(v1, v2, _CMP_LT_OQ); }
+    static MaskType CompareEqual(FloatType v1, FloatType v2) { return _mm512_cmp_ps_mask(v1, v2, _CMP_EQ_OQ); }
+    static MaskType CompareGreaterThanOrEqual(FloatType v1, FloatType v2) { return _mm512_cmp_ps_mask(v1, v2, _CMP_GE_OQ); }
+    static FloatType Select(MaskType Mask, FloatType v1, FloatType v2) { return _mm512_mask_blend_ps(Mask, v2, v1); }
+    static float ReduceAdd(FloatType Vector) { return _mm512_reduce_add_ps(Vector); }
+    static float ReduceMaximum(FloatType Vector) { return _mm512_reduce_max_ps(Vector); }
+
+    static IntType BroadcastInt(int32_t Value) { return _mm512_set1_epi32(Value); }
+    static IntType AddInt(IntType v1, IntType v2) { return _mm512_add_epi32(v1, v2); }
+    static IntType SubtractInt(IntType v1, IntType v2) { return _mm512_sub_epi32(v1, v2); }
+    static IntType AndInt(IntType v1, IntType v2) { return _mm512_and_si512(v1, v2); }
+    static IntType OrInt(IntType v1, IntType v2) { return _mm512_or_si512(v1, v2); }
+    template<unsigned ShiftCount> static IntType ShiftLeftInt(IntType Vector) { return _mm512_slli_epi32(Vector, ShiftCount); }
+    template<unsigned ShiftCount> static IntType ShiftRightInt(IntType Vector) { return _mm512_srai_epi32(Vector, ShiftCount); }
+    static IntType ReinterpretAsInt(FloatType Vector) { return _mm512_castps_si512(Vector); }
+    static FloatType ReinterpretAsFloat(IntType Vector) { return _mm512_castsi512_ps(Vector); }
+    static FloatType CastToFloat(IntType Vector) { return _mm512_cvtepi32_ps(Vector); }
+};
+
+void
+MLASCALL
+MlasExpKernelAvx512F(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    MlasComputeUnaryKernel<MLAS_COMPUTE_OPS_AVX512F,
+        MlasComputeExpVector<MLAS_COMPUTE_OPS_AVX512F>>(Input, Output, N);
+}
+
+void
+MLASCALL
+MlasLogKernelAvx512F(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    MlasComputeUnaryKernel<MLAS_COMPUTE_OPS_AVX512F,
+        MlasComputeLogVector<MLAS_COMPUTE_OPS_AVX512F>>(Input, Output, N);
+}
+
+void
+MLASCALL
+MlasErfKernelAvx512F(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    MlasComputeUnaryKernel<MLAS_COMPUTE_OPS_AVX512F,
+        MlasComputeErfVector<MLAS_COMPUTE_OPS_AVX512F>>(Input, Output, N);
+}
+
+float
+MLASCALL
+MlasComputeSumExpKernelAvx512F(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    )
+{
+    return MlasComputeSumExpRow<MLAS_COMPUTE_OPS_AVX512F>(Input, Output, N, NegativeMaximum);
+}
+
+float
+MLASCALL
+MlasReduceMaximumKernelAvx512F(
+    const float* Input,
+    size_t N
+    )
+{
+    return MlasReduceMaximumRow<MLAS_COMPUTE_OPS_AVX512F>(Input, N);
+}
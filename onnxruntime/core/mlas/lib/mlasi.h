@@ -176,6 +176,36 @@ void
 
 typedef MLAS_TANH_KERNEL_ROUTINE* PMLAS_TANH_KERNEL_ROUTINE;
 
+typedef
+void
+(MLASCALL MLAS_COMPUTE_UNARY_KERNEL_ROUTINE)(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+typedef MLAS_COMPUTE_UNARY_KERNEL_ROUTINE* PMLAS_COMPUTE_UNARY_KERNEL_ROUTINE;
+
+typedef
+float
+(MLASCALL MLAS_COMPUTE_SUMEXP_KERNEL_ROUTINE)(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    );
+
+typedef MLAS_COMPUTE_SUMEXP_KERNEL_ROUTINE* PMLAS_COMPUTE_SUMEXP_KERNEL_ROUTINE;
+
+typedef
+float
+(MLASCALL MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE)(
+    const float* Input,
+    size_t N
+    );
+
+typedef MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE* PMLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE;
+
 extern "C" {
 
     MLAS_SGEMM_KERNEL_ROUTINE MlasSgemmKernelZero;
@@ -212,6 +242,24 @@ extern "C" {
 
 }
 
+MLAS_COMPUTE_UNARY_KERNEL_ROUTINE MlasExpKernel;
+MLAS_COMPUTE_UNARY_KERNEL_ROUTINE MlasLogKernel;
+MLAS_COMPUTE_UNARY_KERNEL_ROUTINE MlasErfKernel;
+MLAS_COMPUTE_SUMEXP_KERNEL_ROUTINE MlasComputeSumExpKernel;
+MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE MlasReduceMaximumKernel;
+#if defined(MLAS_TARGET_AMD64)
+MLAS_COMPUTE_UNARY_KERNEL_ROUTINE MlasExpKernelFma3;
+MLAS_COMPUTE_UNARY_KERNEL_ROUTINE MlasLogKernelFma3;
+MLAS_COMPUTE_UNARY_KERNEL_ROUTINE MlasErfKernelFma3;
+MLAS_COMPUTE_SUMEXP_KERNEL_ROUTINE MlasComputeSumExpKernelFma3;
+MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE MlasReduceMaximumKernelFma3;
+MLAS_COMPUTE_UNARY_KERNEL_ROUTINE MlasExpKernelAvx512F;
+MLAS_COMPUTE_UNARY_KERNEL_ROUTINE MlasLogKernelAvx512F;
+MLAS_COMPUTE_UNARY_KERNEL_ROUTINE MlasErfKernelAvx512F;
+MLAS_COMPUTE_SUMEXP_KERNEL_ROUTINE MlasComputeSumExpKernelAvx512F;
+MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE MlasReduceMaximumKernelAvx512F;
+#endif
+
 //
 // Define the target number of per-thread multiplies before using another
 // thread to perform additional work.
@@ -271,6 +319,11 @@ struct MLAS_PLATFORM {
     PMLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE TransposePackB16x4Routine;
     PMLAS_LOGISTIC_KERNEL_ROUTINE LogisticKernelRoutine;
     PMLAS_TANH_KERNEL_ROUTINE TanhKernelRoutine;
+    PMLAS_COMPUTE_UNARY_KERNEL_ROUTINE ExpKernelRoutine;
+    PMLAS_COMPUTE_UNARY_KERNEL_ROUTINE LogKernelRoutine;
+    PMLAS_COMPUTE_UNARY_KERNEL_ROUTINE ErfKernelRoutine;
+    PMLAS_COMPUTE_SUMEXP_KERNEL_ROUTINE ComputeSumExpKernelRoutine;
+    PMLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE ReduceMaximumKernelRoutine;
 #endif
 
 #if defined(MLAS_USE_WIN32_THREADPOOL)
@@ -566,6 +619,230 @@ MlasMinimumFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #endif
 }
 
+inline
+MLAS_FLOAT32X4
+MlasAndFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(Vector1), vreinterpretq_u32_f32(Vector2)));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_and_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasOrFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(Vector1), vreinterpretq_u32_f32(Vector2)));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_or_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasCompareLessThanFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vcltq_f32(Vector1, Vector2));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_cmplt_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasCompareEqualFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vceqq_f32(Vector1, Vector2));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_cmpeq_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasCompareGreaterThanOrEqualFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vcgeq_f32(Vector1, Vector2));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_cmpge_ps(Vector1, Vector2);
+#endif
+}
+
+//
+// Selects elements from TrueValue where the mask produced by a compare
+// routine is set and elements from FalseValue otherwise.
+//
+
+inline
+MLAS_FLOAT32X4
+MlasSelectFloat32x4(MLAS_FLOAT32X4 Mask, MLAS_FLOAT32X4 TrueValue, MLAS_FLOAT32X4 FalseValue)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vbslq_f32(vreinterpretq_u32_f32(Mask), TrueValue, FalseValue);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_or_ps(_mm_and_ps(Mask, TrueValue), _mm_andnot_ps(Mask, FalseValue));
+#endif
+}
+
+inline
+float
+MlasReduceAddFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    float32x2_t VectorLow = vadd_f32(vget_low_f32(Vector), vget_high_f32(Vector));
+    VectorLow = vpadd_f32(VectorLow, VectorLow);
+    return vget_lane_f32(VectorLow, 0);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    Vector = _mm_add_ps(Vector, _mm_shuffle_ps(Vector, Vector, _MM_SHUFFLE(1, 0, 3, 2)));
+    Vector = _mm_add_ps(Vector, _mm_shuffle_ps(Vector, Vector, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(Vector);
+#endif
+}
+
+inline
+float
+MlasReduceMaximumFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    float32x2_t VectorLow = vpmax_f32(vget_low_f32(Vector), vget_high_f32(Vector));
+    VectorLow = vpmax_f32(VectorLow, VectorLow);
+    return vget_lane_f32(VectorLow, 0);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    Vector = _mm_max_ps(Vector, _mm_shuffle_ps(Vector, Vector, _MM_SHUFFLE(1, 0, 3, 2)));
+    Vector = _mm_max_ps(Vector, _mm_shuffle_ps(Vector, Vector, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(Vector);
+#endif
+}
+
+//
+// Define the 32-bit integer vector type and the routines used by kernels that
+// manipulate the bits of single precision values.
+//
+
+#if defined(MLAS_NEON_INTRINSICS)
+typedef int32x4_t MLAS_INT32X4;
+#elif defined(MLAS_SSE2_INTRINSICS)
+typedef __m128i MLAS_INT32X4;
+#endif
+
+inline
+MLAS_INT32X4
+MlasBroadcastInt32x4(int32_t Value)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vdupq_n_s32(Value);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_set1_epi32(Value);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasAddInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vaddq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_add_epi32(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasSubtractInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vsubq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_sub_epi32(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasAndInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vandq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_and_si128(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasOrInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vorrq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_or_si128(Vector1, Vector2);
+#endif
+}
+
+template<unsigned ShiftCount>
+inline
+MLAS_INT32X4
+MlasShiftLeftInt32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vshlq_n_s32(Vector, ShiftCount);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_slli_epi32(Vector, ShiftCount);
+#endif
+}
+
+template<unsigned ShiftCount>
+inline
+MLAS_INT32X4
+MlasShiftRightInt32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vshrq_n_s32(Vector, ShiftCount);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_srai_epi32(Vector, ShiftCount);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasReinterpretAsInt32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_s32_f32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castps_si128(Vector);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasReinterpretAsFloat32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_s32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castsi128_ps(Vector);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasCastToFloat32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vcvtq_f32_s32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_cvtepi32_ps(Vector);
+#endif
+}
+
 //
 // Reads a platform specific time stamp counter.
 //
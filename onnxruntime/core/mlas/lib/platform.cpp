@@ -55,6 +55,11 @@ Return Value:
     this->TransposePackB16x4Routine = MlasSgemmTransposePackB16x4Sse;
     this->LogisticKernelRoutine = MlasLogisticKernel;
     this->TanhKernelRoutine = MlasTanhKernel;
+    this->ExpKernelRoutine = MlasExpKernel;
+    this->LogKernelRoutine = MlasLogKernel;
+    this->ErfKernelRoutine = MlasErfKernel;
+    this->ComputeSumExpKernelRoutine = MlasComputeSumExpKernel;
+    this->ReduceMaximumKernelRoutine = MlasReduceMaximumKernel;
 #endif
 
     //
@@ -106,9 +111,19 @@ Return Value:
                 if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0)) {
                     this->KernelZeroRoutine = MlasSgemmKernelZeroAvx512F;
                     this->KernelAddRoutine = MlasSgemmKernelAddAvx512F;
+                    this->ExpKernelRoutine = MlasExpKernelAvx512F;
+                    this->LogKernelRoutine = MlasLogKernelAvx512F;
+                    this->ErfKernelRoutine = MlasErfKernelAvx512F;
+                    this->ComputeSumExpKernelRoutine = MlasComputeSumExpKernelAvx512F;
+                    this->ReduceMaximumKernelRoutine = MlasReduceMaximumKernelAvx512F;
                 } else {
                     this->KernelZeroRoutine = MlasSgemmKernelZeroFma3;
                     this->KernelAddRoutine = MlasSgemmKernelAddFma3;
+                    this->ExpKernelRoutine = MlasExpKernelFma3;
+                    this->LogKernelRoutine = MlasLogKernelFma3;
+                    this->ErfKernelRoutine = MlasErfKernelFma3;
+                    this->ComputeSumExpKernelRoutine = MlasComputeSumExpKernelFma3;
+                    this->ReduceMaximumKernelRoutine = MlasReduceMaximumKernelFma3;
                 }
 
                 this->LogisticKernelRoutine = MlasLogisticKernelFma3;
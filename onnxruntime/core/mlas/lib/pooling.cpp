@@ -46,6 +46,29 @@ void
 
 typedef MLAS_POOL_KERNEL_ROUTINE* PMLAS_POOL_KERNEL_ROUTINE;
 
+//
+// Define the parameters to split the channels of a pooling operation across
+// worker threads.
+//
+
+struct MLAS_POOL_THREADED_WORK_BLOCK {
+    const MLAS_WORK_BLOCK* WorkBlock;
+    PMLAS_POOL_KERNEL_ROUTINE PoolKernelRoutine;
+    const float* Input;
+    float* Output;
+    size_t InputSize;
+    size_t OutputSize;
+    size_t TotalChannelCount;
+    size_t ChannelsPerThread;
+};
+
+//
+// Define the number of input elements to process per thread before using
+// another thread to perform additional work.
+//
+
+#define MLAS_POOL_THREAD_ELEMENTS           (16 * 1024)
+
 //
 // Define the number of elements to allocate on the stack for the reduction
 // buffer in the vectorized kernels.
@@ -1071,6 +1094,31 @@ Return Value:
 
         MLAS_FLOAT32X4 Reduction = PoolingType::InitialVector();
 
+        //
+        // Use independent accumulators for large inputs to hide the latency
+        // of the reduction instruction, then fold them into one vector.
+        //
+
+        if (InputSizeRemaining >= 16) {
+
+            MLAS_FLOAT32X4 Reduction1 = PoolingType::InitialVector();
+            MLAS_FLOAT32X4 Reduction2 = PoolingType::InitialVector();
+            MLAS_FLOAT32X4 Reduction3 = PoolingType::InitialVector();
+
+            while (InputSizeRemaining >= 16) {
+                Reduction = PoolingType::Reduce(Reduction, MlasLoadFloat32x4(Input));
+                Reduction1 = PoolingType::Reduce(Reduction1, MlasLoadFloat32x4(Input + 4));
+                Reduction2 = PoolingType::Reduce(Reduction2, MlasLoadFloat32x4(Input + 8));
+                Reduction3 = PoolingType::Reduce(Reduction3, MlasLoadFloat32x4(Input + 12));
+                Input += 16;
+                InputSizeRemaining -= 16;
+            }
+
+            Reduction = PoolingType::Reduce(Reduction, Reduction1);
+            Reduction2 = PoolingType::Reduce(Reduction2, Reduction3);
+            Reduction = PoolingType::Reduce(Reduction, Reduction2);
+        }
+
         while (InputSizeRemaining >= 4) {
             Reduction = PoolingType::Reduce(Reduction, MlasLoadFloat32x4(Input));
             Input += 4;
@@ -1171,6 +1219,45 @@ static const PMLAS_POOL_KERNEL_ROUTINE MlasPoolVectorKernels[][2] =
     },
 };
 
+void
+MlasPoolThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    pooling operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_POOL_THREADED_WORK_BLOCK* ThreadedWorkBlock = (MLAS_POOL_THREADED_WORK_BLOCK*)Context;
+
+    const size_t TotalChannelCount = ThreadedWorkBlock->TotalChannelCount;
+    const size_t c = ThreadedWorkBlock->ChannelsPerThread * Index;
+
+    if (c < TotalChannelCount) {
+
+        const size_t ChannelCount = (std::min)(TotalChannelCount - c, ThreadedWorkBlock->ChannelsPerThread);
+
+        ThreadedWorkBlock->PoolKernelRoutine(ThreadedWorkBlock->WorkBlock, ChannelCount,
+            ThreadedWorkBlock->Input + c * ThreadedWorkBlock->InputSize,
+            ThreadedWorkBlock->Output + c * ThreadedWorkBlock->OutputSize);
+    }
+}
+
 void
 MLASCALL
 MlasPool(
@@ -1316,20 +1403,54 @@ Return Value:
     }
 
     //
-    // Execute the pooling kernel routine.
+    // Determine the number of threads to use. Each thread processes a
+    // contiguous range of the batch and channel planes.
     //
 
-#if defined(MLAS_USE_OPENMP)
+    if (TotalChannelCount == 0) {
+        return;
+    }
 
-    #pragma omp parallel for
-    for (int64_t c = 0; c < int64_t(TotalChannelCount); c++) {
-        PoolKernelRoutine(&WorkBlock, 1, Input + c * InputSize, Output + c * OutputSize);
+    const size_t Elements = TotalChannelCount * InputSize;
+
+    int32_t TargetThreadCount;
+
+    if (Elements < size_t(MLAS_POOL_THREAD_ELEMENTS) * MLAS_MAXIMUM_THREAD_COUNT) {
+        TargetThreadCount = int32_t(Elements / MLAS_POOL_THREAD_ELEMENTS) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
     }
 
-#else
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
 
-    PoolKernelRoutine(&WorkBlock, TotalChannelCount, Input, Output);
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
 
-#endif
+    if (size_t(TargetThreadCount) > TotalChannelCount) {
+        TargetThreadCount = int32_t(TotalChannelCount);
+    }
+
+    //
+    // Execute the pooling kernel routine.
+    //
+
+    if (TargetThreadCount == 1) {
+        PoolKernelRoutine(&WorkBlock, TotalChannelCount, Input, Output);
+        return;
+    }
+
+    MLAS_POOL_THREADED_WORK_BLOCK ThreadedWorkBlock;
+
+    ThreadedWorkBlock.WorkBlock = &WorkBlock;
+    ThreadedWorkBlock.PoolKernelRoutine = PoolKernelRoutine;
+    ThreadedWorkBlock.Input = Input;
+    ThreadedWorkBlock.Output = Output;
+    ThreadedWorkBlock.InputSize = InputSize;
+    ThreadedWorkBlock.OutputSize = OutputSize;
+    ThreadedWorkBlock.TotalChannelCount = TotalChannelCount;
+    ThreadedWorkBlock.ChannelsPerThread = (TotalChannelCount + TargetThreadCount - 1) / TargetThreadCount;
 
+    MlasExecuteThreaded(MlasPoolThreaded, &ThreadedWorkBlock,
+        int32_t((TotalChannelCount + ThreadedWorkBlock.ChannelsPerThread - 1) / ThreadedWorkBlock.ChannelsPerThread));
 }
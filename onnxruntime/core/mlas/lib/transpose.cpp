@@ -0,0 +1,504 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transpose.cpp
+
+Abstract:
+
+    This module implements the matrix transpose operation.
+
+    The matrix is processed in strips of output rows so that the cache lines
+    of the output touched by the inner loop stay resident while successive
+    columns of the strip are filled in. Each strip is transposed using 4x4
+    vector micro-tiles where supported by the element type.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of output rows processed by a single pass over the input.
+//
+// The inner loop writes one partial cache line to each output row of the
+// strip, so the strip size is chosen to keep these lines within L1.
+//
+
+#define MLAS_TRANSPOSE_STRIP_ROWS                   64
+
+//
+// Define the number of elements to process per thread before using another
+// thread to perform additional work.
+//
+
+#define MLAS_TRANSPOSE_THREAD_ELEMENTS              (64 * 1024)
+
+//
+// Define the parameters to execute segments of a transpose operation on worker
+// threads.
+//
+
+struct MLAS_TRANSPOSE_WORK_BLOCK {
+    const void* Input;
+    void* Output;
+    size_t M;
+    size_t N;
+    size_t StrideN;
+};
+
+template<typename ElementType>
+void
+MlasTransposeStripGeneric(
+    const ElementType* Input,
+    size_t InputStride,
+    ElementType* Output,
+    size_t OutputStride,
+    size_t CountM,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a block of the input matrix using scalar moves.
+
+Arguments:
+
+    Input - Supplies the first element of the block in the input matrix.
+
+    InputStride - Supplies the number of elements between rows of the input.
+
+    Output - Supplies the first element of the block in the output matrix.
+
+    OutputStride - Supplies the number of elements between rows of the output.
+
+    CountM - Supplies the number of input rows in the block.
+
+    CountN - Supplies the number of input columns in the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t m = 0; m < CountM; m++) {
+
+        const ElementType* s = Input + m * InputStride;
+        ElementType* d = Output + m;
+
+        for (size_t n = 0; n < CountN; n++) {
+            d[n * OutputStride] = s[n];
+        }
+    }
+}
+
+template<typename ElementType>
+void
+MlasTransposeStrip(
+    const ElementType* Input,
+    ElementType* Output,
+    size_t M,
+    size_t N,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a strip of columns of the input matrix, which is
+    a strip of rows of the output matrix.
+
+Arguments:
+
+    Input - Supplies the first element of the strip in the input matrix.
+
+    Output - Supplies the first element of the strip in the output matrix.
+
+    M - Supplies the number of rows of the input matrix.
+
+    N - Supplies the number of columns of the input matrix.
+
+    CountN - Supplies the number of columns in the strip.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasTransposeStripGeneric(Input, N, Output, M, M, CountN);
+}
+
+#if defined(MLAS_NEON_INTRINSICS) || defined(MLAS_SSE2_INTRINSICS)
+
+inline
+void
+MlasTranspose4x4Block(
+    const float* Input,
+    size_t InputStride,
+    float* Output,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a 4x4 block of 32-bit elements.
+
+Arguments:
+
+    Input - Supplies the input block.
+
+    InputStride - Supplies the number of elements between rows of the input.
+
+    Output - Supplies the output block.
+
+    OutputStride - Supplies the number of elements between rows of the output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 a0 = MlasLoadFloat32x4(&Input[InputStride * 0]);
+    MLAS_FLOAT32X4 a1 = MlasLoadFloat32x4(&Input[InputStride * 1]);
+    MLAS_FLOAT32X4 a2 = MlasLoadFloat32x4(&Input[InputStride * 2]);
+    MLAS_FLOAT32X4 a3 = MlasLoadFloat32x4(&Input[InputStride * 3]);
+
+#if defined(MLAS_NEON_INTRINSICS)
+    float32x4x2_t t01 = vtrnq_f32(a0, a1);
+    float32x4x2_t t23 = vtrnq_f32(a2, a3);
+
+    MLAS_FLOAT32X4 b0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    MLAS_FLOAT32X4 b1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    MLAS_FLOAT32X4 b2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    MLAS_FLOAT32X4 b3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    MLAS_FLOAT32X4 b0 = a0;
+    MLAS_FLOAT32X4 b1 = a1;
+    MLAS_FLOAT32X4 b2 = a2;
+    MLAS_FLOAT32X4 b3 = a3;
+
+    _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+#endif
+
+    MlasStoreFloat32x4(&Output[OutputStride * 0], b0);
+    MlasStoreFloat32x4(&Output[OutputStride * 1], b1);
+    MlasStoreFloat32x4(&Output[OutputStride * 2], b2);
+    MlasStoreFloat32x4(&Output[OutputStride * 3], b3);
+}
+
+template<>
+void
+MlasTransposeStrip<float>(
+    const float* Input,
+    float* Output,
+    size_t M,
+    size_t N,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a strip of columns of the input matrix using 4x4
+    vector blocks.
+
+Arguments:
+
+    Input - Supplies the first element of the strip in the input matrix.
+
+    Output - Supplies the first element of the strip in the output matrix.
+
+    M - Supplies the number of rows of the input matrix.
+
+    N - Supplies the number of columns of the input matrix.
+
+    CountN - Supplies the number of columns in the strip.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t m = 0;
+
+    while (m + 4 <= M) {
+
+        const float* s = Input + m * N;
+        float* d = Output + m;
+        size_t n = 0;
+
+        while (n + 4 <= CountN) {
+            MlasTranspose4x4Block(s + n, N, d + n * M, M);
+            n += 4;
+        }
+
+        while (n < CountN) {
+            d[n * M + 0] = s[n + N * 0];
+            d[n * M + 1] = s[n + N * 1];
+            d[n * M + 2] = s[n + N * 2];
+            d[n * M + 3] = s[n + N * 3];
+            n += 1;
+        }
+
+        m += 4;
+    }
+
+    if (m < M) {
+        MlasTransposeStripGeneric(Input + m * N, N, Output + m, M, M - m, CountN);
+    }
+}
+
+#endif
+
+template<typename ElementType>
+void
+MlasTransposeOperation(
+    const ElementType* Input,
+    ElementType* Output,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the input matrix on the current thread.
+
+Arguments:
+
+    Input - Supplies the input matrix.
+
+    Output - Supplies the output matrix.
+
+    M - Supplies the number of rows of the input matrix and the number of
+        columns of the output matrix.
+
+    N - Supplies the number of columns of the input matrix and the number of
+        rows of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < N; n += MLAS_TRANSPOSE_STRIP_ROWS) {
+
+        size_t CountN = (std::min)(N - n, size_t(MLAS_TRANSPOSE_STRIP_ROWS));
+
+        MlasTransposeStrip(Input + n, Output + n * M, M, N, CountN);
+    }
+}
+
+template<typename ElementType>
+void
+MlasTransposeThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    transpose operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_TRANSPOSE_WORK_BLOCK* WorkBlock = (MLAS_TRANSPOSE_WORK_BLOCK*)Context;
+
+    const size_t N = WorkBlock->N;
+    const size_t n = WorkBlock->StrideN * Index;
+
+    if (n < N) {
+
+        const size_t M = WorkBlock->M;
+        const size_t CountN = (std::min)(N - n, WorkBlock->StrideN);
+
+        const ElementType* Input = (const ElementType*)WorkBlock->Input;
+        ElementType* Output = (ElementType*)WorkBlock->Output;
+
+        for (size_t nn = 0; nn < CountN; nn += MLAS_TRANSPOSE_STRIP_ROWS) {
+
+            size_t CountStripN = (std::min)(CountN - nn, size_t(MLAS_TRANSPOSE_STRIP_ROWS));
+
+            MlasTransposeStrip(Input + n + nn, Output + (n + nn) * M, M, N, CountStripN);
+        }
+    }
+}
+
+template<typename ElementType>
+void
+MlasTransposeDispatch(
+    const ElementType* Input,
+    ElementType* Output,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the input matrix, splitting the rows of the output
+    matrix across threads for large operations.
+
+Arguments:
+
+    Input - Supplies the input matrix.
+
+    Output - Supplies the output matrix.
+
+    M - Supplies the number of rows of the input matrix.
+
+    N - Supplies the number of columns of the input matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t Elements = M * N;
+
+    int32_t TargetThreadCount;
+
+    if (Elements < size_t(MLAS_TRANSPOSE_THREAD_ELEMENTS) * MLAS_MAXIMUM_THREAD_COUNT) {
+        TargetThreadCount = int32_t(Elements / MLAS_TRANSPOSE_THREAD_ELEMENTS) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (TargetThreadCount == 1 || N < 8) {
+        MlasTransposeOperation(Input, Output, M, N);
+        return;
+    }
+
+    //
+    // Segment the output rows across the threads, keeping each segment a
+    // multiple of the vector block size.
+    //
+
+    size_t StrideN = (N + TargetThreadCount - 1) / TargetThreadCount;
+    StrideN = (StrideN + 3) & ~size_t(3);
+
+    MLAS_TRANSPOSE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.StrideN = StrideN;
+
+    MlasExecuteThreaded(MlasTransposeThreaded<ElementType>, &WorkBlock, int32_t((N + StrideN - 1) / StrideN));
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    uint8_t* Output,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the input matrix of M rows and N columns to the
+    output matrix of N rows and M columns.
+
+Arguments:
+
+    Input - Supplies the input matrix.
+
+    Output - Supplies the output matrix.
+
+    M - Supplies the number of rows of the input matrix.
+
+    N - Supplies the number of columns of the input matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasTransposeDispatch(Input, Output, M, N);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    uint16_t* Output,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTransposeDispatch(Input, Output, M, N);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const float* Input,
+    float* Output,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTransposeDispatch(Input, Output, M, N);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    uint32_t* Output,
+    size_t M,
+    size_t N
+    )
+{
+    //
+    // The elements are only moved, so reuse the single precision routine.
+    //
+
+    MlasTransposeDispatch(reinterpret_cast<const float*>(Input), reinterpret_cast<float*>(Output), M, N);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    uint64_t* Output,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTransposeDispatch(Input, Output, M, N);
+}
@@ -455,7 +455,67 @@ class Initializer final {
     }
   }
 
+  // Permute the data in place following Transpose semantics (output dim k is input dim perm[k]).
+  // If perm has a higher rank than the initializer, the dims are first left-padded with 1s as in
+  // numpy broadcasting, so the result can be used as a broadcast operand of the permuted tensor.
+  Initializer& transpose(const std::vector<int64_t>& perm) {
+    ORT_ENFORCE(perm.size() >= dims_.size(), "perm has lower rank than the initializer");
+    dims_.insert(dims_.begin(), perm.size() - dims_.size(), 1);
+
+    switch (data_type_) {
+      case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16: {
+        transpose_data<uint16_t>(perm);
+        break;
+      }
+      case ONNX_NAMESPACE::TensorProto_DataType_FLOAT: {
+        transpose_data<float>(perm);
+        break;
+      }
+      case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE: {
+        transpose_data<double>(perm);
+        break;
+      }
+      default:
+        ORT_NOT_IMPLEMENTED(__FUNCTION__, "data type is not supported");
+        break;
+    }
+
+    std::vector<int64_t> new_dims(perm.size());
+    for (size_t k = 0; k < perm.size(); k++) {
+      new_dims[k] = dims_[perm[k]];
+    }
+    dims_ = std::move(new_dims);
+    return *this;
+  }
+
  private:
+  template <typename T>
+  void transpose_data(const std::vector<int64_t>& perm) {
+    const size_t rank = perm.size();
+    std::vector<int64_t> input_strides(rank, 1);
+    for (size_t k = rank; k-- > 1;) {
+      input_strides[k - 1] = input_strides[k] * dims_[k];
+    }
+
+    // walk the output in order and track the matching input offset with a mixed-radix counter
+    std::vector<int64_t> counter(rank, 0);
+    T* dst = data<T>();
+    std::vector<T> src(dst, dst + size_);
+    int64_t src_offset = 0;
+    for (int64_t i = 0; i < size_; i++) {
+      dst[i] = src[src_offset];
+      for (size_t k = rank; k-- > 0;) {
+        const int64_t axis = perm[k];
+        src_offset += input_strides[axis];
+        if (++counter[k] < dims_[axis]) {
+          break;
+        }
+        src_offset -= input_strides[axis] * dims_[axis];
+        counter[k] = 0;
+      }
+    }
+  }
+
   int data_type_;
   std::string name_;
   std::vector<int64_t> dims_;
@@ -0,0 +1,427 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/transpose_optimizer.h"
+
+#include <unordered_set>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// Element-wise ops with a single input. The output has the layout of the input so a Transpose can be applied
+// after the op instead of before it.
+const std::unordered_set<std::string> kUnaryLayoutAgnosticOps = {
+    "Abs", "Ceil", "Cast", "Clip", "Elu", "Erf", "Exp", "Floor", "HardSigmoid", "Identity", "IsNaN",
+    "LeakyRelu", "Log", "Neg", "Not", "Reciprocal", "Relu", "Selu", "Shrink", "Sigmoid", "Sign",
+    "Softplus", "Softsign", "Sqrt", "Tanh", "ThresholdedRelu"};
+
+// Element-wise ops with two broadcastable inputs.
+const std::unordered_set<std::string> kBinaryLayoutAgnosticOps = {
+    "Add", "And", "Div", "Equal", "Greater", "Less", "Max", "Mean", "Min", "Mul", "Or", "Pow", "Sub",
+    "Sum", "Xor"};
+
+struct EdgeInfo {
+  NodeIndex node;
+  int src_slot;
+  int dst_slot;
+};
+
+bool IsOnnxDomain(const Node& node) {
+  return node.Domain() == kOnnxDomain || node.Domain() == kOnnxDomainAlias;
+}
+
+bool IsTranspose(const Node& node) {
+  return node.OpType() == "Transpose" && IsOnnxDomain(node);
+}
+
+// Get the permutation of a Transpose node. When the attribute is missing the default (reversed axes)
+// is returned, which requires the rank of the input to be known.
+bool GetPermutation(const Node& transpose, std::vector<int64_t>& perm) {
+  if (utils::GetRepeatedNodeAttributeValues(transpose, "perm", perm) && !perm.empty()) {
+    return true;
+  }
+
+  const auto* shape = transpose.InputDefs()[0]->Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+
+  const int64_t rank = shape->dim_size();
+  perm.resize(rank);
+  for (int64_t i = 0; i < rank; i++) {
+    perm[i] = rank - 1 - i;
+  }
+  return true;
+}
+
+bool IsIdentityPermutation(const std::vector<int64_t>& perm) {
+  for (size_t i = 0; i < perm.size(); i++) {
+    if (perm[i] != static_cast<int64_t>(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<int64_t> InversePermutation(const std::vector<int64_t>& perm) {
+  std::vector<int64_t> inverse(perm.size());
+  for (size_t i = 0; i < perm.size(); i++) {
+    inverse[perm[i]] = static_cast<int64_t>(i);
+  }
+  return inverse;
+}
+
+bool GetInputEdge(const Node& node, int dst_slot, EdgeInfo& edge) {
+  for (auto it = node.InputEdgesBegin(); it != node.InputEdgesEnd(); ++it) {
+    if (it->GetDstArgIndex() == dst_slot) {
+      edge = EdgeInfo{it->GetNode().Index(), it->GetSrcArgIndex(), dst_slot};
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<EdgeInfo> GetOutputEdges(const Node& node) {
+  std::vector<EdgeInfo> edges;
+  for (auto it = node.OutputEdgesBegin(); it != node.OutputEdgesEnd(); ++it) {
+    edges.push_back(EdgeInfo{it->GetNode().Index(), it->GetSrcArgIndex(), it->GetDstArgIndex()});
+  }
+  return edges;
+}
+
+void RemoveOutputEdges(Graph& graph, const Node& node, const std::vector<EdgeInfo>& edges) {
+  for (const auto& edge : edges) {
+    graph.RemoveEdge(node.Index(), edge.node, edge.src_slot, edge.dst_slot);
+  }
+}
+
+// Check that no output of the node is consumed implicitly by a subgraph.
+bool AllConsumersExplicit(const Node& node) {
+  for (auto it = node.OutputEdgesBegin(); it != node.OutputEdgesEnd(); ++it) {
+    if (it->GetDstArgIndex() >= static_cast<int>(it->GetNode().InputDefs().size())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Check that the output of the node is consumed by exactly one explicit input of one node,
+// so the node can be moved or removed without affecting anything else.
+bool HasSingleConsumer(Graph& graph, Node& node) {
+  return node.GetOutputEdgesCount() == 1 && !graph.IsNodeOutputsInGraphOutputs(node) && AllConsumersExplicit(node);
+}
+
+// Transpose(initializer) -> initializer holding the permuted data.
+bool FoldIntoInitializer(Graph& graph, Node& transpose, const std::vector<int64_t>& perm) {
+  const NodeArg* input_def = transpose.InputDefs()[0];
+  const TensorProto* tensor_proto = nullptr;
+  if (!graph.GetInitializedTensor(input_def->Name(), tensor_proto) ||
+      !Initializer::IsSupportedDataType(tensor_proto) ||
+      tensor_proto->dims_size() != static_cast<int>(perm.size()) ||
+      graph.IsNodeOutputsInGraphOutputs(transpose) ||
+      !AllConsumersExplicit(transpose)) {
+    return false;
+  }
+
+  Initializer initializer{tensor_proto};
+  initializer.transpose(perm);
+
+  // the permuted data takes over the name of the Transpose output so the consumers are left untouched
+  TensorProto new_tensor_proto(*tensor_proto);
+  initializer.ToProto(&new_tensor_proto);
+  new_tensor_proto.set_name(transpose.OutputDefs()[0]->Name());
+
+  RemoveOutputEdges(graph, transpose, GetOutputEdges(transpose));
+  graph.RemoveNode(transpose.Index());
+  graph.AddInitializedTensor(new_tensor_proto);
+
+  return true;
+}
+
+// Transpose(perm1) -> Transpose(perm2) becomes a single Transpose, or nothing if the permutations cancel out.
+bool MergeWithNextTranspose(Graph& graph, Node& first, const std::vector<int64_t>& first_perm) {
+  if (!HasSingleConsumer(graph, first)) {
+    return false;
+  }
+
+  Node& second = *graph.GetNode((*first.OutputNodesBegin()).Index());
+  std::vector<int64_t> second_perm;
+  if (!IsTranspose(second) || !GetPermutation(second, second_perm) || second_perm.size() != first_perm.size()) {
+    return false;
+  }
+
+  std::vector<int64_t> perm(first_perm.size());
+  for (size_t i = 0; i < perm.size(); i++) {
+    perm[i] = first_perm[second_perm[i]];
+  }
+
+  EdgeInfo producer;
+  const bool has_producer = GetInputEdge(first, 0, producer);
+  NodeArg* input_def = first.MutableInputDefs()[0];
+
+  if (!IsIdentityPermutation(perm)) {
+    graph.RemoveEdge(first.Index(), second.Index(), 0, 0);
+    graph.RemoveNode(first.Index());
+
+    second.MutableInputDefs()[0] = input_def;
+    if (has_producer) {
+      graph.AddEdge(producer.node, second.Index(), producer.src_slot, 0);
+    }
+    second.AddAttribute("perm", perm);
+    return true;
+  }
+
+  if (!AllConsumersExplicit(second)) {
+    return false;
+  }
+
+  const auto consumers = GetOutputEdges(second);
+
+  if (graph.IsNodeOutputsInGraphOutputs(second)) {
+    // The graph output has to keep its name, so the producer of the original input is made to produce it.
+    if (!has_producer) {
+      return false;
+    }
+
+    Node& producer_node = *graph.GetNode(producer.node);
+    if (producer_node.GetOutputEdgesCount() != 1 || graph.IsNodeOutputsInGraphOutputs(producer_node)) {
+      return false;
+    }
+
+    NodeArg* output_def = second.MutableOutputDefs()[0];
+    RemoveOutputEdges(graph, second, consumers);
+    graph.RemoveEdge(first.Index(), second.Index(), 0, 0);
+    graph.RemoveNode(second.Index());
+    graph.RemoveNode(first.Index());
+
+    producer_node.MutableOutputDefs()[producer.src_slot] = output_def;
+    for (const auto& consumer : consumers) {
+      graph.AddEdge(producer.node, consumer.node, producer.src_slot, consumer.dst_slot);
+    }
+    return true;
+  }
+
+  RemoveOutputEdges(graph, second, consumers);
+  graph.RemoveEdge(first.Index(), second.Index(), 0, 0);
+  graph.RemoveNode(second.Index());
+  graph.RemoveNode(first.Index());
+
+  for (const auto& consumer : consumers) {
+    graph.GetNode(consumer.node)->MutableInputDefs()[consumer.dst_slot] = input_def;
+    if (has_producer) {
+      graph.AddEdge(producer.node, consumer.node, producer.src_slot, consumer.dst_slot);
+    }
+  }
+  return true;
+}
+
+// Find the Transpose producing the given input of a node, if it has the same permutation and no other consumer.
+Node* GetMatchingTranspose(Graph& graph, const Node& node, int slot, const std::vector<int64_t>& perm) {
+  EdgeInfo edge;
+  if (!GetInputEdge(node, slot, edge)) {
+    return nullptr;
+  }
+
+  Node* transpose = graph.GetNode(edge.node);
+  std::vector<int64_t> transpose_perm;
+  if (!IsTranspose(*transpose) || !HasSingleConsumer(graph, *transpose) ||
+      !GetPermutation(*transpose, transpose_perm) || transpose_perm != perm) {
+    return nullptr;
+  }
+  return transpose;
+}
+
+// Transpose -> layout agnostic op becomes layout agnostic op -> Transpose. Other inputs of the op must be
+// Transposes with the same permutation, which are removed, or constant initializers, which are permuted with
+// the inverse permutation.
+bool SinkBelowConsumer(Graph& graph, Node& transpose, const std::vector<int64_t>& perm) {
+  if (!HasSingleConsumer(graph, transpose)) {
+    return false;
+  }
+
+  const Node::EdgeEnd& edge = *transpose.OutputEdgesBegin();
+  Node& consumer = *graph.GetNode(edge.GetNode().Index());
+  if (!IsOnnxDomain(consumer) || consumer.OutputDefs().size() != 1 ||
+      consumer.OutputDefs()[0]->TypeAsProto() == nullptr) {
+    return false;
+  }
+
+  const std::string& op_type = consumer.OpType();
+  const int num_inputs = static_cast<int>(consumer.InputDefs().size());
+  const int64_t rank = static_cast<int64_t>(perm.size());
+
+  // input slot -> Transpose feeding it
+  std::vector<std::pair<int, Node*>> transposed_inputs;
+  // input slot -> constant initializer feeding it
+  std::vector<std::pair<int, const TensorProto*>> constant_inputs;
+
+  if (kUnaryLayoutAgnosticOps.count(op_type) != 0) {
+    if (num_inputs != 1) {
+      return false;
+    }
+    transposed_inputs.emplace_back(0, &transpose);
+  } else if (kBinaryLayoutAgnosticOps.count(op_type) != 0 || op_type == "Concat") {
+    if (op_type != "Concat" && num_inputs != 2) {
+      return false;
+    }
+
+    for (int i = 0; i < num_inputs; i++) {
+      if (i == edge.GetDstArgIndex()) {
+        transposed_inputs.emplace_back(i, &transpose);
+        continue;
+      }
+
+      Node* other = GetMatchingTranspose(graph, consumer, i, perm);
+      if (other != nullptr && other != &transpose) {
+        transposed_inputs.emplace_back(i, other);
+        continue;
+      }
+
+      const TensorProto* tensor_proto = nullptr;
+      if (op_type != "Concat" &&
+          graph.GetInitializedTensor(consumer.InputDefs()[i]->Name(), tensor_proto) &&
+          Initializer::IsSupportedDataType(tensor_proto) &&
+          tensor_proto->dims_size() <= rank) {
+        constant_inputs.emplace_back(i, tensor_proto);
+        continue;
+      }
+
+      return false;
+    }
+  } else {
+    return false;
+  }
+
+  int64_t concat_axis = 0;
+  if (op_type == "Concat") {
+    const auto* axis_attr = utils::GetNodeAttribute(consumer, "axis");
+    if (axis_attr == nullptr) {
+      return false;
+    }
+    concat_axis = axis_attr->i() < 0 ? axis_attr->i() + rank : axis_attr->i();
+    if (concat_axis < 0 || concat_axis >= rank) {
+      return false;
+    }
+  }
+
+  // Move the op above the Transposes.
+  NodeArg* output_def = consumer.MutableOutputDefs()[0];
+  const auto consumers = GetOutputEdges(consumer);
+  RemoveOutputEdges(graph, consumer, consumers);
+
+  for (auto& entry : transposed_inputs) {
+    Node& input_transpose = *entry.second;
+    EdgeInfo producer;
+    const bool has_producer = GetInputEdge(input_transpose, 0, producer);
+
+    graph.RemoveEdge(input_transpose.Index(), consumer.Index(), 0, entry.first);
+    if (has_producer) {
+      graph.RemoveEdge(producer.node, input_transpose.Index(), producer.src_slot, 0);
+    }
+
+    consumer.MutableInputDefs()[entry.first] = input_transpose.MutableInputDefs()[0];
+    if (has_producer) {
+      graph.AddEdge(producer.node, consumer.Index(), producer.src_slot, entry.first);
+    }
+
+    if (&input_transpose != &transpose) {
+      graph.RemoveNode(input_transpose.Index());
+    }
+  }
+
+  const std::vector<int64_t> inverse_perm = InversePermutation(perm);
+  for (auto& entry : constant_inputs) {
+    const TensorProto& tensor_proto = *entry.second;
+    Initializer initializer{&tensor_proto};
+    if (initializer.size() == 1) {
+      // a single value broadcasts the same way in any layout
+      continue;
+    }
+
+    initializer.transpose(inverse_perm);
+
+    TensorProto new_tensor_proto(tensor_proto);
+    initializer.ToProto(&new_tensor_proto);
+    new_tensor_proto.set_name(graph.GenerateNodeArgName(tensor_proto.name() + "_transposed"));
+
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(tensor_proto.data_type());
+    for (auto dim : initializer.dims()) {
+      type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+
+    NodeArg& new_input_def = graph.GetOrCreateNodeArg(new_tensor_proto.name(), &type);
+    graph.AddInitializedTensor(new_tensor_proto);
+    consumer.MutableInputDefs()[entry.first] = &new_input_def;
+  }
+
+  if (op_type == "Concat") {
+    consumer.AddAttribute("axis", perm[concat_axis]);
+  }
+
+  // The op now produces a tensor in the original layout, and the Transpose produces the original output.
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(output_def->TypeAsProto()->tensor_type().elem_type());
+  NodeArg& sunk_def = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(output_def->Name()), &type);
+
+  consumer.MutableOutputDefs()[0] = &sunk_def;
+  transpose.MutableInputDefs()[0] = &sunk_def;
+  graph.AddEdge(consumer.Index(), transpose.Index(), 0, 0);
+
+  transpose.MutableOutputDefs()[0] = output_def;
+  for (const auto& next : consumers) {
+    graph.AddEdge(transpose.Index(), next.node, 0, next.dst_slot);
+  }
+
+  // the input rank is no longer known until the graph is resolved again, so make the permutation explicit
+  transpose.AddAttribute("perm", perm);
+
+  return true;
+}
+
+}  // namespace
+
+Status TransposeOptimizer::ApplyImpl(onnxruntime::Graph& graph, bool& modified, int graph_level) const {
+  for (auto& node : graph.Nodes()) {
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level));
+  }
+
+  // Every rewrite either removes a Transpose or moves one below another node, so this terminates.
+  bool changed = true;
+  while (changed) {
+    changed = false;
+
+    std::vector<NodeIndex> transposes;
+    for (auto& node : graph.Nodes()) {
+      if (IsTranspose(node)) {
+        transposes.push_back(node.Index());
+      }
+    }
+
+    for (auto index : transposes) {
+      Node* node = graph.GetNode(index);
+      std::vector<int64_t> perm;
+      if (node == nullptr || !GetPermutation(*node, perm)) {
+        continue;
+      }
+
+      if (FoldIntoInitializer(graph, *node, perm) ||
+          MergeWithNextTranspose(graph, *node, perm) ||
+          SinkBelowConsumer(graph, *node, perm)) {
+        changed = true;
+      }
+    }
+
+    modified = modified || changed;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
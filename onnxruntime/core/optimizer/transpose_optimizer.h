@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class TransposeOptimizer
+
+Removes layout permutations from the graph. Transpose nodes are
+  - folded into constant initializers they consume,
+  - pushed below layout agnostic nodes (unary and binary element-wise ops, Concat) so they meet each other,
+  - merged with a following Transpose, and dropped entirely if the two permutations cancel out.
+Models converted from NHWC frameworks typically wrap every layout sensitive node in a pair of Transposes,
+most of which disappear after this pass.
+*/
+class TransposeOptimizer : public onnxruntime::GraphTransformer {
+ public:
+  TransposeOptimizer() noexcept
+      : onnxruntime::GraphTransformer("TransposeOptimizer", "Fold, sink and cancel Transpose nodes") {}
+
+ private:
+  Status ApplyImpl(onnxruntime::Graph& graph, bool& modified, int graph_level) const override;
+};
+
+}  // namespace onnxruntime
@@ -12,6 +12,7 @@
 #include "core/providers/cpu/controlflow/loop.h"
 #include "core/providers/cpu/controlflow/utils.h"
 
+#include "core/framework/execution_frame.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/sequential_executor.h"
@@ -325,6 +326,9 @@ Status LoopImpl::Execute(FeedsFetchesManager* ffm, const FeedsFetchesManager* ca
   std::vector<MLValue> feeds;
   std::vector<MLValue> fetches;
 
+  // one frame is reset and reused for all iterations after the first
+  std::unique_ptr<ExecutionFrame> frame;
+
   CreateInitialFeeds(feeds);
 
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
@@ -339,9 +343,8 @@ Status LoopImpl::Execute(FeedsFetchesManager* ffm, const FeedsFetchesManager* ca
     // there will be to allocate loop outputs upfront. due to that we can't use a custom fetch allocator
     // for any outputs
     if (cached_ffm) {
-      status = utils::ExecuteGraphWithCachedInfo(session_state_, *cached_ffm, feeds, fetches, {},
-                                                 /*sequential_execution*/ true, context_.GetTerminateFlag(),
-                                                 context_.Logger());
+      status = utils::ExecuteSubgraphWithCachedInfo(session_state_, *cached_ffm, feeds, fetches, frame,
+                                                    context_.GetTerminateFlag(), context_.Logger());
     } else {
       status = utils::ExecuteGraph(session_state_, *ffm, feeds, fetches, {},
                                    /*sequential_execution*/ true, context_.GetTerminateFlag(), context_.Logger(),
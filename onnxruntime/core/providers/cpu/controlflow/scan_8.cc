@@ -13,6 +13,7 @@
 #include "core/providers/cpu/controlflow/utils.h"
 
 #include "core/framework/framework_common.h"
+#include "core/framework/intra_op_parallel.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
@@ -108,6 +109,11 @@ class Scan8Impl {
   Status AllocateOutputTensors();
   Status CreateLoopStateVariables(std::vector<std::vector<LoopStateVariable>>& loop_state_variables);
 
+  // iterate the sequence of a single batch entry, writing the scan outputs via output_iterators
+  Status ExecuteBatchEntry(int64_t b, std::vector<LoopStateVariable>& loop_state_variables,
+                           std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
+                           FeedsFetchesManager* ffm, const FeedsFetchesManager* cached_ffm);
+
   using ConstTensorSlicerIterators = std::vector<MLValueTensorSlicer<const MLValue>::Iterator>;
   using MutableTensorSlicerIterators = std::vector<MLValueTensorSlicer<MLValue>::Iterator>;
 
@@ -153,10 +159,6 @@ Status Scan<8>::Compute(OpKernelContext* ctx) const {
   auto* session_state = ctx_internal->SubgraphSessionState("body");
   ORT_ENFORCE(session_state, "Subgraph SessionState was not found for 'body' attribute.");
 
-  // TODO:
-  //       Consider how usage of ExecutionFrame and SequentialExecutor can be optimized
-  //         - initial implementation is focused on making it work, rather than optimizing.
-
   Scan8Impl scan_impl{*ctx_internal, *session_state, num_scan_inputs_, input_directions_};
 
   auto status = scan_impl.Initialize();
@@ -386,6 +388,50 @@ Status Scan8Impl::CreateFeedsFetchesManager(std::unique_ptr<FeedsFetchesManager>
                                                  ffm);
 }
 
+Status Scan8Impl::ExecuteBatchEntry(int64_t b, std::vector<LoopStateVariable>& loop_state_variables,
+                                    std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
+                                    FeedsFetchesManager* ffm, const FeedsFetchesManager* cached_ffm) {
+  auto sequence_len = sequence_lens_[b];
+
+  // Setup input MLValue streams
+  std::vector<MLValueTensorSlicer<const MLValue>::Iterator> scan_input_stream_iterators;
+  scan_input_stream_iterators.reserve(num_variadic_inputs_ - num_loop_state_variables_);
+
+  for (int i = num_loop_state_variables_, end = num_variadic_inputs_; i < end; ++i) {
+    const auto& mlvalue = GetSubgraphInputMLValue(context_, i);
+
+    // forward
+    if (directions_[i - num_loop_state_variables_] == static_cast<int64_t>(ScanDirection::kForward)) {
+      // the iterator is self contained, so we don't need to keep the MLValueTensorSlicer instance around
+      scan_input_stream_iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).begin());
+    } else {  // reverse
+      scan_input_stream_iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).rbegin());
+      // need to skip past the empty entries at the end of the input if sequence length is short
+      auto offset = max_sequence_len_ - sequence_len;
+      if (offset > 0) {
+        // reverse iterator so += moves backwards through the input
+        scan_input_stream_iterators.back() += offset;
+      }
+    }
+  }
+
+  // Call the subgraph for each item in the sequence
+  auto status = IterateSequence(context_, session_state_, loop_state_variables, scan_input_stream_iterators,
+                                sequence_len, num_loop_state_variables_, num_variadic_inputs_, num_variadic_outputs_,
+                                implicit_inputs_, output_iterators, ffm, cached_ffm);
+
+  // zero out any remaining values in the sequence
+  for (int64_t i = sequence_len; i < max_sequence_len_; ++i) {
+    for (int output = num_loop_state_variables_; output < num_variadic_outputs_; ++output) {
+      auto& iterator = *output_iterators[output];
+      iterator.ZeroOutCurrent();
+      ++iterator;
+    }
+  }
+
+  return status;
+}
+
 Status Scan8Impl::Execute(FeedsFetchesManager* ffm, const FeedsFetchesManager* cached_ffm) {
   Status status = Status::OK();
 
@@ -394,50 +440,62 @@ Status Scan8Impl::Execute(FeedsFetchesManager* ffm, const FeedsFetchesManager* c
   status = CreateLoopStateVariables(batch_loop_state_variables);
   ORT_RETURN_IF_ERROR(status);
 
-  for (int64_t b = 0; b < batch_size_; ++b) {
-    auto sequence_len = sequence_lens_[b];
-
-    // Setup input MLValue streams
-    std::vector<MLValueTensorSlicer<const MLValue>::Iterator> scan_input_stream_iterators;
-    scan_input_stream_iterators.reserve(num_variadic_inputs_ - num_loop_state_variables_);
-
-    for (int i = num_loop_state_variables_, end = num_variadic_inputs_; i < end; ++i) {
-      const auto& mlvalue = GetSubgraphInputMLValue(context_, i);
-
-      // forward
-      if (directions_[i - num_loop_state_variables_] == static_cast<int64_t>(ScanDirection::kForward)) {
-        // the iterator is self contained, so we don't need to keep the MLValueTensorSlicer instance around
-        scan_input_stream_iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).begin());
-      } else {  // reverse
-        scan_input_stream_iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).rbegin());
-        // need to skip past the empty entries at the end of the input if sequence length is short
-        auto offset = max_sequence_len_ - sequence_len;
-        if (offset > 0) {
-          // reverse iterator so += moves backwards through the input
-          scan_input_stream_iterators.back() += offset;
-        }
-      }
-    }
+  if (batch_size_ == 0) {
+    return status;
+  }
 
-    // Call the subgraph for each item in the sequence
-    status = IterateSequence(context_, session_state_, batch_loop_state_variables[b], scan_input_stream_iterators,
-                             sequence_len, num_loop_state_variables_, num_variadic_inputs_, num_variadic_outputs_,
-                             implicit_inputs_, output_iterators_, ffm, cached_ffm);
+  // the first batch entry runs on its own. that allocates any outputs with a symbolic shape and caches the
+  // feeds/fetches info, so the remaining entries only read shared state.
+  status = ExecuteBatchEntry(0, batch_loop_state_variables[0], output_iterators_, ffm, cached_ffm);
+  ORT_RETURN_IF_ERROR(status);
 
-    // use the cached info from now on
+  // use the cached info from now on
+  if (ffm) {
     cached_ffm = ffm;
-    ffm = nullptr;
+  }
+
+  if (batch_size_ == 1) {
+    return status;
+  }
+
+  int num_threads;
+  auto& ttp = GetIntraOpThreadPool(context_, num_threads);
+
+  const int num_entries = gsl::narrow<int>(batch_size_ - 1);
+  if (num_threads == 1) {
+    for (int64_t b = 1; b < batch_size_; ++b) {
+      status = ExecuteBatchEntry(b, batch_loop_state_variables[b], output_iterators_, nullptr, cached_ffm);
+      ORT_RETURN_IF_ERROR(status);
+    }
 
-    // zero out any remaining values in the sequence
-    for (int64_t i = sequence_len; i < max_sequence_len_; ++i) {
+    return status;
+  }
+
+  // each batch entry reads its own slice of the inputs, writes its own slice of the outputs and runs the subgraph
+  // in its own execution frame, so the entries are independent and the results match the serial execution.
+  // the status of each entry is kept so the error reported is the one from the first failing entry in batch order.
+  std::vector<Status> entry_status(num_entries);
+  const int step = std::max(1, (num_entries + num_threads - 1) / num_threads);
+
+  auto execute_entries = [&](int first) {
+    const int last = std::min(first + step, num_entries);
+    for (int entry = first; entry < last; ++entry) {
+      const int64_t b = entry + 1;
+
+      std::vector<std::unique_ptr<OutputIterator>> output_iterators(num_variadic_outputs_);
       for (int output = num_loop_state_variables_; output < num_variadic_outputs_; ++output) {
-        auto& iterator = *output_iterators_[output];
-        iterator.ZeroOutCurrent();
-        ++iterator;
+        output_iterators[output] = output_iterators_[output]->CreateBatchEntryIterator(b);
       }
+
+      entry_status[entry] = ExecuteBatchEntry(b, batch_loop_state_variables[b], output_iterators,
+                                              nullptr, cached_ffm);
     }
+  };
 
-    ORT_RETURN_IF_ERROR(status);
+  ExecuteLambdaInParallel("Scan batch entries", execute_entries, num_entries, step, ttp, context_.Logger());
+
+  for (const auto& s : entry_status) {
+    ORT_RETURN_IF_ERROR(s);
   }
 
   return status;
@@ -13,6 +13,7 @@
 
 #include "gsl/gsl_algorithm"
 
+#include "core/framework/execution_frame.h"
 #include "core/framework/mldata_type_utils.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/sequential_executor.h"
@@ -153,6 +154,9 @@ Status IterateSequence(OpKernelContextInternal& context,
   std::vector<MLValue> fetches;
   std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
 
+  // once the outputs are allocated, one frame is reset and reused for all the remaining iterations
+  std::unique_ptr<ExecutionFrame> frame;
+
   feeds.resize(num_inputs);
   fetches.resize(num_variadic_outputs);
 
@@ -208,7 +212,10 @@ Status IterateSequence(OpKernelContextInternal& context,
     }
 
     // Create Executor and run graph.
-    if (cached_ffm) {
+    if (cached_ffm && fetch_allocators.empty()) {
+      status = utils::ExecuteSubgraphWithCachedInfo(session_state, *cached_ffm, feeds, fetches, frame,
+                                                    context.GetTerminateFlag(), context.Logger());
+    } else if (cached_ffm) {
       status = utils::ExecuteGraphWithCachedInfo(session_state, *cached_ffm, feeds, fetches, fetch_allocators,
                                                  /*sequential_execution*/ true, context.GetTerminateFlag(),
                                                  context.Logger());
@@ -486,6 +493,23 @@ Status OutputIterator::AllocateSubgraphOutput(const TensorShape& shape, MLValue&
   return Status::OK();
 }
 
+std::unique_ptr<OutputIterator> OutputIterator::CreateBatchEntryIterator(int64_t batch_entry) const {
+  ORT_ENFORCE(is_v8_ && !is_loop_state_var_, "Batch entry iterators are only supported for v8 scan outputs.");
+  ORT_ENFORCE(is_concrete_shape_, "Final output must be allocated before creating a batch entry iterator.");
+  ORT_ENFORCE(batch_entry >= 0 && batch_entry < static_cast<int64_t>(slicer_iterators_.size()),
+              "Invalid batch entry of ", batch_entry);
+
+  std::unique_ptr<OutputIterator> iterator{new OutputIterator(*this)};
+
+  // the slicer iterators are self contained so a copy of the one for the batch entry is all that is needed
+  iterator->slicer_iterators_ = {slicer_iterators_[batch_entry]};
+  iterator->cur_slicer_iterator_ = iterator->slicer_iterators_.begin();
+  iterator->num_iterations_ = final_shape_[1];
+  iterator->cur_iteration_ = 0;
+
+  return iterator;
+}
+
 MLValue& OutputIterator::operator*() {
   ORT_ENFORCE(cur_iteration_ < num_iterations_);
   ORT_ENFORCE(is_concrete_shape_,
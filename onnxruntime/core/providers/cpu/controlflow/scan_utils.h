@@ -111,6 +111,11 @@ class OutputIterator {
     return *final_output_mlvalue_;
   }
 
+  // create an iterator that only covers the sequence of one batch entry of a v8 scan output.
+  // the final output must already be allocated. the new iterator writes to the same buffer but is independent of
+  // this one, so the batch entries can be processed concurrently.
+  std::unique_ptr<OutputIterator> CreateBatchEntryIterator(int64_t batch_entry) const;
+
  private:
   OutputIterator(OpKernelContextInternal& context,
                  int output_index,
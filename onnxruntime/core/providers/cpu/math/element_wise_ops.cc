@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include <unsupported/Eigen/SpecialFunctions>
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -420,7 +421,7 @@ Status Exp<float>::Compute(OpKernelContext* ctx) const {
   auto& X = *ctx->Input<Tensor>(0);
   auto& Y = *ctx->Output(0, X.Shape());
 
-  EigenMap<float>(Y) = EigenMap<float>(X).array().exp();
+  MlasComputeExp(X.Data<float>(), Y.MutableData<float>(), static_cast<size_t>(X.Shape().Size()));
 
   return Status::OK();
 }
@@ -430,7 +431,7 @@ Status Log<float>::Compute(OpKernelContext* ctx) const {
   auto& X = *ctx->Input<Tensor>(0);
   auto& Y = *ctx->Output(0, X.Shape());
 
-  EigenMap<float>(Y) = EigenMap<float>(X).array().log();
+  MlasComputeLog(X.Data<float>(), Y.MutableData<float>(), static_cast<size_t>(X.Shape().Size()));
 
   return Status::OK();
 }
@@ -1036,7 +1037,7 @@ Status Erf<float>::Compute(OpKernelContext* context) const {
   ORT_ENFORCE(X_ptr != nullptr);
   auto& X = *X_ptr;
   auto& Y = *context->Output(0, X.Shape());
-  EigenMap<float>(Y) = EigenMap<float>(X).array().erf();
+  MlasComputeErf(X.Data<float>(), Y.MutableData<float>(), static_cast<size_t>(X.Shape().Size()));
 
   return Status::OK();
 }
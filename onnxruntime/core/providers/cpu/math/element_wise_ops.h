@@ -349,6 +349,20 @@ struct BroadcastIterator {
     return index;
   }
 
+  // Positions the iterator at the given element offset into the broadcast output.
+  // Every level k of the iterator adds deltas_[k] each time the product of the lower counts is passed,
+  // so the index is the sum of these contributions.
+  void Seek(size_t offset) {
+    index_ = 0;
+    size_t period = 1;
+    for (size_t counterIndex = 0; counterIndex < counts_.size(); counterIndex++) {
+      size_t steps = offset / period;
+      index_ += deltas_[counterIndex] * steps;
+      counters_[counterIndex] = steps % counts_[counterIndex];
+      period *= counts_[counterIndex];
+    }
+  }
+
   void Init(int64_t axis, int64_t largest) {
     ORT_ENFORCE(axis == 1 || axis == largest, "Attempting to broadcast an axis by a dimension other than 1. ", axis, " by ", largest);
 
@@ -504,6 +518,12 @@ struct TBroadcaster {
   ConstEigenVectorMap<T0> NextEigen0() { return ConstEigenVectorMap<T0>(Next0(), span_size_); }
   ConstEigenVectorMap<T1> NextEigen1() { return ConstEigenVectorMap<T1>(Next1(), span_size_); }
 
+  // Positions both inputs at the given offset into the output, which must be a multiple of the span size.
+  void Seek(size_t offset) {
+    broadcaster_.iterator1_.Seek(offset);
+    broadcaster_.iterator2_.Seek(offset);
+  }
+
  private:
   const T0* Next0() { return input0_ + broadcaster_.iterator1_.AdvanceBy(span_size_); }
   const T1* Next1() { return input1_ + broadcaster_.iterator2_.AdvanceBy(span_size_); }
@@ -525,6 +545,13 @@ struct TBroadcastOutput {
     output_end_ = output_ + tensor.Shape().Size();
   }
 
+  // Output limited to the elements [start_offset, end_offset) of the tensor.
+  TBroadcastOutput(size_t span_size, Tensor& tensor, int64_t start_offset, int64_t end_offset)
+      : span_size_(span_size) {
+    output_ = tensor.template MutableData<T>() + start_offset;
+    output_end_ = tensor.template MutableData<T>() + end_offset;
+  }
+
   operator bool() const {
     return output_ != output_end_;
   }
@@ -604,11 +631,47 @@ void BroadcastLoopSpan(TBroadcaster& bc, Output& output, Input0Scalar input0scal
   }
 }
 
+// Number of output elements handled by one unit of work in ParallelBroadcastLoop.
+constexpr int64_t kParallelBroadcastBlockSize = 16384;
+
+// Runs BroadcastLoop over the output tensor split into blocks of whole spans, so that large outputs can be
+// processed by several threads. Each block seeks a copy of the broadcaster to its first span. Small spans are
+// grouped so that a block covers roughly kParallelBroadcastBlockSize elements, and a span larger than that
+// is a block on its own.
+template <typename TOutput, typename TBroadcaster, typename Input0Scalar, typename Input1Scalar, typename General>
+void ParallelBroadcastLoop(TBroadcaster& bc, Tensor& output_tensor,
+                           Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
+  const int64_t output_size = output_tensor.Shape().Size();
+  const int64_t span_size = static_cast<int64_t>(bc.GetSpanSize());
+
+  const int64_t spans_per_block = span_size > 0 ? std::max<int64_t>(1, kParallelBroadcastBlockSize / span_size) : 1;
+  const int64_t block_size = spans_per_block * span_size;
+  const int64_t num_blocks = block_size > 0 ? (output_size + block_size - 1) / block_size : 0;
+
+  if (num_blocks <= 1) {
+    TBroadcastOutput<TOutput> output(bc.GetSpanSize(), output_tensor);
+    BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+    return;
+  }
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int64_t block = 0; block < num_blocks; ++block) {
+    const int64_t start_offset = block * block_size;
+    const int64_t end_offset = std::min(start_offset + block_size, output_size);
+
+    TBroadcaster block_bc(bc);
+    block_bc.Seek(static_cast<size_t>(start_offset));
+    TBroadcastOutput<TOutput> output(bc.GetSpanSize(), output_tensor, start_offset, end_offset);
+    BroadcastLoop(block_bc, output, input0scalar, input1scalar, general);
+  }
+}
+
 template <typename TInput, typename TOutput, typename Input0Scalar, typename Input1Scalar, typename General>
 Status BroadcastTwo(OpKernelContext& context, Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
   TBroadcaster<TInput, TInput> bc(*context.Input<Tensor>(0), *context.Input<Tensor>(1));
-  TBroadcastOutput<TOutput> output(bc.GetSpanSize(), *context.Output(0, bc.GetOutputShape()));
-  BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+  ParallelBroadcastLoop<TOutput>(bc, *context.Output(0, bc.GetOutputShape()), input0scalar, input1scalar, general);
 
   return Status::OK();
 }
@@ -645,9 +708,7 @@ Status BroadcastVariadic(const Node& node, OpKernelContext& context, Input0Scala
       p_output = tempOutput.get();
     }
 
-    TBroadcastOutput<TOutput> output(bc.GetSpanSize(), *p_output);
-
-    BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+    ParallelBroadcastLoop<TOutput>(bc, *p_output, input0scalar, input1scalar, general);
 
     tempInput = std::move(tempOutput);
   }
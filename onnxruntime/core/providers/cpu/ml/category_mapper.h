@@ -6,6 +6,7 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/ml/ml_common.h"
+#include "core/providers/cpu/ml/hash_index.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -13,36 +14,26 @@ namespace ml {
 class CategoryMapper final : public OpKernel {
  public:
   CategoryMapper(const OpKernelInfo& info) : OpKernel(info) {
-    std::vector<std::string> string_categories;
-    std::vector<int64_t> int_categories;
-
-    ORT_ENFORCE(info.GetAttrs<std::string>("cats_strings", string_categories).IsOK());
-    ORT_ENFORCE(info.GetAttrs<int64_t>("cats_int64s", int_categories).IsOK());
+    ORT_ENFORCE(info.GetAttrs<std::string>("cats_strings", string_categories_).IsOK());
+    ORT_ENFORCE(info.GetAttrs<int64_t>("cats_int64s", int_categories_).IsOK());
 
     ORT_ENFORCE(info.GetAttr<std::string>("default_string", &default_string_).IsOK());
     ORT_ENFORCE(info.GetAttr<int64_t>("default_int64", &default_int_).IsOK());
 
-    auto num_entries = string_categories.size();
-
-    ORT_ENFORCE(num_entries == int_categories.size());
-
-    string_to_int_map_.reserve(num_entries);
-    int_to_string_map_.reserve(num_entries);
-
-    for (size_t i = 0; i < num_entries; ++i) {
-      const std::string& str = string_categories[i];
-      int64_t index = int_categories[i];
+    ORT_ENFORCE(string_categories_.size() == int_categories_.size());
 
-      string_to_int_map_[str] = index;
-      int_to_string_map_[index] = str;
-    }
+    // when a category is repeated its last mapping is used
+    string_index_ = HashIndex<std::string>(string_categories_);
+    int_index_ = HashIndex<int64_t>(int_categories_);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
-  std::unordered_map<int64_t, std::string> int_to_string_map_;
+  std::vector<std::string> string_categories_;
+  std::vector<int64_t> int_categories_;
+  HashIndex<std::string> string_index_;
+  HashIndex<int64_t> int_index_;
 
   std::string default_string_;
   int64_t default_int_;
@@ -2,10 +2,12 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
 #include <string>
 #include <vector>
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/ml/hash_index.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -16,24 +18,26 @@ class DictVectorizerOp final : public OpKernel {
     //In some stupid models, the vocabulary could have duplicated elements.
     //We must support that, otherwise some tests will be break.
     ORT_ENFORCE(info.GetAttrs(std::is_same<AttrType, std::string>::value ? "string_vocabulary" : "int64_vocabulary", vocabulary_).IsOK());
+    vocabulary_index_ = HashIndex<AttrType>(vocabulary_);
   }
   common::Status Compute(OpKernelContext* ctx) const override {
     auto map = ctx->Input<std::map<AttrType, TargetType> >(0);
     auto Y = ctx->Output(0, TensorShape({1, static_cast<int64_t>(vocabulary_.size())}));
     auto* y_data = Y->template MutableData<TargetType>();
-    for (size_t i = 0, end = vocabulary_.size(); i < end; ++i) {
-      auto index = map->find(vocabulary_[i]);
-      if (index != map->end()) {
-        *y_data++ = index->second;
-      } else {
-        //Any keys not present in the input dictionary, will be zero in the output array
-        *y_data++ = TargetType();
+    //Any keys not present in the input dictionary, will be zero in the output array
+    std::fill_n(y_data, vocabulary_.size(), TargetType());
+    // look up the keys of the input, the cost does not depend on the size of the vocabulary
+    for (const auto& entry : *map) {
+      for (int64_t i = vocabulary_index_.FindFirst(entry.first); i != HashIndex<AttrType>::kNotFound;
+           i = vocabulary_index_.NextPosition(i)) {
+        y_data[i] = entry.second;
       }
     }
     return Status::OK();
   }
 
   std::vector<AttrType> vocabulary_;
+  HashIndex<AttrType> vocabulary_index_;
 };
 
 }  // namespace ml
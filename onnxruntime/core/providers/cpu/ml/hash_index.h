@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace ml {
+
+inline uint64_t HashIndexMix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+inline uint64_t HashIndexHash(int64_t key) {
+  return HashIndexMix(static_cast<uint64_t>(key));
+}
+
+inline uint64_t HashIndexHash(const char* data, size_t size) {
+  uint64_t h = 0x9e3779b97f4a7c15ULL ^ size;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t chunk;
+    memcpy(&chunk, data + i, 8);
+    h = (h ^ chunk) * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 29;
+  }
+  if (i < size) {
+    uint64_t chunk = 0;
+    memcpy(&chunk, data + i, size - i);
+    h = (h ^ chunk) * 0x9e3779b97f4a7c15ULL;
+  }
+  return HashIndexMix(h);
+}
+
+// Key storage of HashIndex. The int64 keys are kept as they are, the strings are interned in a single
+// character buffer so that a lookup compares the bytes of the query with a view of the stored key.
+template <typename TKey>
+class HashIndexKeys;
+
+template <>
+class HashIndexKeys<int64_t> {
+ public:
+  void Add(int64_t key) { keys_.push_back(key); }
+  static uint64_t Hash(int64_t key) { return HashIndexHash(key); }
+  bool Equals(size_t position, int64_t key) const { return keys_[position] == key; }
+
+ private:
+  std::vector<int64_t> keys_;
+};
+
+template <>
+class HashIndexKeys<std::string> {
+ public:
+  HashIndexKeys() : offsets_(1, 0) {}
+  void Add(const std::string& key) {
+    chars_.insert(chars_.end(), key.begin(), key.end());
+    offsets_.push_back(chars_.size());
+  }
+  static uint64_t Hash(const std::string& key) { return HashIndexHash(key.data(), key.size()); }
+  bool Equals(size_t position, const std::string& key) const {
+    const size_t begin = offsets_[position];
+    const size_t size = offsets_[position + 1] - begin;
+    return size == key.size() && (size == 0 || memcmp(chars_.data() + begin, key.data(), size) == 0);
+  }
+
+ private:
+  std::vector<char> chars_;
+  std::vector<size_t> offsets_;
+};
+
+/**
+Read-only open addressing hash table from the keys of an attribute to their positions in it, built once
+when the kernel is created. Duplicated keys are allowed: the first and the last position of each key are
+both available, and NextPosition walks through all of them.
+*/
+template <typename TKey>
+class HashIndex {
+ public:
+  static constexpr int64_t kNotFound = -1;
+
+  HashIndex() = default;
+
+  explicit HashIndex(const std::vector<TKey>& keys) {
+    ORT_ENFORCE(keys.size() < static_cast<size_t>(std::numeric_limits<int32_t>::max()), "Too many keys.");
+    // at most half full
+    size_t capacity = 16;
+    while (capacity < 2 * keys.size()) capacity *= 2;
+    mask_ = capacity - 1;
+    slots_.resize(capacity);
+    next_.assign(keys.size(), -1);
+
+    for (size_t position = 0; position < keys.size(); ++position) {
+      keys_.Add(keys[position]);
+      const uint64_t hash = HashIndexKeys<TKey>::Hash(keys[position]);
+      for (size_t s = hash & mask_;; s = (s + 1) & mask_) {
+        Slot& slot = slots_[s];
+        if (slot.first < 0) {
+          slot.hash = hash;
+          slot.first = slot.last = static_cast<int32_t>(position);
+          break;
+        }
+        if (slot.hash == hash && keys_.Equals(slot.first, keys[position])) {
+          next_[slot.last] = static_cast<int32_t>(position);
+          slot.last = static_cast<int32_t>(position);
+          break;
+        }
+      }
+    }
+  }
+
+  // Position of the first occurrence of key, or kNotFound.
+  int64_t FindFirst(const TKey& key) const {
+    const Slot* slot = Find(key);
+    return slot ? slot->first : kNotFound;
+  }
+
+  // Position of the last occurrence of key, or kNotFound.
+  int64_t FindLast(const TKey& key) const {
+    const Slot* slot = Find(key);
+    return slot ? slot->last : kNotFound;
+  }
+
+  // Position of the next occurrence of the key found at position, or kNotFound.
+  int64_t NextPosition(int64_t position) const {
+    return next_[position];
+  }
+
+ private:
+  struct Slot {
+    uint64_t hash = 0;
+    int32_t first = -1;
+    int32_t last = -1;
+  };
+
+  const Slot* Find(const TKey& key) const {
+    if (slots_.empty()) return nullptr;
+    const uint64_t hash = HashIndexKeys<TKey>::Hash(key);
+    for (size_t s = hash & mask_;; s = (s + 1) & mask_) {
+      const Slot& slot = slots_[s];
+      if (slot.first < 0) return nullptr;
+      if (slot.hash == hash && keys_.Equals(slot.first, key)) return &slot;
+    }
+  }
+
+  HashIndexKeys<TKey> keys_;
+  std::vector<Slot> slots_;
+  std::vector<int32_t> next_;
+  size_t mask_ = 0;
+};
+
+template <typename TKey>
+constexpr int64_t HashIndex<TKey>::kNotFound;
+
+}  // namespace ml
+}  // namespace onnxruntime
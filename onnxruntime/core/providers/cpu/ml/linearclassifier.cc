@@ -50,6 +50,19 @@ LinearClassifier<T>::LinearClassifier(const OpKernelInfo& info) : OpKernel(info)
 
   using_strings_ = !classlabels_strings_.empty();
   class_count_ = static_cast<int64_t>(intercepts_.size());
+
+  // coefficients are [classes, features], store them transposed so scoring is a plain [N, F] x [F, C] GEMM
+  feature_count_ = 0;
+  if (class_count_ > 0) {
+    ORT_ENFORCE(coefficients_.size() % class_count_ == 0, "coefficients size must be a multiple of the number of classes.");
+    feature_count_ = static_cast<int64_t>(coefficients_.size()) / class_count_;
+    packed_coefficients_.resize(coefficients_.size());
+    for (int64_t j = 0; j < class_count_; j++) {
+      for (int64_t k = 0; k < feature_count_; k++) {
+        packed_coefficients_[k * class_count_ + j] = coefficients_[j * feature_count_ + k];
+      }
+    }
+  }
 }
 
 template <typename T>
@@ -72,33 +85,45 @@ Status LinearClassifier<T>::Compute(OpKernelContext* ctx) const {
     add_second_class = true;
   }
   Tensor* Z = ctx->Output(1, TensorShape({N, output_classes}));
+  if (class_count_ > 0 && stride != feature_count_) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Input feature count does not match the coefficients.");
+  }
 
-  int64_t zindex = 0;
-  const auto* x_data = X->template Data<T>();
+  // scores of every point for every class, written straight into Z when it has one column per class
+  std::vector<float> score_buffer;
+  float* scores = nullptr;
+  if (Z != nullptr && !add_second_class) {
+    scores = Z->template MutableData<float>();
+  } else {
+    score_buffer.resize(N * class_count_);
+    scores = score_buffer.data();
+  }
+
+  if (N > 0 && class_count_ > 0) {
+    std::vector<float> x_buffer;
+    int64_t lda;
+    const float* x_data = ml_float_rows(X->template Data<T>(), N, stride, stride, x_buffer, lda);
+    if (feature_count_ > 0) {
+      MlasSgemm(CblasNoTrans, CblasNoTrans, static_cast<size_t>(N), static_cast<size_t>(class_count_),
+                static_cast<size_t>(feature_count_), 1.f, x_data, static_cast<size_t>(lda),
+                packed_coefficients_.data(), static_cast<size_t>(class_count_), 0.f, scores, static_cast<size_t>(class_count_));
+    } else {
+      std::fill_n(scores, N * class_count_, 0.f);
+    }
+    for (int64_t i = 0; i < N; i++) {
+      EigenVectorMap<float>(scores + i * class_count_, class_count_) += ConstEigenVectorMap<float>(intercepts_.data(), class_count_);
+    }
+  }
 
-  size_t class_count = static_cast<size_t>(class_count_);
-  std::vector<float> scores;
-  scores.reserve(class_count);
   for (int64_t i = 0; i < N; i++)  //for each point
   {
-    scores.clear();
-    size_t current_weight_0 = i * stride;
+    const float* point_scores = scores + i * class_count_;
     int maxclass = -1;
     float maxweight = 0.f;
-    for (int j = 0; j < class_count; j++)  //for each class
+    for (int j = 0; j < class_count_; j++)  //for each class
     {
-      size_t current_coeff_0 = j * stride;
-      float weight = 0.f;
-      for (int64_t k = 0; k < stride; k++)  //for each weight
-      {
-        weight += static_cast<float>(x_data[current_weight_0 + k] * coefficients_[current_coeff_0 + k]);
-      }
-      if (intercepts_.size() == class_count) {
-        weight += intercepts_[j];
-      }
-      scores.push_back(weight);
-      if (weight > maxweight || maxclass == -1) {
-        maxweight = weight;
+      if (point_scores[j] > maxweight || maxclass == -1) {
+        maxweight = point_scores[j];
         maxclass = j;
       }
     }
@@ -135,16 +160,25 @@ Status LinearClassifier<T>::Compute(OpKernelContext* ctx) const {
         Y->template MutableData<int64_t>()[i] = classlabels_ints_[maxclass];
       }
     }
-    //write float values
-    if (add_second_class && maxweight > 0) {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, 0);
-    } else if (add_second_class) {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, 1);
-    } else {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, -1);
-    }
-    zindex += scores.size();
   }  //for each point
+
+  //write float values
+  if (Z == nullptr) {
+    return Status::OK();
+  }
+  if (add_second_class) {
+    // a single score expanded to two columns, which does not fit the batched transform
+    std::vector<float> point_scores;
+    point_scores.reserve(2);
+    int64_t zindex = 0;
+    for (int64_t i = 0; i < N; i++) {
+      point_scores.assign(1, scores[i]);
+      ::onnxruntime::ml::write_scores(point_scores, post_transform_, zindex, Z, scores[i] > 0 ? 0 : 1);
+      zindex += point_scores.size();
+    }
+  } else {
+    batched_post_transform(scores, N, class_count_, post_transform_);
+  }
   return Status::OK();
 }
 
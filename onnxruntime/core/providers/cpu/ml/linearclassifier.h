@@ -22,7 +22,9 @@ class LinearClassifier final : public OpKernel {
   int64_t class_count_;
   POST_EVAL_TRANSFORM post_transform_;
   bool using_strings_;
+  int64_t feature_count_;
   std::vector<float> coefficients_;
+  std::vector<float> packed_coefficients_;  // coefficients_ transposed to [features, classes] for the GEMM
   std::vector<float> intercepts_;
   std::vector<std::string> classlabels_strings_;
   std::vector<int64_t> classlabels_ints_;
@@ -18,6 +18,19 @@ LinearRegressor<T>::LinearRegressor(const OpKernelInfo& info) : OpKernel(info),
                                                                 post_transform_(MakeTransform(info.GetAttrOrDefault<std::string>("post_transform", "NONE"))) {
   ORT_ENFORCE(info.GetAttr<int64_t>("targets", &targets_).IsOK());
   ORT_ENFORCE(info.GetAttrs<float>("coefficients", coefficients_).IsOK());
+
+  // coefficients are [targets, features], store them transposed so scoring is a plain [N, F] x [F, T] GEMM
+  feature_count_ = 0;
+  if (targets_ > 0) {
+    ORT_ENFORCE(coefficients_.size() % targets_ == 0, "coefficients size must be a multiple of the number of targets.");
+    feature_count_ = static_cast<int64_t>(coefficients_.size()) / targets_;
+    packed_coefficients_.resize(coefficients_.size());
+    for (int64_t j = 0; j < targets_; j++) {
+      for (int64_t k = 0; k < feature_count_; k++) {
+        packed_coefficients_[k * targets_ + j] = coefficients_[j * feature_count_ + k];
+      }
+    }
+  }
 }
 
 template <>
@@ -31,30 +44,31 @@ Status LinearRegressor<float>::Compute(OpKernelContext* ctx) const {
   int64_t stride = X->Shape().NumDimensions() == 1 ? X->Shape()[0] : X->Shape()[1];
   int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
   Tensor* Y = ctx->Output(0, TensorShape({N, targets_}));
+  if (targets_ > 0 && stride != feature_count_) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Input feature count does not match the coefficients.");
+  }
+  if (N == 0 || targets_ == 0) {
+    return Status::OK();
+  }
+
   const auto* Xdata = X->template Data<float>();
-  int64_t yindex = 0;
+  float* Ydata = Y->template MutableData<float>();
+  if (feature_count_ > 0) {
+    MlasSgemm(CblasNoTrans, CblasNoTrans, static_cast<size_t>(N), static_cast<size_t>(targets_),
+              static_cast<size_t>(feature_count_), 1.f, Xdata, static_cast<size_t>(stride),
+              packed_coefficients_.data(), static_cast<size_t>(targets_), 0.f, Ydata, static_cast<size_t>(targets_));
+  } else {
+    std::fill_n(Ydata, N * targets_, 0.f);
+  }
 
   bool useIntercepts = intercepts_.size() == static_cast<size_t>(targets_) ? true : false;
-  for (int64_t i = 0; i < N; i++)  //for each point
-  {
-    std::vector<float> scores;
-    int64_t current_weight_0 = i * stride;
-    for (int j = 0; j < targets_; j++)  //for each target
-    {
-      int64_t current_coeff_0 = j * stride;
-      float weight = 0.f;
-      for (int64_t k = 0; k < stride; k++)  //for each weight
-      {
-        weight = weight + Xdata[current_weight_0 + k] * coefficients_[current_coeff_0 + k];
-      }
-      if (useIntercepts) {
-        weight = weight + intercepts_[j];
-      }
-      scores.push_back(weight);
+  if (useIntercepts) {
+    for (int64_t i = 0; i < N; i++) {
+      EigenVectorMap<float>(Ydata + i * targets_, targets_) += ConstEigenVectorMap<float>(intercepts_.data(), targets_);
     }
-    ::onnxruntime::ml::write_scores(scores, post_transform_, yindex, Y, -1);
-    yindex += scores.size();
   }
+  ::onnxruntime::ml::batched_post_transform(Ydata, N, targets_, post_transform_);
+
   return Status::OK();
 }
 
@@ -19,7 +19,9 @@ class LinearRegressor final : public OpKernel {
 
  private:
   int64_t targets_;
+  int64_t feature_count_;
   std::vector<float> coefficients_;
+  std::vector<float> packed_coefficients_;  // coefficients_ transposed to [features, targets] for the GEMM
   std::vector<float> intercepts_;
   POST_EVAL_TRANSFORM post_transform_;
 };
@@ -5,6 +5,7 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace ml {  // name space for onnx.ml operators
@@ -324,5 +325,69 @@ static inline void write_scores(std::vector<float>& scores, POST_EVAL_TRANSFORM
   }
 }
 
+// Returns the N rows of len values of x, which are stride apart, as float: float input is used in place,
+// other types are converted into buffer. ld receives the distance between the returned rows.
+inline const float* ml_float_rows(const float* x, int64_t /*N*/, int64_t stride, int64_t /*len*/,
+                                  std::vector<float>& /*buffer*/, int64_t& ld) {
+  ld = stride;
+  return x;
+}
+
+template <typename T>
+const float* ml_float_rows(const T* x, int64_t N, int64_t stride, int64_t len,
+                           std::vector<float>& buffer, int64_t& ld) {
+  buffer.resize(N * len);
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t i = 0; i < len; i++) {
+      buffer[n * len + i] = static_cast<float>(x[n * stride + i]);
+    }
+  }
+  ld = len;
+  return buffer.data();
+}
+
+// Applies post_transform in place to N rows of D contiguous scores. This is what write_scores does to a
+// row of D >= 2 scores, or to a single score when no second class is added, done for all the rows at once.
+static inline void batched_post_transform(float* scores, int64_t N, int64_t D, POST_EVAL_TRANSFORM post_transform) {
+  if (N == 0 || D == 0) return;
+  if (D == 1) {
+    if (post_transform == POST_EVAL_TRANSFORM::PROBIT) {
+      for (int64_t i = 0; i < N; i++) {
+        scores[i] = ml_sqrt2 * ml_inv_erf(2 * scores[i] - 1);
+      }
+    }
+    return;
+  }
+
+  if (post_transform == POST_EVAL_TRANSFORM::LOGISTIC) {
+    MlasComputeLogistic(scores, scores, static_cast<size_t>(N * D));
+  } else if (post_transform == POST_EVAL_TRANSFORM::SOFTMAX) {
+    MlasComputeSoftmax(scores, scores, static_cast<size_t>(N), static_cast<size_t>(D), false);
+  } else if (post_transform == POST_EVAL_TRANSFORM::SOFTMAX_ZERO) {
+    // same as compute_softmax_zero, in place
+    for (int64_t i = 0; i < N; i++) {
+      float* row = scores + i * D;
+      float v_max = -std::numeric_limits<float>::max();
+      for (int64_t k = 0; k < D; k++) {
+        if (row[k] > v_max)
+          v_max = row[k];
+      }
+      float exp_neg_v_max = std::exp(-v_max);
+      float this_sum = 0.f;
+      for (int64_t k = 0; k < D; k++) {
+        if (row[k] > 0.0000001f || row[k] < -0.0000001f) {
+          row[k] = std::exp(row[k] - v_max);
+          this_sum += row[k];
+        } else {
+          row[k] = row[k] * exp_neg_v_max;
+        }
+      }
+      for (int64_t k = 0; k < D; k++) {
+        row[k] /= this_sum;
+      }
+    }
+  }
+}
+
 }  // namespace ml
 }  // namespace onnxruntime
@@ -73,6 +73,9 @@ SVMClassifier<T>::SVMClassifier(const OpKernelInfo& info)
       break;
     }
   }
+  if (mode_ == SVM_TYPE::SVM_SVC && get_kernel_type() == KERNEL::RBF) {
+    support_vector_norms_ = svm_row_squared_norms(support_vectors_, vector_count_, feature_count_);
+  }
 }
 
 template <typename T>
@@ -92,164 +95,177 @@ Status SVMClassifier<T>::Compute(OpKernelContext* ctx) const {
     dims = {static_cast<int64_t>(N), static_cast<int64_t>(class_count_)};
   Z = ctx->Output(1, TensorShape(dims));
 
+  if (stride < feature_count_) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Input has fewer features than the model.");
+  }
+
   const auto* x_data = X->template Data<T>();
   int64_t zindex = 0;
 
-  for (int64_t n = 0; n < N; n++)  //for each example
-  {
-    int64_t current_weight_0 = n * stride;
-    int64_t maxclass = -1;
-    double maxweight = 0.f;
-    std::vector<float> decisions;
-    std::vector<float> scores;
-    std::vector<float> kernels;
-    std::vector<int64_t> votes;
+  // the kernel values of a block of rows come from one GEMM, the rest is scored row by row in buffers
+  // that are reused for every row
+  const int64_t kernel_count = mode_ == SVM_TYPE::SVM_SVC ? vector_count_ : class_count_;
+  const int64_t block_size = kernel_row_block(N, kernel_count);
+  std::vector<float> kernels(block_size * kernel_count);
+  std::vector<float> x_buffer;
+  std::vector<float> scores;
+  std::vector<int64_t> votes;
+  std::vector<float> probsp2;
+  std::vector<float> estimates;
+  scores.reserve(std::max<int64_t>(class_count_ * (class_count_ - 1) / 2, class_count_) + 1);
+  if (mode_ == SVM_TYPE::SVM_SVC) {
+    votes.resize(class_count_);
+  }
+  if (proba_.size() > 0 && mode_ == SVM_TYPE::SVM_SVC) {
+    probsp2.resize(class_count_ * class_count_);
+    estimates.resize(class_count_);
+  }
 
+  for (int64_t block_start = 0; block_start < N; block_start += block_size) {
+    const int64_t block_rows = std::min(block_size, N - block_start);
     if (mode_ == SVM_TYPE::SVM_SVC) {
-      for (int64_t j = 0; j < vector_count_; j++) {
-        float val = kernel_dot(x_data, current_weight_0, support_vectors_, feature_count_ * j, feature_count_, get_kernel_type());
-        kernels.push_back(val);
-      }
-      for (int64_t j = 0; j < class_count_; j++) {
-        votes.push_back(0);
-      }
-      int evals = 0;
-      for (int64_t i = 0; i < class_count_; i++) {        //for each class
-        for (int64_t j = i + 1; j < class_count_; j++) {  //for each class
-          float sum = 0;
-          int64_t start_index_i = starting_vector_[i];  // *feature_count_;
-          int64_t start_index_j = starting_vector_[j];  // *feature_count_;
+      batched_kernel_dot(x_data + block_start * stride, block_rows, stride, support_vectors_, support_vector_norms_,
+                         vector_count_, feature_count_, get_kernel_type(), kernels.data(), x_buffer);
+    } else {  //liblinear
+      batched_kernel_dot(x_data + block_start * stride, block_rows, stride, coefficients_, support_vector_norms_,
+                         class_count_, feature_count_, KERNEL::LINEAR, kernels.data(), x_buffer);
+    }
 
-          int64_t class_i_support_count = vectors_per_class_[i];
-          int64_t class_j_support_count = vectors_per_class_[j];
+    for (int64_t n = block_start; n < block_start + block_rows; n++)  //for each example
+    {
+      const float* row_kernels = kernels.data() + (n - block_start) * kernel_count;
+      int64_t maxclass = -1;
+      double maxweight = 0.f;
+      scores.clear();
 
-          int64_t pos1 = (vector_count_) * (j - 1);
-          int64_t pos2 = (vector_count_) * (i);
-          for (int64_t m = 0; m < class_i_support_count; m++) {
-            float val1 = coefficients_[pos1 + start_index_i + m];
-            float val2 = kernels[start_index_i + m];
-            sum += val1 * val2;
-          }
-          for (int64_t m = 0; m < class_j_support_count; m++) {
-            float val1 = coefficients_[pos2 + start_index_j + m];
-            float val2 = kernels[start_index_j + m];
-            sum += val1 * val2;
-          }
+      if (mode_ == SVM_TYPE::SVM_SVC) {
+        std::fill(votes.begin(), votes.end(), int64_t{0});
+        int evals = 0;
+        for (int64_t i = 0; i < class_count_; i++) {        //for each class
+          for (int64_t j = i + 1; j < class_count_; j++) {  //for each class
+            float sum = 0;
+            int64_t start_index_i = starting_vector_[i];  // *feature_count_;
+            int64_t start_index_j = starting_vector_[j];  // *feature_count_;
 
-          sum += rho_[evals];
-          scores.push_back(sum);
-          if (sum > 0) {
-            votes[i]++;
-          } else {
-            votes[j]++;
+            int64_t class_i_support_count = vectors_per_class_[i];
+            int64_t class_j_support_count = vectors_per_class_[j];
+
+            int64_t pos1 = (vector_count_) * (j - 1);
+            int64_t pos2 = (vector_count_) * (i);
+            for (int64_t m = 0; m < class_i_support_count; m++) {
+              float val1 = coefficients_[pos1 + start_index_i + m];
+              float val2 = row_kernels[start_index_i + m];
+              sum += val1 * val2;
+            }
+            for (int64_t m = 0; m < class_j_support_count; m++) {
+              float val1 = coefficients_[pos2 + start_index_j + m];
+              float val2 = row_kernels[start_index_j + m];
+              sum += val1 * val2;
+            }
+
+            sum += rho_[evals];
+            scores.push_back(sum);
+            if (sum > 0) {
+              votes[i]++;
+            } else {
+              votes[j]++;
+            }
+            evals++;  //index into rho
           }
-          evals++;  //index into rho
         }
-      }
-    } else if (mode_ == SVM_TYPE::SVM_LINEAR) {     //liblinear
-      for (int64_t j = 0; j < class_count_; j++) {  //for each class
-        float val = kernel_dot(x_data, current_weight_0, coefficients_, feature_count_ * j, feature_count_, get_kernel_type());
-        val += rho_[0];
-        scores.push_back(val);
-      }
-    }
-    if (proba_.size() > 0 && mode_ == SVM_TYPE::SVM_SVC) {
-      //compute probabilities from the scores
-      std::vector<float> estimates;
-      std::vector<float> probsp2;
-      int64_t num = class_count_ * class_count_;
-      for (int64_t m = 0; m < num; m++) {
-        probsp2.push_back(0.f);  //min prob
-      }
-      for (int64_t m = 0; m < class_count_; m++) {
-        estimates.push_back(0.f);  //min prob
-      }
-      int64_t index = 0;
-      for (int64_t i = 0; i < class_count_; i++) {
-        for (int64_t j = i + 1; j < class_count_; j++) {
-          float val1 = sigmoid_probability(scores[index], proba_[index], probb_[index]);
-          float val2 = std::max(val1, 1.0e-7f);
-          probsp2[i * class_count_ + j] = std::min(val2, 1 - 1.0e-7f);
-          probsp2[j * class_count_ + i] = 1 - probsp2[i * class_count_ + j];
-          index++;
+      } else if (mode_ == SVM_TYPE::SVM_LINEAR) {     //liblinear
+        for (int64_t j = 0; j < class_count_; j++) {  //for each class
+          scores.push_back(row_kernels[j] + rho_[0]);
         }
       }
-      multiclass_probability(class_count_, probsp2, estimates);
-      //copy probabilities back into scores
-      scores.resize(estimates.size());
-      for (int64_t k = 0; k < static_cast<int64_t>(estimates.size()); k++) {
-        scores[k] = estimates[k];
-      }
-    }
-    int64_t maxvotes = 0;
-    if (votes.size() > 0) {
-      for (int64_t k = 0; k < static_cast<int64_t>(votes.size()); k++) {
-        if (votes[k] > maxvotes) {
-          maxvotes = votes[k];
-          maxclass = k;
+      if (proba_.size() > 0 && mode_ == SVM_TYPE::SVM_SVC) {
+        //compute probabilities from the scores
+        std::fill(probsp2.begin(), probsp2.end(), 0.f);      //min prob
+        std::fill(estimates.begin(), estimates.end(), 0.f);  //min prob
+        int64_t index = 0;
+        for (int64_t i = 0; i < class_count_; i++) {
+          for (int64_t j = i + 1; j < class_count_; j++) {
+            float val1 = sigmoid_probability(scores[index], proba_[index], probb_[index]);
+            float val2 = std::max(val1, 1.0e-7f);
+            probsp2[i * class_count_ + j] = std::min(val2, 1 - 1.0e-7f);
+            probsp2[j * class_count_ + i] = 1 - probsp2[i * class_count_ + j];
+            index++;
+          }
         }
+        multiclass_probability(class_count_, probsp2, estimates);
+        //copy probabilities back into scores
+        scores.assign(estimates.begin(), estimates.end());
       }
-    } else {
-      for (int64_t k = 0; k < static_cast<int64_t>(scores.size()); k++) {
-        if (scores[k] > maxweight) {
-          maxclass = k;
-          maxweight = scores[k];
+      int64_t maxvotes = 0;
+      if (votes.size() > 0) {
+        for (int64_t k = 0; k < static_cast<int64_t>(votes.size()); k++) {
+          if (votes[k] > maxvotes) {
+            maxvotes = votes[k];
+            maxclass = k;
+          }
         }
-      }
-    }
-    //write top class
-    int write_additional_scores = -1;
-    if (rho_.size() == 1)  //binary
-    {
-      if (using_strings_) {
-        if (classlabels_strings_.size() == 2 && weights_are_all_positive_ && maxweight >= 0.5 && proba_.size() == 0) {
-          Y->template MutableData<std::string>()[n] = classlabels_strings_[1];  //positive label
-          write_additional_scores = 0;
-        } else if (classlabels_strings_.size() == 2 && maxweight > 0 && !weights_are_all_positive_ && proba_.size() == 0) {
-          Y->template MutableData<std::string>()[n] = classlabels_strings_[1];  //positive label
-          write_additional_scores = 0;
-        } else if (classlabels_strings_.size() == 2 && proba_.size() > 0) {            //this case all classes are in their rightful spot
-          Y->template MutableData<std::string>()[n] = classlabels_strings_[maxclass];  //whichever label
-          write_additional_scores = -1;
-        } else if (classlabels_strings_.size() == 2) {
-          Y->template MutableData<std::string>()[n] = classlabels_strings_[0];  //negative label
-          write_additional_scores = 1;
-        } else if (maxweight > 0) {
-          Y->template MutableData<std::string>()[n] = "1";  //positive label
-        } else {
-          Y->template MutableData<std::string>()[n] = "0";  //negative label
+      } else {
+        for (int64_t k = 0; k < static_cast<int64_t>(scores.size()); k++) {
+          if (scores[k] > maxweight) {
+            maxclass = k;
+            maxweight = scores[k];
+          }
         }
-      } else  //no strings
+      }
+      //write top class
+      int write_additional_scores = -1;
+      if (rho_.size() == 1)  //binary
       {
-        if (classlabels_ints_.size() == 2 && weights_are_all_positive_ && maxweight >= 0.5 && proba_.size() == 0) {
-          Y->template MutableData<int64_t>()[n] = classlabels_ints_[1];  //positive label
-          write_additional_scores = 0;
-        } else if (classlabels_ints_.size() == 2 && maxweight > 0 && !weights_are_all_positive_ && proba_.size() == 0) {
-          Y->template MutableData<int64_t>()[n] = classlabels_ints_[0];  //pos  label
-          write_additional_scores = 0;
-        } else if (classlabels_ints_.size() == 2 && proba_.size() > 0)  //this case all classes are in their rightful spot
+        if (using_strings_) {
+          if (classlabels_strings_.size() == 2 && weights_are_all_positive_ && maxweight >= 0.5 && proba_.size() == 0) {
+            Y->template MutableData<std::string>()[n] = classlabels_strings_[1];  //positive label
+            write_additional_scores = 0;
+          } else if (classlabels_strings_.size() == 2 && maxweight > 0 && !weights_are_all_positive_ && proba_.size() == 0) {
+            Y->template MutableData<std::string>()[n] = classlabels_strings_[1];  //positive label
+            write_additional_scores = 0;
+          } else if (classlabels_strings_.size() == 2 && proba_.size() > 0) {            //this case all classes are in their rightful spot
+            Y->template MutableData<std::string>()[n] = classlabels_strings_[maxclass];  //whichever label
+            write_additional_scores = -1;
+          } else if (classlabels_strings_.size() == 2) {
+            Y->template MutableData<std::string>()[n] = classlabels_strings_[0];  //negative label
+            write_additional_scores = 1;
+          } else if (maxweight > 0) {
+            Y->template MutableData<std::string>()[n] = "1";  //positive label
+          } else {
+            Y->template MutableData<std::string>()[n] = "0";  //negative label
+          }
+        } else  //no strings
         {
-          Y->template MutableData<int64_t>()[n] = classlabels_ints_[maxclass];  //whichever label
-          write_additional_scores = -1;
-        } else if (classlabels_ints_.size() == 2) {
-          Y->template MutableData<int64_t>()[n] = classlabels_ints_[0];  //negative label
-          write_additional_scores = 1;
-        } else if (maxweight > 0) {
-          Y->template MutableData<int64_t>()[n] = 1;  //positive label
+          if (classlabels_ints_.size() == 2 && weights_are_all_positive_ && maxweight >= 0.5 && proba_.size() == 0) {
+            Y->template MutableData<int64_t>()[n] = classlabels_ints_[1];  //positive label
+            write_additional_scores = 0;
+          } else if (classlabels_ints_.size() == 2 && maxweight > 0 && !weights_are_all_positive_ && proba_.size() == 0) {
+            Y->template MutableData<int64_t>()[n] = classlabels_ints_[0];  //pos  label
+            write_additional_scores = 0;
+          } else if (classlabels_ints_.size() == 2 && proba_.size() > 0)  //this case all classes are in their rightful spot
+          {
+            Y->template MutableData<int64_t>()[n] = classlabels_ints_[maxclass];  //whichever label
+            write_additional_scores = -1;
+          } else if (classlabels_ints_.size() == 2) {
+            Y->template MutableData<int64_t>()[n] = classlabels_ints_[0];  //negative label
+            write_additional_scores = 1;
+          } else if (maxweight > 0) {
+            Y->template MutableData<int64_t>()[n] = 1;  //positive label
+          } else {
+            Y->template MutableData<int64_t>()[n] = 0;  //negative label
+          }
+        }
+      } else {  //multiclass
+        if (using_strings_) {
+          Y->template MutableData<std::string>()[n] = classlabels_strings_[maxclass];
         } else {
-          Y->template MutableData<int64_t>()[n] = 0;  //negative label
+          Y->template MutableData<int64_t>()[n] = classlabels_ints_[maxclass];
         }
       }
-    } else {  //multiclass
-      if (using_strings_) {
-        Y->template MutableData<std::string>()[n] = classlabels_strings_[maxclass];
-      } else {
-        Y->template MutableData<int64_t>()[n] = classlabels_ints_[maxclass];
-      }
-    }
 
-    write_scores(scores, post_transform_, zindex, Z, write_additional_scores);
-    zindex += scores.size();
+      write_scores(scores, post_transform_, zindex, Z, write_additional_scores);
+      zindex += scores.size();
+    }
   }
 
   return Status::OK();
@@ -11,6 +11,23 @@
 namespace onnxruntime {
 namespace ml {
 
+// Number of kernel values computed per batch of rows, which bounds the scratch space of SVMClassifier
+// and SVMRegressor regardless of the number of rows and support vectors.
+static constexpr int64_t kSVMKernelBlockElements = 1 << 20;
+
+// RBF distances expanded as |x|^2 + |b|^2 - 2 x.b lose precision through cancellation when x is close to b
+// relative to their norms. Distances below this fraction of |x|^2 + |b|^2 are recomputed directly as |x - b|^2.
+static constexpr float kSVMRBFExpansionLimit = 0.25f;
+
+// Squared norm of each of the count rows of len values in B.
+inline std::vector<float> svm_row_squared_norms(const std::vector<float>& B, int64_t count, int64_t len) {
+  std::vector<float> norms(count);
+  for (int64_t j = 0; j < count; j++) {
+    norms[j] = ConstEigenVectorMap<float>(B.data() + j * len, len).squaredNorm();
+  }
+  return norms;
+}
+
 // stuffs shared by SVMClassifier and SVMRegressor
 template <typename T>
 class SVMCommon {
@@ -29,32 +46,58 @@ class SVMCommon {
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
-  float kernel_dot(const T* A, int64_t a, const std::vector<float>& B, int64_t b, int64_t len, KERNEL k) const {
-    float sum = 0.f;
-    if (k == KERNEL::POLY) {
-      for (int64_t i = 0; i < len; i++) {
-        sum += B[b + i] * static_cast<float>(A[a + i]);
+  // Computes the kernel between each of the N rows of x_data, which are stride apart, and each of the count
+  // rows of B with one GEMM. out is a row-major [N, count] matrix. B_norms holds the squared norms of the rows
+  // of B and is only used by RBF, which is expanded as exp(-gamma * (|x|^2 + |b|^2 - 2 x.b)) except for the
+  // pairs that are close compared to their norms, see kSVMRBFExpansionLimit.
+  // x_buffer is scratch space for input that is not float.
+  void batched_kernel_dot(const T* x_data, int64_t N, int64_t stride,
+                          const std::vector<float>& B, const std::vector<float>& B_norms, int64_t count,
+                          int64_t len, KERNEL k, float* out, std::vector<float>& x_buffer) const {
+    if (N == 0 || count == 0) return;
+    if (len == 0) {
+      std::fill_n(out, N * count, 0.f);
+    } else {
+      int64_t lda;
+      const float* A = ml_float_rows(x_data, N, stride, len, x_buffer, lda);
+      float alpha = 1.f;
+      if (k == KERNEL::POLY || k == KERNEL::SIGMOID) {
+        alpha = gamma_;
+      } else if (k == KERNEL::RBF) {
+        alpha = -2.f;
       }
-      sum = gamma_ * sum + coef0_;
-      sum = std::pow(sum, degree_);
-    } else if (k == KERNEL::SIGMOID) {
-      for (int64_t i = 0; i < len; i++) {
-        sum += B[b + i] * static_cast<float>(A[a + i]);
+      MlasSgemm(CblasNoTrans, CblasTrans, static_cast<size_t>(N), static_cast<size_t>(count), static_cast<size_t>(len),
+                alpha, A, static_cast<size_t>(lda), B.data(), static_cast<size_t>(len), 0.f, out, static_cast<size_t>(count));
+      if (k == KERNEL::RBF) {
+        for (int64_t n = 0; n < N; n++) {
+          const ConstEigenVectorMap<float> x(A + n * lda, len);
+          const float x_norm = x.squaredNorm();
+          float* row = out + n * count;
+          for (int64_t j = 0; j < count; j++) {
+            float distance = row[j] + x_norm + B_norms[j];
+            if (distance < kSVMRBFExpansionLimit * (x_norm + B_norms[j])) {
+              distance = (x - ConstEigenVectorMap<float>(B.data() + j * len, len)).squaredNorm();
+            }
+            row[j] = -gamma_ * std::max(distance, 0.f);
+          }
+        }
       }
-      sum = gamma_ * sum + coef0_;
-      sum = std::tanh(sum);
+    }
+
+    EigenVectorMap<float> values(out, N * count);
+    if (k == KERNEL::POLY) {
+      values = (values.array() + coef0_).pow(degree_);
+    } else if (k == KERNEL::SIGMOID) {
+      values.array() += coef0_;
+      MlasComputeTanh(out, out, static_cast<size_t>(N * count));
     } else if (k == KERNEL::RBF) {
-      for (int64_t i = 0; i < len; i++) {
-        float val = static_cast<float>(A[a + i]) - B[b + i];
-        sum += (val * val);
-      }
-      sum = std::exp(-gamma_ * sum);
-    } else if (k == KERNEL::LINEAR) {
-      for (int64_t i = 0; i < len; i++) {
-        sum += B[b + i] * static_cast<float>(A[a + i]);
-      }
+      MlasComputeExp(out, out, static_cast<size_t>(N * count));
     }
-    return sum;
+  }
+
+  // Number of rows to process together so that their [rows, count] kernel values fit in one block.
+  static int64_t kernel_row_block(int64_t N, int64_t count) {
+    return std::max<int64_t>(1, std::min<int64_t>(N, kSVMKernelBlockElements / std::max<int64_t>(count, 1)));
   }
 
  private:
@@ -66,7 +109,8 @@ class SVMCommon {
 
 template <typename T>
 class SVMClassifier final : public OpKernel, private SVMCommon<T> {
-  using SVMCommon<T>::kernel_dot;
+  using SVMCommon<T>::batched_kernel_dot;
+  using SVMCommon<T>::kernel_row_block;
   using SVMCommon<T>::set_kernel_type;
   using SVMCommon<T>::get_kernel_type;
 
@@ -87,6 +131,7 @@ class SVMClassifier final : public OpKernel, private SVMCommon<T> {
   std::vector<float> probb_;
   std::vector<float> coefficients_;
   std::vector<float> support_vectors_;
+  std::vector<float> support_vector_norms_;  // squared norms of the support vectors for RBF
   std::vector<int64_t> classlabels_ints_;
   std::vector<std::string> classlabels_strings_;
   POST_EVAL_TRANSFORM post_transform_;
@@ -34,6 +34,9 @@ SVMRegressor<T>::SVMRegressor(const OpKernelInfo& info)
     mode_ = SVM_TYPE::SVM_LINEAR;
     set_kernel_type(KERNEL::LINEAR);
   }
+  if (mode_ == SVM_TYPE::SVM_SVC && get_kernel_type() == KERNEL::RBF) {
+    support_vector_norms_ = svm_row_squared_norms(support_vectors_, vector_count_, feature_count_);
+  }
 }
 
 template <typename T>
@@ -44,31 +47,40 @@ Status SVMRegressor<T>::Compute(OpKernelContext* ctx) const {
   int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
 
   Tensor* Y = ctx->Output(0, TensorShape({N, 1}));  // this op outputs for one target only
-  const auto* x_data = X->template Data<T>();
+  if (stride < feature_count_) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Input has fewer features than the model.");
+  }
 
-  for (int64_t n = 0; n < N; n++) {  //for each example
-    int64_t current_weight_0 = n * stride;
-    std::vector<float> scores;
+  const auto* x_data = X->template Data<T>();
+  float* y_data = Y->template MutableData<float>();
 
-    float sum = 0.f;
-    if (mode_ == SVM_TYPE::SVM_SVC) {
-      for (int64_t j = 0; j < vector_count_; j++) {
-        float val1 = kernel_dot(x_data, current_weight_0, support_vectors_, feature_count_ * j, feature_count_, get_kernel_type());
-        float val2 = coefficients_[j];
-        float val3 = val1 * val2;
-        sum += val3;
-      }
-      sum += rho_[0];
-    } else if (mode_ == SVM_TYPE::SVM_LINEAR) {  //liblinear
-      sum = kernel_dot(x_data, current_weight_0, coefficients_, 0, feature_count_, get_kernel_type());
-      sum += rho_[0];
+  if (mode_ == SVM_TYPE::SVM_SVC) {
+    // kernel values of a block of rows against all the support vectors, then one GEMV with the coefficients
+    const int64_t block_size = kernel_row_block(N, vector_count_);
+    std::vector<float> kernels(block_size * vector_count_);
+    std::vector<float> x_buffer;
+    for (int64_t block_start = 0; block_start < N; block_start += block_size) {
+      const int64_t block_rows = std::min(block_size, N - block_start);
+      batched_kernel_dot(x_data + block_start * stride, block_rows, stride, support_vectors_, support_vector_norms_,
+                         vector_count_, feature_count_, get_kernel_type(), kernels.data(), x_buffer);
+      MlasSgemm(CblasNoTrans, CblasNoTrans, static_cast<size_t>(block_rows), 1, static_cast<size_t>(vector_count_),
+                1.f, kernels.data(), static_cast<size_t>(vector_count_), coefficients_.data(), 1,
+                0.f, y_data + block_start, 1);
     }
+  } else if (mode_ == SVM_TYPE::SVM_LINEAR) {  //liblinear
+    std::vector<float> x_buffer;
+    batched_kernel_dot(x_data, N, stride, coefficients_, support_vector_norms_, 1, feature_count_,
+                       get_kernel_type(), y_data, x_buffer);
+  }
+
+  for (int64_t n = 0; n < N; n++) {  //for each example
+    float sum = y_data[n] + rho_[0];
     if (one_class_ && sum > 0) {
-      Y->template MutableData<float>()[n] = 1.f;
+      y_data[n] = 1.f;
     } else if (one_class_) {
-      Y->template MutableData<float>()[n] = -1.f;
+      y_data[n] = -1.f;
     } else {
-      Y->template MutableData<float>()[n] = sum;
+      y_data[n] = sum;
     }
   }
 
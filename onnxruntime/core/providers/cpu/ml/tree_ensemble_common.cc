@@ -0,0 +1,206 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/ml/tree_ensemble_common.h"
+#include <limits>
+#include <map>
+
+namespace onnxruntime {
+namespace ml {
+
+void TreeEnsembleCompiled::Initialize(int64_t num_targets,
+                                      const std::vector<int64_t>& nodes_treeids,
+                                      const std::vector<int64_t>& nodes_nodeids,
+                                      const std::vector<int64_t>& nodes_featureids,
+                                      const std::vector<float>& nodes_values,
+                                      const std::vector<NODE_MODE>& nodes_modes,
+                                      const std::vector<int64_t>& nodes_truenodeids,
+                                      const std::vector<int64_t>& nodes_falsenodeids,
+                                      const std::vector<int64_t>& missing_tracks_true,
+                                      const std::vector<int64_t>& target_treeids,
+                                      const std::vector<int64_t>& target_nodeids,
+                                      const std::vector<int64_t>& target_ids,
+                                      const std::vector<float>& target_weights) {
+  const size_t n_nodes = nodes_treeids.size();
+  ORT_ENFORCE(nodes_nodeids.size() == n_nodes);
+  ORT_ENFORCE(nodes_featureids.size() == n_nodes);
+  ORT_ENFORCE(nodes_values.size() == n_nodes);
+  ORT_ENFORCE(nodes_modes.size() == n_nodes);
+  ORT_ENFORCE(nodes_truenodeids.size() == n_nodes);
+  ORT_ENFORCE(nodes_falsenodeids.size() == n_nodes);
+  ORT_ENFORCE(target_treeids.size() == target_ids.size());
+  ORT_ENFORCE(target_nodeids.size() == target_ids.size());
+  ORT_ENFORCE(target_weights.size() == target_ids.size());
+  ORT_ENFORCE(n_nodes < std::numeric_limits<uint32_t>::max());
+
+  // the attribute is optional and only applies if it describes every node
+  const bool use_missing_tracks_true = missing_tracks_true.size() == n_nodes;
+
+  // (tree id, node id) -> position in the attribute arrays
+  std::map<std::pair<int64_t, int64_t>, size_t> positions;
+  for (size_t i = 0; i < n_nodes; ++i) {
+    positions.insert(std::make_pair(std::make_pair(nodes_treeids[i], nodes_nodeids[i]), i));
+  }
+
+  // resolve the children of every branch node; a node that is nobody's child is a root
+  std::vector<size_t> true_child(n_nodes);
+  std::vector<size_t> false_child(n_nodes);
+  std::vector<bool> has_parent(n_nodes, false);
+  for (size_t i = 0; i < n_nodes; ++i) {
+    if (nodes_modes[i] == NODE_MODE::LEAF) continue;
+    ORT_ENFORCE(nodes_featureids[i] >= 0, "Branch node with a negative feature id.");
+    // children must be in the same tree
+    auto it = positions.find(std::make_pair(nodes_treeids[i], nodes_truenodeids[i]));
+    ORT_ENFORCE(it != positions.end());
+    true_child[i] = it->second;
+    it = positions.find(std::make_pair(nodes_treeids[i], nodes_falsenodeids[i]));
+    ORT_ENFORCE(it != positions.end());
+    false_child[i] = it->second;
+    has_parent[true_child[i]] = true;
+    has_parent[false_child[i]] = true;
+  }
+
+  // group the leaf weights by node
+  std::vector<std::vector<TreeLeafWeight>> leaf_weights(n_nodes);
+  num_targets_ = num_targets;
+  for (size_t i = 0, end = target_ids.size(); i < end; ++i) {
+    ORT_ENFORCE(target_ids[i] >= 0, "Negative class or target id.");
+    auto it = positions.find(std::make_pair(target_treeids[i], target_nodeids[i]));
+    if (it == positions.end()) continue;
+    leaf_weights[it->second].push_back({static_cast<uint32_t>(target_ids[i]), target_weights[i]});
+    num_targets_ = std::max(num_targets_, target_ids[i] + 1);
+  }
+
+  // lay out each tree depth first with the true branch next to its parent
+  const uint32_t kUnassigned = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> new_index(n_nodes, kUnassigned);
+  std::vector<size_t> order;
+  order.reserve(n_nodes);
+  std::vector<size_t> stack;
+  for (size_t i = 0; i < n_nodes; ++i) {
+    if (has_parent[i]) continue;
+    roots_.push_back(static_cast<uint32_t>(order.size()));
+    stack.push_back(i);
+    while (!stack.empty()) {
+      size_t pos = stack.back();
+      stack.pop_back();
+      if (new_index[pos] != kUnassigned) continue;
+      new_index[pos] = static_cast<uint32_t>(order.size());
+      order.push_back(pos);
+      if (nodes_modes[pos] != NODE_MODE::LEAF) {
+        stack.push_back(false_child[pos]);
+        stack.push_back(true_child[pos]);
+      }
+    }
+  }
+
+  nodes_.resize(order.size());
+  all_branch_leq_ = true;
+  max_feature_id_ = -1;
+  for (size_t n = 0, end = order.size(); n < end; ++n) {
+    const size_t pos = order[n];
+    TreeNodeElement& node = nodes_[n];
+    node.mode = nodes_modes[pos];
+    node.missing_tracks_true = use_missing_tracks_true && missing_tracks_true[pos] != 0;
+    if (node.mode == NODE_MODE::LEAF) {
+      const auto& weights = leaf_weights[pos];
+      node.truenode = static_cast<uint32_t>(weights.size());
+      node.falsenode = 0;
+      if (weights.size() == 1) {
+        node.feature_id = weights[0].target_id;
+        node.value = weights[0].value;
+      } else {
+        node.feature_id = static_cast<uint32_t>(weights_.size());
+        node.value = 0.f;
+        weights_.insert(weights_.end(), weights.begin(), weights.end());
+      }
+    } else {
+      node.feature_id = static_cast<uint32_t>(nodes_featureids[pos]);
+      node.value = nodes_values[pos];
+      node.truenode = new_index[true_child[pos]];
+      node.falsenode = new_index[false_child[pos]];
+      max_feature_id_ = std::max(max_feature_id_, nodes_featureids[pos]);
+      all_branch_leq_ = all_branch_leq_ && node.mode == NODE_MODE::BRANCH_LEQ;
+    }
+  }
+
+  InitializeQuickScorer();
+}
+
+void TreeEnsembleCompiled::InitializeQuickScorer() {
+  use_quickscorer_ = false;
+  if (!all_branch_leq_ || roots_.size() < kTreeEnsembleQuickScorerMinTrees) return;
+
+  // Missing values follow the false branch, which is what the threshold scan does for NaN, unless
+  // they are tracked to the true branch.
+  const size_t n_nodes = nodes_.size();
+  std::vector<uint32_t> parents(n_nodes, 0);
+  for (const TreeNodeElement& node : nodes_) {
+    if (node.mode == NODE_MODE::LEAF) continue;
+    if (node.missing_tracks_true) return;
+    parents[node.truenode]++;
+    parents[node.falsenode]++;
+  }
+  // Every node must be reached from a single parent so that the depth first layout places the true
+  // subtree of a node at [truenode, falsenode).
+  if (std::any_of(parents.begin(), parents.end(), [](uint32_t count) { return count > 1; })) return;
+
+  // number of leaves before each node in the layout
+  std::vector<uint32_t> leaves_before(n_nodes + 1, 0);
+  for (size_t n = 0; n < n_nodes; ++n) {
+    leaves_before[n + 1] = leaves_before[n] + (nodes_[n].mode == NODE_MODE::LEAF ? 1 : 0);
+  }
+
+  std::vector<TreeFalseNodeMask> masks;
+  std::vector<uint32_t> mask_features;
+  std::vector<uint32_t> leaf_offsets;
+  std::vector<uint32_t> leaves;
+  for (size_t tree = 0, num_trees = roots_.size(); tree < num_trees; ++tree) {
+    const uint32_t begin = roots_[tree];
+    const uint32_t end = tree + 1 < num_trees ? roots_[tree + 1] : static_cast<uint32_t>(n_nodes);
+    const uint32_t first_leaf = leaves_before[begin];
+    if (leaves_before[end] - first_leaf > kTreeEnsembleQuickScorerMaxLeaves) return;
+
+    leaf_offsets.push_back(static_cast<uint32_t>(leaves.size()));
+    for (uint32_t n = begin; n < end; ++n) {
+      const TreeNodeElement& node = nodes_[n];
+      if (node.mode == NODE_MODE::LEAF) {
+        leaves.push_back(n);
+        continue;
+      }
+      // the threshold scan relies on the thresholds of a feature being ordered
+      if (std::isnan(node.value)) return;
+      const uint32_t lo = leaves_before[node.truenode] - first_leaf;
+      const uint32_t count = leaves_before[node.falsenode] - leaves_before[node.truenode];
+      const uint64_t true_leaves = (count == 64 ? ~uint64_t{0} : ((uint64_t{1} << count) - 1)) << lo;
+      masks.push_back({node.value, static_cast<uint32_t>(tree), ~true_leaves});
+      mask_features.push_back(node.feature_id);
+    }
+  }
+
+  // group the nodes by feature and order them by threshold
+  std::vector<size_t> order(masks.size());
+  for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    if (mask_features[a] != mask_features[b]) return mask_features[a] < mask_features[b];
+    return masks[a].value < masks[b].value;
+  });
+
+  qs_nodes_.clear();
+  qs_features_.clear();
+  for (size_t i = 0; i < order.size(); ++i) {
+    const uint32_t feature_id = mask_features[order[i]];
+    if (qs_features_.empty() || qs_features_.back().feature_id != feature_id) {
+      const uint32_t position = static_cast<uint32_t>(i);
+      qs_features_.push_back({feature_id, position, position});
+    }
+    qs_nodes_.push_back(masks[order[i]]);
+    qs_features_.back().end++;
+  }
+  qs_leaves_ = std::move(leaves);
+  qs_leaf_offsets_ = std::move(leaf_offsets);
+  use_quickscorer_ = true;
+}
+
+}  // namespace ml
+}  // namespace onnxruntime
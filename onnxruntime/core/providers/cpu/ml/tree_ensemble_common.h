@@ -0,0 +1,361 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <cmath>
+#include "core/common/common.h"
+#include "ml_common.h"
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace onnxruntime {
+namespace ml {
+
+// A single node of a compiled tree. Branch nodes hold the feature to test, the threshold and the
+// indices of both children in TreeEnsembleCompiled::nodes_. Leaves reuse the same fields for their
+// weights: a leaf with a single weight stores the target id in feature_id and the weight in value,
+// otherwise feature_id is the first entry of TreeEnsembleCompiled::weights_ and value is unused.
+// For leaves, truenode holds the number of weights.
+struct TreeNodeElement {
+  uint32_t feature_id;
+  float value;
+  uint32_t truenode;
+  uint32_t falsenode;
+  NODE_MODE mode;
+  bool missing_tracks_true;
+};
+
+struct TreeLeafWeight {
+  uint32_t target_id;
+  float value;
+};
+
+// A branch node as seen by the QuickScorer evaluation: if the test on its feature fails, the leaves of its
+// true subtree are cleared from the tree's bitvector of candidate exit leaves.
+struct TreeFalseNodeMask {
+  float value;
+  uint32_t tree_id;
+  uint64_t leaves_mask;
+};
+
+// The nodes testing a feature, a range of TreeEnsembleCompiled::qs_nodes_ sorted by threshold.
+struct TreeFeatureNodes {
+  uint32_t feature_id;
+  uint32_t begin;
+  uint32_t end;
+};
+
+// TreeEnsembleCompiled converts the structure-of-arrays attributes shared by TreeEnsembleClassifier and
+// TreeEnsembleRegressor into a compact node array at kernel construction. The nodes of each tree are
+// stored in depth first order so a walk from the root touches nearby memory, child links and ids are
+// 32 bit, and the leaf weights live in (or next to) the leaf. Scoring accumulates into a dense
+// [N, NumTargets()] array and walks a block of rows through each tree together so the loads of
+// independent rows overlap. Large batches are split over threads by rows; batches too small to keep
+// every thread busy are split by trees instead, with each thread summing into its own scores.
+//
+// Ensembles of many small BRANCH_LEQ trees are instead scored with QuickScorer (Lucchese et al., 2015):
+// each tree has a bitvector of its candidate exit leaves, the nodes of every feature are visited in
+// threshold order and each failed test clears the leaves of its true subtree, and the exit leaf is the
+// lowest bit left set. This replaces the data dependent walk by a scan that stops at the first passed test.
+class TreeEnsembleCompiled {
+ public:
+  TreeEnsembleCompiled() = default;
+
+  // num_targets is the minimum number of score slots per row; it is raised to cover every id in target_ids.
+  void Initialize(int64_t num_targets,
+                  const std::vector<int64_t>& nodes_treeids,
+                  const std::vector<int64_t>& nodes_nodeids,
+                  const std::vector<int64_t>& nodes_featureids,
+                  const std::vector<float>& nodes_values,
+                  const std::vector<NODE_MODE>& nodes_modes,
+                  const std::vector<int64_t>& nodes_truenodeids,
+                  const std::vector<int64_t>& nodes_falsenodeids,
+                  const std::vector<int64_t>& missing_tracks_true,
+                  const std::vector<int64_t>& target_treeids,
+                  const std::vector<int64_t>& target_nodeids,
+                  const std::vector<int64_t>& target_ids,
+                  const std::vector<float>& target_weights);
+
+  size_t NumTrees() const { return roots_.size(); }
+
+  // Number of score slots per row.
+  int64_t NumTargets() const { return num_targets_; }
+
+  // Largest feature index read by any branch node, or -1 if the trees are all leaves.
+  int64_t MaxFeatureId() const { return max_feature_id_; }
+
+  // True if the ensemble is scored with QuickScorer rather than by walking the trees.
+  bool UsesQuickScorer() const { return use_quickscorer_; }
+
+  // Adds the leaf weights reached by each of the N rows of x_data to scores, which is [N, NumTargets()],
+  // and sets the matching entries of has_score to 1. When the trees are split over threads the partial
+  // sums are added in a fixed order, so the result only depends on the number of threads.
+  template <typename T>
+  void ComputeScores(const T* x_data, int64_t N, int64_t stride, float* scores, uint8_t* has_score) const;
+
+ private:
+  void InitializeQuickScorer();
+
+  void AddLeafWeights(const TreeNodeElement& leaf, float* row_scores, uint8_t* row_has_score) const;
+
+  template <typename T>
+  void ComputeScoresQuickScorer(const T* x_data, int64_t N, int64_t stride, float* scores, uint8_t* has_score) const;
+
+  template <typename T>
+  void ComputeScoresRange(const T* x_data, int64_t N, int64_t stride, size_t tree_begin, size_t tree_end,
+                          float* scores, uint8_t* has_score) const;
+
+  template <typename T, bool AllBranchLeq>
+  void ComputeScoresBlock(const T* x_data, int64_t count, int64_t stride, size_t tree_begin, size_t tree_end,
+                          float* scores, uint8_t* has_score) const;
+
+  std::vector<TreeNodeElement> nodes_;
+  std::vector<TreeLeafWeight> weights_;
+  std::vector<uint32_t> roots_;
+  int64_t num_targets_ = 0;
+  int64_t max_feature_id_ = -1;
+  bool all_branch_leq_ = true;
+
+  bool use_quickscorer_ = false;
+  std::vector<TreeFeatureNodes> qs_features_;
+  std::vector<TreeFalseNodeMask> qs_nodes_;
+  std::vector<uint32_t> qs_leaves_;
+  std::vector<uint32_t> qs_leaf_offsets_;
+};
+
+// Number of rows walked through a tree together.
+static constexpr int64_t kTreeEnsembleRowBlock = 8;
+
+// Minimum number of trees given to a thread when the trees of a small batch are split over threads.
+static constexpr size_t kTreeEnsembleMinTreesPerThread = 16;
+
+// Below this many row by tree walks the scores are computed on the calling thread.
+static constexpr int64_t kTreeEnsembleMinParallelWalks = 4096;
+
+// QuickScorer is used for ensembles with at least this many trees, none with more leaves than bits in
+// the leaf bitvector.
+static constexpr size_t kTreeEnsembleQuickScorerMinTrees = 16;
+static constexpr size_t kTreeEnsembleQuickScorerMaxLeaves = 64;
+
+// Walks that have not reached a leaf after this many steps are abandoned, as in the original kernels.
+static constexpr int kTreeEnsembleMaxDepth = 1000;
+
+template <typename T>
+inline bool TreeEnsembleIsMissing(T val) {
+  return std::isnan(static_cast<float>(val));
+}
+
+template <typename T, bool AllBranchLeq>
+inline uint32_t TreeEnsembleNextNode(const TreeNodeElement& node, const T* x_row) {
+  const T val = x_row[node.feature_id];
+  const float threshold = node.value;
+  bool cond;
+  if (AllBranchLeq) {
+    cond = val <= threshold;
+  } else {
+    switch (node.mode) {
+      case NODE_MODE::BRANCH_LEQ:
+        cond = val <= threshold;
+        break;
+      case NODE_MODE::BRANCH_LT:
+        cond = val < threshold;
+        break;
+      case NODE_MODE::BRANCH_GTE:
+        cond = val >= threshold;
+        break;
+      case NODE_MODE::BRANCH_GT:
+        cond = val > threshold;
+        break;
+      case NODE_MODE::BRANCH_EQ:
+        cond = val == threshold;
+        break;
+      default:
+        cond = val != threshold;
+        break;
+    }
+  }
+  return (cond || (node.missing_tracks_true && TreeEnsembleIsMissing(val))) ? node.truenode : node.falsenode;
+}
+
+// Index of the lowest set bit of a non-zero value.
+inline uint32_t TreeEnsembleLowestBit(uint64_t value) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward64(&index, value);
+  return static_cast<uint32_t>(index);
+#else
+  return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+}
+
+inline void TreeEnsembleCompiled::AddLeafWeights(const TreeNodeElement& leaf, float* row_scores,
+                                                 uint8_t* row_has_score) const {
+  if (leaf.truenode == 1) {
+    row_scores[leaf.feature_id] += leaf.value;
+    row_has_score[leaf.feature_id] = 1;
+  } else {
+    const TreeLeafWeight* weight = weights_.data() + leaf.feature_id;
+    for (uint32_t w = 0; w < leaf.truenode; ++w, ++weight) {
+      row_scores[weight->target_id] += weight->value;
+      row_has_score[weight->target_id] = 1;
+    }
+  }
+}
+
+template <typename T>
+void TreeEnsembleCompiled::ComputeScoresQuickScorer(const T* x_data, int64_t N, int64_t stride,
+                                                    float* scores, uint8_t* has_score) const {
+  const size_t num_trees = roots_.size();
+  std::vector<uint64_t> leaves(num_trees);
+
+  for (int64_t i = 0; i < N; ++i) {
+    const T* x_row = x_data + i * stride;
+    std::fill(leaves.begin(), leaves.end(), ~uint64_t{0});
+
+    for (const TreeFeatureNodes& feature : qs_features_) {
+      const T val = x_row[feature.feature_id];
+      // thresholds are ascending, so the tests of this feature fail up to the first one that passes
+      for (uint32_t k = feature.begin; k < feature.end; ++k) {
+        const TreeFalseNodeMask& node = qs_nodes_[k];
+        if (val <= node.value) break;
+        leaves[node.tree_id] &= node.leaves_mask;
+      }
+    }
+
+    float* row_scores = scores + i * num_targets_;
+    uint8_t* row_has_score = has_score + i * num_targets_;
+    for (size_t tree = 0; tree < num_trees; ++tree) {
+      const uint32_t leaf = qs_leaves_[qs_leaf_offsets_[tree] + TreeEnsembleLowestBit(leaves[tree])];
+      AddLeafWeights(nodes_[leaf], row_scores, row_has_score);
+    }
+  }
+}
+
+template <typename T, bool AllBranchLeq>
+void TreeEnsembleCompiled::ComputeScoresBlock(const T* x_data, int64_t count, int64_t stride,
+                                              size_t tree_begin, size_t tree_end,
+                                              float* scores, uint8_t* has_score) const {
+  const TreeNodeElement* nodes = nodes_.data();
+  uint32_t current[kTreeEnsembleRowBlock];
+
+  for (size_t tree = tree_begin; tree < tree_end; ++tree) {
+    const uint32_t root = roots_[tree];
+    for (int64_t r = 0; r < count; ++r) {
+      current[r] = root;
+    }
+
+    // advance every row of the block by one level per pass until they have all reached a leaf
+    for (int depth = 0; depth <= kTreeEnsembleMaxDepth; ++depth) {
+      bool active = false;
+      for (int64_t r = 0; r < count; ++r) {
+        const TreeNodeElement& node = nodes[current[r]];
+        if (node.mode != NODE_MODE::LEAF) {
+          current[r] = TreeEnsembleNextNode<T, AllBranchLeq>(node, x_data + r * stride);
+          active = true;
+        }
+      }
+      if (!active) break;
+    }
+
+    for (int64_t r = 0; r < count; ++r) {
+      const TreeNodeElement& leaf = nodes[current[r]];
+      if (leaf.mode != NODE_MODE::LEAF) continue;
+      AddLeafWeights(leaf, scores + r * num_targets_, has_score + r * num_targets_);
+    }
+  }
+}
+
+template <typename T>
+void TreeEnsembleCompiled::ComputeScoresRange(const T* x_data, int64_t N, int64_t stride,
+                                              size_t tree_begin, size_t tree_end,
+                                              float* scores, uint8_t* has_score) const {
+  for (int64_t i = 0; i < N; i += kTreeEnsembleRowBlock) {
+    const int64_t count = std::min(kTreeEnsembleRowBlock, N - i);
+    if (all_branch_leq_) {
+      ComputeScoresBlock<T, true>(x_data + i * stride, count, stride, tree_begin, tree_end,
+                                  scores + i * num_targets_, has_score + i * num_targets_);
+    } else {
+      ComputeScoresBlock<T, false>(x_data + i * stride, count, stride, tree_begin, tree_end,
+                                   scores + i * num_targets_, has_score + i * num_targets_);
+    }
+  }
+}
+
+template <typename T>
+void TreeEnsembleCompiled::ComputeScores(const T* x_data, int64_t N, int64_t stride,
+                                         float* scores, uint8_t* has_score) const {
+  const size_t num_trees = roots_.size();
+  int64_t num_threads = 1;
+#ifdef USE_OPENMP
+  num_threads = omp_get_max_threads();
+#endif
+
+  if (num_threads == 1 || N * static_cast<int64_t>(num_trees) < kTreeEnsembleMinParallelWalks) {
+    if (use_quickscorer_) {
+      ComputeScoresQuickScorer(x_data, N, stride, scores, has_score);
+    } else {
+      ComputeScoresRange(x_data, N, stride, 0, num_trees, scores, has_score);
+    }
+    return;
+  }
+
+  // QuickScorer visits every tree for a row, so it is only split by rows
+  const int64_t num_row_blocks = (N + kTreeEnsembleRowBlock - 1) / kTreeEnsembleRowBlock;
+  if (num_row_blocks >= num_threads || use_quickscorer_) {
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int64_t b = 0; b < num_row_blocks; ++b) {
+      const int64_t i = b * kTreeEnsembleRowBlock;
+      const int64_t count = std::min(kTreeEnsembleRowBlock, N - i);
+      if (use_quickscorer_) {
+        ComputeScoresQuickScorer(x_data + i * stride, count, stride,
+                                 scores + i * num_targets_, has_score + i * num_targets_);
+      } else {
+        ComputeScoresRange(x_data + i * stride, count, stride, 0, num_trees,
+                           scores + i * num_targets_, has_score + i * num_targets_);
+      }
+    }
+    return;
+  }
+
+  // Too few rows to occupy the threads: split the trees instead. The first chunk adds to the caller's
+  // scores, the others to zeroed buffers that are folded in afterwards in chunk order.
+  const int64_t num_chunks = std::min(num_threads,
+                                      static_cast<int64_t>(std::max<size_t>(num_trees / kTreeEnsembleMinTreesPerThread, 1)));
+  const int64_t chunk_size = N * num_targets_;
+  std::vector<float> chunk_scores((num_chunks - 1) * chunk_size, 0.f);
+  std::vector<uint8_t> chunk_has_score((num_chunks - 1) * chunk_size, 0);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int64_t c = 0; c < num_chunks; ++c) {
+    const size_t tree_begin = num_trees * c / num_chunks;
+    const size_t tree_end = num_trees * (c + 1) / num_chunks;
+    if (c == 0) {
+      ComputeScoresRange(x_data, N, stride, tree_begin, tree_end, scores, has_score);
+    } else {
+      ComputeScoresRange(x_data, N, stride, tree_begin, tree_end,
+                         chunk_scores.data() + (c - 1) * chunk_size, chunk_has_score.data() + (c - 1) * chunk_size);
+    }
+  }
+
+  for (int64_t c = 1; c < num_chunks; ++c) {
+    const float* partial_scores = chunk_scores.data() + (c - 1) * chunk_size;
+    const uint8_t* partial_has_score = chunk_has_score.data() + (c - 1) * chunk_size;
+    for (int64_t k = 0; k < chunk_size; ++k) {
+      scores[k] += partial_scores[k];
+      has_score[k] |= partial_has_score[k];
+    }
+  }
+}
+
+}  // namespace ml
+}  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/ml/zipmap.h"
 #include "core/util/math_cpuonly.h"
+#include <algorithm>
 /**
 https://github.com/onnx/onnx/blob/master/onnx/defs/traditionalml/defs.cc
 ONNX_OPERATOR_SCHEMA(ZipMap)
@@ -42,6 +43,18 @@ ZipMapOp::ZipMapOp(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.empty() ^ classlabels_int64s_.empty(),
               "Must provide classlabels_strings or classlabels_int64s but not both.");
   using_strings_ = !classlabels_strings_.empty();
+  columnar_int64_keys_ = std::make_shared<const std::vector<int64_t>>(classlabels_int64s_);
+  columnar_string_keys_ = std::make_shared<const std::vector<std::string>>(classlabels_strings_);
+}
+
+// Writes the rows of X to a columnar output, which the caller asks for by providing the output value
+// preallocated with that type (see RunOptions::columnar_map_sequences).
+template <typename TKey>
+static void WriteColumnar(const float* x_data, int64_t batch_size, int64_t features_per_batch,
+                          const std::shared_ptr<const std::vector<TKey>>& keys,
+                          ColumnarMapSequence<TKey, float>& y) {
+  y.Reset(keys, static_cast<size_t>(batch_size));
+  std::copy_n(x_data, batch_size * features_per_batch, y.MutableValues());
 }
 
 common::Status ZipMapOp::Compute(OpKernelContext* context) const {
@@ -75,6 +88,11 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
                     "Input features_per_batch[" + std::to_string(features_per_batch) +
                         "] != number of classlabels[" + std::to_string(classlabels_strings_.size()) + "]");
     }
+    if (context->OutputType(0) == DataTypeImpl::GetType<ColumnarMapStringToFloat>()) {
+      WriteColumnar(x_data, batch_size, features_per_batch, columnar_string_keys_,
+                    *context->Output<ColumnarMapStringToFloat>(0));
+      return common::Status::OK();
+    }
     auto* y_data = context->Output<std::vector<std::map<std::string, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
 
@@ -96,6 +114,11 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
                     "Input features_per_batch[" + std::to_string(features_per_batch) +
                         "] != number of classlabels[" + std::to_string(classlabels_int64s_.size()) + "]");
     }
+    if (context->OutputType(0) == DataTypeImpl::GetType<ColumnarMapInt64ToFloat>()) {
+      WriteColumnar(x_data, batch_size, features_per_batch, columnar_int64_keys_,
+                    *context->Output<ColumnarMapInt64ToFloat>(0));
+      return common::Status::OK();
+    }
     auto* y_data = context->Output<std::vector<std::map<std::int64_t, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
     //auto* y_data = Y->template MutableData<std::vector<std::map<int64_t, float>>>();
@@ -16,6 +16,9 @@ class ZipMapOp final : public OpKernel {
   bool using_strings_;
   std::vector<int64_t> classlabels_int64s_;
   std::vector<std::string> classlabels_strings_;
+  // key tables shared by every columnar output of this kernel
+  std::shared_ptr<const std::vector<int64_t>> columnar_int64_keys_;
+  std::shared_ptr<const std::vector<std::string>> columnar_string_keys_;
 };
 
 }  // namespace ml
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/nn/roi_pool.h"
 #include <cmath>
+#include <vector>
 
 namespace onnxruntime {
 ONNX_CPU_OPERATOR_KERNEL(
@@ -35,6 +36,18 @@ Status RoiPool<float>::Compute(OpKernelContext* context) const {
 
   float* Ydata = Y->template MutableData<float>();
 
+  // the pooling region of an output unit only depends on the ROI, so the row range of each ph and the column range
+  // of each pw are computed once per ROI and shared by all the channels.
+  // each ROI has pooled_height_ row ranges followed by pooled_width_ column ranges.
+  struct BinRange {
+    int start;  // included
+    int end;    // excluded
+  };
+
+  const int64_t ranges_per_roi = pooled_height_ + pooled_width_;
+  std::vector<BinRange> bin_ranges(num_rois * ranges_per_roi);
+  std::vector<int> roi_batch_ids(num_rois);
+
   for (int n = 0; n < num_rois; n++) {
     int roi_batch_id = static_cast<int>(rois[0]);
     int roi_start_w = static_cast<int>(round(rois[1] * spatial_scale_));
@@ -43,6 +56,7 @@ Status RoiPool<float>::Compute(OpKernelContext* context) const {
     int roi_end_h = static_cast<int>(round(rois[4] * spatial_scale_));
     ORT_ENFORCE(roi_batch_id >= 0);
     ORT_ENFORCE(roi_batch_id < batch_size);
+    roi_batch_ids[n] = roi_batch_id;
 
     // Force malformed ROIs to be 1x1
     int roi_height = std::max(roi_end_h - roi_start_h + 1, 1);
@@ -53,49 +67,68 @@ Status RoiPool<float>::Compute(OpKernelContext* context) const {
     const float bin_size_w =
         static_cast<float>(roi_width) / static_cast<float>(pooled_width_);
 
-    const float* batch_data = Xdata + roi_batch_id * X->Shape().SizeFromDimension(1);
-
-    for (int c = 0; c < channels; ++c) {
-      for (int ph = 0; ph < pooled_height_; ++ph) {
-        for (int pw = 0; pw < pooled_width_; ++pw) {
-          // Compute pooling region for this output unit:
-          //  start (included) = floor(ph * roi_height / pooled_height_)
-          //  end (excluded) = ceil((ph + 1) * roi_height / pooled_height_)
-          int hstart =
-              static_cast<int>(floor(static_cast<float>(ph) * bin_size_h));
-          int wstart =
-              static_cast<int>(floor(static_cast<float>(pw) * bin_size_w));
-          int hend =
-              static_cast<int>(ceil(static_cast<float>(ph + 1) * bin_size_h));
-          int wend =
-              static_cast<int>(ceil(static_cast<float>(pw + 1) * bin_size_w));
-
-          // Add roi offsets and clip to input boundaries
-          hstart = std::min(std::max(hstart + roi_start_h, 0), height);
-          hend = std::min(std::max(hend + roi_start_h, 0), height);
-          wstart = std::min(std::max(wstart + roi_start_w, 0), width);
-          wend = std::min(std::max(wend + roi_start_w, 0), width);
-
-          const int pool_index = static_cast<int>(ph * pooled_width_ + pw);
-
-          // Define an empty pooling region to be zero
-          bool is_empty = (hend <= hstart) || (wend <= wstart);
-          Ydata[pool_index] = is_empty ? 0 : std::numeric_limits<float>::lowest();
-
-          for (int h = hstart; h < hend; ++h) {
-            for (int w = wstart; w < wend; ++w) {
-              const int index = h * width + w;
-              Ydata[pool_index] = std::max(batch_data[index], Ydata[pool_index]);
-            }
+    // Compute pooling region for each output unit:
+    //  start (included) = floor(ph * roi_height / pooled_height_)
+    //  end (excluded) = ceil((ph + 1) * roi_height / pooled_height_)
+    // then add roi offsets and clip to input boundaries
+    BinRange* h_ranges = bin_ranges.data() + n * ranges_per_roi;
+    for (int ph = 0; ph < pooled_height_; ++ph) {
+      int hstart = static_cast<int>(floor(static_cast<float>(ph) * bin_size_h));
+      int hend = static_cast<int>(ceil(static_cast<float>(ph + 1) * bin_size_h));
+      h_ranges[ph].start = std::min(std::max(hstart + roi_start_h, 0), height);
+      h_ranges[ph].end = std::min(std::max(hend + roi_start_h, 0), height);
+    }
+
+    BinRange* w_ranges = h_ranges + pooled_height_;
+    for (int pw = 0; pw < pooled_width_; ++pw) {
+      int wstart = static_cast<int>(floor(static_cast<float>(pw) * bin_size_w));
+      int wend = static_cast<int>(ceil(static_cast<float>(pw + 1) * bin_size_w));
+      w_ranges[pw].start = std::min(std::max(wstart + roi_start_w, 0), width);
+      w_ranges[pw].end = std::min(std::max(wend + roi_start_w, 0), width);
+    }
+
+    // Increment ROI data pointer
+    rois += R->Shape().SizeFromDimension(1);
+  }
+
+  const int64_t channel_size = X->Shape().SizeFromDimension(2);
+  const int64_t pooled_size = Y->Shape().SizeFromDimension(2);
+  const int64_t total_roi_channels = static_cast<int64_t>(num_rois) * channels;
+
+  // every (roi, channel) pair writes its own output plane, so they can be processed in any order
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int64_t i = 0; i < total_roi_channels; ++i) {
+    const int64_t n = i / channels;
+    const int64_t c = i % channels;
+    const float* channel_data = Xdata + (roi_batch_ids[n] * channels + c) * channel_size;
+    float* pooled_data = Ydata + i * pooled_size;
+    const BinRange* h_ranges = bin_ranges.data() + n * ranges_per_roi;
+    const BinRange* w_ranges = h_ranges + pooled_height_;
+
+    for (int ph = 0; ph < pooled_height_; ++ph) {
+      const int hstart = h_ranges[ph].start;
+      const int hend = h_ranges[ph].end;
+
+      for (int pw = 0; pw < pooled_width_; ++pw) {
+        const int wstart = w_ranges[pw].start;
+        const int wend = w_ranges[pw].end;
+
+        // Define an empty pooling region to be zero
+        bool is_empty = (hend <= hstart) || (wend <= wstart);
+        float pooled_value = is_empty ? 0 : std::numeric_limits<float>::lowest();
+
+        for (int h = hstart; h < hend; ++h) {
+          const float* row = channel_data + h * width;
+          for (int w = wstart; w < wend; ++w) {
+            pooled_value = std::max(row[w], pooled_value);
           }
         }
+
+        pooled_data[ph * pooled_width_ + pw] = pooled_value;
       }
-      // Increment all data pointers by one channel
-      batch_data += X->Shape().SizeFromDimension(2);
-      Ydata += Y->Shape().SizeFromDimension(2);
     }
-    // Increment ROI data pointer
-    rois += R->Shape().SizeFromDimension(1);
   }
 
   return Status::OK();
@@ -6,10 +6,11 @@
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
 
-#include <functional>
-#include <unordered_set>
-#include <ostream>
-#include <iterator>
+#include "core/providers/cpu/ml/hash_index.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
 
 namespace onnxruntime {
 
@@ -42,148 +43,122 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
 
 namespace ngram_details {
 
-class NgramEntryBase {
-  size_t id_;  // Id in the pool
- protected:
-  NgramEntryBase(size_t id) : id_(id) {}
-  ~NgramEntryBase() = default;
-
+/**
+Trie of the pool n-grams over token ids, a token id being the position of an item in the
+vocabulary of the pool. Every node is the prefix of at least one n-gram, so a walk over the
+input stops at the first prefix that is not in the pool. After Freeze() the children are
+looked up in one flat open addressing table keyed by (node, token).
+*/
+class NgramTrie {
  public:
-  size_t Id() const { return id_; }
-};
+  static constexpr int32_t kNone = -1;
 
-template <class T>
-class NgramEntry;
+  NgramTrie() : ngram_ids_(1, kNone) {}
 
-template <>
-class NgramEntry<int64_t> : public NgramEntryBase {
-  std::vector<int64_t> items_;
-  size_t hash_ = 0;
+  static constexpr int32_t Root() { return 0; }
 
-  void RunningHash(int64_t v) {
-    std::hash<int64_t> hf{};
-    hash_ ^= hf(v) + 0x9e3779b9 + (hash_ << 6) + (hash_ >> 2);
+  // Returns the child of node for token, creates it if needed. Only before Freeze().
+  int32_t AddChild(int32_t node, int32_t token) {
+    auto p = building_.emplace(Key(node, token), static_cast<int32_t>(ngram_ids_.size()));
+    if (p.second) {
+      ORT_ENFORCE(ngram_ids_.size() < static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                  "Too many n-gram prefixes in the pool");
+      ngram_ids_.push_back(kNone);
+    }
+    return p.first->second;
   }
 
- public:
-  template <typename ForwardIter>
-  explicit NgramEntry(size_t id, ForwardIter first, ForwardIter last) : NgramEntryBase(id) {
-    while (first != last) {
-      RunningHash(*first);
-      items_.push_back(*first);
-      ++first;
+  // Returns false if an n-gram already ends at node
+  bool SetNgramId(int32_t node, int64_t ngram_id) {
+    if (ngram_ids_[node] != kNone) {
+      return false;
     }
-    assert(!items_.empty());
-  }
-  // For sampling
-  explicit NgramEntry() : NgramEntryBase(0) {}
-  void AddItem(int64_t v) {
-    items_.push_back(v);
-    RunningHash(v);
-  }
-  void DebugPrint() const {
-    std::copy(items_.cbegin(), items_.cend(), std::ostream_iterator<int64_t>(std::cout, ","));
-    std::cout << std::endl;
+    ngram_ids_[node] = ngram_id;
+    return true;
   }
-  void Clear() {
-    items_.clear();
-    hash_ = 0;
-  }
-  bool operator==(const NgramEntry& o) const {
-    return items_ == o.items_;
+
+  void Freeze() {
+    // at most half full
+    size_t capacity = 16;
+    while (capacity < 2 * building_.size()) capacity *= 2;
+    mask_ = capacity - 1;
+    slots_.assign(capacity, Slot());
+    for (const auto& child : building_) {
+      size_t s = ml::HashIndexMix(child.first) & mask_;
+      while (slots_[s].key != kEmpty) s = (s + 1) & mask_;
+      slots_[s].key = child.first;
+      slots_[s].child = child.second;
+    }
+    building_.clear();
   }
-  size_t Hash() const {
-    return hash_;
+
+  // Returns the child of node for token or kNone
+  int32_t Child(int32_t node, int32_t token) const {
+    const uint64_t key = Key(node, token);
+    for (size_t s = ml::HashIndexMix(key) & mask_;; s = (s + 1) & mask_) {
+      const Slot& slot = slots_[s];
+      if (slot.key == key) return slot.child;
+      if (slot.key == kEmpty) return kNone;
+    }
   }
-};
 
-template <>
-class NgramEntry<int32_t> : public NgramEntry<int64_t> {
- public:
-  template <typename ForwardIter>
-  explicit NgramEntry(size_t id, ForwardIter first, ForwardIter last) : NgramEntry<int64_t>(id, first, last) {}
-  explicit NgramEntry() = default;
-};
+  // Id in the pool of the n-gram that ends at node or kNone
+  int64_t NgramId(int32_t node) const { return ngram_ids_[node]; }
 
-template <>
-class NgramEntry<std::string> : public NgramEntryBase {
  private:
-  std::vector<std::reference_wrapper<const std::string>> items_;
-  size_t hash_ = 0;
+  // node and token are non negative so a key never has the high bit set
+  static constexpr uint64_t kEmpty = ~uint64_t{0};
 
-  void RunningHash(const std::string& s) {
-    std::hash<std::string> hf{};
-    hash_ ^= hf(s) + 0x9e3779b9 + (hash_ << 6) + (hash_ >> 2);
+  static uint64_t Key(int32_t node, int32_t token) {
+    return (static_cast<uint64_t>(node) << 32) | static_cast<uint32_t>(token);
   }
 
+  struct Slot {
+    uint64_t key = kEmpty;
+    int32_t child = kNone;
+  };
+
+  std::unordered_map<uint64_t, int32_t> building_;
+  std::vector<Slot> slots_;
+  size_t mask_ = 0;
+  std::vector<int64_t> ngram_ids_;
+};
+
+constexpr int32_t NgramTrie::kNone;
+constexpr uint64_t NgramTrie::kEmpty;
+
+// Assigns token ids to the pool items while the n-grams are added to the trie
+template <class T>
+class NgramTrieBuilder {
  public:
+  explicit NgramTrieBuilder(NgramTrie& trie) : trie_(trie) {}
+
+  // Returns false on duplicate n-grams
   template <typename ForwardIter>
-  explicit NgramEntry(size_t id, ForwardIter first, ForwardIter last) : NgramEntryBase(id) {
-    while (first != last) {
-      RunningHash(*first);
-      items_.push_back(std::cref(*first));
-      ++first;
+  bool Add(ForwardIter first, size_t ngram_size, int64_t ngram_id) {
+    int32_t node = NgramTrie::Root();
+    for (size_t i = 0; i < ngram_size; ++i, ++first) {
+      auto p = ids_.emplace(*first, static_cast<int32_t>(vocabulary_.size()));
+      if (p.second) {
+        vocabulary_.push_back(*first);
+      }
+      node = trie_.AddChild(node, p.first->second);
     }
-    assert(!items_.empty());
-  }
-  explicit NgramEntry() : NgramEntryBase(0) {}
-  void AddItem(const std::string& s) {
-    items_.push_back(std::cref(s));
-    RunningHash(s);
-  }
-  void DebugPrint() const {
-    std::copy(items_.cbegin(), items_.cend(), std::ostream_iterator<std::string>(std::cout, ","));
-    std::cout << std::endl;
-  }
-  void Clear() {
-    items_.clear();
-    hash_ = 0;
+    return trie_.SetNgramId(node, ngram_id);
   }
 
-  bool operator==(const NgramEntry& o) const {
-    if (items_.size() == o.items_.size()) {
-      return std::equal(items_.cbegin(), items_.cend(),
-                        o.items_.cbegin(), o.items_.cend(),
-                        std::equal_to<std::string>());
-    }
-    return false;
-  }
-  size_t Hash() const {
-    return hash_;
-  }
-};
+  // Items in token id order
+  const std::vector<T>& Vocabulary() const { return vocabulary_; }
 
-using IntegerPoolSet = std::unordered_set<NgramEntry<int64_t>>;
-// Does not own strings, contains references to them. This helps
-// to search by string references that point to the current input.
-using StringPoolSet = std::unordered_set<NgramEntry<std::string>>;
-
-template <typename ForwardIter, typename Cont>
-inline void Emplace(ForwardIter first, size_t ngrams, size_t ngram_size, size_t& ngram_id, Cont& c) {
-  for (; ngrams > 0; --ngrams) {
-    c.emplace(ngram_id, first, first + ngram_size);
-    first += ngram_size;
-    ++ngram_id;
-  }
-}
+ private:
+  NgramTrie& trie_;
+  std::unordered_map<T, int32_t> ids_;
+  std::vector<T> vocabulary_;
+};
 
 }  // namespace ngram_details
-}  // namespace onnxruntime
-
-using namespace onnxruntime::ngram_details;
-
-namespace std {
-template <typename T>
-struct hash<NgramEntry<T>> {
-  typedef NgramEntry<T> argument_type;
-  typedef size_t result_type;
-  result_type operator()(const argument_type& a) const {
-    return a.Hash();
-  }
-};
-}  // namespace std
 
-namespace onnxruntime {
+using namespace ngram_details;
 
 // The weighting criteria.
 // "TF"(term frequency),
@@ -219,12 +194,10 @@ struct TfIdfVectorizer::Impl {
   std::vector<int64_t> ngram_indexes_;
   std::vector<float> weights_;
 
-  std::vector<std::string> pool_strings_;
-  // This set contains references to pool_string_ entries
-  // of pool_strings attribute
-  StringPoolSet str_set_;
-  // This set contains pool_int64s entries
-  IntegerPoolSet int64_set_;
+  // Token ids of the items of the loaded n-grams
+  ml::HashIndex<int64_t> int64_vocabulary_;
+  ml::HashIndex<std::string> str_vocabulary_;
+  NgramTrie trie_;
   size_t output_size_ = 0;
 
   Impl() = default;
@@ -232,49 +205,84 @@ struct TfIdfVectorizer::Impl {
   Impl(const Impl&) = delete;
   Impl& operator=(const Impl&) = delete;
 
+  // Token id of the item or NgramTrie::kNone if it is in no n-gram
   template <typename T>
-  auto PoolEnd() const;
+  int32_t TokenId(const T& item) const;
 
+  // Counts the n-grams of a row of C items into its output_size_ frequencies
   template <typename T>
-  auto PoolFind(const ngram_details::NgramEntry<T>&) const;
+  void CountRow(const T* row, size_t C, std::vector<int32_t>& tokens, uint32_t* frequencies) const;
 
-  void IncrementCount(size_t ngram_id, size_t row_num,
-                      std::vector<uint32_t>& frequencies) const {
-    assert(ngram_id < ngram_indexes_.size());
-    auto output_idx = row_num * output_size_ + ngram_indexes_[ngram_id];
-    assert(static_cast<size_t>(output_idx) < frequencies.size());
+  void IncrementCount(int64_t ngram_id, uint32_t* frequencies) const {
+    assert(static_cast<size_t>(ngram_id) < ngram_indexes_.size());
+    auto output_idx = ngram_indexes_[ngram_id];
+    assert(static_cast<size_t>(output_idx) < output_size_);
     ++frequencies[output_idx];
   }
 };
 
 template <>
-inline auto TfIdfVectorizer::Impl::PoolEnd<int64_t>() const {
-  return int64_set_.cend();
+inline int32_t TfIdfVectorizer::Impl::TokenId<int64_t>(const int64_t& item) const {
+  return static_cast<int32_t>(int64_vocabulary_.FindFirst(item));
 }
 
 template <>
-inline auto TfIdfVectorizer::Impl::PoolEnd<int32_t>() const {
-  return PoolEnd<int64_t>();
+inline int32_t TfIdfVectorizer::Impl::TokenId<int32_t>(const int32_t& item) const {
+  return static_cast<int32_t>(int64_vocabulary_.FindFirst(item));
 }
 
 template <>
-inline auto TfIdfVectorizer::Impl::PoolEnd<std::string>() const {
-  return str_set_.cend();
+inline int32_t TfIdfVectorizer::Impl::TokenId<std::string>(const std::string& item) const {
+  return static_cast<int32_t>(str_vocabulary_.FindFirst(item));
 }
 
-template <>
-inline auto TfIdfVectorizer::Impl::PoolFind<int64_t>(const NgramEntry<int64_t>& i) const {
-  return int64_set_.find(i);
-}
+template <typename T>
+void TfIdfVectorizer::Impl::CountRow(const T* row, size_t C, std::vector<int32_t>& tokens,
+                                     uint32_t* frequencies) const {
+  // Each item is looked up once, the n-grams are then walked over token ids
+  tokens.resize(C);
+  for (size_t i = 0; i < C; ++i) {
+    tokens[i] = TokenId<T>(row[i]);
+  }
 
-template <>
-inline auto TfIdfVectorizer::Impl::PoolFind<int32_t>(const NgramEntry<int32_t>& i) const {
-  return int64_set_.find(i);
-}
+  auto start_ngram_size = min_gram_length_;
+  // Treat 1-grams in a special way
+  if (start_ngram_size == 1) {
+    for (size_t i = 0; i < C; ++i) {
+      if (tokens[i] == NgramTrie::kNone) continue;
+      const int32_t node = trie_.Child(NgramTrie::Root(), tokens[i]);
+      if (node != NgramTrie::kNone && trie_.NgramId(node) != NgramTrie::kNone) {
+        IncrementCount(trie_.NgramId(node), frequencies);
+      }
+    }
+    if (++start_ngram_size > max_gram_length_) {
+      return;
+    }
+  }
 
-template <>
-inline auto TfIdfVectorizer::Impl::PoolFind<std::string>(const NgramEntry<std::string>& i) const {
-  return str_set_.find(i);
+  const int64_t max_skip_distance = max_skip_count_ + 1;  // Convert to distance
+  for (int64_t skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
+    for (size_t ngram_start = 0; ngram_start < C; ++ngram_start) {
+      // At least items of start_ngram_size should fit before the end of the row
+      if (ngram_start + skip_distance * (start_ngram_size - 1) >= C) {
+        break;
+      }
+      int32_t node = NgramTrie::Root();
+      size_t ngram_item = ngram_start;
+      for (int64_t ngram_size = 1;
+           ngram_size <= max_gram_length_ && ngram_item < C;
+           ++ngram_size, ngram_item += skip_distance) {
+        if (tokens[ngram_item] == NgramTrie::kNone) break;
+        node = trie_.Child(node, tokens[ngram_item]);
+        // no n-gram in the pool starts with these items
+        if (node == NgramTrie::kNone) break;
+        // Do not count anything before start_ngram_size
+        if (ngram_size >= start_ngram_size && trie_.NgramId(node) != NgramTrie::kNone) {
+          IncrementCount(trie_.NgramId(node), frequencies);
+        }
+      }
+    }
+  }
 }
 
 TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), impl_(new Impl) {
@@ -334,18 +342,21 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
   }
 
   std::vector<int64_t> pool_int64s;
-  status = info.GetAttrs("pool_strings", impl_->pool_strings_);
+  std::vector<std::string> pool_strings;
+  status = info.GetAttrs("pool_strings", pool_strings);
   if (status.IsOK()) {
-    ORT_ENFORCE(!impl_->pool_strings_.empty(), "pool_strings must not be empty if specified");
+    ORT_ENFORCE(!pool_strings.empty(), "pool_strings must not be empty if specified");
   } else {
     status = info.GetAttrs("pool_int64s", pool_int64s);
     ORT_ENFORCE(status.IsOK() && !pool_int64s.empty(), "non-empty pool_int64s is required if pool_strings not provided");
   }
 
   // Iterator via the pool. Insert 1 item for 1-grams, 2 items for 2-grams, etc.
-  const auto total_items = (impl_->pool_strings_.empty()) ? pool_int64s.size() : impl_->pool_strings_.size();
+  const auto total_items = (pool_strings.empty()) ? pool_int64s.size() : pool_strings.size();
+  NgramTrieBuilder<int64_t> int64_builder(impl_->trie_);
+  NgramTrieBuilder<std::string> str_builder(impl_->trie_);
   size_t ngram_id = 0;
-  // Load into dictionary only required gram sizes
+  // Load into the trie only required gram sizes
   const size_t min_gram_length = impl_->min_gram_length_;
   const size_t max_gram_length = impl_->max_gram_length_;
   size_t ngram_size = 1;
@@ -359,16 +370,16 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       ORT_ENFORCE((items % ngram_size == 0),
                   "Number of items must compose whole ", std::to_string(ngram_size), "-grams");
       auto ngrams = items / ngram_size;
-      // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
+      // Skip loading ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
-        if (impl_->pool_strings_.empty()) {
-          auto before_insert = impl_->int64_set_.size();
-          Emplace(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_set_);
-          ORT_ENFORCE((before_insert + ngrams) == impl_->int64_set_.size(), "pool_int64s duplicate ", std::to_string(ngram_size), "-grams detected");
-        } else {
-          auto before_insert = impl_->str_set_.size();
-          Emplace(impl_->pool_strings_.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_set_);
-          ORT_ENFORCE((before_insert + ngrams) == impl_->str_set_.size(), "poll_strings duplicate ", std::to_string(ngram_size), "-grams detected");
+        for (size_t start = start_idx; start < end_idx; start += ngram_size, ++ngram_id) {
+          if (pool_strings.empty()) {
+            ORT_ENFORCE(int64_builder.Add(pool_int64s.cbegin() + start, ngram_size, ngram_id),
+                        "pool_int64s duplicate ", std::to_string(ngram_size), "-grams detected");
+          } else {
+            ORT_ENFORCE(str_builder.Add(pool_strings.cbegin() + start, ngram_size, ngram_id),
+                        "poll_strings duplicate ", std::to_string(ngram_size), "-grams detected");
+          }
         }
       } else {
         ngram_id += ngrams;
@@ -376,6 +387,9 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
     }
     ++ngram_size;
   }
+  impl_->trie_.Freeze();
+  impl_->int64_vocabulary_ = ml::HashIndex<int64_t>(int64_builder.Vocabulary());
+  impl_->str_vocabulary_ = ml::HashIndex<std::string>(str_builder.Vocabulary());
 }
 
 TfIdfVectorizer::~TfIdfVectorizer() {
@@ -436,7 +450,6 @@ void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::ve
 template <typename T>
 Status TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx) const {
   const auto& impl = *impl_;
-  auto const set_end = impl.PoolEnd<T>();
 
   auto X = ctx->Input<Tensor>(0);
   auto& input_shape = X->Shape();
@@ -477,81 +490,22 @@ Status TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx) const {
   std::vector<uint32_t> frequencies;
   frequencies.resize(b_dim * impl.output_size_, 0);
 
-  const auto max_gram_length = impl.max_gram_length_;
-  const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
-  auto start_ngram_size = impl.min_gram_length_;
+  // Every row counts into its own frequencies
+  const int64_t rows = static_cast<int64_t>(b_dim);
   auto const input_data = X->template Data<T>();
-  auto const end_data = input_data + total_items;
-  NgramEntry<T> sample;
-
-  // Treat 1-grams in a special way
-  if (start_ngram_size == 1) {
-    size_t row_num = 0;
-    auto ngram_start = input_data;
-    while (ngram_start < end_data) {
-      auto const ngram_row_end = ngram_start + C;
-      while (ngram_start < ngram_row_end) {
-        sample.Clear();
-        sample.AddItem(*ngram_start);
-        auto hit = impl.PoolFind<T>(sample);
-        if (hit != set_end) {
-          // record frequency
-          auto ngram_id = hit->Id();
-          impl.IncrementCount(ngram_id, row_num, frequencies);
-        }
-        ++ngram_start;
-      }
-      ++row_num;
-      ngram_start = ngram_row_end;
-    }
-    if (++start_ngram_size > max_gram_length) {
-      OutputResult(ctx, B, frequencies);
-      return Status::OK();
+#ifdef USE_OPENMP
+#pragma omp parallel
+#endif
+  {
+    std::vector<int32_t> tokens;  // per thread scratch
+#ifdef USE_OPENMP
+#pragma omp for
+#endif
+    for (int64_t row_num = 0; row_num < rows; ++row_num) {
+      impl.CountRow<T>(input_data + row_num * C, C, tokens, frequencies.data() + row_num * impl.output_size_);
     }
   }
 
-  for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = input_data;
-    size_t row_num = 0;
-    while (ngram_start < end_data) {
-      assert((B == 0) || (row_num < B));
-      auto const ngram_row_end = ngram_start + C;
-      assert(ngram_row_end <= end_data);
-      while (ngram_start < ngram_row_end) {
-        // Check if any n-gram size in [start_ngram_size..max_gram_length] range
-        // fit before the end of the row so we do not waste time adding [1..start_ngram_size)
-        // At least items of start_ngram_size should fit
-        // last row should match end_data
-        auto at_least_this = ngram_start + skip_distance * (start_ngram_size - 1);
-        if (at_least_this >= ngram_row_end) {
-          break;
-        }
-        sample.Clear();
-        auto ngram_item = ngram_start;
-        for (auto ngram_size = 1;
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item += skip_distance) {
-          sample.AddItem(*ngram_item);
-
-          // Do not test anything before start_ngram_size
-          if (ngram_size >= start_ngram_size) {
-            auto hit = impl.PoolFind<T>(sample);
-            if (hit != set_end) {
-              // record frequency
-              auto ngram_id = hit->Id();
-              impl.IncrementCount(ngram_id, row_num, frequencies);
-            }
-          }
-        }
-        // Sliding window shift
-        ++ngram_start;
-      }
-      // Next row
-      ngram_start = ngram_row_end;
-      ++row_num;
-    }
-  }
   OutputResult(ctx, B, frequencies);
   return Status::OK();
 }
@@ -4,6 +4,7 @@
 #include "core/providers/cpu/reduction/reduction_ops.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
 using namespace std;
 namespace onnxruntime {
 
@@ -35,11 +36,54 @@ REGISTER_UNARY_ELEMENTWISE_KERNEL(ReduceSumSquare, 1);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMax, 1);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMin, 1);
 
-// When all reduce axises located at the tail of the dims, quite general cases, transpose and extra
-// copy could be skiped to improve performance, if required by check_no_transpose = true;
-// return value: true means transposedInputData is not created/copied, input tensor data could
-//               be direct use as row major matrix [block_size, blocks], where blocks is the
-//               size of each reduce.
+// Shape of the input once size 1 axes are dropped and adjacent axes that are all kept or all reduced
+// are merged, when it takes the form [outer, reduce, inner] with the outer and inner axes kept.
+// The reduction can then walk the input in place: each of the outer * inner outputs reduces
+// reduce values that are inner elements apart.
+struct ReduceStridedShape {
+  int64_t outer;
+  int64_t reduce;
+  int64_t inner;
+};
+
+// Computes the strided shape of the input for the sorted reduced axes.
+// Returns false if the reduced axes are not contiguous after merging, e.g. reducing N and W of NCHW.
+static bool ComputeReduceStridedShape(const std::vector<int64_t>& in_dims, const std::vector<bool>& keep_axis,
+                                      ReduceStridedShape& shape) {
+  std::vector<int64_t> merged_dims;
+  std::vector<bool> merged_keep;
+  for (size_t i = 0; i < in_dims.size(); ++i) {
+    if (in_dims[i] == 1)
+      continue;
+    if (!merged_keep.empty() && merged_keep.back() == keep_axis[i]) {
+      merged_dims.back() *= in_dims[i];
+    } else {
+      merged_dims.push_back(in_dims[i]);
+      merged_keep.push_back(keep_axis[i]);
+    }
+  }
+
+  shape.outer = 1;
+  shape.reduce = 1;
+  shape.inner = 1;
+
+  size_t i = 0;
+  if (i < merged_dims.size() && merged_keep[i] && i + 1 < merged_dims.size())
+    shape.outer = merged_dims[i++];
+  if (i < merged_dims.size() && !merged_keep[i])
+    shape.reduce = merged_dims[i++];
+  if (i < merged_dims.size() && merged_keep[i])
+    shape.inner = merged_dims[i++];
+
+  return i == merged_dims.size();
+}
+
+// Computes the output shape and prepares the input for the reduction.
+// If strided_shape is provided and the reduced axes are contiguous after merging, the shape of the
+// input as [outer, reduce, inner] is returned through it and the return value is true: the input
+// tensor data is reduced in place and transposedInputData is not created.
+// Otherwise the input is transposed into transposedInputData so that it can be used as a column
+// major matrix [block_size, blocks], where blocks is the size of each reduce.
 template <typename T>
 bool PrepareForReduce(OpKernelContext* ctx,
                       std::vector<T>& transposedInputData,
@@ -48,7 +92,7 @@ bool PrepareForReduce(OpKernelContext* ctx,
                       int64_t& blocks,
                       const std::vector<int64_t>& axes_,
                       bool keepdims_,
-                      bool check_no_transpose = false) {
+                      ReduceStridedShape* strided_shape = nullptr) {
   const Tensor* input_tensor_ptr = ctx->Input<Tensor>(0);
   ORT_ENFORCE(input_tensor_ptr != nullptr);
   const Tensor& input = *input_tensor_ptr;
@@ -67,13 +111,6 @@ bool PrepareForReduce(OpKernelContext* ctx,
 
   std::sort(axes.begin(), axes.end());
 
-  // If all reduced axes are located at the tail of the input shape, then copy could be skipped is required
-  bool need_copy = true;
-  if (axes.size() <= ndim && axes.front() == static_cast<int64_t>(ndim - axes.size()) 
-      && axes.back() == static_cast<int64_t>(ndim) - 1) {
-    need_copy = false;
-  }
-
   vector<bool> keep_axis(ndim, true);
   for (auto i : axes) {
     keep_axis[i] = false;
@@ -128,7 +165,7 @@ bool PrepareForReduce(OpKernelContext* ctx,
   block_size = input.Shape().Size() / first_dim;
   blocks = first_dim;
 
-  if (!need_copy && check_no_transpose) {
+  if (strided_shape != nullptr && count > 0 && ComputeReduceStridedShape(in_dims, keep_axis, *strided_shape)) {
     return true;
   }
 
@@ -198,17 +235,150 @@ bool PrepareForReduce(OpKernelContext* ctx,
   return false;
 }
 
+// Number of inner elements that are reduced together by one unit of work when walking the input in
+// place. The inner axis is split so that there is enough parallel work when there are few outer rows.
+static constexpr int64_t kReduceInnerBlockSize = 4096;
+
+// Runs fn(outer_index, inner_begin, inner_end) over the blocks of outputs of a strided reduction.
+template <typename Func>
+static void ForEachReduceBlock(const ReduceStridedShape& shape, Func fn) {
+  const int64_t inner_blocks = (shape.inner + kReduceInnerBlockSize - 1) / kReduceInnerBlockSize;
+  const int64_t num_blocks = shape.outer * inner_blocks;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int64_t b = 0; b < num_blocks; ++b) {
+    const int64_t o = b / inner_blocks;
+    const int64_t inner_begin = (b % inner_blocks) * kReduceInnerBlockSize;
+    const int64_t inner_end = std::min(inner_begin + kReduceInnerBlockSize, shape.inner);
+    fn(o, inner_begin, inner_end);
+  }
+}
+
+// ReduceStrided: reduces the input viewed as [outer, reduce, inner] along the middle axis.
+// When inner is 1 each output is reduced from a contiguous run of the input. Otherwise each block of outputs
+// is accumulated from reduce contiguous input rows, which keeps the inner loop unit stride.
+// The Aggregator provides:
+//   Init(acc, row) / Update(acc, row): start and continue a row-wise accumulation,
+//   Finalize(acc, reduce_size): post-process the accumulated row,
+//   ReduceContiguous(values): reduce a contiguous run of values to one output.
+template <typename T, typename Aggregator>
+static void ReduceStrided(const T* input, T* output, const ReduceStridedShape& shape) {
+  if (shape.inner == 1) {
+    const int64_t reduce = shape.reduce;
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int64_t o = 0; o < shape.outer; ++o) {
+      output[o] = Aggregator::ReduceContiguous(ConstEigenVectorMap<T>(input + o * reduce, reduce));
+    }
+    return;
+  }
+
+  ForEachReduceBlock(shape, [input, output, &shape](int64_t o, int64_t inner_begin, int64_t inner_end) {
+    const int64_t count = inner_end - inner_begin;
+    const T* in = input + o * shape.reduce * shape.inner + inner_begin;
+
+    EigenVectorMap<T> acc(output + o * shape.inner + inner_begin, count);
+    Aggregator::Init(acc, ConstEigenVectorMap<T>(in, count));
+    for (int64_t r = 1; r < shape.reduce; ++r) {
+      in += shape.inner;
+      Aggregator::Update(acc, ConstEigenVectorMap<T>(in, count));
+    }
+    Aggregator::Finalize(acc, shape.reduce);
+  });
+}
+
+template <typename T>
+struct ReduceAggregatorSum {
+  static void Init(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& row) { acc = row; }
+  static void Update(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& row) { acc += row; }
+  static void Finalize(EigenVectorMap<T>&, int64_t) {}
+  static T ReduceContiguous(const ConstEigenVectorMap<T>& values) { return values.sum(); }
+};
+
+template <typename T>
+struct ReduceAggregatorMean : ReduceAggregatorSum<T> {
+  static void Finalize(EigenVectorMap<T>& acc, int64_t reduce_size) { acc /= static_cast<T>(reduce_size); }
+  static T ReduceContiguous(const ConstEigenVectorMap<T>& values) { return values.mean(); }
+};
+
+template <typename T>
+struct ReduceAggregatorLogSum : ReduceAggregatorSum<T> {
+  static void Finalize(EigenVectorMap<T>& acc, int64_t) {
+    for (int64_t i = 0; i < acc.size(); ++i)
+      acc[i] = static_cast<T>(std::log(acc[i]));
+  }
+  static T ReduceContiguous(const ConstEigenVectorMap<T>& values) { return static_cast<T>(std::log(values.sum())); }
+};
+
+template <typename T>
+struct ReduceAggregatorSumSquare {
+  static void Init(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& row) { acc = row.cwiseAbs2(); }
+  static void Update(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& row) { acc += row.cwiseAbs2(); }
+  static void Finalize(EigenVectorMap<T>&, int64_t) {}
+  static T ReduceContiguous(const ConstEigenVectorMap<T>& values) { return values.squaredNorm(); }
+};
+
+template <typename T>
+struct ReduceAggregatorL2 : ReduceAggregatorSumSquare<T> {
+  static void Finalize(EigenVectorMap<T>& acc, int64_t) {
+    for (int64_t i = 0; i < acc.size(); ++i)
+      acc[i] = static_cast<T>(std::sqrt(acc[i]));
+  }
+  static T ReduceContiguous(const ConstEigenVectorMap<T>& values) { return values.norm(); }
+};
+
+template <typename T>
+struct ReduceAggregatorL1 {
+  static void Init(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& row) { acc = row.cwiseAbs(); }
+  static void Update(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& row) { acc += row.cwiseAbs(); }
+  static void Finalize(EigenVectorMap<T>&, int64_t) {}
+  static T ReduceContiguous(const ConstEigenVectorMap<T>& values) { return values.cwiseAbs().sum(); }
+};
+
+template <typename T>
+struct ReduceAggregatorMax {
+  static void Init(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& row) { acc = row; }
+  static void Update(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& row) { acc = acc.cwiseMax(row); }
+  static void Finalize(EigenVectorMap<T>&, int64_t) {}
+  static T ReduceContiguous(const ConstEigenVectorMap<T>& values) { return values.maxCoeff(); }
+};
+
+template <typename T>
+struct ReduceAggregatorMin {
+  static void Init(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& row) { acc = row; }
+  static void Update(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& row) { acc = acc.cwiseMin(row); }
+  static void Finalize(EigenVectorMap<T>&, int64_t) {}
+  static T ReduceContiguous(const ConstEigenVectorMap<T>& values) { return values.minCoeff(); }
+};
+
+template <typename T>
+struct ReduceAggregatorProd {
+  static void Init(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& row) { acc = row; }
+  static void Update(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& row) { acc = acc.cwiseProduct(row); }
+  static void Finalize(EigenVectorMap<T>&, int64_t) {}
+  static T ReduceContiguous(const ConstEigenVectorMap<T>& values) { return values.prod(); }
+};
+
 template <typename T>
 Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
   int64_t block_size, blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  ReduceStridedShape strided_shape;
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_,
+                                          &strided_shape);
 
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).cwiseAbs().rowwise().sum();
+  if (no_transpose) {
+    ReduceStrided<T, ReduceAggregatorL1<T>>(ctx->Input<Tensor>(0)->template Data<T>(), output_data, strided_shape);
+  } else {
+    EigenVectorMap<T> out_vec(output_data, block_size);
+    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).cwiseAbs().rowwise().sum();
+  }
 
   return Status::OK();
 }
@@ -218,12 +388,18 @@ Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
   int64_t block_size, blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  ReduceStridedShape strided_shape;
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_,
+                                          &strided_shape);
 
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().norm();
+  if (no_transpose) {
+    ReduceStrided<T, ReduceAggregatorL2<T>>(ctx->Input<Tensor>(0)->template Data<T>(), output_data, strided_shape);
+  } else {
+    EigenVectorMap<T> out_vec(output_data, block_size);
+    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().norm();
+  }
 
   return Status::OK();
 }
@@ -233,29 +409,101 @@ Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
   int64_t block_size, blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  ReduceStridedShape strided_shape;
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_,
+                                          &strided_shape);
 
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  for (int j = 0; j < block_size; ++j) {
-    *(output_data) = static_cast<T>(std::log(*(output_data)));
-    ++output_data;
+  if (no_transpose) {
+    ReduceStrided<T, ReduceAggregatorLogSum<T>>(ctx->Input<Tensor>(0)->template Data<T>(), output_data,
+                                                strided_shape);
+  } else {
+    EigenVectorMap<T> out_vec(output_data, block_size);
+    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
+    for (int j = 0; j < block_size; ++j) {
+      *(output_data) = static_cast<T>(std::log(*(output_data)));
+      ++output_data;
+    }
   }
 
   return Status::OK();
 }
 
+// Replaces each of the count values with its exponential.
+template <typename T>
+static void ExpInPlace(T* data, int64_t count) {
+  for (int64_t i = 0; i < count; ++i) {
+    data[i] = static_cast<T>(std::exp(data[i]));
+  }
+}
+
+template <>
+void ExpInPlace<float>(float* data, int64_t count) {
+  MlasComputeExp(data, data, static_cast<size_t>(count));
+}
+
 template <typename T>
 Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
   int64_t block_size, blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  ReduceStridedShape strided_shape;
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_,
+                                          &strided_shape);
 
   T* output_data = reduced->template MutableData<T>();
 
+  if (no_transpose) {
+    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+    const ReduceStridedShape& shape = strided_shape;
+
+    if (shape.inner == 1) {
+      const int64_t reduce = shape.reduce;
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+      for (int64_t o = 0; o < shape.outer; ++o) {
+        ConstEigenVectorMap<T> values(input_data + o * reduce, reduce);
+        const T max_value = values.maxCoeff();
+        std::vector<T> scaled_exp(reduce);
+        EigenVectorMap<T>(scaled_exp.data(), reduce) = values.array() - max_value;
+        ExpInPlace(scaled_exp.data(), reduce);
+        output_data[o] = static_cast<T>(std::log(ConstEigenVectorMap<T>(scaled_exp.data(), reduce).sum()) + max_value);
+      }
+      return Status::OK();
+    }
+
+    // Two passes over the rows of each block: the first finds the maximum used to scale the exponentials.
+    ForEachReduceBlock(shape, [input_data, output_data, &shape](int64_t o, int64_t inner_begin, int64_t inner_end) {
+      const int64_t count = inner_end - inner_begin;
+      const T* in = input_data + o * shape.reduce * shape.inner + inner_begin;
+      T* out = output_data + o * shape.inner + inner_begin;
+
+      EigenVectorMap<T> max_values(out, count);
+      max_values = ConstEigenVectorMap<T>(in, count);
+      for (int64_t r = 1; r < shape.reduce; ++r) {
+        max_values = max_values.cwiseMax(ConstEigenVectorMap<T>(in + r * shape.inner, count));
+      }
+
+      std::vector<T> scaled_exp(count);
+      std::vector<T> scaled_exp_sum(count, 0);
+      EigenVectorMap<T> scaled_exp_vec(scaled_exp.data(), count);
+      EigenVectorMap<T> scaled_exp_sum_vec(scaled_exp_sum.data(), count);
+      for (int64_t r = 0; r < shape.reduce; ++r) {
+        scaled_exp_vec = ConstEigenVectorMap<T>(in + r * shape.inner, count) - max_values;
+        ExpInPlace(scaled_exp.data(), count);
+        scaled_exp_sum_vec += scaled_exp_vec;
+      }
+
+      for (int64_t i = 0; i < count; ++i) {
+        out[i] = static_cast<T>(std::log(scaled_exp_sum[i]) + out[i]);
+      }
+    });
+
+    return Status::OK();
+  }
+
   for (int j = 0; j < block_size; ++j) {
     T max_value = std::numeric_limits<T>::lowest();
     for (int i = 0; i < blocks; ++i) {
@@ -275,12 +523,18 @@ Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
   int64_t block_size, blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  ReduceStridedShape strided_shape;
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_,
+                                          &strided_shape);
 
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().maxCoeff();
+  if (no_transpose) {
+    ReduceStrided<T, ReduceAggregatorMax<T>>(ctx->Input<Tensor>(0)->template Data<T>(), output_data, strided_shape);
+  } else {
+    EigenVectorMap<T> out_vec(output_data, block_size);
+    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().maxCoeff();
+  }
 
   return Status::OK();
 }
@@ -290,21 +544,15 @@ Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
   int64_t block_size, blocks;
   Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
+  ReduceStridedShape strided_shape;
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_,
+                                          &strided_shape);
 
   T* output_data = reduced->template MutableData<T>();
 
   if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).mean();
-    }
-  }
-  else {
+    ReduceStrided<T, ReduceAggregatorMean<T>>(ctx->Input<Tensor>(0)->template Data<T>(), output_data, strided_shape);
+  } else {
     EigenVectorMap<T> out_vec(output_data, block_size);
     out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().mean();
   }
@@ -317,12 +565,18 @@ Status ReduceMin<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
   int64_t block_size, blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  ReduceStridedShape strided_shape;
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_,
+                                          &strided_shape);
 
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().minCoeff();
+  if (no_transpose) {
+    ReduceStrided<T, ReduceAggregatorMin<T>>(ctx->Input<Tensor>(0)->template Data<T>(), output_data, strided_shape);
+  } else {
+    EigenVectorMap<T> out_vec(output_data, block_size);
+    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().minCoeff();
+  }
 
   return Status::OK();
 }
@@ -332,12 +586,18 @@ Status ReduceProd<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
   int64_t block_size, blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  ReduceStridedShape strided_shape;
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_,
+                                          &strided_shape);
 
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().prod();
+  if (no_transpose) {
+    ReduceStrided<T, ReduceAggregatorProd<T>>(ctx->Input<Tensor>(0)->template Data<T>(), output_data, strided_shape);
+  } else {
+    EigenVectorMap<T> out_vec(output_data, block_size);
+    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().prod();
+  }
 
   return Status::OK();
 }
@@ -347,21 +607,15 @@ Status ReduceSum<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
   int64_t block_size, blocks;
   Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
+  ReduceStridedShape strided_shape;
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_,
+                                          &strided_shape);
 
   T* output_data = reduced->template MutableData<T>();
 
   if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).sum();
-    }
-  }
-  else {
+    ReduceStrided<T, ReduceAggregatorSum<T>>(ctx->Input<Tensor>(0)->template Data<T>(), output_data, strided_shape);
+  } else {
     EigenVectorMap<T> out_vec(output_data, block_size);
     out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
   }
@@ -374,25 +628,63 @@ Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
   int64_t block_size, blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  ReduceStridedShape strided_shape;
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_,
+                                          &strided_shape);
 
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().squaredNorm();
+  if (no_transpose) {
+    ReduceStrided<T, ReduceAggregatorSumSquare<T>>(ctx->Input<Tensor>(0)->template Data<T>(), output_data,
+                                                   strided_shape);
+  } else {
+    EigenVectorMap<T> out_vec(output_data, block_size);
+    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().squaredNorm();
+  }
 
   return Status::OK();
 }
 
+// ArgReduceStrided: finds the index of the first value along the middle axis of [outer, reduce, inner]
+// for which is_better(value, best) holds over all previous values.
+template <typename T, typename Compare>
+static void ArgReduceStrided(const T* input, int64_t* output, const ReduceStridedShape& shape, Compare is_better) {
+  ForEachReduceBlock(shape, [input, output, &shape, is_better](int64_t o, int64_t inner_begin, int64_t inner_end) {
+    const int64_t count = inner_end - inner_begin;
+    const T* in = input + o * shape.reduce * shape.inner + inner_begin;
+    int64_t* out = output + o * shape.inner + inner_begin;
+
+    std::vector<T> best(in, in + count);
+    std::fill_n(out, count, int64_t{0});
+    for (int64_t r = 1; r < shape.reduce; ++r) {
+      const T* row = in + r * shape.inner;
+      for (int64_t i = 0; i < count; ++i) {
+        if (is_better(row[i], best[i])) {
+          best[i] = row[i];
+          out[i] = r;
+        }
+      }
+    }
+  });
+}
+
 template <typename T>
 Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
   int64_t block_size, blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  ReduceStridedShape strided_shape;
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_,
+                                          &strided_shape);
 
   int64_t* output_data = reduced->template MutableData<int64_t>();
 
+  if (no_transpose) {
+    ArgReduceStrided(ctx->Input<Tensor>(0)->template Data<T>(), output_data, strided_shape,
+                     [](T value, T best) { return value > best; });
+    return Status::OK();
+  }
+
   Eigen::MatrixXf::Index maxIndex;
   auto matrixData = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks);
   for (int i = 0; i < block_size; ++i) {
@@ -408,10 +700,18 @@ Status ArgMin<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
   int64_t block_size, blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  ReduceStridedShape strided_shape;
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_,
+                                          &strided_shape);
 
   int64_t* output_data = reduced->template MutableData<int64_t>();
 
+  if (no_transpose) {
+    ArgReduceStrided(ctx->Input<Tensor>(0)->template Data<T>(), output_data, strided_shape,
+                     [](T value, T best) { return value < best; });
+    return Status::OK();
+  }
+
   Eigen::MatrixXf::Index minIndex;
   auto matrixData = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks);
   for (int i = 0; i < block_size; ++i) {
@@ -18,6 +18,7 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -177,17 +178,33 @@ class UniDirectionalGru {
                     const ActivationFuncs::Entry& activation_func_f,
                     const ActivationFuncs::Entry& activation_func_g,
                     const float clip,
-#ifdef USE_EIGEN_THREADPOOL
-                    Eigen::NonBlockingThreadPool& ttp_);
-#else
-                    TaskThreadPool& ttp_);
-#endif
-
+                    ThreadPool& ttp,
+                    int num_threads);
+
+  // Whether this instance, left over from an earlier call, can run a call with these settings.
+  bool CanReuse(Direction direction, int batch_size, int input_size, bool use_bias) const;
+
+  // Sets up an instance for which CanReuse returned true for the next call, keeping its buffers.
+  // The sequence length may differ from the earlier call.
+  void Reset(const logging::Logger& logger,
+             const int seq_length,
+             const gsl::span<const T>& bias,
+             const gsl::span<const T>& initial_hidden_state);
+
+  // Run the GEMMs of the following Compute calls on the integer GEMM with these weights, which are laid out as
+  // prepacked weights. The input_weights and recurrent_weights passed to Compute are ignored then.
+  void UseQuantizedWeights(const QuantizedWeights& input_weights,
+                           const QuantizedWeights& recurrent_weightsZR,
+                           const QuantizedWeights& recurrent_weightsH);
+
+  // weights_prepacked is true if input_weights and recurrent_weights come from DeepCpuGruOp::PrepackWeights,
+  // with W, R[zr] and R[h] each stored as [K, N] instead of the transposed ONNX layout.
   void Compute(const gsl::span<const T>& inputs,
                const gsl::span<const int>& sequence_lengths,
                const int num_directions,
                const gsl::span<const T>& input_weights,
                const gsl::span<const T>& recurrent_weights,
+               const bool weights_prepacked,
                gsl::span<T>& outputs,
                gsl::span<T>& final_hidden_state);
 
@@ -195,15 +212,12 @@ class UniDirectionalGru {
 
  private:
   AllocatorPtr allocator_;
-  const logging::Logger& logger_;
+  const logging::Logger* logger_;
 
-#ifdef USE_EIGEN_THREADPOOL
-  Eigen::NonBlockingThreadPool& ttp_;
-#else
-  TaskThreadPool& ttp_;
-#endif
+  ThreadPool& ttp_;
 
   int seq_length_;
+  int sequence_capacity_ = 0;  // sequence length the buffers in AllocateSequenceBuffers have room for
   int batch_size_;
   int input_size_;
   int hidden_size_;
@@ -249,6 +263,15 @@ class UniDirectionalGru {
   gsl::span<T> inputs_reverse_;
   gsl::span<T> outputs_reverse_;
 
+  // set by UseQuantizedWeights. the scratch buffers hold the quantized inputs or hidden state and the int32 GEMM
+  // output. the recurrent GEMMs use the rows of quantized_output_ matching the batch rows they process.
+  bool quantized_ = false;
+  QuantizedWeights quantized_input_weights_, quantized_recurrent_weightsZR_, quantized_recurrent_weightsH_;
+  IAllocatorUniquePtr<uint8_t> quantized_inputs_ptr_, quantized_hidden_ptr_;
+  IAllocatorUniquePtr<int32_t> quantized_output_ptr_;
+  gsl::span<uint8_t> quantized_inputs_, quantized_hidden_;
+  gsl::span<int32_t> quantized_output_;
+
   deepcpu::ClipWithBiasFuncPtr clip_with_bias_ptr_ = nullptr;
 
   float zr_alpha_ = 0.f, zr_beta_ = 0.f;
@@ -259,7 +282,10 @@ class UniDirectionalGru {
   deepcpu::GruOutputGateFuncPtr output_gate_ = nullptr;
 
   void AllocateBuffers();
-  void SetNumThreads();
+  void AllocateSequenceBuffers();
+  void InitializeBuffers(const gsl::span<const T>& initial_hidden_state);
+  void LoadBias(const gsl::span<const T>& WbRb_values);
+  void SetNumThreads(int num_threads);
 };
 }  // namespace detail
 
@@ -270,6 +296,147 @@ class UniDirectionalGru {
 #define DumpMatrix(...) ((void)0)
 #endif
 
+DeepCpuGruOp::DeepCpuGruOp(const OpKernelInfo& info, bool quantize_weights)
+    : OpKernel(info), quantize_weights_(quantize_weights) {
+  // required attributes
+  std::string direction;
+  ORT_ENFORCE(info.GetAttr("direction", &direction).IsOK());
+
+  int64_t int64_value;
+  ORT_ENFORCE(info.GetAttr("linear_before_reset", &int64_value).IsOK());
+  linear_before_reset_ = gsl::narrow<int>(int64_value);
+
+  ORT_ENFORCE(info.GetAttr("hidden_size", &int64_value).IsOK() && int64_value > 0);
+  hidden_size_ = gsl::narrow<int>(int64_value);
+
+  // optional attributes
+  std::vector<std::string> activation_func_names = info.GetAttrsOrDefault<std::string>("activations");
+  std::vector<float> activation_func_alphas = info.GetAttrsOrDefault<float>("activation_alpha");
+  std::vector<float> activation_func_betas = info.GetAttrsOrDefault<float>("activation_beta");
+
+  clip_ = info.GetAttrOrDefault<float>("clip", std::numeric_limits<float>::max());
+  ORT_ENFORCE(clip_ > 0.f);
+
+  direction_ = rnn::detail::MakeDirection(direction);
+  num_directions_ = direction_ == rnn::detail::Direction::kBidirectional ? 2 : 1;
+
+  if (activation_func_names.empty()) {
+    for (int i = 0; i < num_directions_; ++i) {
+      activation_func_names.emplace_back("sigmoid");
+      activation_func_names.emplace_back("tanh");
+    }
+  }
+
+  ORT_ENFORCE(activation_func_names.size() == num_directions_ * 2);
+
+  activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
+                                                   activation_func_alphas,
+                                                   activation_func_betas);
+
+  PrepackWeights(info);
+}
+
+DeepCpuGruOp::~DeepCpuGruOp() = default;
+
+void DeepCpuGruOp::PrepackWeights(const OpKernelInfo& info) {
+  const Tensor* W;
+  const Tensor* R;
+  if (!info.TryGetConstantInput(1, &W) || !info.TryGetConstantInput(2, &R) ||
+      W->DataType() != DataTypeImpl::GetType<float>() || R->DataType() != DataTypeImpl::GetType<float>()) {
+    ORT_ENFORCE(!quantize_weights_, "DynamicQuantizeGRU requires W and R to be float initializers.");
+    return;
+  }
+
+  // ValidateCommonRnnInputs reports unexpected shapes when the kernel runs, so just don't prepack those.
+  const auto& W_shape = W->Shape();
+  const auto& R_shape = R->Shape();
+  if (W_shape.NumDimensions() != 3 || W_shape[0] != num_directions_ || W_shape[1] != 3 * hidden_size_ ||
+      R_shape.NumDimensions() != 3 || R_shape[0] != num_directions_ || R_shape[1] != 3 * hidden_size_ ||
+      R_shape[2] != hidden_size_) {
+    ORT_ENFORCE(!quantize_weights_, "DynamicQuantizeGRU has unexpected W shape ", W_shape,
+                " or R shape ", R_shape);
+    return;
+  }
+
+  const size_t input_size = gsl::narrow<size_t>(W_shape[2]);
+  const size_t hidden_size = static_cast<size_t>(hidden_size_);
+  const size_t input_weights_size_per_direction = 3 * hidden_size * input_size;
+  const size_t recurrent_weights_size_per_direction = 3 * hidden_size * hidden_size;
+  const size_t recurrent_weights_zr_size = 2 * hidden_size * hidden_size;
+
+  AllocatorPtr alloc = info.GetAllocator(0, OrtMemTypeDefault);
+  packed_input_weights_ = Allocate(alloc, input_weights_size_per_direction * num_directions_,
+                                   packed_input_weights_ptr_);
+  packed_recurrent_weights_ = Allocate(alloc, recurrent_weights_size_per_direction * num_directions_,
+                                       packed_recurrent_weights_ptr_);
+
+  // R[zr] and R[h] are used by separate GEMMs, so they are transposed separately
+  for (int i = 0; i < num_directions_; ++i) {
+    const float* R_data = R->Data<float>() + i * recurrent_weights_size_per_direction;
+    float* packed_R = packed_recurrent_weights_.data() + i * recurrent_weights_size_per_direction;
+
+    MlasTranspose(W->Data<float>() + i * input_weights_size_per_direction,
+                  packed_input_weights_.data() + i * input_weights_size_per_direction,
+                  3 * hidden_size, input_size);
+    MlasTranspose(R_data, packed_R, 2 * hidden_size, hidden_size);
+    MlasTranspose(R_data + recurrent_weights_zr_size, packed_R + recurrent_weights_zr_size, hidden_size, hidden_size);
+  }
+
+  if (quantize_weights_) {
+    const size_t scales_per_direction = 3 * hidden_size;
+    quantized_input_weights_ = Allocate(alloc, packed_input_weights_.size(), quantized_input_weights_ptr_);
+    quantized_recurrent_weights_ = Allocate(alloc, packed_recurrent_weights_.size(), quantized_recurrent_weights_ptr_);
+    input_weights_scales_ = Allocate(alloc, scales_per_direction * num_directions_, input_weights_scales_ptr_);
+    recurrent_weights_scales_ = Allocate(alloc, scales_per_direction * num_directions_, recurrent_weights_scales_ptr_);
+
+    for (int i = 0; i < num_directions_; ++i) {
+      const float* packed_R = packed_recurrent_weights_.data() + i * recurrent_weights_size_per_direction;
+      uint8_t* quantized_R = quantized_recurrent_weights_.data() + i * recurrent_weights_size_per_direction;
+      float* R_scales = recurrent_weights_scales_.data() + i * scales_per_direction;
+
+      QuantizeWeights(packed_input_weights_.data() + i * input_weights_size_per_direction,
+                      static_cast<int>(input_size), hidden_size_ * 3,
+                      quantized_input_weights_.data() + i * input_weights_size_per_direction,
+                      input_weights_scales_.data() + i * scales_per_direction);
+      QuantizeWeights(packed_R, hidden_size_, hidden_size_ * 2, quantized_R, R_scales);
+      QuantizeWeights(packed_R + recurrent_weights_zr_size, hidden_size_, hidden_size_,
+                      quantized_R + recurrent_weights_zr_size, R_scales + 2 * hidden_size);
+    }
+
+    packed_input_weights_ptr_.reset();
+    packed_recurrent_weights_ptr_.reset();
+    packed_input_weights_ = gsl::span<float>();
+    packed_recurrent_weights_ = gsl::span<float>();
+  }
+}
+
+std::unique_ptr<detail::UniDirectionalGru<float>> DeepCpuGruOp::TakeCachedGru(Direction direction,
+                                                                              int batch_size, int input_size,
+                                                                              bool use_bias) const {
+  std::lock_guard<OrtMutex> lock(gru_cache_mutex_);
+  for (auto it = gru_cache_.begin(); it != gru_cache_.end(); ++it) {
+    if ((*it)->CanReuse(direction, batch_size, input_size, use_bias)) {
+      auto gru = std::move(*it);
+      gru_cache_.erase(it);
+      return gru;
+    }
+  }
+
+  return nullptr;
+}
+
+void DeepCpuGruOp::CacheGru(std::unique_ptr<detail::UniDirectionalGru<float>> gru) const {
+  // enough for both directions of a few concurrent calls. if the batch or input size keeps changing the oldest
+  // instances are dropped.
+  constexpr size_t max_cached = 8;
+
+  std::lock_guard<OrtMutex> lock(gru_cache_mutex_);
+  if (gru_cache_.size() >= max_cached)
+    gru_cache_.erase(gru_cache_.begin());
+
+  gru_cache_.push_back(std::move(gru));
+}
+
 Status DeepCpuGruOp::Compute(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
 
@@ -293,6 +460,9 @@ template <typename T>
 Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   auto& logger = context.Logger();
 
+  int num_threads;
+  ThreadPool& ttp = GetIntraOpThreadPool(context, num_threads);
+
   const Tensor& X = *context.Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
   const Tensor& W = *context.Input<Tensor>(1);  // weights. [num_directions, 3*hidden_size, input_size]
   const Tensor& R = *context.Input<Tensor>(2);  // recurrence weights. [num_directions, 3*hidden_size, hidden_size]
@@ -321,8 +491,13 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   AllocatorPtr alloc;
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
-  gsl::span<const T> input_weights = W.DataAsSpan<T>();
-  gsl::span<const T> recurrent_weights = R.DataAsSpan<T>();
+
+  // use the weights transposed by PrepackWeights if W and R are initializers
+  const bool weights_prepacked = !packed_input_weights_.empty();
+  gsl::span<const T> input_weights = weights_prepacked ? gsl::span<const T>(packed_input_weights_)
+                                                       : W.DataAsSpan<T>();
+  gsl::span<const T> recurrent_weights = weights_prepacked ? gsl::span<const T>(packed_recurrent_weights_)
+                                                           : R.DataAsSpan<T>();
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
 
   // spans for first direction
@@ -364,6 +539,53 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
 
   gsl::span<T> hidden_output_1 = hidden_output.subspan(0, hidden_output_size_per_direction);
 
+  // run the two directions of a bidirectional GRU concurrently, each with half of the threads.
+  // with OpenMP the GEMMs already fan out over the OpenMP threads, and a team per direction would oversubscribe them.
+#if defined(USE_MLAS) && !defined(USE_OPENMP)
+  const bool parallel_directions = direction_ == Direction::kBidirectional && num_threads > 1;
+#else
+  const bool parallel_directions = false;
+#endif
+  const int direction_threads = parallel_directions ? num_threads / 2 : num_threads;
+
+  // take an instance left from an earlier call if there is one with matching buffer sizes.
+  // activations are the 2 entries starting at first_activation.
+  auto make_gru = [&](Direction direction,
+                      const gsl::span<const T>& gru_bias, const gsl::span<const T>& gru_initial_hidden,
+                      size_t first_activation) {
+    auto gru = TakeCachedGru(direction, batch_size, input_size, !gru_bias.empty());
+    if (gru) {
+      gru->Reset(logger, seq_length, gru_bias, gru_initial_hidden);
+    } else {
+      gru = std::make_unique<detail::UniDirectionalGru<T>>(
+          alloc, logger,
+          seq_length, batch_size, input_size, hidden_size_, linear_before_reset_, direction,
+          gru_bias, gru_initial_hidden,
+          activation_funcs_.Entries()[first_activation],
+          activation_funcs_.Entries()[first_activation + 1],
+          clip_, ttp, direction_threads);
+    }
+
+    if (quantize_weights_) {
+      const size_t i = direction == Direction::kReverse && direction_ == Direction::kBidirectional ? 1 : 0;
+      const size_t scales_per_direction = 3 * hidden_size_;
+      const size_t recurrent_weights_zr_size = 2 * hidden_size_ * hidden_size_;
+      const size_t recurrent_weights_offset = i * recurrent_weights_size_per_direction;
+      const size_t scales_offset = i * scales_per_direction;
+      gru->UseQuantizedWeights(
+          QuantizedWeights{quantized_input_weights_.subspan(i * input_weights_size_per_direction,
+                                                            input_weights_size_per_direction),
+                           input_weights_scales_.subspan(scales_offset, scales_per_direction)},
+          QuantizedWeights{quantized_recurrent_weights_.subspan(recurrent_weights_offset, recurrent_weights_zr_size),
+                           recurrent_weights_scales_.subspan(scales_offset, 2 * hidden_size_)},
+          QuantizedWeights{quantized_recurrent_weights_.subspan(recurrent_weights_offset + recurrent_weights_zr_size,
+                                                                hidden_size_ * hidden_size_),
+                           recurrent_weights_scales_.subspan(scales_offset + 2 * hidden_size_, hidden_size_)});
+    }
+
+    return gru;
+  };
+
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
     gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
@@ -383,81 +605,44 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
     gsl::span<T> hidden_output_2 = hidden_output.subspan(hidden_output_size_per_direction,
                                                          hidden_output_size_per_direction);
 
-#if defined(USE_MLAS) && !defined(USE_OPENMP)
-#ifdef USE_EIGEN_THREADPOOL
-    auto fn =
-#else
-    std::packaged_task<void()> task_fw{
-#endif
-        [&]() {
-#endif  // USE_MLAS && ! USE_OPENMP
-          std::unique_ptr<detail::UniDirectionalGru<T>> fw = std::make_unique<detail::UniDirectionalGru<T>>(
-              alloc, logger,
-              seq_length, batch_size, input_size, hidden_size_, linear_before_reset_, Direction::kForward,
-              bias_1, initial_hidden_1,
-              activation_funcs_.Entries()[0],
-              activation_funcs_.Entries()[1],
-              clip_, ttp_);
-          fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
+    std::unique_ptr<detail::UniDirectionalGru<T>> fw = make_gru(Direction::kForward, bias_1, initial_hidden_1, 0);
+    std::unique_ptr<detail::UniDirectionalGru<T>> bw = make_gru(Direction::kReverse, bias_2, initial_hidden_2, 2);
 
-#if defined(USE_MLAS) && !defined(USE_OPENMP)
-#ifndef USE_EIGEN_THREADPOOL
-        }
-  };
-  auto task_results_fw = task_fw.get_future();
-  ttp_.RunTask(std::move(task_fw));
-#else
-        };
-    OrtCondVar cv;
-    OrtMutex lock;
-    bool done = false;
-
-    ttp_.Schedule([&]() {
-      fn();
-      auto ul = std::unique_lock<OrtMutex>(lock);
-      done = true;
-      cv.notify_one();
-    });
-#endif  // USE_EIGEN_THREADPOOL
-#endif  // USE_MLAS && ! USE_OPENMP
-
-  std::unique_ptr<detail::UniDirectionalGru<T>> bw = std::make_unique<detail::UniDirectionalGru<T>>(
-      alloc, logger,
-      seq_length, batch_size, input_size, hidden_size_, linear_before_reset_, Direction::kReverse,
-      bias_2, initial_hidden_2,
-      activation_funcs_.Entries()[2],
-      activation_funcs_.Entries()[3],
-      clip_, ttp_);
-  bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2, output_2, hidden_output_2);
+    auto compute_direction = [&](int i) {
+      if (i == 0)
+        fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+                    weights_prepacked, output_1, hidden_output_1);
+      else
+        bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2,
+                    weights_prepacked, output_2, hidden_output_2);
+    };
 
-#if defined(USE_MLAS) && !defined(USE_OPENMP)
-#ifdef USE_EIGEN_THREADPOOL
-  auto ul = std::unique_lock<OrtMutex>(lock);
-  if (!done) cv.wait(ul);
-#else
-    task_results_fw.get();
-#endif
-#endif  // USE_MLAS && ! USE_OPENMP
-}  // namespace onnxruntime
-else {
-  std::unique_ptr<detail::UniDirectionalGru<T>> gru_p = std::make_unique<detail::UniDirectionalGru<T>>(
-      alloc, logger,
-      seq_length, batch_size, input_size, hidden_size_, linear_before_reset_, direction_,
-      bias_1, initial_hidden_1,
-      activation_funcs_.Entries()[0],
-      activation_funcs_.Entries()[1],
-      clip_, ttp_);
-
-  gru_p->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
-}
+    if (parallel_directions) {
+      ExecuteLambdaInParallel("Processing directions", compute_direction, 2, 1, ttp, logger);
+    } else {
+      compute_direction(0);
+      compute_direction(1);
+    }
 
-if (!output.empty())
-  DumpMatrix("Y", output.data(), seq_length* num_directions_* batch_size, hidden_size_);
+    // keep the instances, and with them their buffers, for the next call
+    CacheGru(std::move(fw));
+    CacheGru(std::move(bw));
+  } else {
+    std::unique_ptr<detail::UniDirectionalGru<T>> gru_p = make_gru(direction_, bias_1, initial_hidden_1, 0);
 
-DumpMatrix("Y_h", hidden_output.data(), num_directions_* batch_size, hidden_size_);
+    gru_p->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+                   weights_prepacked, output_1, hidden_output_1);
 
-return Status::OK();
-}  // namespace onnxruntime
+    CacheGru(std::move(gru_p));
+  }
+
+  if (!output.empty())
+    DumpMatrix("Y", output.data(), seq_length * num_directions_ * batch_size, hidden_size_);
+
+  DumpMatrix("Y_h", hidden_output.data(), num_directions_ * batch_size, hidden_size_);
+
+  return Status::OK();
+}
 
 //
 // Implementation of internal helper code
@@ -477,13 +662,10 @@ UniDirectionalGru<T>::UniDirectionalGru(AllocatorPtr allocator,
                                         const ActivationFuncs::Entry& activation_func_f,
                                         const ActivationFuncs::Entry& activation_func_g,
                                         const float clip,
-#ifdef USE_EIGEN_THREADPOOL
-                                        Eigen::NonBlockingThreadPool& ttp)
-#else
-                                        TaskThreadPool& ttp)
-#endif
+                                        ThreadPool& ttp,
+                                        int num_threads)
     : allocator_(allocator),
-      logger_(logger),
+      logger_(&logger),
       ttp_(ttp),
       seq_length_(seq_length),
       batch_size_(batch_size),
@@ -506,49 +688,100 @@ UniDirectionalGru<T>::UniDirectionalGru(AllocatorPtr allocator,
   h_alpha_ = activation_func_g.alpha;
   h_beta_ = activation_func_g.beta;
 
-  SetNumThreads();
+  SetNumThreads(num_threads);
   AllocateBuffers();
+  AllocateSequenceBuffers();
+  InitializeBuffers(initial_hidden_state);
 
-  if (use_bias_) {
-    auto bias_Wz = bias.subspan(0 * hidden_size_, hidden_size_);
-    auto bias_Wr = bias.subspan(1 * hidden_size_, hidden_size_);
-    auto bias_Wo = bias.subspan(2 * hidden_size_, hidden_size_);
-    auto bias_Rz = bias.subspan(3 * hidden_size_, hidden_size_);
-    auto bias_Rr = bias.subspan(4 * hidden_size_, hidden_size_);
-    auto bias_Ro = bias.subspan(5 * hidden_size_, hidden_size_);
-
-    // add Wb[zr] and Rb[zr] and replicate so we have batch_size_ copies of the result
-    auto combine_and_replicate = [&](gsl::span<const T>& bias_w,
-                                     gsl::span<const T>& bias_r,
-                                     gsl::span<T>& output) {
-      // add once
-      for (int i = 0; i < hidden_size_; ++i) {
-        output[i] = bias_w[i] + bias_r[i];
-      }
+  if (use_bias_)
+    LoadBias(bias);
+}
 
-      // replicate what we just wrote to the start of the output span so we have batch_size_ copies
-      auto values = output.cbegin();
-      ORT_IGNORE_RETURN_VALUE(RepeatVectorToConstructArray(values, values + hidden_size_,
-                                                           output.begin() + hidden_size_,  // skip the first batch
-                                                           batch_size_ - 1));              // and replicate batch size - 1 times
-    };
+template <typename T>
+bool UniDirectionalGru<T>::CanReuse(Direction direction, int batch_size, int input_size, bool use_bias) const {
+  return direction_ == direction && batch_size_ == batch_size && input_size_ == input_size && use_bias_ == use_bias;
+}
 
-    // we can always combine the z and r weights
-    combine_and_replicate(bias_Wz, bias_Rz, batched_bias_WRz_);
-    combine_and_replicate(bias_Wr, bias_Rr, batched_bias_WRr_);
+template <typename T>
+void UniDirectionalGru<T>::Reset(const logging::Logger& logger,
+                                 const int seq_length,
+                                 const gsl::span<const T>& bias,
+                                 const gsl::span<const T>& initial_hidden_state) {
+  logger_ = &logger;
+  seq_length_ = seq_length;
+
+  AllocateSequenceBuffers();
+  InitializeBuffers(initial_hidden_state);
+
+  // B isn't necessarily an initializer, so reload it every call
+  if (use_bias_)
+    LoadBias(bias);
+}
 
-    // how we treat the h weight depends on whether linear_before_reset_ is set
-    if (linear_before_reset_) {
-      // need to replicate Wb[o] and Rb[o] separately
-      ORT_IGNORE_RETURN_VALUE(RepeatVectorToConstructArray(bias_Wo.cbegin(), bias_Wo.cend(), batched_bias_Wh_.begin(), batch_size_));
-      ORT_IGNORE_RETURN_VALUE(RepeatVectorToConstructArray(bias_Ro.cbegin(), bias_Ro.cend(), batched_bias_Rh_.begin(), batch_size_));
-    } else {
-      combine_and_replicate(bias_Wo, bias_Ro, batched_bias_WRh_);
-    }
+template <typename T>
+void UniDirectionalGru<T>::UseQuantizedWeights(const QuantizedWeights& input_weights,
+                                               const QuantizedWeights& recurrent_weightsZR,
+                                               const QuantizedWeights& recurrent_weightsH) {
+  quantized_ = true;
+  quantized_input_weights_ = input_weights;
+  quantized_recurrent_weightsZR_ = recurrent_weightsZR;
+  quantized_recurrent_weightsH_ = recurrent_weightsH;
+
+  const size_t rows = static_cast<size_t>(seq_length_) * batch_size_;
+  if (static_cast<size_t>(quantized_inputs_.size()) < rows * input_size_) {
+    quantized_inputs_ = Allocate(allocator_, rows * input_size_, quantized_inputs_ptr_);
+    quantized_output_ = Allocate(allocator_, rows * 3 * hidden_size_, quantized_output_ptr_);
   }
 
+  if (quantized_hidden_.empty())
+    quantized_hidden_ = Allocate(allocator_, batch_size_ * hidden_size_, quantized_hidden_ptr_);
+}
+
+template <typename T>
+void UniDirectionalGru<T>::InitializeBuffers(const gsl::span<const T>& initial_hidden_state) {
   if (!initial_hidden_state.empty()) {
     gsl::copy(initial_hidden_state, batched_hidden0_);
+  } else {
+    std::fill_n(batched_hidden0_.data(), batched_hidden0_.size(), T{});
+  }
+}
+
+template <typename T>
+void UniDirectionalGru<T>::LoadBias(const gsl::span<const T>& WbRb_values) {
+  auto bias_Wz = WbRb_values.subspan(0 * hidden_size_, hidden_size_);
+  auto bias_Wr = WbRb_values.subspan(1 * hidden_size_, hidden_size_);
+  auto bias_Wo = WbRb_values.subspan(2 * hidden_size_, hidden_size_);
+  auto bias_Rz = WbRb_values.subspan(3 * hidden_size_, hidden_size_);
+  auto bias_Rr = WbRb_values.subspan(4 * hidden_size_, hidden_size_);
+  auto bias_Ro = WbRb_values.subspan(5 * hidden_size_, hidden_size_);
+
+  // add Wb[zr] and Rb[zr] and replicate so we have batch_size_ copies of the result
+  auto combine_and_replicate = [&](gsl::span<const T>& bias_w,
+                                   gsl::span<const T>& bias_r,
+                                   gsl::span<T>& output) {
+    // add once
+    for (int i = 0; i < hidden_size_; ++i) {
+      output[i] = bias_w[i] + bias_r[i];
+    }
+
+    // replicate what we just wrote to the start of the output span so we have batch_size_ copies
+    auto values = output.cbegin();
+    ORT_IGNORE_RETURN_VALUE(RepeatVectorToConstructArray(values, values + hidden_size_,
+                                                         output.begin() + hidden_size_,  // skip the first batch
+                                                         batch_size_ - 1));              // and replicate batch size - 1 times
+  };
+
+  // we can always combine the z and r weights
+  combine_and_replicate(bias_Wz, bias_Rz, batched_bias_WRz_);
+  combine_and_replicate(bias_Wr, bias_Rr, batched_bias_WRr_);
+
+  // how we treat the h weight depends on whether linear_before_reset_ is set
+  if (linear_before_reset_) {
+    // need to replicate Wb[o] and Rb[o] separately
+    ORT_IGNORE_RETURN_VALUE(RepeatVectorToConstructArray(bias_Wo.cbegin(), bias_Wo.cend(), batched_bias_Wh_.begin(), batch_size_));
+    ORT_IGNORE_RETURN_VALUE(RepeatVectorToConstructArray(bias_Ro.cbegin(), bias_Ro.cend(), batched_bias_Rh_.begin(), batch_size_));
+  } else {
+    combine_and_replicate(bias_Wo, bias_Ro, batched_bias_WRh_);
   }
 }
 
@@ -558,6 +791,7 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
                                    const int num_directions,
                                    const gsl::span<const T>& input_weights,
                                    const gsl::span<const T>& recurrent_weights,
+                                   const bool weights_prepacked,
                                    gsl::span<T>& outputs,
                                    gsl::span<T>& final_hidden_state) {
   using span_T_const_iter = typename gsl::span<T>::const_iterator;
@@ -569,7 +803,10 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
 
   // if sequence lengths weren't provided, use internal array and init all to seq_length
   if (sequence_lengths.empty()) {
-    sequence_lengths_ = Allocate(allocator_, batch_size_, sequence_lengths_ptr_, true, seq_length_);
+    if (sequence_lengths_.empty())
+      sequence_lengths_ = Allocate(allocator_, batch_size_, sequence_lengths_ptr_);
+
+    std::fill_n(sequence_lengths_.data(), sequence_lengths_.size(), seq_length_);
     sequence_lengths = sequence_lengths_;
   }
 
@@ -577,6 +814,11 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   DumpMatrix("input_weights", input_weights.data(), 3 * hidden_size_, input_size_);
   DumpMatrix("recurrent_weights", recurrent_weights.data(), 3 * hidden_size_, hidden_size_);
 
+  // prepacked weights are [K, N] so the GEMMs read B without a transpose
+  const bool weights_transposed = !weights_prepacked;
+  const int input_weights_ld = weights_prepacked ? 3 * hidden_size_ : input_size_;
+  const int recurrent_weightsZR_ld = weights_prepacked ? 2 * hidden_size_ : hidden_size_;
+
   gsl::span<const T> recurrent_weightsZR = recurrent_weights.subspan(0, 2 * hidden_size_ * hidden_size_);
   gsl::span<const T> recurrent_weightsH = recurrent_weights.subspan(2 * hidden_size_ * hidden_size_, hidden_size_ * hidden_size_);
 
@@ -607,19 +849,55 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   float beta = 0.0f;  // zero out outputZRH_ when calling ComputeGemm.
 
   // apply weights to all the inputs
-  ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
-              inputs.cbegin(), inputs.cend(),
-              input_size_,
-              input_weights.cbegin(), input_weights.cend(),
-              input_size_, beta,
-              outputZRH_.begin(), outputZRH_.end(),
-              hidden_size_x3);
+  if (quantized_) {
+    ORT_ENFORCE(static_cast<size_t>(inputs.size()) >= static_cast<size_t>(total_rows) * input_size_);
+    ComputeQuantizedGemm(total_rows, hidden_size_x3, input_size_,
+                         inputs.data(), input_size_,
+                         quantized_input_weights_,
+                         beta,
+                         outputZRH_.data(), hidden_size_x3,
+                         quantized_inputs_, quantized_output_);
+  } else {
+    ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
+                inputs.cbegin(), inputs.cend(),
+                input_size_,
+                input_weights.cbegin(), input_weights.cend(),
+                input_weights_ld, beta,
+                outputZRH_.begin(), outputZRH_.end(),
+                hidden_size_x3, weights_transposed);
+  }
 
   DumpMatrix("inputs with weights applied", outputZRH_.data(), seq_length_ * batch_size_ * 3, hidden_size_);
 
   // set to 1 so the weighted inputs in outputZRH_ are added to the result in the next call to ComputeGemm
   beta = 1.0f;
 
+  // multiply rows of the hidden state starting at batch row 'row' with R[zr] or R[h], accumulating into C.
+  // with quantized weights the rows of the scratch buffers matching the batch rows are used, so calls for
+  // different rows can run concurrently.
+  auto recurrent_gemm = [&](int row, int rows, int N,
+                            span_T_const_iter A, span_T_const_iter A_end,
+                            const gsl::span<const T>& weights, int ldb, const QuantizedWeights& quantized_weights,
+                            span_T_iter C, span_T_iter C_end, int ldc) {
+    if (quantized_) {
+      ComputeQuantizedGemm(rows, N, hidden_size_,
+                           SafeRawConstPointer<T>(A, A_end, rows * hidden_size_), hidden_size_,
+                           quantized_weights,
+                           beta,
+                           SafeRawPointer<T>(C, C_end, (rows - 1) * ldc + N), ldc,
+                           quantized_hidden_.subspan(row * hidden_size_, rows * hidden_size_),
+                           quantized_output_.subspan(row * hidden_size_x3, rows * N));
+    } else {
+      ComputeGemm(rows, N, hidden_size_, alpha,
+                  A, A_end,
+                  hidden_size_,
+                  weights.cbegin(), weights.cend(),
+                  ldb, beta,
+                  C, C_end,
+                  ldc, weights_transposed);
+    }
+  };
+
   // output shape is [seq_length, num_directions, batch_size, hidden_size]
   // if we are doing 2 directions and this is the forward pass we're writing to the real output so
   // need to include num_directions in the step length.
@@ -685,13 +963,11 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         out_added_offset = (step * batch_size_ + row) * hidden_size_x3;
 
         // calculate Ht-1*R[zr], and add to the weighted inputs that are in outputZRH_
-        ComputeGemm(local_fused_hidden_rows, hidden_size_x2, hidden_size_, alpha,
-                    prev_Ht, prev_Ht_end,
-                    hidden_size_,
-                    recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
-                    hidden_size_, beta,
-                    outputZRH_.begin() + out_added_offset, outputZRH_.end(),
-                    hidden_size_x3);
+        recurrent_gemm(row, local_fused_hidden_rows, hidden_size_x2,
+                       prev_Ht, prev_Ht_end,
+                       recurrent_weightsZR, recurrent_weightsZR_ld, quantized_recurrent_weightsZR_,
+                       outputZRH_.begin() + out_added_offset, outputZRH_.end(),
+                       hidden_size_x3);
 
         DumpMatrix("Xt*(W[zr]^T) + Ht-1 * R[zr]" + row_str,
                    outputZRH_.data() + out_added_offset, local_fused_hidden_rows, hidden_size_x2, 0, hidden_size_x3);
@@ -702,13 +978,11 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
                     linear_output_.subspan(linear_output_local - linear_output_.begin(), linear_output_local_end - linear_output_local));
 
           // compute Ht-1 * (Rh^T) + Rbh
-          ComputeGemm(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
-                      prev_Ht, prev_Ht_end,  // Ht-1
-                      hidden_size_,
-                      recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                      hidden_size_, beta,
-                      linear_output_local, linear_output_.end(),  // pre: Rbh, post:output
-                      hidden_size_);
+          recurrent_gemm(row, local_fused_hidden_rows, hidden_size_,
+                         prev_Ht, prev_Ht_end,                                                 // Ht-1
+                         recurrent_weightsH, hidden_size_, quantized_recurrent_weightsH_,  // Rh^T
+                         linear_output_local, linear_output_.end(),                          // pre: Rbh, post:output
+                         hidden_size_);
 
           DumpMatrix("Ht-1 * (Rh^T) + Rbh " + row_str, &*linear_output_local, batch_size_, hidden_size_);
         }
@@ -765,13 +1039,11 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
           }
         } else {
           label += " * Rh^T";
-          ComputeGemm(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
-                      cur_h_local, cur_h_local_end,
-                      hidden_size_,
-                      recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),
-                      hidden_size_, beta,
-                      outputZRH_.begin() + out_added_offset + hidden_size_x2, outputZRH_.end(),
-                      hidden_size_x3);
+          recurrent_gemm(row, local_fused_hidden_rows, hidden_size_,
+                         cur_h_local, cur_h_local_end,
+                         recurrent_weightsH, hidden_size_, quantized_recurrent_weightsH_,
+                         outputZRH_.begin() + out_added_offset + hidden_size_x2, outputZRH_.end(),
+                         hidden_size_x3);
         }
 
         DumpMatrix("Xt*(Wh^T) + (" + label + ")" + row_str,
@@ -854,7 +1126,7 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
       }
     };
 
-    ExecuteLambdaInParallel("Processing batch", hidden_gemm_and_activations, batch_size_, fused_hidden_rows, ttp_, logger_);
+    ExecuteLambdaInParallel("Processing batch", hidden_gemm_and_activations, batch_size_, fused_hidden_rows, ttp_, *logger_);
   } else {
     size_t out_added_offset;
 
@@ -891,13 +1163,11 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
 
       // calculate Ht-1*R[zr], and add to the weighted inputs that are in outputZRH_
       // Ht-1 * R[zr] + Xt*(W[zr]^T)
-      ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
-                  prev_Ht, prev_Ht_end,
-                  hidden_size_,
-                  recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
-                  hidden_size_, beta,
-                  outputZRH_.begin() + out_added_offset, outputZRH_.end(),
-                  hidden_size_x3);
+      recurrent_gemm(0, batch_size_, hidden_size_x2,
+                     prev_Ht, prev_Ht_end,
+                     recurrent_weightsZR, recurrent_weightsZR_ld, quantized_recurrent_weightsZR_,
+                     outputZRH_.begin() + out_added_offset, outputZRH_.end(),
+                     hidden_size_x3);
 
       DumpMatrix("Ht-1 * R[zr] + Xt*(W[zr]^T)" + seqno_str,
                  outputZRH_.data() + out_added_offset, batch_size_, hidden_size_x2, 0, hidden_size_x3);
@@ -907,13 +1177,11 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         gsl::copy(batched_bias_Rh_.subspan(batched_bias_Rh_local - batched_bias_Rh_.begin(), batched_bias_Rh_local_end - batched_bias_Rh_local), linear_output_);
 
         // compute Ht-1 * (Rh^T) + Rbh
-        ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
-                    prev_Ht, prev_Ht_end,  // Ht-1
-                    hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                    hidden_size_, beta,
-                    linear_output_.begin(), linear_output_.end(),  // pre: Rbh, post:output
-                    hidden_size_);
+        recurrent_gemm(0, batch_size_, hidden_size_,
+                       prev_Ht, prev_Ht_end,                                                 // Ht-1
+                       recurrent_weightsH, hidden_size_, quantized_recurrent_weightsH_,  // Rh^T
+                       linear_output_.begin(), linear_output_.end(),                       // pre: Rbh, post:output
+                       hidden_size_);
 
         DumpMatrix("Ht-1 * (Rh^T) + Rbh " + seqno_str, linear_output_.data(), batch_size_, hidden_size_);
       }
@@ -974,13 +1242,11 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         auto out_H = outputZRH_.begin() + out_added_offset + hidden_size_x2;
 
         // Calculate Xt*(Wh^T) + rt (.) Ht-1 * Rh
-        ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
-                    cur_h_local, cur_h_local_end,  // rt (.) Ht-1
-                    hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                    hidden_size_, beta,
-                    out_H, outputZRH_.end(),
-                    hidden_size_x3);
+        recurrent_gemm(0, batch_size_, hidden_size_,
+                       cur_h_local, cur_h_local_end,                                       // rt (.) Ht-1
+                       recurrent_weightsH, hidden_size_, quantized_recurrent_weightsH_,  // Rh^T
+                       out_H, outputZRH_.end(),
+                       hidden_size_x3);
       }
 
       DumpMatrix("Xt*(Wh^T) + (" + label + ")" + seqno_str, outputZRH_.data() + out_added_offset,
@@ -1082,7 +1348,7 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
 template <typename T>
 void UniDirectionalGru<T>::AllocateBuffers() {
   cur_h_ = Allocate(allocator_, hidden_size_ * batch_size_, cur_h_ptr_);
-  batched_hidden0_ = Allocate(allocator_, batch_size_ * hidden_size_, batched_hidden0_ptr_, true);
+  batched_hidden0_ = Allocate(allocator_, batch_size_ * hidden_size_, batched_hidden0_ptr_);
 
   if (use_bias_) {
     batched_bias_WRz_ = Allocate(allocator_, batch_size_ * hidden_size_, batched_bias_WRz_ptr_);
@@ -1096,10 +1362,21 @@ void UniDirectionalGru<T>::AllocateBuffers() {
       batched_bias_WRh_ = Allocate(allocator_, batch_size_ * hidden_size_, batched_bias_WRh_ptr_);
     }
   }
+}
+
+// buffers whose size depends on the sequence length. these only grow, so an instance that is reused for
+// calls with varying sequence lengths settles at the longest one.
+template <typename T>
+void UniDirectionalGru<T>::AllocateSequenceBuffers() {
+  if (seq_length_ <= sequence_capacity_)
+    return;
+
+  sequence_capacity_ = seq_length_;
 
   auto batch_times_seq_length = batch_size_ * seq_length_;
 
-  outputZRH_ = Allocate(allocator_, hidden_size_ * 3 * batch_times_seq_length, outputZRH_ptr_, true);
+  // every row is written by the input GEMM before use, so there's no need to fill this
+  outputZRH_ = Allocate(allocator_, hidden_size_ * 3 * batch_times_seq_length, outputZRH_ptr_);
 
   if (direction_ == kReverse) {
     inputs_reverse_ = Allocate(allocator_, batch_times_seq_length * input_size_, inputs_reverse_ptr_);
@@ -1108,8 +1385,9 @@ void UniDirectionalGru<T>::AllocateBuffers() {
 }
 
 template <typename T>
-void UniDirectionalGru<T>::SetNumThreads() {
-  int threads = std::thread::hardware_concurrency() - 1;
+void UniDirectionalGru<T>::SetNumThreads(int num_threads) {
+  // the calling thread processes rows as well, so it counts towards the threads used
+  int threads = num_threads;
 
   if (threads < 1)
     threads = 1;
@@ -1126,7 +1404,7 @@ void UniDirectionalGru<T>::SetNumThreads() {
       (num_rows >= 2 && num_columns <= 256) ||
       (num_rows >= 3 && num_columns <= 512)) {
     batch_parallel_ = true;
-    VLOGS(logger_, 1) << "Hidden Threads : " << hidden_num_threads_;
+    VLOGS(*logger_, 1) << "Hidden Threads : " << hidden_num_threads_;
   }
 
   ORT_ENFORCE(hidden_num_threads_ >= 1);
@@ -4,57 +4,34 @@
 #pragma once
 
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include "core/framework/allocator.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
 
 namespace onnxruntime {
+namespace detail {
+template <typename T>
+class UniDirectionalGru;
+}  // namespace detail
 
 /// The class represents GRU operator using DeepCPU implementation for
 /// fast inference computation on CPU machines.
-class DeepCpuGruOp final : public OpKernel {
+class DeepCpuGruOp : public OpKernel {
  public:
-  DeepCpuGruOp(const OpKernelInfo& info) : OpKernel(info) {
-    // required attributes
-    std::string direction;
-    ORT_ENFORCE(info.GetAttr("direction", &direction).IsOK());
-
-    int64_t int64_value;
-    ORT_ENFORCE(info.GetAttr("linear_before_reset", &int64_value).IsOK());
-    linear_before_reset_ = gsl::narrow<int>(int64_value);
-
-    ORT_ENFORCE(info.GetAttr("hidden_size", &int64_value).IsOK() && int64_value > 0);
-    hidden_size_ = gsl::narrow<int>(int64_value);
-
-    // optional attributes
-    std::vector<std::string> activation_func_names = info.GetAttrsOrDefault<std::string>("activations");
-    std::vector<float> activation_func_alphas = info.GetAttrsOrDefault<float>("activation_alpha");
-    std::vector<float> activation_func_betas = info.GetAttrsOrDefault<float>("activation_beta");
-
-    clip_ = info.GetAttrOrDefault<float>("clip", std::numeric_limits<float>::max());
-    ORT_ENFORCE(clip_ > 0.f);
-
-    direction_ = rnn::detail::MakeDirection(direction);
-    num_directions_ = direction_ == rnn::detail::Direction::kBidirectional ? 2 : 1;
-
-    if (activation_func_names.empty()) {
-      for (int i = 0; i < num_directions_; ++i) {
-        activation_func_names.emplace_back("sigmoid");
-        activation_func_names.emplace_back("tanh");
-      }
-    }
-
-    ORT_ENFORCE(activation_func_names.size() == num_directions_ * 2);
-
-    activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
-                                                     activation_func_alphas,
-                                                     activation_func_betas);
-  }
+  DeepCpuGruOp(const OpKernelInfo& info) : DeepCpuGruOp(info, false) {}
 
   Status Compute(OpKernelContext* context) const override;
 
-  ~DeepCpuGruOp() override = default;
+  ~DeepCpuGruOp() override;
+
+ protected:
+  // if quantize_weights is true W and R must be initializers. They are quantized to 8 bits once, and the
+  // GEMMs run on the integer GEMM with the inputs and hidden state quantized dynamically (DynamicQuantizeGRU).
+  DeepCpuGruOp(const OpKernelInfo& info, bool quantize_weights);
 
  private:
   rnn::detail::Direction direction_;
@@ -66,18 +43,36 @@ class DeepCpuGruOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
-  // Threadpool for operator. If concurrent Compute calls are possible, it will be shared
-  // across them. mutable due to this.
-  // The alternative would be to create a threadpool in each call to Compute but that would incur thread creation
-  // cost on every call.
-#ifdef USE_EIGEN_THREADPOOL
-  mutable Eigen::NonBlockingThreadPool ttp_{static_cast<int>(std::thread::hardware_concurrency())};
-#else
-  mutable TaskThreadPool ttp_{std::thread::hardware_concurrency()};
-#endif
+  // W transposed to [num_directions, input_size, 3*hidden_size], and R to [num_directions, hidden_size, 2*hidden_size]
+  // for the z and r gates followed by [num_directions, hidden_size, hidden_size] for h, when they are constant
+  // initializers, so the GEMMs don't transpose them on every call and time step.
+  IAllocatorUniquePtr<float> packed_input_weights_ptr_, packed_recurrent_weights_ptr_;
+  gsl::span<float> packed_input_weights_, packed_recurrent_weights_;
+
+  // the prepacked W and R quantized by rnn::detail::QuantizeWeights, with 3*hidden_size scales per direction for each.
+  // R[zr] and R[h] are quantized as separate matrices, so their scales follow each other in the same order.
+  // the float copies above are released once these are created.
+  bool quantize_weights_ = false;
+  IAllocatorUniquePtr<uint8_t> quantized_input_weights_ptr_, quantized_recurrent_weights_ptr_;
+  IAllocatorUniquePtr<float> input_weights_scales_ptr_, recurrent_weights_scales_ptr_;
+  gsl::span<uint8_t> quantized_input_weights_, quantized_recurrent_weights_;
+  gsl::span<float> input_weights_scales_, recurrent_weights_scales_;
+
+  // UniDirectionalGru instances of earlier calls, which keep their scratch buffers, so a call with the same batch
+  // and input size reuses them instead of allocating new ones. A call takes the instances it uses out of the cache,
+  // so concurrent calls never share one.
+  mutable OrtMutex gru_cache_mutex_;
+  mutable std::vector<std::unique_ptr<detail::UniDirectionalGru<float>>> gru_cache_;
 
   template <typename T>
   Status ComputeImpl(OpKernelContext& context) const;
+
+  void PrepackWeights(const OpKernelInfo& info);
+
+  std::unique_ptr<detail::UniDirectionalGru<float>> TakeCachedGru(rnn::detail::Direction direction,
+                                                                  int batch_size, int input_size,
+                                                                  bool use_bias) const;
+  void CacheGru(std::unique_ptr<detail::UniDirectionalGru<float>> gru) const;
 };
 
 }  // namespace onnxruntime
@@ -14,6 +14,7 @@
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
+#include "core/mlas/inc/mlas.h"
 
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -203,17 +204,33 @@ class UniDirectionalLstm {
                      const ActivationFuncs::Entry& activation_func_g,
                      const ActivationFuncs::Entry& activation_func_h,
                      const float clip,
-#ifdef USE_EIGEN_THREADPOOL
-                     Eigen::NonBlockingThreadPool& ttp);
-#else
-                     TaskThreadPool& ttp);
-#endif
-
+                     ThreadPool& ttp,
+                     int num_threads);
+
+  // Whether this instance, left over from an earlier call, can run a call with these settings.
+  bool CanReuse(Direction direction, int batch_size, int input_size, bool use_bias, bool use_peepholes) const;
+
+  // Sets up an instance for which CanReuse returned true for the next call, keeping its buffers.
+  // The sequence length may differ from the earlier call.
+  void Reset(const logging::Logger& logger,
+             const int seq_length,
+             const gsl::span<const T>& bias,
+             const gsl::span<const T>& peephole_weights,
+             const gsl::span<const T>& initial_hidden_state,
+             const gsl::span<const T>& initial_cell_state);
+
+  // Run the GEMMs of the following Compute calls on the integer GEMM with these weights, which are laid out as
+  // prepacked weights. The input_weights and recurrent_weights passed to Compute are ignored then.
+  void UseQuantizedWeights(const QuantizedWeights& input_weights, const QuantizedWeights& recurrent_weights);
+
+  // weights_prepacked is true if input_weights and recurrent_weights come from DeepCpuLstmOp::PrepackWeights
+  // and are [input_size, 4*hidden_size] and [hidden_size, 4*hidden_size] instead of the transposed ONNX layout.
   void Compute(const gsl::span<const T>& inputs,
                const gsl::span<const int>& sequence_lengths,
                const int num_directions,
                const gsl::span<const T>& input_weights,
                const gsl::span<const T>& recurrent_weights,
+               const bool weights_prepacked,
                gsl::span<T>& outputs,
                gsl::span<T>& final_hidden_state,
                gsl::span<T>& final_cell_state);
@@ -224,7 +241,7 @@ class UniDirectionalLstm {
   using span_T_const_iter = typename gsl::span<T>::const_iterator;
   using span_T_iter = typename gsl::span<T>::iterator;
 
-  void SetNumThreads();
+  void SetNumThreads(int num_threads);
 
   void GateComputations(span_T_iter& out, span_T_iter& out_end,
                         span_T_iter& C_prev, span_T_iter& C_prev_end,  // Ct-1 value not 'ct'. using 'C' for clarity
@@ -238,6 +255,7 @@ class UniDirectionalLstm {
                         bool output_sequence);
 
   void AllocateBuffers();
+  void AllocateSequenceBuffers();
 
   void InitializeBuffers(const gsl::span<const T>& initial_hidden_state,
                          const gsl::span<const T>& initial_cell_state);
@@ -246,9 +264,10 @@ class UniDirectionalLstm {
   void LoadBias(const gsl::span<const T>& WbRb_values);
 
   AllocatorPtr allocator_;
-  const logging::Logger& logger_;
+  const logging::Logger* logger_;
 
   int seq_length_;
+  int sequence_capacity_ = 0;  // sequence length the buffers in AllocateSequenceBuffers have room for
   int batch_size_;
   int input_size_;
   int hidden_size_;
@@ -262,6 +281,10 @@ class UniDirectionalLstm {
   bool use_bias_;
   bool use_peepholes_;
 
+  // with the default activations, no clipping and no peepholes the gate activations run over each block of GEMM
+  // output with MlasActivation rather than per row and gate.
+  bool fused_gates_;
+
   int hidden_num_threads_ = -1;
 
   IAllocatorUniquePtr<T> output_iofc_ptr_;
@@ -276,12 +299,11 @@ class UniDirectionalLstm {
   gsl::span<T> internal_memory_cur_, batched_internal_memory_cur_;
   gsl::span<T> batched_internal_memory_clipped_;
 
-  IAllocatorUniquePtr<T> bias_WRi_ptr_, bias_WRf_ptr_, bias_WRo_ptr_, bias_WRc_ptr_;
-  IAllocatorUniquePtr<T> batched_bias_WRi_ptr_, batched_bias_WRf_ptr_, batched_bias_WRo_ptr_, batched_bias_WRc_ptr_;
+  // Wb[iofc] + Rb[iofc]. every row of output_iofc_ starts out with these values so the input GEMM adds the bias.
+  IAllocatorUniquePtr<T> bias_WR_ptr_;
   IAllocatorUniquePtr<T> peephole_i_ptr_, peephole_f_ptr_, peephole_o_ptr_;
   IAllocatorUniquePtr<T> inputs_reverse_ptr_, outputs_reverse_ptr_;
-  gsl::span<T> bias_WRi_, bias_WRf_, bias_WRo_, bias_WRc_;
-  gsl::span<T> batched_bias_WRi_, batched_bias_WRf_, batched_bias_WRo_, *batched_bias_WRc_;
+  gsl::span<T> bias_WR_;
   gsl::span<T> inputs_reverse_, outputs_reverse_;
 
 #if defined(LSTM_NO_PEEPHOLE_COPY)
@@ -293,21 +315,158 @@ class UniDirectionalLstm {
   IAllocatorUniquePtr<int> sequence_lengths_ptr_;
   gsl::span<int> sequence_lengths_;
 
-  deepcpu::ClipWithBiasFuncPtr clip_with_bias_ptr_;
+  // set by UseQuantizedWeights. the scratch buffers hold the quantized inputs or hidden state and the int32 GEMM
+  // output. the recurrent GEMMs use the rows of quantized_output_ matching the batch rows they process.
+  bool quantized_ = false;
+  QuantizedWeights quantized_input_weights_, quantized_recurrent_weights_;
+  IAllocatorUniquePtr<uint8_t> quantized_inputs_ptr_, quantized_hidden_ptr_;
+  IAllocatorUniquePtr<int32_t> quantized_output_ptr_;
+  gsl::span<uint8_t> quantized_inputs_, quantized_hidden_;
+  gsl::span<int32_t> quantized_output_;
 
   ActivationInfo<deepcpu::ActivationFuncPtr> activation_f_;
   ActivationInfo<deepcpu::ActivationFuncPtr> activation_g_;
   ActivationInfo<deepcpu::LstmMergeGatesFuncPtr> activation_h_;
 
-#ifdef USE_EIGEN_THREADPOOL
-  Eigen::NonBlockingThreadPool& ttp_;
-#else
-  TaskThreadPool& ttp_;
-#endif
+  ThreadPool& ttp_;
 };
 
 }  // namespace detail
 
+DeepCpuLstmOp::DeepCpuLstmOp(const OpKernelInfo& info, bool quantize_weights)
+    : OpKernel(info),
+      clip_(info.GetAttrOrDefault<float>("clip", std::numeric_limits<float>::max())),
+      quantize_weights_(quantize_weights) {
+  std::string direction;
+  ORT_ENFORCE(info.GetAttr("direction", &direction).IsOK());
+
+  int64_t int64_value;
+  ORT_ENFORCE(info.GetAttr("hidden_size", &int64_value).IsOK() && int64_value > 0);
+  hidden_size_ = gsl::narrow<int>(int64_value);
+
+  // optional attributes
+  std::vector<std::string> activation_func_names = info.GetAttrsOrDefault<std::string>("activations");
+  std::vector<float> activation_func_alphas = info.GetAttrsOrDefault<float>("activation_alpha");
+  std::vector<float> activation_func_betas = info.GetAttrsOrDefault<float>("activation_beta");
+  ORT_ENFORCE(clip_ > 0.f);
+
+  if (info.GetAttr("input_forget", &int64_value).IsOK())
+    input_forget_ = int64_value != 0;
+
+  direction_ = rnn::detail::MakeDirection(direction);
+  num_directions_ = direction_ == rnn::detail::Direction::kBidirectional ? 2 : 1;
+
+  if (activation_func_names.empty()) {
+    for (int i = 0; i < num_directions_; ++i) {
+      activation_func_names.emplace_back("sigmoid");
+      activation_func_names.emplace_back("tanh");
+      activation_func_names.emplace_back("tanh");
+    }
+  }
+
+  ORT_ENFORCE(activation_func_names.size() == num_directions_ * 3);
+
+  activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
+                                                   activation_func_alphas,
+                                                   activation_func_betas);
+
+  PrepackWeights(info);
+}
+
+DeepCpuLstmOp::~DeepCpuLstmOp() = default;
+
+void DeepCpuLstmOp::PrepackWeights(const OpKernelInfo& info) {
+  const Tensor* W;
+  const Tensor* R;
+  if (!info.TryGetConstantInput(1, &W) || !info.TryGetConstantInput(2, &R) ||
+      W->DataType() != DataTypeImpl::GetType<float>() || R->DataType() != DataTypeImpl::GetType<float>()) {
+    ORT_ENFORCE(!quantize_weights_, "DynamicQuantizeLSTM requires W and R to be float initializers.");
+    return;
+  }
+
+  // ValidateInputs reports unexpected shapes when the kernel runs, so just don't prepack those.
+  const auto& W_shape = W->Shape();
+  const auto& R_shape = R->Shape();
+  if (W_shape.NumDimensions() != 3 || W_shape[0] != num_directions_ || W_shape[1] != 4 * hidden_size_ ||
+      R_shape.NumDimensions() != 3 || R_shape[0] != num_directions_ || R_shape[1] != 4 * hidden_size_ ||
+      R_shape[2] != hidden_size_) {
+    ORT_ENFORCE(!quantize_weights_, "DynamicQuantizeLSTM has unexpected W shape ", W_shape,
+                " or R shape ", R_shape);
+    return;
+  }
+
+  const size_t input_size = gsl::narrow<size_t>(W_shape[2]);
+  const size_t hidden_size_x4 = 4 * static_cast<size_t>(hidden_size_);
+  const size_t input_weights_size_per_direction = hidden_size_x4 * input_size;
+  const size_t recurrent_weights_size_per_direction = hidden_size_x4 * hidden_size_;
+
+  AllocatorPtr alloc = info.GetAllocator(0, OrtMemTypeDefault);
+  packed_input_weights_ = Allocate(alloc, input_weights_size_per_direction * num_directions_,
+                                   packed_input_weights_ptr_);
+  packed_recurrent_weights_ = Allocate(alloc, recurrent_weights_size_per_direction * num_directions_,
+                                       packed_recurrent_weights_ptr_);
+
+  for (int i = 0; i < num_directions_; ++i) {
+    MlasTranspose(W->Data<float>() + i * input_weights_size_per_direction,
+                  packed_input_weights_.data() + i * input_weights_size_per_direction,
+                  hidden_size_x4, input_size);
+    MlasTranspose(R->Data<float>() + i * recurrent_weights_size_per_direction,
+                  packed_recurrent_weights_.data() + i * recurrent_weights_size_per_direction,
+                  hidden_size_x4, static_cast<size_t>(hidden_size_));
+  }
+
+  if (quantize_weights_) {
+    quantized_input_weights_ = Allocate(alloc, packed_input_weights_.size(), quantized_input_weights_ptr_);
+    quantized_recurrent_weights_ = Allocate(alloc, packed_recurrent_weights_.size(), quantized_recurrent_weights_ptr_);
+    input_weights_scales_ = Allocate(alloc, hidden_size_x4 * num_directions_, input_weights_scales_ptr_);
+    recurrent_weights_scales_ = Allocate(alloc, hidden_size_x4 * num_directions_, recurrent_weights_scales_ptr_);
+
+    for (int i = 0; i < num_directions_; ++i) {
+      QuantizeWeights(packed_input_weights_.data() + i * input_weights_size_per_direction,
+                      static_cast<int>(input_size), static_cast<int>(hidden_size_x4),
+                      quantized_input_weights_.data() + i * input_weights_size_per_direction,
+                      input_weights_scales_.data() + i * hidden_size_x4);
+      QuantizeWeights(packed_recurrent_weights_.data() + i * recurrent_weights_size_per_direction,
+                      hidden_size_, static_cast<int>(hidden_size_x4),
+                      quantized_recurrent_weights_.data() + i * recurrent_weights_size_per_direction,
+                      recurrent_weights_scales_.data() + i * hidden_size_x4);
+    }
+
+    packed_input_weights_ptr_.reset();
+    packed_recurrent_weights_ptr_.reset();
+    packed_input_weights_ = gsl::span<float>();
+    packed_recurrent_weights_ = gsl::span<float>();
+  }
+}
+
+std::unique_ptr<detail::UniDirectionalLstm<float>> DeepCpuLstmOp::TakeCachedLstm(Direction direction,
+                                                                                 int batch_size, int input_size,
+                                                                                 bool use_bias,
+                                                                                 bool use_peepholes) const {
+  std::lock_guard<OrtMutex> lock(lstm_cache_mutex_);
+  for (auto it = lstm_cache_.begin(); it != lstm_cache_.end(); ++it) {
+    if ((*it)->CanReuse(direction, batch_size, input_size, use_bias, use_peepholes)) {
+      auto lstm = std::move(*it);
+      lstm_cache_.erase(it);
+      return lstm;
+    }
+  }
+
+  return nullptr;
+}
+
+void DeepCpuLstmOp::CacheLstm(std::unique_ptr<detail::UniDirectionalLstm<float>> lstm) const {
+  // enough for both directions of a few concurrent calls. if the batch or input size keeps changing the oldest
+  // instances are dropped.
+  constexpr size_t max_cached = 8;
+
+  std::lock_guard<OrtMutex> lock(lstm_cache_mutex_);
+  if (lstm_cache_.size() >= max_cached)
+    lstm_cache_.erase(lstm_cache_.begin());
+
+  lstm_cache_.push_back(std::move(lstm));
+}
+
 Status
 DeepCpuLstmOp::Compute(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
@@ -339,6 +498,9 @@ template <typename T>
 Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   auto& logger = context.Logger();
 
+  int num_threads;
+  ThreadPool& ttp = GetIntraOpThreadPool(context, num_threads);
+
   const Tensor& X = *context.Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
   const Tensor& W = *context.Input<Tensor>(1);  // weights. [num_directions, 4*hidden_size, input_size]
   const Tensor& R = *context.Input<Tensor>(2);  // recurrence weights. [num_directions, 4*hidden_size, hidden_size]
@@ -373,8 +535,12 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
 
-  gsl::span<const T> input_weights = W.DataAsSpan<T>();
-  gsl::span<const T> recurrent_weights = R.DataAsSpan<T>();
+  // use the weights transposed by PrepackWeights if W and R are initializers
+  const bool weights_prepacked = !packed_input_weights_.empty();
+  gsl::span<const T> input_weights = weights_prepacked ? gsl::span<const T>(packed_input_weights_)
+                                                       : W.DataAsSpan<T>();
+  gsl::span<const T> recurrent_weights = weights_prepacked ? gsl::span<const T>(packed_recurrent_weights_)
+                                                           : R.DataAsSpan<T>();
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
   gsl::span<const T> peephole_weights = P != nullptr ? P->DataAsSpan<T>() : gsl::span<const T>();
 
@@ -438,6 +604,51 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   std::unique_ptr<detail::UniDirectionalLstm<T>> fw;
   std::unique_ptr<detail::UniDirectionalLstm<T>> bw;
 
+  // run the two directions of a bidirectional LSTM concurrently, each with half of the threads.
+  // with OpenMP the GEMMs already fan out over the OpenMP threads, and a team per direction would oversubscribe them.
+#if defined(USE_MLAS) && !defined(USE_OPENMP)
+  const bool parallel_directions = direction_ == Direction::kBidirectional && num_threads > 1;
+#else
+  const bool parallel_directions = false;
+#endif
+  const int direction_threads = parallel_directions ? num_threads / 2 : num_threads;
+
+  // take an instance left from an earlier call if there is one with matching buffer sizes.
+  // activations are the 3 entries starting at first_activation.
+  auto make_lstm = [&](Direction direction,
+                       const gsl::span<const T>& lstm_bias, const gsl::span<const T>& lstm_peephole_weights,
+                       const gsl::span<const T>& lstm_initial_hidden, const gsl::span<const T>& lstm_initial_cell,
+                       size_t first_activation) {
+    auto lstm = TakeCachedLstm(direction, batch_size, input_size, !lstm_bias.empty(), !lstm_peephole_weights.empty());
+    if (lstm) {
+      lstm->Reset(logger, seq_length, lstm_bias, lstm_peephole_weights, lstm_initial_hidden, lstm_initial_cell);
+    } else {
+      lstm = std::make_unique<detail::UniDirectionalLstm<T>>(alloc, logger,
+                                                             seq_length, batch_size, input_size,
+                                                             hidden_size_, direction, input_forget_,
+                                                             lstm_bias, lstm_peephole_weights,
+                                                             lstm_initial_hidden, lstm_initial_cell,
+                                                             activation_funcs_.Entries()[first_activation],
+                                                             activation_funcs_.Entries()[first_activation + 1],
+                                                             activation_funcs_.Entries()[first_activation + 2],
+                                                             clip_, ttp, direction_threads);
+    }
+
+    if (quantize_weights_) {
+      const size_t i = direction == Direction::kReverse && direction_ == Direction::kBidirectional ? 1 : 0;
+      const size_t scales_per_direction = 4 * hidden_size_;
+      lstm->UseQuantizedWeights(
+          QuantizedWeights{quantized_input_weights_.subspan(i * input_weights_size_per_direction,
+                                                            input_weights_size_per_direction),
+                           input_weights_scales_.subspan(i * scales_per_direction, scales_per_direction)},
+          QuantizedWeights{quantized_recurrent_weights_.subspan(i * hidden_weights_size_per_direction,
+                                                                hidden_weights_size_per_direction),
+                           recurrent_weights_scales_.subspan(i * scales_per_direction, scales_per_direction)});
+    }
+
+    return lstm;
+  };
+
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
     gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
@@ -466,39 +677,36 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
     gsl::span<T> last_cell_2 = last_cell.subspan(last_cell_size_per_direction,
                                                  last_cell_size_per_direction);
 
-    fw = std::make_unique<detail::UniDirectionalLstm<T>>(alloc, logger,
-                                                         seq_length, batch_size, input_size,
-                                                         hidden_size_, Direction::kForward, input_forget_,
-                                                         bias_1, peephole_weights_1, initial_hidden_1, initial_cell_1,
-                                                         activation_funcs_.Entries()[0],
-                                                         activation_funcs_.Entries()[1],
-                                                         activation_funcs_.Entries()[2],
-                                                         clip_, ttp_);
-
-    bw = std::make_unique<detail::UniDirectionalLstm<T>>(alloc, logger,
-                                                         seq_length, batch_size, input_size,
-                                                         hidden_size_, Direction::kReverse, input_forget_,
-                                                         bias_2, peephole_weights_2, initial_hidden_2, initial_cell_2,
-                                                         activation_funcs_.Entries()[3],
-                                                         activation_funcs_.Entries()[4],
-                                                         activation_funcs_.Entries()[5],
-                                                         clip_, ttp_);
-
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
-    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+    fw = make_lstm(Direction::kForward, bias_1, peephole_weights_1, initial_hidden_1, initial_cell_1, 0);
+    bw = make_lstm(Direction::kReverse, bias_2, peephole_weights_2, initial_hidden_2, initial_cell_2, 3);
+
+    auto compute_direction = [&](int i) {
+      if (i == 0)
+        fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+                    weights_prepacked, output_1, hidden_output_1, last_cell_1);
+      else
+        bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2,
+                    weights_prepacked, output_2, hidden_output_2, last_cell_2);
+    };
+
+    if (parallel_directions) {
+      ExecuteLambdaInParallel("Processing directions", compute_direction, 2, 1, ttp, logger);
+    } else {
+      compute_direction(0);
+      compute_direction(1);
+    }
   } else {
-    fw = std::make_unique<detail::UniDirectionalLstm<T>>(alloc, logger,
-                                                         seq_length, batch_size, input_size,
-                                                         hidden_size_, direction_, input_forget_,
-                                                         bias_1, peephole_weights_1, initial_hidden_1, initial_cell_1,
-                                                         activation_funcs_.Entries()[0],
-                                                         activation_funcs_.Entries()[1],
-                                                         activation_funcs_.Entries()[2],
-                                                         clip_, ttp_);
-
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+    fw = make_lstm(direction_, bias_1, peephole_weights_1, initial_hidden_1, initial_cell_1, 0);
+
+    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+                weights_prepacked, output_1, hidden_output_1, last_cell_1);
   }
 
+  // keep the instances, and with them their buffers, for the next call
+  CacheLstm(std::move(fw));
+  if (bw)
+    CacheLstm(std::move(bw));
+
   if (!output.empty())
     DumpMatrix("Y", output.data(), seq_length * num_directions_ * batch_size, hidden_size_);
 
@@ -566,13 +774,10 @@ UniDirectionalLstm<T>::UniDirectionalLstm(AllocatorPtr allocator,
                                           const ActivationFuncs::Entry& activation_func_g,
                                           const ActivationFuncs::Entry& activation_func_h,
                                           const float clip,
-#ifdef USE_EIGEN_THREADPOOL
-                                          Eigen::NonBlockingThreadPool& ttp)
-#else
-                                          TaskThreadPool& ttp)
-#endif
+                                          ThreadPool& ttp,
+                                          int num_threads)
     : allocator_(allocator),
-      logger_(logger),
+      logger_(&logger),
       seq_length_(seq_length),
       batch_size_(batch_size),
       input_size_(input_size),
@@ -595,12 +800,42 @@ UniDirectionalLstm<T>::UniDirectionalLstm(AllocatorPtr allocator,
                    activation_func_h.alpha,
                    activation_func_h.beta};
 
-  clip_with_bias_ptr_ = use_bias_ ? deepcpu::clip_add_bias : deepcpu::clip_ignore_bias;
+  fused_gates_ = !use_peepholes_ && clip_ == std::numeric_limits<float>::max() &&
+                 activation_func_f.name == "sigmoid" && activation_func_g.name == "tanh" &&
+                 activation_func_h.name == "tanh";
 
-  SetNumThreads();
+  SetNumThreads(num_threads);
   AllocateBuffers();
+  AllocateSequenceBuffers();
+  InitializeBuffers(initial_hidden_state, initial_cell_state);
+
+  if (!peephole_weights.empty())
+    LoadPeepholeWeights(peephole_weights);
+  if (!bias.empty())
+    LoadBias(bias);
+}
+
+template <typename T>
+bool UniDirectionalLstm<T>::CanReuse(Direction direction, int batch_size, int input_size,
+                                     bool use_bias, bool use_peepholes) const {
+  return direction_ == direction && batch_size_ == batch_size && input_size_ == input_size &&
+         use_bias_ == use_bias && use_peepholes_ == use_peepholes;
+}
+
+template <typename T>
+void UniDirectionalLstm<T>::Reset(const logging::Logger& logger,
+                                  const int seq_length,
+                                  const gsl::span<const T>& bias,
+                                  const gsl::span<const T>& peephole_weights,
+                                  const gsl::span<const T>& initial_hidden_state,
+                                  const gsl::span<const T>& initial_cell_state) {
+  logger_ = &logger;
+  seq_length_ = seq_length;
+
+  AllocateSequenceBuffers();
   InitializeBuffers(initial_hidden_state, initial_cell_state);
 
+  // B and P aren't necessarily initializers, so reload them every call
   if (!peephole_weights.empty())
     LoadPeepholeWeights(peephole_weights);
   if (!bias.empty())
@@ -623,19 +858,8 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
   batched_internal_memory_clipped_ = Allocate(allocator_, batch_size_ * hidden_size_,
                                               batched_internal_memory_clipped_ptr_, fill);
 
-  output_iofc_ = Allocate(allocator_, hidden_size_ * 4 * batch_size_ * seq_length_, output_iofc_ptr_, fill);
-
-  if (use_bias_) {
-    bias_WRi_ = Allocate(allocator_, hidden_size_, bias_WRi_ptr_);
-    bias_WRf_ = Allocate(allocator_, hidden_size_, bias_WRf_ptr_);
-    bias_WRo_ = Allocate(allocator_, hidden_size_, bias_WRo_ptr_);
-    bias_WRc_ = Allocate(allocator_, hidden_size_, bias_WRc_ptr_);
-  }
-
-  if (direction_ == kReverse) {
-    inputs_reverse_ = Allocate(allocator_, seq_length_ * batch_size_ * input_size_, inputs_reverse_ptr_);
-    outputs_reverse_ = Allocate(allocator_, seq_length_ * batch_size_ * hidden_size_, outputs_reverse_ptr_);
-  }
+  if (use_bias_)
+    bias_WR_ = Allocate(allocator_, hidden_size_ * 4, bias_WR_ptr_);
 
 #if !defined(LSTM_NO_PEEPHOLE_COPY)
   if (use_peepholes_) {
@@ -646,6 +870,41 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
 #endif
 }
 
+template <typename T>
+void UniDirectionalLstm<T>::UseQuantizedWeights(const QuantizedWeights& input_weights,
+                                                const QuantizedWeights& recurrent_weights) {
+  quantized_ = true;
+  quantized_input_weights_ = input_weights;
+  quantized_recurrent_weights_ = recurrent_weights;
+
+  const size_t rows = static_cast<size_t>(seq_length_) * batch_size_;
+  if (static_cast<size_t>(quantized_inputs_.size()) < rows * input_size_) {
+    quantized_inputs_ = Allocate(allocator_, rows * input_size_, quantized_inputs_ptr_);
+    quantized_output_ = Allocate(allocator_, rows * 4 * hidden_size_, quantized_output_ptr_);
+  }
+
+  if (quantized_hidden_.empty())
+    quantized_hidden_ = Allocate(allocator_, batch_size_ * hidden_size_, quantized_hidden_ptr_);
+}
+
+// buffers whose size depends on the sequence length. these only grow, so an instance that is reused for
+// calls with varying sequence lengths settles at the longest one.
+template <typename T>
+void UniDirectionalLstm<T>::AllocateSequenceBuffers() {
+  if (seq_length_ <= sequence_capacity_)
+    return;
+
+  sequence_capacity_ = seq_length_;
+
+  // every row is written by the input GEMM before use, so there's no need to fill this
+  output_iofc_ = Allocate(allocator_, hidden_size_ * 4 * batch_size_ * seq_length_, output_iofc_ptr_);
+
+  if (direction_ == kReverse) {
+    inputs_reverse_ = Allocate(allocator_, seq_length_ * batch_size_ * input_size_, inputs_reverse_ptr_);
+    outputs_reverse_ = Allocate(allocator_, seq_length_ * batch_size_ * hidden_size_, outputs_reverse_ptr_);
+  }
+}
+
 template <typename T>
 void UniDirectionalLstm<T>::InitializeBuffers(const gsl::span<const T>& initial_hidden_state,
                                               const gsl::span<const T>& initial_cell_state) {
@@ -697,23 +956,13 @@ void UniDirectionalLstm<T>::LoadPeepholeWeights(const gsl::span<const T>& peepho
 
 template <typename T>
 void UniDirectionalLstm<T>::LoadBias(const gsl::span<const T>& WbRb_values) {
-  // add Wb and Rb
-  auto copy_fused_bias = [this, &WbRb_values](int offset, gsl::span<T>& out) {
-    // gap between Wb and Wb value for an entry
-    const int Wb_to_Rb_offset = 4 * hidden_size_;
-
-    for (int j = 0; j < hidden_size_; ++j)
-      out[j] = WbRb_values[j + offset] + WbRb_values[j + offset + Wb_to_Rb_offset];
-  };
-
-  int i = 0;
-  copy_fused_bias((i++) * hidden_size_, bias_WRi_);
-  copy_fused_bias((i++) * hidden_size_, bias_WRo_);
-  copy_fused_bias((i++) * hidden_size_, bias_WRf_);
-  copy_fused_bias((i++) * hidden_size_, bias_WRc_);
+  // add Wb and Rb. both are in iofc order so this is a single pass over the 4 gates.
+  const int Wb_to_Rb_offset = 4 * hidden_size_;
+  for (int j = 0; j < Wb_to_Rb_offset; ++j)
+    bias_WR_[j] = WbRb_values[j] + WbRb_values[j + Wb_to_Rb_offset];
 
   /*
-  i = 0;
+  int i = 0;
   DumpMatrix("Wb[i]", WbRb_values.data() + (i++ * hidden_size_), 1, hidden_size_);
   DumpMatrix("Wb[o]", WbRb_values.data() + (i++ * hidden_size_), 1, hidden_size_);
   DumpMatrix("Wb[f]", WbRb_values.data() + (i++ * hidden_size_), 1, hidden_size_);
@@ -723,10 +972,7 @@ void UniDirectionalLstm<T>::LoadBias(const gsl::span<const T>& WbRb_values) {
   DumpMatrix("Rb[f]", WbRb_values.data() + (i++ * hidden_size_), 1, hidden_size_);
   DumpMatrix("Rb[c]", WbRb_values.data() + (i++ * hidden_size_), 1, hidden_size_);
 
-  DumpMatrix("Wb[i]+Rb[i]", bias_WRi_.data(), 1, hidden_size_);
-  DumpMatrix("Wb[o]+Rb[o]", bias_WRo_.data(), 1, hidden_size_);
-  DumpMatrix("Wb[f]+Rb[f]", bias_WRf_.data(), 1, hidden_size_);
-  DumpMatrix("Wb[c]+Rb[c]", bias_WRc_.data(), 1, hidden_size_);
+  DumpMatrix("Wb[iofc]+Rb[iofc]", bias_WR_.data(), 1, 4 * hidden_size_);
   */
 }
 
@@ -736,6 +982,7 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
                                     const int num_directions,
                                     const gsl::span<const T>& input_weights,
                                     const gsl::span<const T>& recurrent_weights,
+                                    const bool weights_prepacked,
                                     gsl::span<T>& outputs,
                                     gsl::span<T>& final_hidden_state,
                                     gsl::span<T>& final_cell_state) {
@@ -745,7 +992,10 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
 
   // if sequence lengths weren't provided, use internal array and init all to seq_length
   if (sequence_lengths.empty()) {
-    sequence_lengths_ = Allocate(allocator_, batch_size_, sequence_lengths_ptr_, true, seq_length_);
+    if (sequence_lengths_.empty())
+      sequence_lengths_ = Allocate(allocator_, batch_size_, sequence_lengths_ptr_);
+
+    std::fill_n(sequence_lengths_.data(), sequence_lengths_.size(), seq_length_);
     sequence_lengths = sequence_lengths_;
   }
 
@@ -791,16 +1041,39 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
   const int hidden_size_x4 = 4 * hidden_size_;
   const int total_rows = max_sequence_length * batch_size_;
 
+  // prepacked weights are [K, 4*hidden_size] so the GEMMs read B without a transpose
+  const bool weights_transposed = !weights_prepacked;
+  const int input_weights_ld = weights_prepacked ? hidden_size_x4 : input_size_;
+  const int recurrent_weights_ld = weights_prepacked ? hidden_size_x4 : hidden_size_;
+
+  // start every row with the bias so the input GEMM accumulates onto it rather than adding it per gate later
+  if (use_bias_) {
+    for (int r = 0; r < total_rows; ++r)
+      std::copy(bias_WR_.cbegin(), bias_WR_.cend(), output_iofc_.begin() + r * hidden_size_x4);
+
+    beta = 1.0f;
+  }
+
   // apply the weights to all the inputs and save to output_IOFC
-  ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
-              inputs.cbegin(), inputs.cend(),
-              input_size_,
-              input_weights.cbegin(), input_weights.cend(),  // W[iofc]
-              input_size_, beta,
-              output_iofc_.begin(), output_iofc_.end(),
-              hidden_size_x4);
+  if (quantized_) {
+    ORT_ENFORCE(static_cast<size_t>(inputs.size()) >= static_cast<size_t>(total_rows) * input_size_);
+    ComputeQuantizedGemm(total_rows, hidden_size_x4, input_size_,
+                         inputs.data(), input_size_,
+                         quantized_input_weights_,  // W[iofc]
+                         beta,
+                         output_iofc_.data(), hidden_size_x4,
+                         quantized_inputs_, quantized_output_);
+  } else {
+    ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
+                inputs.cbegin(), inputs.cend(),
+                input_size_,
+                input_weights.cbegin(), input_weights.cend(),  // W[iofc]
+                input_weights_ld, beta,
+                output_iofc_.begin(), output_iofc_.end(),
+                hidden_size_x4, weights_transposed);
+  }
 
-  DumpMatrix("Xt*(W[iofc]^T)", output_iofc_.data(), total_rows, hidden_size_x4);
+  DumpMatrix("Xt*(W[iofc]^T) + Wb[iofc] + Rb[iofc]", output_iofc_.data(), total_rows, hidden_size_x4);
 
   beta = 1.0f;  // calls to ComputeGemm now add to existing data
 
@@ -841,13 +1114,28 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
         span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_ + row) * hidden_size_x4;
 
         // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
-        ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
-                    previous_state, previous_state_end,  // Ht-1
-                    hidden_size_,
-                    recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                    hidden_size_, beta,
-                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                    hidden_size_x4);
+        if (quantized_) {
+          ComputeQuantizedGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_,
+                               SafeRawConstPointer<T>(previous_state, previous_state_end,
+                                                      local_fused_hidden_rows * hidden_size_),  // Ht-1
+                               hidden_size_,
+                               quantized_recurrent_weights_,  // R[iofc]
+                               beta,
+                               SafeRawPointer<T>(step_out_IOFC, output_iofc_.end(),
+                                                 local_fused_hidden_rows * hidden_size_x4),
+                               hidden_size_x4,
+                               quantized_hidden_.subspan(row * hidden_size_, local_fused_hidden_rows * hidden_size_),
+                               quantized_output_.subspan(row * hidden_size_x4,
+                                                         local_fused_hidden_rows * hidden_size_x4));
+        } else {
+          ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
+                      previous_state, previous_state_end,  // Ht-1
+                      hidden_size_,
+                      recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
+                      recurrent_weights_ld, beta,
+                      step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                      hidden_size_x4, weights_transposed);
+        }
 
         DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str,
                    &*step_out_IOFC, local_fused_hidden_rows, hidden_size_x4);
@@ -893,7 +1181,7 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       }
     };
 
-    ExecuteLambdaInParallel("Processing batch", hidden_gemm_and_activations, batch_size_, fused_hidden_rows, ttp_, logger_);
+    ExecuteLambdaInParallel("Processing batch", hidden_gemm_and_activations, batch_size_, fused_hidden_rows, ttp_, *logger_);
 
   } else {
     span_T_iter c_prev = batched_internal_state_prev_one_step.begin();
@@ -914,13 +1202,25 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_) * hidden_size_x4;
 
       // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
-      ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
-                  previous_state, previous_state_end,  // Ht-1
-                  hidden_size_,
-                  recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                  hidden_size_, beta,
-                  step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4);
+      if (quantized_) {
+        ComputeQuantizedGemm(batch_size_, hidden_size_x4, hidden_size_,
+                             SafeRawConstPointer<T>(previous_state, previous_state_end,
+                                                    batch_size_ * hidden_size_),  // Ht-1
+                             hidden_size_,
+                             quantized_recurrent_weights_,  // R[iofc]
+                             beta,
+                             SafeRawPointer<T>(step_out_IOFC, output_iofc_.end(), batch_size_ * hidden_size_x4),
+                             hidden_size_x4,
+                             quantized_hidden_, quantized_output_);
+      } else {
+        ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
+                    previous_state, previous_state_end,  // Ht-1
+                    hidden_size_,
+                    recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
+                    recurrent_weights_ld, beta,
+                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4, weights_transposed);
+      }
 
       span_T_iter batched_output, batched_output_end;
       if (output_sequence) {
@@ -992,6 +1292,17 @@ void UniDirectionalLstm<T>::GateComputations(span_T_iter& out, span_T_iter& out_
                                              bool output_sequence) {
   int hidden_size_x4 = 4 * hidden_size_;
 
+  if (fused_gates_) {
+    // i, o and f are contiguous in each row so one sigmoid covers all three, then tanh over c.
+    // rows past their sequence length are activated too, but they are never read.
+    float* pi = SafeRawPointer<T>(out, out_end, local_fused_hidden_rows * hidden_size_x4);
+    MLAS_ACTIVATION logistic_activation{MlasLogisticActivation, 0.f};
+    MLAS_ACTIVATION tanh_activation{MlasTanhActivation, 0.f};
+    MlasActivation(&logistic_activation, pi, nullptr, local_fused_hidden_rows, pi, 3 * hidden_size_, hidden_size_x4);
+    MlasActivation(&tanh_activation, pi + 3 * hidden_size_, nullptr, local_fused_hidden_rows, pi + 3 * hidden_size_,
+                   hidden_size_, hidden_size_x4);
+  }
+
   // Activation gates.
   for (int b = 0; b < local_fused_hidden_rows; b++) {
     if (step >= min_sequence_length && step >= seq_lengths[row + b]) {
@@ -1025,32 +1336,33 @@ void UniDirectionalLstm<T>::GateComputations(span_T_iter& out, span_T_iter& out_
                                    pi, hidden_size_);
     }
 
-    const float* pBi = use_bias_ ? SafeRawConstPointer<T>(bias_WRi_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBi, pi, hidden_size_);  // post: pi has input to f() to calculate i
-    activation_f_.func(pi, hidden_size_, activation_f_.alpha, activation_f_.beta);
+    if (!fused_gates_) {
+      deepcpu::clip_ignore_bias(clip_, nullptr, pi, hidden_size_);  // post: pi has input to f() to calculate i
+      activation_f_.func(pi, hidden_size_, activation_f_.alpha, activation_f_.beta);
+    }
     // DumpMatrix("i" + row_str, pi, 1, hidden_size_);
 
     // Forget Gate
     if (input_forget_) {
       for (int i = 0; i < hidden_size_; i++)
         pf[i] = 1.0f - pi[i];
-    } else {
+    } else if (!fused_gates_) {
       if (use_peepholes_) {
         deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_f_, 0, hidden_size_),
                                      pf, hidden_size_);
       }
 
-      const float* pBf = use_bias_ ? SafeRawConstPointer<T>(bias_WRf_, 0, hidden_size_) : nullptr;
-      clip_with_bias_ptr_(clip_, pBf, pf, hidden_size_);
+      deepcpu::clip_ignore_bias(clip_, nullptr, pf, hidden_size_);
       activation_f_.func(pf, hidden_size_, activation_f_.alpha, activation_f_.beta);
     }
 
     // DumpMatrix("f" + row_str, pf, 1, hidden_size_);
 
     // Block Gate
-    const float* pBc = use_bias_ ? SafeRawConstPointer<T>(bias_WRc_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBc, pc, hidden_size_);
-    activation_g_.func(pc, hidden_size_, activation_g_.alpha, activation_g_.beta);
+    if (!fused_gates_) {
+      deepcpu::clip_ignore_bias(clip_, nullptr, pc, hidden_size_);
+      activation_g_.func(pc, hidden_size_, activation_g_.alpha, activation_g_.beta);
+    }
 
     // DumpMatrix("c" + row_str, pc, 1, hidden_size_);
 
@@ -1070,9 +1382,10 @@ void UniDirectionalLstm<T>::GateComputations(span_T_iter& out, span_T_iter& out_
                                    po, hidden_size_);
 
     // calculate 'ot'
-    const float* pBo = use_bias_ ? SafeRawConstPointer<T>(bias_WRo_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBo, po, hidden_size_);
-    activation_f_.func(po, hidden_size_, activation_f_.alpha, activation_f_.beta);
+    if (!fused_gates_) {
+      deepcpu::clip_ignore_bias(clip_, nullptr, po, hidden_size_);
+      activation_f_.func(po, hidden_size_, activation_f_.alpha, activation_f_.beta);
+    }
     // DumpMatrix("o" + row_str, po, 1, hidden_size_);
 
     // calculate 'Ht'
@@ -1106,8 +1419,9 @@ void UniDirectionalLstm<T>::GateComputations(span_T_iter& out, span_T_iter& out_
 }
 
 template <typename T>
-void UniDirectionalLstm<T>::SetNumThreads() {
-  int threads = std::thread::hardware_concurrency() - 1;
+void UniDirectionalLstm<T>::SetNumThreads(int num_threads) {
+  // the calling thread processes rows as well, so it counts towards the threads used
+  int threads = num_threads;
 
   if (threads < 1)
     threads = 1;
@@ -1122,7 +1436,7 @@ void UniDirectionalLstm<T>::SetNumThreads() {
   // parallelize by partitioning the batch rows
   if (num_rows > 4 || (num_rows >= 2 && num_columns <= 256)) {
     batch_parallel_ = true;
-    VLOGS(logger_, 1) << "Hidden Threads : " << hidden_num_threads_;
+    VLOGS(*logger_, 1) << "Hidden Threads : " << hidden_num_threads_;
   }
 }
 
@@ -1,6 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#ifdef _MSC_VER
+#pragma warning(disable : 4244)
+#pragma warning(disable : 4267)
+#endif
+
 #include "core/providers/cpu/rnn/rnn_helpers.h"
 
 #include <cmath>
@@ -14,6 +19,7 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/rnn/rnn_activation_functors.h"
+#include "core/util/gemmlowp_common_wrapper.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -188,6 +194,84 @@ ActivationFuncs::ActivationFuncs(const std::vector<std::string>& funcs,
   }
 }
 
+void QuantizeWeights(const float* B, int K, int N, uint8_t* quantized, float* scales) {
+  // symmetric per column, so a single zero point works for the integer GEMM while each gate output keeps the
+  // resolution of its own range.
+  std::fill_n(scales, N, 0.f);
+  for (int k = 0; k < K; ++k) {
+    for (int n = 0; n < N; ++n) {
+      scales[n] = std::max(scales[n], std::abs(B[k * N + n]));
+    }
+  }
+
+  for (int n = 0; n < N; ++n) {
+    scales[n] = scales[n] > 0.f ? scales[n] / 127.f : 1.f;
+  }
+
+  for (int k = 0; k < K; ++k) {
+    for (int n = 0; n < N; ++n) {
+      float value = std::round(B[k * N + n] / scales[n]);
+      value = std::min(127.f, std::max(-127.f, value));
+      quantized[k * N + n] = static_cast<uint8_t>(static_cast<int>(value) + kQuantizedWeightsZeroPoint);
+    }
+  }
+}
+
+void ComputeQuantizedGemm(int M, int N, int K,
+                          const float* A, int lda,
+                          const QuantizedWeights& B,
+                          float beta,
+                          float* C, int ldc,
+                          gsl::span<uint8_t> A_quantized,
+                          gsl::span<int32_t> C_int32) {
+  ORT_ENFORCE(lda >= K && ldc >= N);
+  ORT_ENFORCE(static_cast<size_t>(B.data.size()) >= static_cast<size_t>(K) * N &&
+              static_cast<size_t>(B.scales.size()) >= static_cast<size_t>(N));
+  ORT_ENFORCE(static_cast<size_t>(A_quantized.size()) >= static_cast<size_t>(M) * K &&
+              static_cast<size_t>(C_int32.size()) >= static_cast<size_t>(M) * N);
+
+  // the range always includes 0 so zero padding and zero rows are exact
+  float min_value = 0.f;
+  float max_value = 0.f;
+  for (int m = 0; m < M; ++m) {
+    const float* row = A + m * lda;
+    for (int k = 0; k < K; ++k) {
+      min_value = std::min(min_value, row[k]);
+      max_value = std::max(max_value, row[k]);
+    }
+  }
+
+  const float scale = max_value > min_value ? (max_value - min_value) / 255.f : 1.f;
+  const int zero_point = std::min(255, std::max(0, static_cast<int>(std::round(-min_value / scale))));
+
+  uint8_t* quantized = A_quantized.data();
+  for (int m = 0; m < M; ++m) {
+    const float* row = A + m * lda;
+    for (int k = 0; k < K; ++k) {
+      const int value = static_cast<int>(std::round(row[k] / scale)) + zero_point;
+      *quantized++ = static_cast<uint8_t>(std::min(255, std::max(0, value)));
+    }
+  }
+
+  const auto order = gemmlowp::MapOrder::RowMajor;
+  gemmlowp::MatrixMap<const std::uint8_t, order> lhs(A_quantized.data(), M, K);
+  gemmlowp::MatrixMap<const std::uint8_t, order> rhs(B.data.data(), K, N);
+  gemmlowp::MatrixMap<std::int32_t, order> result(C_int32.data(), M, N);
+
+  gemmlowp::GemmContext gemm_context;
+  gemmlowp::GemmWithOutputPipeline<std::uint8_t, std::int32_t, gemmlowp::DefaultL8R8BitDepthParams>(
+      &gemm_context, lhs, rhs, &result, -zero_point, -kQuantizedWeightsZeroPoint, std::tuple<>());
+
+  for (int m = 0; m < M; ++m) {
+    const int32_t* int_row = C_int32.data() + m * N;
+    float* out = C + m * ldc;
+    for (int n = 0; n < N; ++n) {
+      const float value = scale * B.scales[n] * static_cast<float>(int_row[n]);
+      out[n] = beta == 0.f ? value : value + beta * out[n];
+    }
+  }
+}
+
 void DumpMatrixImpl(const std::string& name, const float* src, int row, int col, int offset, int col_width) {
   std::cout << "Dump matrix: " << name << std::endl;
 
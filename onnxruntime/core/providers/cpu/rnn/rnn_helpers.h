@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <functional>
 #include <future>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -19,15 +20,10 @@
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
+#include "core/framework/intra_op_parallel.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
-#ifdef USE_EIGEN_THREADPOOL
-#include <unsupported/Eigen/CXX11/ThreadPool>
-#else
-#include "core/common/task_thread_pool.h"
-#endif
-
 namespace onnxruntime {
 class Tensor;
 class OpKernelContext;
@@ -148,7 +144,8 @@ void ReverseSequence(gsl::span<const T> inputs,
   }
 }
 
-// A has size M x K, B has size N x K (transposed), and C has size M x N
+// A has size M x K, B has size N x K (transposed), and C has size M x N.
+// If B_transposed is false B has size K x N instead, which is how weights prepacked by the kernels are laid out.
 // We check that A, B and C are large enough before calling the lower level GEMM implementation
 template <typename TSpanAIter, typename TSpanBIter, typename TSpanCIter>
 void ComputeGemm(const int M,
@@ -164,22 +161,52 @@ void ComputeGemm(const int M,
                  const float beta,
                  TSpanCIter C,
                  TSpanCIter C_end,
-                 const int ldc) {
+                 const int ldc,
+                 const bool B_transposed = true) {
   // validate all the inputs
   // need to use the lda/ldb/ldc strides which should be >= the columns for the span
-  ORT_ENFORCE(lda >= K && ldb >= K && ldc >= N);
+  ORT_ENFORCE(lda >= K && ldc >= N);
   ORT_ENFORCE(A + (M * lda - (lda - K)) <= A_end);
-  ORT_ENFORCE(B + (N * ldb - (ldb - K)) <= B_end);
+  if (B_transposed) {
+    ORT_ENFORCE(ldb >= K);
+    ORT_ENFORCE(B + (N * ldb - (ldb - K)) <= B_end);
+  } else {
+    ORT_ENFORCE(ldb >= N);
+    ORT_ENFORCE(B + (K * ldb - (ldb - N)) <= B_end);
+  }
   ORT_ENFORCE(C + (M * ldc - (ldc - N)) <= C_end);
 
   ::onnxruntime::math::GemmEx<float, CPUMathUtil>(
-      CblasNoTrans, CblasTrans,
+      CblasNoTrans, B_transposed ? CblasTrans : CblasNoTrans,
       M, N, K, alpha,
       &*A, lda,
       &*B, ldb, beta,
       &*C, ldc, &CPUMathUtil::Instance());
 }
 
+// The K x N B matrix of a GEMM, quantized by QuantizeWeights for the dynamically quantized RNN operators.
+// Values are uint8 with a zero point of kQuantizedWeightsZeroPoint, and each column has its own scale.
+struct QuantizedWeights {
+  gsl::span<const uint8_t> data;
+  gsl::span<const float> scales;
+};
+
+constexpr int kQuantizedWeightsZeroPoint = 128;
+
+// Quantizes the K x N matrix B. quantized must have room for K x N values and scales for N.
+void QuantizeWeights(const float* B, int K, int N, uint8_t* quantized, float* scales);
+
+// C = A * B + beta * C, where A is M x K with leading dimension lda and C is M x N with leading dimension ldc.
+// A is quantized using its own range into A_quantized and multiplied with the integer GEMM, and the int32 result
+// in C_int32 is scaled back to float. A_quantized needs room for M x K values and C_int32 for M x N.
+void ComputeQuantizedGemm(int M, int N, int K,
+                          const float* A, int lda,
+                          const QuantizedWeights& B,
+                          float beta,
+                          float* C, int ldc,
+                          gsl::span<uint8_t> A_quantized,
+                          gsl::span<int32_t> C_int32);
+
 // helper to convert a span to a raw pointer
 // after validating the memory covered by the span supports the size required
 template <typename T>
@@ -216,61 +243,7 @@ T* SafeRawPointer(typename gsl::span<T> span, size_t offset, size_t size) {
   return span.data() + offset;
 }
 
-template <typename TLambda>
-void ExecuteLambdaInParallel(const std::string& name, TLambda lambda, int max, int step,
-#ifdef USE_EIGEN_THREADPOOL
-                             Eigen::NonBlockingThreadPool& ttp,
-#else
-                             TaskThreadPool& ttp,
-#endif
-                             const ::onnxruntime::logging::Logger& logger) {
-  // #define NOTHREADS to execute the lambdas directly and in order if you need to do that to debug
-
-#ifdef NOTHREADS
-  ORT_UNUSED_PARAMETER(ttp);
-  ORT_UNUSED_PARAMETER(logger);
-
-  for (int i = 0; i < max; i += step) {
-    (void)name;
-    std::bind(lambda, i)();
-  }
-#else
-
-#ifdef USE_EIGEN_THREADPOOL
-  ORT_UNUSED_PARAMETER(name);
-  ORT_UNUSED_PARAMETER(logger);
-
-  std::atomic<int> done(0);
-  for (int i = 0; i < max; i += step) {
-    ttp.Schedule([lambda, i, &done]() {
-      lambda(i);
-      ++done;
-    });
-  }
-
-  int totalTasks = (int)max / (step > 0 ? step : 1) + (max % step > 0 ? 1 : 0);
-  while (done != totalTasks) {
-  }
-#else
-  std::vector<std::future<void> > task_results{};
-  task_results.reserve(static_cast<size_t>(std::ceil(max / step)));
-
-  for (int i = 0; i < max; i += step) {
-    std::packaged_task<void()> task{std::bind(lambda, i)};
-    task_results.emplace_back(task.get_future());
-    ttp.RunTask(std::move(task));
-  }
-  try {
-    // wait for all and propagate any exceptions
-    for (auto& future : task_results)
-      future.get();
-  } catch (const std::exception& ex) {
-    LOGS(logger, ERROR) << name << " - exception running tasks: " << ex.what();
-    throw;
-  }
-#endif  // else part of #ifdef USE_EIGEN_THREADPOOLs
-#endif  // else part of #ifdef NOTHREADS
-}
+using ThreadPool = ::onnxruntime::IntraOpThreadPool;
 
 void DumpMatrixImpl(const std::string& name, const float* src, int row, int col,
                     int offset = 0, int col_width = -1);
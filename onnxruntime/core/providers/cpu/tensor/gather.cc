@@ -4,13 +4,15 @@
 //https://github.com/onnx/onnx/blob/master/docs/Operators.md#Gather
 #include "core/providers/cpu/tensor/gather.h"
 #include "core/common/common.h"
+#include "core/providers/cpu/tensor/packed_strings.h"
+#include <algorithm>
 
 namespace onnxruntime {
 
 ONNX_CPU_OPERATOR_KERNEL(
     Gather,
     1,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::AllTensorTypes()).TypeConstraint("Tind", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}),
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::AllTensorTypes()).TypeConstraint("Tind", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}).PackedStrings(0, 0),
     Gather);
 
 Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const {
@@ -30,6 +32,58 @@ Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const
   return Status::OK();
 }
 
+template <typename Tin>
+Status GatherElementIndices(const Tensor& indices_tensor, const TensorShape& input_data_shape, const int64_t axis,
+                            std::vector<int64_t>& element_indices) {
+  const Tin* indices_data = indices_tensor.template Data<Tin>();
+  const int64_t axis_dim = input_data_shape[axis];
+  const int64_t block = input_data_shape.SizeFromDimension(axis + 1);
+  const int64_t M = input_data_shape.SizeToDimension(axis);
+  const int64_t N = indices_tensor.Shape().Size();
+
+  for (int64_t i = 0; i < N; ++i) {
+    Tin idx = indices_data[i];
+    if (idx < 0 || idx >= axis_dim) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices element out of data bounds, idx=", idx,
+                             " data_dim=", axis_dim);
+    }
+  }
+
+  element_indices.resize(M * N * block);
+  int64_t* out = element_indices.data();
+  for (int64_t batch = 0; batch < M; ++batch) {
+    for (int64_t i = 0; i < N; ++i) {
+      const int64_t src = (batch * axis_dim + indices_data[i]) * block;
+      for (int64_t j = 0; j < block; ++j) {
+        *out++ = src + j;
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+Status GatherBase::PrepareElementIndices(const TensorShape& input_data_shape, const Tensor& indices_tensor,
+                                         std::vector<int64_t>& output_dims,
+                                         std::vector<int64_t>& element_indices) const {
+  const TensorShape& indices_shape = indices_tensor.Shape();
+  const int64_t axis = HandleNegativeAxis(axis_, input_data_shape.NumDimensions());
+
+  output_dims.assign(input_data_shape.GetDims().begin(), input_data_shape.GetDims().begin() + axis);
+  output_dims.insert(output_dims.end(), indices_shape.GetDims().begin(), indices_shape.GetDims().end());
+  output_dims.insert(output_dims.end(), input_data_shape.GetDims().begin() + axis + 1,
+                     input_data_shape.GetDims().end());
+
+  MLDataType Tind_type = indices_tensor.DataType();
+  if (Tind_type == DataTypeImpl::GetType<int32_t>()) {
+    return GatherElementIndices<int32_t>(indices_tensor, input_data_shape, axis, element_indices);
+  } else if (Tind_type == DataTypeImpl::GetType<int64_t>()) {
+    return GatherElementIndices<int64_t>(indices_tensor, input_data_shape, axis, element_indices);
+  }
+
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Type for Tind not supported yet in Gather.");
+}
+
 template <typename Tin>
 Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uint8_t* dst_base, bool is_string_type,
                       const size_t element_bytes, const int64_t block_size, const int64_t M,
@@ -60,8 +114,9 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
     const int64_t dst_offset = dst_offset_batch + i * block_size;
 
     if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
+      // a block holds block_size / element_bytes strings, all of them are copied
+      const std::string* src = reinterpret_cast<const std::string*>(src_base + src_offset);
+      std::copy(src, src + block_size / element_bytes, reinterpret_cast<std::string*>(dst_base + dst_offset));
     } else {
       memcpy(dst_base + dst_offset, src_base + src_offset, block_size);
     }
@@ -70,7 +125,20 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
   return Status::OK();
 }
 
+// Gather on the packed form of a string tensor selects elements without copying the strings.
+Status Gather::ComputePackedStrings(OpKernelContext* context) const {
+  std::vector<int64_t> output_dims, element_indices;
+  ORT_RETURN_IF_ERROR(PrepareElementIndices(StringInputShape(context), *context->Input<Tensor>(1),
+                                            output_dims, element_indices));
+  CopyStringElements(context, TensorShape(output_dims), element_indices.data());
+  return Status::OK();
+}
+
 Status Gather::Compute(OpKernelContext* context) const {
+  if (HasPackedStrings(context)) {
+    return ComputePackedStrings(context);
+  }
+
   Prepare p;
   ORT_RETURN_IF_ERROR(PrepareForCompute(context, p));
 
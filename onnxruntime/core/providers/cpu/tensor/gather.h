@@ -24,6 +24,11 @@ class GatherBase {
 
   Status PrepareForCompute(OpKernelContext* context, Prepare& p) const;
 
+  // For inputs that are not copied block by block, such as the packed form of a string tensor:
+  // the output shape and the flat index in the input of each output element.
+  Status PrepareElementIndices(const TensorShape& input_data_shape, const Tensor& indices_tensor,
+                               std::vector<int64_t>& output_dims, std::vector<int64_t>& element_indices) const;
+
  private:
   int64_t axis_;
 };
@@ -33,5 +38,8 @@ class Gather final : public OpKernel, public GatherBase {
   Gather(const OpKernelInfo& info) : OpKernel(info), GatherBase(info) {}
 
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  Status ComputePackedStrings(OpKernelContext* context) const;
 };
 }  // namespace onnxruntime
@@ -14,7 +14,7 @@ ONNX_CPU_OPERATOR_KERNEL(
 ONNX_CPU_OPERATOR_KERNEL(
     Identity,
     1,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::AllTensorTypes()).Alias(0, 0),
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::AllTensorTypes()).Alias(0, 0).PackedStrings(0, 0),
     IdentityOp<false>);
 
 }  // namespace onnxruntime
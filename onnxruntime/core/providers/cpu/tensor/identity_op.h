@@ -12,6 +12,7 @@
 #pragma warning(pop)
 #endif
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/tensor/packed_strings.h"
 
 namespace onnxruntime {
 
@@ -22,6 +23,10 @@ class IdentityOp final : public OpKernel {
   }
 
   Status Compute(OpKernelContext* context) const override {
+    if (!is_dropout && HasPackedStrings(context)) {
+      return ComputePackedStrings(context);
+    }
+
     const Tensor* X = context->Input<Tensor>(0);
     ORT_ENFORCE(X != nullptr);
     const TensorShape& shape = X->Shape();
@@ -48,6 +53,24 @@ class IdentityOp final : public OpKernel {
 
     return Status::OK();
   }
+
+ private:
+  // A packed output shares the buffer of a packed input, the strings are only copied from or to a Tensor.
+  static Status ComputePackedStrings(OpKernelContext* context) {
+    PackedStringTensor* packed_output = context->OutputPackedStrings(0);
+    if (context->InputType(0) == DataTypeImpl::GetType<PackedStringTensor>()) {
+      const PackedStringTensor& X = *context->Input<PackedStringTensor>(0);
+      if (packed_output != nullptr) {
+        *packed_output = X;
+      } else {
+        X.CopyTo(context->Output(0, X.Shape())->template MutableData<std::string>());
+      }
+    } else {
+      const Tensor& X = *context->Input<Tensor>(0);
+      packed_output->Assign(X.Shape(), X.template Data<std::string>());
+    }
+    return Status::OK();
+  }
 };
 
 }  //namespace onnxruntime
@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tensor/packed_strings.h"
+
+namespace onnxruntime {
+
+static bool IsPackedInput(const OpKernelContext* context) {
+  return context->InputType(0) == DataTypeImpl::GetType<PackedStringTensor>();
+}
+
+bool HasPackedStrings(OpKernelContext* context) {
+  return IsPackedInput(context) || context->OutputPackedStrings(0) != nullptr;
+}
+
+const TensorShape& StringInputShape(const OpKernelContext* context) {
+  return IsPackedInput(context) ? context->Input<PackedStringTensor>(0)->Shape()
+                                : context->Input<Tensor>(0)->Shape();
+}
+
+void CopyStringElements(OpKernelContext* context, const TensorShape& output_shape, const int64_t* indices) {
+  PackedStringTensor* packed_output = context->OutputPackedStrings(0);
+  if (IsPackedInput(context)) {
+    const auto& input = *context->Input<PackedStringTensor>(0);
+    if (packed_output != nullptr) {
+      packed_output->Select(input, output_shape, indices);
+      return;
+    }
+    std::string* output = context->Output(0, output_shape)->MutableData<std::string>();
+    for (int64_t i = 0, end = output_shape.Size(); i < end; ++i) {
+      output[i].assign(input.ElementData(indices[i]), input.ElementLength(indices[i]));
+    }
+  } else {
+    ORT_ENFORCE(packed_output != nullptr, "Neither input 0 nor output 0 is a PackedStringTensor.");
+    packed_output->Assign(output_shape, context->Input<Tensor>(0)->Data<std::string>(), indices);
+  }
+}
+
+}  // namespace onnxruntime
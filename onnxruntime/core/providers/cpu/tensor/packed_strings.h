@@ -0,0 +1,23 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+
+// Helpers for the kernels declared with KernelDefBuilder::PackedStrings(0, 0) that select elements of input 0.
+// Input 0 and output 0 of such a kernel may be PackedStringTensor values instead of string tensors.
+
+// Returns true if input 0 or output 0 is a PackedStringTensor.
+bool HasPackedStrings(OpKernelContext* context);
+
+// Returns the shape of input 0 in either form.
+const TensorShape& StringInputShape(const OpKernelContext* context);
+
+// Writes the elements of input 0 at the flat indices, one per element of output_shape, to output 0.
+// A packed output shares the buffer of a packed input, the strings are only copied from or to a Tensor.
+void CopyStringElements(OpKernelContext* context, const TensorShape& output_shape, const int64_t* indices);
+
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/slice.h"
+#include "core/providers/cpu/tensor/packed_strings.h"
 #include "core/providers/cpu/tensor/utils.h"
 using namespace ::onnxruntime::common;
 using namespace std;
@@ -28,7 +29,14 @@ ADD_TYPED_SLICE_OP(float,    int64_t);
 ADD_TYPED_SLICE_OP(double,   int64_t);
 ADD_TYPED_SLICE_OP(MLFloat16,int64_t);
 ADD_TYPED_SLICE_OP(bool,     int64_t);
-ADD_TYPED_SLICE_OP(string,   int64_t);
+
+// string slices may also be in the packed form, see KernelDefBuilder::PackedStrings
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Slice,
+    1,
+    string,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<string>()).PackedStrings(0, 0),
+    Slice<string, int64_t, false>);
 
 #define ADD_TYPED_DYNAMIC_SLICE_OP(data_type, indice_type)                                   \
   ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                            \
@@ -39,6 +47,16 @@ ADD_TYPED_SLICE_OP(string,   int64_t);
                         .TypeConstraint("Tind", DataTypeImpl::GetTensorType<indice_type>()), \
       Slice<data_type, indice_type, true>);
 
+#define ADD_STRING_DYNAMIC_SLICE_OP(indice_type)                                              \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                            \
+      DynamicSlice,                                                                          \
+      1,                                                                                     \
+      string_##indice_type,                                                                  \
+      KernelDefBuilder().TypeConstraint("T",    DataTypeImpl::GetTensorType<string>())       \
+                        .TypeConstraint("Tind", DataTypeImpl::GetTensorType<indice_type>())  \
+                        .PackedStrings(0, 0),                                                \
+      Slice<string, indice_type, true>);
+
 ADD_TYPED_DYNAMIC_SLICE_OP(uint8_t,  int32_t);
 ADD_TYPED_DYNAMIC_SLICE_OP(uint16_t, int32_t);
 ADD_TYPED_DYNAMIC_SLICE_OP(uint32_t, int32_t);
@@ -51,7 +69,7 @@ ADD_TYPED_DYNAMIC_SLICE_OP(float,    int32_t);
 ADD_TYPED_DYNAMIC_SLICE_OP(double,   int32_t);
 ADD_TYPED_DYNAMIC_SLICE_OP(MLFloat16,int32_t);
 ADD_TYPED_DYNAMIC_SLICE_OP(bool,     int32_t);
-ADD_TYPED_DYNAMIC_SLICE_OP(string,   int32_t);
+ADD_STRING_DYNAMIC_SLICE_OP(int32_t);
 
 ADD_TYPED_DYNAMIC_SLICE_OP(uint8_t,  int64_t);
 ADD_TYPED_DYNAMIC_SLICE_OP(uint16_t, int64_t);
@@ -65,7 +83,7 @@ ADD_TYPED_DYNAMIC_SLICE_OP(float,    int64_t);
 ADD_TYPED_DYNAMIC_SLICE_OP(double,   int64_t);
 ADD_TYPED_DYNAMIC_SLICE_OP(MLFloat16,int64_t);
 ADD_TYPED_DYNAMIC_SLICE_OP(bool,     int64_t);
-ADD_TYPED_DYNAMIC_SLICE_OP(string,   int64_t);
+ADD_STRING_DYNAMIC_SLICE_OP(int64_t);
 
 namespace {
 // std::clamp doesn't exist until C++17 so create a local version
@@ -75,6 +93,34 @@ const T& clamp(const T& v, const T& lo, const T& hi) {
   if (v > hi) return hi;
   return v;
 }
+
+// The flat index in the input of each element of the slice, in order.
+std::vector<int64_t> SliceElementIndices(const TensorShape& input_shape, const std::vector<int64_t>& starts,
+                                         const std::vector<int64_t>& extents) {
+  if (extents.empty()) return {0};  // a scalar
+  TensorPitches pitches(input_shape);
+  std::vector<int64_t> counters(extents.size(), 0);
+  std::vector<int64_t> element_indices;
+  const int64_t size = TensorShape(extents).Size();
+  element_indices.reserve(size);
+  for (bool done = size == 0; !done;) {
+    int64_t index = 0;
+    for (size_t i = 0; i < extents.size(); ++i) {
+      index += (starts[i] + counters[i]) * pitches[i];
+    }
+    element_indices.push_back(index);
+
+    done = true;
+    for (size_t i = extents.size(); i-- > 0;) {
+      if (++counters[i] < extents[i]) {
+        done = false;
+        break;
+      }
+      counters[i] = 0;
+    }
+  }
+  return element_indices;
+}
 }  // namespace
 
 Status SliceBase::PrepareForCompute(const std::vector<int64_t>& raw_starts,
@@ -140,10 +186,9 @@ void SliceBase::FillVectorsFromInput(const OpKernelContext* context,
 
 template <typename T, typename Tind, bool dynamic>
 Status Slice<T, Tind, dynamic>::Compute(OpKernelContext* ctx) const {
-  const Tensor* input_tensor_ptr = ctx->Input<Tensor>(0);
-  ORT_ENFORCE(input_tensor_ptr != nullptr);
-  auto& input_tensor = *input_tensor_ptr;
-  auto& input_dimensions = input_tensor.Shape().GetDims();
+  const bool packed_strings = std::is_same<T, string>::value && HasPackedStrings(ctx);
+  const TensorShape& input_shape = packed_strings ? StringInputShape(ctx) : ctx->Input<Tensor>(0)->Shape();
+  auto& input_dimensions = input_shape.GetDims();
 
   // Initialize the starts & ends to the actual tensor shape
   const size_t dimension_count = input_dimensions.size();
@@ -161,6 +206,13 @@ Status Slice<T, Tind, dynamic>::Compute(OpKernelContext* ctx) const {
   }
 
   TensorShape output_shape(output_dims);
+  if (packed_strings) {
+    // the packed form of a string tensor is sliced without copying the strings
+    CopyStringElements(ctx, output_shape, SliceElementIndices(input_shape, starts, output_dims).data());
+    return Status::OK();
+  }
+
+  auto& input_tensor = *ctx->Input<Tensor>(0);
   auto& output_tensor = *ctx->Output(0, output_shape);
   auto* output = output_tensor.template MutableData<T>();
   const auto* output_end = output + output_shape.Size();
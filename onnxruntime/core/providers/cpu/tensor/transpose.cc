@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/tensor/transpose.h"
 #include "core/framework/utils.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -39,7 +40,7 @@ template <typename T>
 static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
                             size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
                             const T* source, T* target) {
-  size_t blocksize = num_elts_in_block * sizeof(float);
+  size_t blocksize = num_elts_in_block * sizeof(T);
   // index used to iterate over target iteration-space
   std::vector<int64_t> target_index(num_axes, 0);
   for (size_t i = 0; i < num_blocks; ++i) {
@@ -85,12 +86,117 @@ static void DoTransposeSingleBlock(size_t num_elts_in_block, const T* source, T*
   memcpy(target, source, blocksize);
 }
 
+// IsBatchedMatrixTranspose: checks whether the permutation, once axes of size 1 are dropped and runs of axes
+// that remain adjacent in the output are merged, reduces to [1,0] or [0,2,1]. If so, the input can be viewed as
+// num_batches matrices of rows x cols that are each transposed. This covers 2D transposes as well as the
+// NCHW <-> NHWC conversions.
+static bool IsBatchedMatrixTranspose(const std::vector<int64_t>& permutations, const std::vector<int64_t>& input_dims,
+                                     size_t& num_batches, size_t& rows, size_t& cols) {
+  const size_t rank = input_dims.size();
+
+  // renumber the axes that are not of size 1
+  std::vector<int64_t> compact_axis(rank, -1);
+  std::vector<int64_t> compact_dims;
+  for (size_t i = 0; i < rank; ++i) {
+    if (input_dims[i] != 1) {
+      compact_axis[i] = static_cast<int64_t>(compact_dims.size());
+      compact_dims.push_back(input_dims[i]);
+    }
+  }
+
+  // group the output axes into runs of consecutive input axes
+  std::vector<int64_t> group_first_axis;
+  std::vector<size_t> group_size;
+  int64_t prev_axis = -2;
+  for (auto axis : permutations) {
+    int64_t c = compact_axis[axis];
+    if (c < 0)
+      continue;
+    if (c == prev_axis + 1) {
+      group_size.back() *= static_cast<size_t>(compact_dims[c]);
+    } else {
+      group_first_axis.push_back(c);
+      group_size.push_back(static_cast<size_t>(compact_dims[c]));
+    }
+    prev_axis = c;
+  }
+
+  if (group_first_axis.size() == 2 && group_first_axis[0] > group_first_axis[1]) {
+    num_batches = 1;
+    rows = group_size[1];
+    cols = group_size[0];
+    return true;
+  }
+
+  if (group_first_axis.size() == 3 && group_first_axis[0] < group_first_axis[2] &&
+      group_first_axis[2] < group_first_axis[1]) {
+    num_batches = group_size[0];
+    rows = group_size[2];
+    cols = group_size[1];
+    return true;
+  }
+
+  return false;
+}
+
+template <typename TElement>
+static void DoTransposeBatchedMatrixImpl(size_t num_batches, size_t rows, size_t cols,
+                                         const TElement* source, TElement* target) {
+  const size_t matrix_size = rows * cols;
+
+  if (num_batches == 1) {
+    MlasTranspose(source, target, rows, cols);
+    return;
+  }
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int64_t b = 0; b < static_cast<int64_t>(num_batches); ++b) {
+    MlasTranspose(source + b * matrix_size, target + b * matrix_size, rows, cols);
+  }
+}
+
+// DoTransposeBatchedMatrix: transposes num_batches matrices of rows x cols elements using the
+// cache blocked MLAS kernel. The elements are only moved, so they are handled by size.
+template <typename T>
+static bool DoTransposeBatchedMatrix(size_t num_batches, size_t rows, size_t cols, const T* source, T* target) {
+  static_assert(std::is_trivially_copyable<T>::value, "Transpose element type must be trivially copyable.");
+
+  switch (sizeof(T)) {
+    case sizeof(uint8_t):
+      DoTransposeBatchedMatrixImpl(num_batches, rows, cols, reinterpret_cast<const uint8_t*>(source),
+                                   reinterpret_cast<uint8_t*>(target));
+      return true;
+    case sizeof(uint16_t):
+      DoTransposeBatchedMatrixImpl(num_batches, rows, cols, reinterpret_cast<const uint16_t*>(source),
+                                   reinterpret_cast<uint16_t*>(target));
+      return true;
+    case sizeof(uint32_t):
+      DoTransposeBatchedMatrixImpl(num_batches, rows, cols, reinterpret_cast<const uint32_t*>(source),
+                                   reinterpret_cast<uint32_t*>(target));
+      return true;
+    case sizeof(uint64_t):
+      DoTransposeBatchedMatrixImpl(num_batches, rows, cols, reinterpret_cast<const uint64_t*>(source),
+                                   reinterpret_cast<uint64_t*>(target));
+      return true;
+    default:
+      return false;
+  }
+}
+
 template <typename T>
 static Status DoTypedTranspose(const std::vector<int64_t>& permutations, const Tensor& input, Tensor& output) {
   const auto& input_shape = input.Shape();
   const auto& input_dims = input_shape.GetDims();
   auto rank = input_shape.NumDimensions();
 
+  size_t num_batches, rows, cols;
+  if (IsBatchedMatrixTranspose(permutations, input_dims, num_batches, rows, cols) &&
+      DoTransposeBatchedMatrix<T>(num_batches, rows, cols, input.Data<T>(), output.MutableData<T>())) {
+    return Status::OK();
+  }
+
   std::vector<size_t> stride(rank);
   for (int i = 0; i < rank; i++) {
     size_t inpdim = permutations[i];
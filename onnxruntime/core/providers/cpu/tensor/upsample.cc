@@ -3,6 +3,10 @@
 
 #include "core/providers/cpu/tensor/upsample.h"
 #include <math.h>  //for fabs
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
 
 using namespace ::onnxruntime::common;
 using namespace std;
@@ -29,29 +33,48 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<uint8_t>()),
     Upsample<uint8_t>);
 
+// Upsample the H and W dimensions of a NCHW tensor by whole numbers.
+// Each input row is expanded once and the result copied to the other output rows it maps to.
 template <typename T>
-void UpsampleNearest2x(
+void UpsampleNearestInteger(
     int64_t batch_size,
     int64_t num_channels,
     int64_t input_height,
     int64_t input_width,
+    int64_t height_scale,
+    int64_t width_scale,
     const T* input,
     T* output) {
-  const int64_t output_height = input_height * 2;
-  const int64_t output_width = input_width * 2;
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        const int64_t in_y = y / 2;
+  const int64_t output_height = input_height * height_scale;
+  const int64_t output_width = input_width * width_scale;
+  const int64_t total_channels = batch_size * num_channels;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int64_t c = 0; c < total_channels; ++c) {
+    const T* input_plane = input + c * input_height * input_width;
+    T* output_plane = output + c * output_height * output_width;
+
+    for (int64_t in_y = 0; in_y < input_height; ++in_y) {
+      const T* input_row = input_plane + in_y * input_width;
+      T* output_row = output_plane + in_y * height_scale * output_width;
+
+      if (width_scale == 2) {
+        for (int64_t x = 0; x < input_width; ++x) {
+          const T v = input_row[x];
+          output_row[x * 2 + 0] = v;
+          output_row[x * 2 + 1] = v;
+        }
+      } else {
         for (int64_t x = 0; x < input_width; ++x) {
-          const T v = input[in_y * input_width + x];
-          const int64_t oidx = output_width * y + x * 2;
-          output[oidx + 0] = v;
-          output[oidx + 1] = v;
+          std::fill_n(output_row + x * width_scale, width_scale, input_row[x]);
         }
       }
-      input += input_height * input_width;
-      output += output_height * output_width;
+
+      for (int64_t i = 1; i < height_scale; ++i) {
+        memcpy(output_row + i * output_width, output_row, output_width * sizeof(T));
+      }
     }
   }
 }
@@ -67,24 +90,53 @@ Status UpsampleNearest(const T* input,
   if (input_shape.NumDimensions() != output_shape.NumDimensions())
     return Status(ONNXRUNTIME, FAIL, "Upsample: input/output value's dimension mismatch");
   auto n_dim = input_shape.NumDimensions();
-  if (scales.size() == 4 && scales[0] == 1 && scales[1] == 1 && scales[2] == 2 && scales[3] == 2) {
-    UpsampleNearest2x<T>(input_shape[0], input_shape[1], input_shape[2], input_shape[3], input, output);
-  } else {
-    for (size_t i = 0, size = output_shape.Size(); i < size; i++) {
-      size_t old_idx = 0;
-      size_t cur_idx = i;
+  if (n_dim == 0 || output_shape.Size() == 0)
+    return Status::OK();
 
-      int64_t base = 1;
-      for (int64_t j = static_cast<int64_t>(n_dim - 1); j >= 0; j--) {
-        auto tmp = cur_idx % output_shape[j];
-        old_idx += (std::min(static_cast<int64_t>(tmp / scales[j]), input_shape[j] - 1)) * base;
-        base *= input_shape[j];
-        cur_idx /= output_shape[j];
-      }
+  // the 2x and 4x scales of FPN and U-Net style decoders, or any other whole number scale of H and W
+  if (scales.size() == 4 && scales[0] == 1 && scales[1] == 1 &&
+      scales[2] == std::floor(scales[2]) && scales[3] == std::floor(scales[3])) {
+    UpsampleNearestInteger<T>(input_shape[0], input_shape[1], input_shape[2], input_shape[3],
+                              static_cast<int64_t>(scales[2]), static_cast<int64_t>(scales[3]), input, output);
+    return Status::OK();
+  }
+
+  // the source index along an axis only depends on the output index along that axis, so a table of the input
+  // offset for every output index is built per axis. the offsets of an output row are then the sum of the entries
+  // of its outer indices, and the elements in the row are a lookup in the table of the innermost axis.
+  std::vector<std::vector<int64_t>> input_offsets(n_dim);
+  int64_t input_stride = 1;
+  for (int64_t j = static_cast<int64_t>(n_dim - 1); j >= 0; j--) {
+    auto& offsets = input_offsets[j];
+    offsets.resize(output_shape[j]);
+    for (int64_t i = 0; i < output_shape[j]; ++i) {
+      offsets[i] = std::min(static_cast<int64_t>(i / scales[j]), input_shape[j] - 1) * input_stride;
+    }
+    input_stride *= input_shape[j];
+  }
+
+  const int64_t output_width = output_shape[n_dim - 1];
+  const int64_t output_rows = output_shape.Size() / output_width;
+  const int64_t* row_offsets = input_offsets[n_dim - 1].data();
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int64_t row = 0; row < output_rows; ++row) {
+    int64_t input_offset = 0;
+    int64_t cur_idx = row;
+    for (int64_t j = static_cast<int64_t>(n_dim - 2); j >= 0; j--) {
+      input_offset += input_offsets[j][cur_idx % output_shape[j]];
+      cur_idx /= output_shape[j];
+    }
 
-      output[i] = input[old_idx];
+    const T* input_row = input + input_offset;
+    T* output_row = output + row * output_width;
+    for (int64_t x = 0; x < output_width; ++x) {
+      output_row[x] = input_row[row_offsets[x]];
     }
   }
+
   return Status::OK();
 }
 
@@ -156,48 +208,99 @@ void upsampleBilinear(
     T* Ydata) {
   int64_t output_width = static_cast<int64_t>(input_width * width_scale);
   int64_t output_height = static_cast<int64_t>(input_height * height_scale);
+  if (output_width == 0 || output_height == 0)
+    return;
+
+  // the two source indices and their weights only depend on the output row or column,
+  // so they are computed once per axis and shared by all the channels
+  std::vector<int64_t> in_y1(output_height), in_y2(output_height);
+  std::vector<float> dy1(output_height), dy2(output_height);
+  for (int64_t y = 0; y < output_height; ++y) {
+    float in_y = std::min(y / height_scale, static_cast<float>(input_height - 1));
+    in_y1[y] = std::min(static_cast<int64_t>(in_y), input_height - 1);
+    in_y2[y] = std::min(in_y1[y] + 1, input_height - 1);
+    dy1[y] = fabs(in_y - in_y1[y]);
+    dy2[y] = fabs(in_y - in_y2[y]);
+    if (in_y1[y] == in_y2[y]) {
+      dy1[y] = 0.5f;
+      dy2[y] = 0.5f;
+    }
+  }
+
+  std::vector<int64_t> in_x1(output_width), in_x2(output_width);
+  std::vector<float> dx1(output_width), dx2(output_width);
+  for (int64_t x = 0; x < output_width; ++x) {
+    float in_x = std::min(x / width_scale, static_cast<float>(input_width - 1));
+    in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
+    in_x2[x] = std::min(in_x1[x] + 1, input_width - 1);
+    dx1[x] = std::abs(in_x - in_x1[x]);
+    dx2[x] = std::abs(in_x - in_x2[x]);
+    if (in_x1[x] == in_x2[x]) {
+      dx1[x] = 0.5f;
+      dx2[x] = 0.5f;
+    }
+  }
+
+  const int64_t total_channels = batch_size * num_channels;
 
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int64_t c = 0; c < total_channels; ++c) {
+    const T* input_plane = Xdata + c * input_height * input_width;
+    T* output_plane = Ydata + c * output_height * output_width;
+
+    if (!std::is_floating_point<T>::value) {
+      // the result is truncated, so keep the exact per pixel sum that integer outputs have always been rounded from
       for (int64_t y = 0; y < output_height; ++y) {
-        float in_y = std::min(y / height_scale, static_cast<float>(input_height - 1));
-        const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
-        const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-        float dy1 = fabs(in_y - in_y1);
-        float dy2 = fabs(in_y - in_y2);
-        if (in_y1 == in_y2) {
-          dy1 = 0.5f;
-          dy2 = 0.5f;
+        const T* input_row1 = input_plane + input_width * in_y1[y];
+        const T* input_row2 = input_plane + input_width * in_y2[y];
+        T* output_row = output_plane + y * output_width;
+
+        for (int64_t x = 0; x < output_width; ++x) {
+          T X11 = input_row1[in_x1[x]];
+          T X21 = input_row1[in_x2[x]];
+          T X12 = input_row2[in_x1[x]];
+          T X22 = input_row2[in_x2[x]];
+
+          output_row[x] = static_cast<T>(dx2[x] * dy2[y] * X11 +
+                                         dx1[x] * dy2[y] * X21 +
+                                         dx2[x] * dy1[y] * X12 +
+                                         dx1[x] * dy1[y] * X22);
         }
+      }
+      continue;
+    }
 
-        const int64_t input_width_mul_y1 = input_width * in_y1;
-        const int64_t input_width_mul_y2 = input_width * in_y2;
+    // the interpolation is separable. each input row is interpolated horizontally once into one of two row
+    // buffers, and each output row is the vertical blend of two of those rows.
+    // in_y1 never decreases and in_y2 is in_y1 or in_y1 + 1, so a slot per odd/even input row is enough.
+    std::vector<float> rows(2 * output_width);
+    int64_t row_in_slot[2] = {-1, -1};
 
+    auto horizontal_row = [&](int64_t in_y) -> const float* {
+      const int64_t slot = in_y & 1;
+      float* row = rows.data() + slot * output_width;
+      if (row_in_slot[slot] != in_y) {
+        const T* input_row = input_plane + in_y * input_width;
         for (int64_t x = 0; x < output_width; ++x) {
-          float in_x = std::min(x / width_scale, static_cast<float>(input_width - 1));
-          const int64_t in_x1 = std::min(static_cast<int64_t>(in_x), input_width - 1);
-          const int64_t in_x2 = std::min(in_x1 + 1, input_width - 1);
-
-          float dx1 = std::abs(in_x - in_x1);
-          float dx2 = std::abs(in_x - in_x2);
-          if (in_x1 == in_x2) {
-            dx1 = 0.5f;
-            dx2 = 0.5f;
-          }
-
-          T X11 = Xdata[input_width_mul_y1 + in_x1];
-          T X21 = Xdata[input_width_mul_y1 + in_x2];
-          T X12 = Xdata[input_width_mul_y2 + in_x1];
-          T X22 = Xdata[input_width_mul_y2 + in_x2];
-
-          Ydata[output_width * y + x] = static_cast<T>(dx2 * dy2 * X11 +
-                                                       dx1 * dy2 * X21 +
-                                                       dx2 * dy1 * X12 +
-                                                       dx1 * dy1 * X22);
+          row[x] = dx2[x] * input_row[in_x1[x]] + dx1[x] * input_row[in_x2[x]];
         }
+        row_in_slot[slot] = in_y;
+      }
+      return row;
+    };
+
+    for (int64_t y = 0; y < output_height; ++y) {
+      const float* row1 = horizontal_row(in_y1[y]);
+      const float* row2 = horizontal_row(in_y2[y]);
+      const float w1 = dy2[y];
+      const float w2 = dy1[y];
+      T* output_row = output_plane + y * output_width;
+
+      for (int64_t x = 0; x < output_width; ++x) {
+        output_row[x] = static_cast<T>(w1 * row1[x] + w2 * row2[x]);
       }
-      Xdata += input_height * input_width;
-      Ydata += output_width * output_height;
     }
   }
 }
@@ -82,6 +82,13 @@ ORT_API(int, OrtSetSessionThreadPoolSize, _In_ OrtSessionOptions* options, int s
   return 0;
 }
 
+///How many threads a kernel that splits its own work may use.
+ORT_API(int, OrtSetIntraOpThreadPoolSize, _In_ OrtSessionOptions* options, int intra_op_thread_pool_size) {
+  if (intra_op_thread_pool_size <= 0) return -1;
+  options->value.intra_op_thread_pool_size = intra_op_thread_pool_size;
+  return 0;
+}
+
 ORT_API(void, OrtAppendCustomOpLibPath, _In_ OrtSessionOptions* options, const char* lib_path) {
   options->custom_op_paths.emplace_back(lib_path);
 }
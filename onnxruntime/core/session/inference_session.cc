@@ -115,6 +115,18 @@ class InferenceSession::Impl {
     }
 
     session_state_.SetThreadPool(thread_pool_.get());
+
+    // the thread calling Run takes part in the intra-op work, so the pool needs one thread less than the budget.
+    if (session_options_.intra_op_thread_pool_size > 1) {
+#ifdef USE_EIGEN_THREADPOOL
+      intra_op_thread_pool_ = std::make_unique<Eigen::NonBlockingThreadPool>(
+          session_options_.intra_op_thread_pool_size - 1);
+#else
+      intra_op_thread_pool_ = std::make_unique<TaskThreadPool>(session_options_.intra_op_thread_pool_size - 1);
+#endif
+    }
+
+    session_state_.SetIntraOpThreadPool(intra_op_thread_pool_.get(), session_options_.intra_op_thread_pool_size);
     session_profiler_.Initialize(session_logger_);
     session_state_.SetProfiler(session_profiler_);
     if (session_options.enable_profiling) {
@@ -314,6 +326,8 @@ class InferenceSession::Impl {
         auto subgraph_session_state = std::make_unique<SessionState>(execution_providers_);
         subgraph_session_state->SetProfiler(session_profiler_);
         subgraph_session_state->SetLogger(*session_logger_);
+        subgraph_session_state->SetIntraOpThreadPool(intra_op_thread_pool_.get(),
+                                                     session_options_.intra_op_thread_pool_size);
 
         // recurse
         ORT_RETURN_IF_ERROR(CreateSubgraphSessionState(*subgraph, *subgraph_session_state));
@@ -420,6 +434,8 @@ class InferenceSession::Impl {
 
       session_state_.CalculateNodeIndexInfo();
 
+      SavePackedStringOutputs(graph);
+
       is_inited_ = true;
 
       LOGS(*session_logger_, INFO) << "Session successfully initialized.";
@@ -454,6 +470,14 @@ class InferenceSession::Impl {
                   "Unexpected input data type. Actual: (" + actual_name + ") , expected: (" + expected_name + ")");
   }
 
+  // The element type of a tensor feed. A PackedStringTensor is accepted wherever a string tensor is.
+  static MLDataType FeedElementType(const MLValue& feed) {
+    if (feed.IsTensor()) {
+      return feed.Get<Tensor>().DataType();
+    }
+    return feed.Type() == DataTypeImpl::GetType<PackedStringTensor>() ? DataTypeImpl::GetType<std::string>() : nullptr;
+  }
+
   common::Status ValidateInputs(const std::vector<std::string>& feed_names,
                                 const std::vector<MLValue>& feeds) {
     const auto begin_names = feed_names.cbegin();
@@ -476,9 +500,9 @@ class InferenceSession::Impl {
       auto& input_ml_value = feeds.at(idx);
       auto expected_type = utils::GetMLDataType(*arg);
 
-      if (input_ml_value.IsTensor()) {
+      auto input_element_type = FeedElementType(input_ml_value);
+      if (input_element_type != nullptr && expected_type->AsTensorType() != nullptr) {
         auto expected_element_type = expected_type->AsTensorType()->GetElementType();
-        auto input_element_type = input_ml_value.Get<Tensor>().DataType();
         ORT_RETURN_IF_ERROR(CheckTypes(input_element_type, expected_element_type));
       } else {
         auto input_type = input_ml_value.Type();
@@ -507,8 +531,8 @@ class InferenceSession::Impl {
         }
 
         auto& input_ml_value = feeds.at(i);
-        ORT_ENFORCE(input_ml_value.IsTensor());
-        auto input_element_type = input_ml_value.Get<Tensor>().DataType();
+        auto input_element_type = FeedElementType(input_ml_value);
+        ORT_ENFORCE(input_element_type != nullptr);
 
         auto expected_type = utils::GetMLDataType(*iter->second);
         auto expected_element_type = expected_type->AsTensorType()->GetElementType();
@@ -575,6 +599,9 @@ class InferenceSession::Impl {
     Status retval = Status::OK();
 
     try {
+      std::vector<MLValue> unpacked_feeds;
+      const auto& run_feeds = UnpackStringFeeds(feed_names, feeds, unpacked_feeds);
+
       // use cached info if available, otherwise create a FeedsFetchesManager and update it in the call to ExecuteGraph
       std::unique_ptr<FeedsFetchesManager> local_ffm;
       FeedsFetchesManager* feeds_fetches_manager = nullptr;
@@ -583,7 +610,7 @@ class InferenceSession::Impl {
       // lambda to construct so that we can call it under the lock if we're caching this, or outside of the lock
       // if we're not.
       auto create_feeds_fetches_manager = [&]() {
-        ORT_RETURN_IF_ERROR(ValidateInputs(feed_names, feeds));
+        ORT_RETURN_IF_ERROR(ValidateInputs(feed_names, run_feeds));
 
         // if the output vector is non-empty, ensure that its the same size as the output_names
         ORT_RETURN_IF_ERROR(ValidateOutputs(output_names, p_fetches));
@@ -642,6 +669,14 @@ class InferenceSession::Impl {
         LOGS(*session_logger_, INFO) << "Running with tag: " << run_options.run_tag;
       }
 
+      if (run_options.columnar_map_sequences && !columnar_output_types_.empty()) {
+        PreallocateColumnarFetches(output_names, *p_fetches);
+      }
+
+      if (run_options.packed_string_tensors && !packed_string_output_names_.empty()) {
+        PreallocatePackedStringFetches(output_names, *p_fetches);
+      }
+
       ++current_num_runs_;
 
       // TODO should we add this exec to the list of executors? i guess its not needed now?
@@ -660,13 +695,13 @@ class InferenceSession::Impl {
       if (cached_feeds_fetches_manager) {
         // used the const cached_feeds_fetches_manager to execute the graph
         ORT_CHECK_AND_SET_RETVAL(
-            utils::ExecuteGraphWithCachedInfo(session_state_, *cached_feeds_fetches_manager, feeds, *p_fetches, {},
+            utils::ExecuteGraphWithCachedInfo(session_state_, *cached_feeds_fetches_manager, run_feeds, *p_fetches, {},
                                               session_options_.enable_sequential_execution, run_options.terminate,
                                               run_logger));
       } else {
         // execute the graph and update feeds_fetches_manager
         ORT_CHECK_AND_SET_RETVAL(
-            utils::ExecuteGraph(session_state_, *feeds_fetches_manager, feeds, *p_fetches, {},
+            utils::ExecuteGraph(session_state_, *feeds_fetches_manager, run_feeds, *p_fetches, {},
                                 session_options_.enable_sequential_execution, run_options.terminate, run_logger,
                                 run_options.cache_feeds_fetches_info));
       }
@@ -823,10 +858,99 @@ class InferenceSession::Impl {
       model_output_names_.insert(elem->Name());
     }
 
+    // graph outputs that ZipMap can write in columnar form. only outputs nothing else in the graph reads
+    // qualify, as the consumers expect the std::vector form.
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() != "ZipMap" || node.Domain() != kMLDomain || node.GetOutputEdgesCount() != 0) continue;
+      for (const auto* output : node.OutputDefs()) {
+        if (model_output_names_.count(output->Name()) == 0) continue;
+        bool string_keys = node.GetAttributes().count("classlabels_strings") != 0;
+        columnar_output_types_[output->Name()] = string_keys
+                                                     ? DataTypeImpl::GetType<ColumnarMapStringToFloat>()
+                                                     : DataTypeImpl::GetType<ColumnarMapInt64ToFloat>();
+      }
+    }
+
     VLOGS(*session_logger_, 1) << "Done saving model metadata";
     return common::Status::OK();
   }
 
+  // Provide an empty columnar value for every requested output that ZipMap can write in that form and that
+  // the caller did not preallocate. The kernel checks the type of its output value to pick the form.
+  void PreallocateColumnarFetches(const std::vector<std::string>& output_names,
+                                  std::vector<MLValue>& fetches) const {
+    if (fetches.empty()) {
+      fetches.resize(output_names.size());
+    }
+    for (size_t i = 0, end = output_names.size(); i < end; ++i) {
+      auto entry = columnar_output_types_.find(output_names[i]);
+      if (entry == columnar_output_types_.cend() || fetches[i].IsAllocated()) continue;
+      const auto* type = static_cast<const NonTensorTypeBase*>(entry->second);
+      fetches[i].Init(type->GetCreateFunc()(), type, type->GetDeleteFunc());
+    }
+  }
+
+  // graph outputs whose producing kernel can write them as a PackedStringTensor. like the columnar outputs,
+  // only outputs nothing else in the graph reads qualify. the plan never makes graph outputs packed,
+  // the caller asks for the form with RunOptions::packed_string_tensors.
+  void SavePackedStringOutputs(const onnxruntime::Graph& graph) {
+    const auto string_tensor_type = DataTypeImpl::GetTensorType<std::string>();
+    for (const auto& node : graph.Nodes()) {
+      const OpKernel* kernel = session_state_.GetKernel(node.Index());
+      if (kernel == nullptr || node.GetOutputEdgesCount() != 0) continue;
+      const auto& output_defs = node.OutputDefs();
+      for (const auto& packed : kernel->KernelDef().PackedStrings()) {
+        if (static_cast<size_t>(packed.second) >= output_defs.size()) continue;
+        const auto* output = output_defs[packed.second];
+        if (!output->Exists() || model_output_names_.count(output->Name()) == 0 ||
+            utils::GetMLDataType(*output) != string_tensor_type) continue;
+        packed_string_output_names_.insert(output->Name());
+      }
+    }
+  }
+
+  // Provide an empty PackedStringTensor for every requested output that can be written in that form and that
+  // the caller did not preallocate. The kernel checks the type of its output value to pick the form.
+  void PreallocatePackedStringFetches(const std::vector<std::string>& output_names,
+                                      std::vector<MLValue>& fetches) const {
+    if (fetches.empty()) {
+      fetches.resize(output_names.size());
+    }
+    const auto* type = static_cast<const NonTensorTypeBase*>(DataTypeImpl::GetType<PackedStringTensor>());
+    for (size_t i = 0, end = output_names.size(); i < end; ++i) {
+      if (packed_string_output_names_.count(output_names[i]) == 0 || fetches[i].IsAllocated()) continue;
+      fetches[i].Init(type->GetCreateFunc()(), type, type->GetDeleteFunc());
+    }
+  }
+
+  // A PackedStringTensor can be fed for any string input. The plan only reads the inputs whose readers all
+  // support that form as PackedStringTensor values, the others are converted to string tensors here.
+  // Returns feeds if nothing needs converting, otherwise the converted copy in unpacked_feeds.
+  const std::vector<MLValue>& UnpackStringFeeds(const std::vector<std::string>& feed_names,
+                                                const std::vector<MLValue>& feeds,
+                                                std::vector<MLValue>& unpacked_feeds) const {
+    const auto packed_type = DataTypeImpl::GetType<PackedStringTensor>();
+    const SequentialExecutionPlan* plan = session_state_.GetExecutionPlan();
+    for (size_t i = 0, end = std::min(feed_names.size(), feeds.size()); i < end; ++i) {
+      if (!feeds[i].IsAllocated() || feeds[i].Type() != packed_type) continue;
+      int mlvalue_idx;
+      if (plan != nullptr && session_state_.GetMLValueNameIdxMap().GetIdx(feed_names[i], mlvalue_idx).IsOK() &&
+          plan->allocation_plan.at(mlvalue_idx).value_type == packed_type) continue;
+
+      if (unpacked_feeds.empty()) {
+        unpacked_feeds = feeds;
+      }
+      const auto& packed = feeds[i].Get<PackedStringTensor>();
+      auto tensor = std::make_unique<Tensor>(
+          DataTypeImpl::GetType<std::string>(), packed.Shape(),
+          execution_providers_.Get(onnxruntime::kCpuExecutionProvider)->GetAllocator(0, OrtMemTypeDefault));
+      packed.CopyTo(tensor->MutableData<std::string>());
+      auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+      unpacked_feeds[i].Init(tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+    }
+    return unpacked_feeds.empty() ? feeds : unpacked_feeds;
+  }
+
   // Create a Logger for a single execution if possible. Otherwise use the default logger.
   // If a new logger is created, it will also be stored in new_run_logger,
   // which must remain valid for the duration of the execution.
@@ -944,6 +1068,13 @@ class InferenceSession::Impl {
   std::unordered_set<std::string> model_input_names_;
   std::unordered_set<std::string> model_output_names_;
 
+  // type of the preallocated fetch for each output produced in columnar form when
+  // RunOptions::columnar_map_sequences is set
+  std::unordered_map<std::string, MLDataType> columnar_output_types_;
+
+  // graph outputs returned as PackedStringTensor values when RunOptions::packed_string_tensors is set
+  std::unordered_set<std::string> packed_string_output_names_;
+
   // Environment for this session
   // not used now; we'll need it when we introduce threadpool
   // statically allocated pointer, no need to manage its lifetime.
@@ -957,6 +1088,13 @@ class InferenceSession::Impl {
   std::unique_ptr<TaskThreadPool> thread_pool_;
 #endif
 
+  // pool for kernels that split their own work. only created when intra_op_thread_pool_size asks for one.
+#ifdef USE_EIGEN_THREADPOOL
+  std::unique_ptr<Eigen::NonBlockingThreadPool> intra_op_thread_pool_;
+#else
+  std::unique_ptr<TaskThreadPool> intra_op_thread_pool_;
+#endif
+
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_;
 
@@ -55,6 +55,10 @@ struct SessionOptions {
 
   // How many threads in the session thread pool.
   int session_thread_pool_size = 0;
+
+  // How many threads, including the one calling Run, a kernel that splits its own work (e.g. LSTM, GRU) may use.
+  // 0 shares a process-wide pool sized to the hardware concurrency between all sessions.
+  int intra_op_thread_pool_size = 0;
 };
 
 /**
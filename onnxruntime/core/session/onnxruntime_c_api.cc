@@ -132,7 +132,16 @@ ORT_API_STATUS_IMPL(OrtCreateEnv, OrtLoggingLevel default_warning_level,
   API_IMPL_END
 }
 
+static const PackedStringTensor* GetPackedStringTensor(const OrtValue* value) {
+  auto v = reinterpret_cast<const ::onnxruntime::MLValue*>(value);
+  return v->Type() == DataTypeImpl::GetType<PackedStringTensor>() ? &v->Get<PackedStringTensor>() : nullptr;
+}
+
 ORT_API_STATUS_IMPL(OrtGetStringTensorDataLength, _In_ const OrtValue* value, _Out_ size_t* out) {
+  if (const auto* packed = GetPackedStringTensor(value)) {
+    *out = packed->DataLength();
+    return nullptr;
+  }
   TENSOR_READ_API_BEGIN
   const auto* src = tensor.Data<std::string>();
   int64_t len = tensor.Shape().Size();
@@ -163,6 +172,32 @@ ORT_API_STATUS_IMPL(OrtFillStringTensor, _In_ OrtValue* value, _In_ const char*
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtFillStringTensorFromBuffer, _In_ OrtValue* value, _In_ const void* s, size_t s_len,
+                    _In_ const size_t* offsets, size_t offsets_len) {
+  TENSOR_READWRITE_API_BEGIN
+  auto* dst = tensor->MutableData<std::string>();
+  auto len = static_cast<size_t>(tensor->Shape().Size());
+  if (offsets_len < len) {
+    return OrtCreateStatus(ORT_INVALID_ARGUMENT, "offsets array is too short");
+  }
+  // offsets are the start of each string, the last one ends at s_len.
+  // check all of them before assigning so a bad offset leaves the tensor unchanged.
+  for (size_t i = 0; i != len; ++i) {
+    const size_t end = i + 1 != len ? offsets[i + 1] : s_len;
+    if (offsets[i] > end || end > s_len) {
+      return OrtCreateStatus(ORT_INVALID_ARGUMENT, "offsets are not increasing or out of bounds");
+    }
+  }
+  const char* p = static_cast<const char*>(s);
+  for (size_t i = 0; i != len; ++i) {
+    const size_t begin = offsets[i];
+    const size_t end = i + 1 != len ? offsets[i + 1] : s_len;
+    dst[i].assign(p + begin, end - begin);
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 template <typename T>
 OrtStatus* CreateTensorImpl(const size_t* shape, size_t shape_len, OrtAllocator* allocator,
                             std::unique_ptr<Tensor>* out) {
@@ -455,6 +490,13 @@ ORT_API_STATUS_IMPL(OrtGetTensorMutableData, _In_ OrtValue* value, _Out_ void**
 
 ORT_API_STATUS_IMPL(OrtGetStringTensorContent, _In_ const OrtValue* value,
                     _Out_ void* s, size_t s_len, _Out_ size_t* offsets, size_t offsets_len) {
+  if (const auto* packed = GetPackedStringTensor(value)) {
+    if (offsets_len < packed->Size() || s_len < packed->DataLength()) {
+      return OrtCreateStatus(ORT_FAIL, "space is not enough");
+    }
+    packed->CopyTo(static_cast<char*>(s), offsets);
+    return nullptr;
+  }
   TENSOR_READ_API_BEGIN
   const auto* input = tensor.Data<std::string>();
   auto len = static_cast<size_t>(tensor.Shape().Size());
@@ -472,7 +514,7 @@ ORT_API_STATUS_IMPL(OrtGetStringTensorContent, _In_ const OrtValue* value,
   }
   size_t f = 0;
   char* p = static_cast<char*>(s);
-  for (size_t i = 0; i != offsets_len; ++i, ++offsets) {
+  for (size_t i = 0; i != len; ++i, ++offsets) {
     memcpy(p, input[i].data(), input[i].size());
     p += input[i].size();
     *offsets = f;
@@ -615,7 +657,7 @@ static OrtStatus* GetInputOutputNameImpl(_In_ const OrtSession* sess, size_t ind
 
 ORT_API(int, OrtIsTensor, _In_ const OrtValue* value) {
   auto v = reinterpret_cast<const ::onnxruntime::MLValue*>(value);
-  return v->IsTensor() ? 1 : 0;
+  return v->IsTensor() || GetPackedStringTensor(value) != nullptr ? 1 : 0;
 }
 
 ORT_API(void*, OrtAllocatorAlloc, _Inout_ OrtAllocator* ptr, size_t size) {
@@ -693,6 +735,10 @@ static OrtStatus* OrtGetValueCountImpl(const OrtValue* value, size_t* out) {
       return OrtGetNumSequenceElements<VectorMapStringToFloat>(v, out);
     } else if (type == DataTypeImpl::GetType<VectorMapInt64ToFloat>()) {
       return OrtGetNumSequenceElements<VectorMapInt64ToFloat>(v, out);
+    } else if (type == DataTypeImpl::GetType<ColumnarMapStringToFloat>()) {
+      return OrtGetNumSequenceElements<ColumnarMapStringToFloat>(v, out);
+    } else if (type == DataTypeImpl::GetType<ColumnarMapInt64ToFloat>()) {
+      return OrtGetNumSequenceElements<ColumnarMapInt64ToFloat>(v, out);
     } else {
       return OrtCreateStatus(ORT_FAIL, "Input is not of one of the supported sequence types.");
     }
@@ -726,6 +772,23 @@ static OrtStatus* OrtGetValueImplSeqOfMap(const MLValue* p_ml_value, int index,
   return nullptr;
 }
 
+// builds the map of a single row instead of materializing the whole sequence
+template <typename T>
+static OrtStatus* OrtGetValueImplColumnarMap(const MLValue* p_ml_value, int index, OrtValue** out) {
+  using MapType = typename T::value_type;
+  auto& data = p_ml_value->Get<T>();
+  if (index < 0 || static_cast<size_t>(index) >= data.size()) {
+    return OrtCreateStatus(ORT_INVALID_ARGUMENT, "index out of range");
+  }
+  auto row = std::make_unique<MapType>(data.Row(static_cast<size_t>(index)));
+  std::unique_ptr<MLValue> value = std::make_unique<MLValue>();
+  value->Init(row.release(),
+              DataTypeImpl::GetType<MapType>(),
+              DataTypeImpl::GetType<MapType>()->GetDeleteFunc());
+  *out = reinterpret_cast<OrtValue*>(value.release());
+  return nullptr;
+}
+
 template <typename T>
 ONNXTensorElementDataType GetONNXTensorElementDataType() {
   return ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED;
@@ -807,6 +870,10 @@ static OrtStatus* OrtGetValueImplSeq(const OrtValue* value, int index, OrtAlloca
     return OrtGetValueImplSeqOfMap<VectorMapStringToFloat>(p_ml_value, index, out);
   } else if (type == DataTypeImpl::GetType<VectorMapInt64ToFloat>()) {
     return OrtGetValueImplSeqOfMap<VectorMapInt64ToFloat>(p_ml_value, index, out);
+  } else if (type == DataTypeImpl::GetType<ColumnarMapStringToFloat>()) {
+    return OrtGetValueImplColumnarMap<ColumnarMapStringToFloat>(p_ml_value, index, out);
+  } else if (type == DataTypeImpl::GetType<ColumnarMapInt64ToFloat>()) {
+    return OrtGetValueImplColumnarMap<ColumnarMapInt64ToFloat>(p_ml_value, index, out);
   } else {
     return OrtCreateStatus(ORT_FAIL, "Input is not of one of the supported sequence types.");
   }
@@ -892,6 +959,99 @@ ORT_API_STATUS_IMPL(OrtGetValue, const OrtValue* value, int index, OrtAllocator*
   API_IMPL_END
 }
 
+///////////////////
+// Packed string tensors
+ORT_API_STATUS_IMPL(OrtCreatePackedStringTensorAsOrtValue, _In_ const size_t* shape, size_t shape_len,
+                    _In_ const void* s, size_t s_len, _In_ const size_t* offsets, size_t offsets_len,
+                    _Out_ OrtValue** out) {
+  API_IMPL_BEGIN
+  std::vector<int64_t> dims(shape, shape + shape_len);
+  TensorShape tensor_shape(dims);
+  if (offsets_len < static_cast<size_t>(tensor_shape.Size())) {
+    return OrtCreateStatus(ORT_INVALID_ARGUMENT, "offsets array is too short");
+  }
+  auto packed = std::make_unique<PackedStringTensor>();
+  ORT_C_API_RETURN_IF_ERROR(packed->Assign(tensor_shape, static_cast<const char*>(s), s_len, offsets));
+  auto value = std::make_unique<MLValue>();
+  auto type = DataTypeImpl::GetType<PackedStringTensor>();
+  value->Init(packed.release(), type, type->GetDeleteFunc());
+  *out = reinterpret_cast<OrtValue*>(value.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtIsPackedStringTensor, const OrtValue* value, int* out) {
+  API_IMPL_BEGIN
+  *out = GetPackedStringTensor(value) != nullptr ? 1 : 0;
+  return nullptr;
+  API_IMPL_END
+}
+
+///////////////////
+// Columnar sequences of maps
+static bool IsColumnarMapSequence(const MLValue* p_ml_value) {
+  auto type = p_ml_value->Type();
+  return type == DataTypeImpl::GetType<ColumnarMapStringToFloat>() ||
+         type == DataTypeImpl::GetType<ColumnarMapInt64ToFloat>();
+}
+
+ORT_API_STATUS_IMPL(OrtIsColumnarMapSequence, const OrtValue* value, int* out) {
+  API_IMPL_BEGIN
+  *out = IsColumnarMapSequence(reinterpret_cast<const MLValue*>(value)) ? 1 : 0;
+  return nullptr;
+  API_IMPL_END
+}
+
+template <typename T>
+static OrtStatus* OrtGetColumnarMapSequenceKeysImpl(const MLValue* p_ml_value, OrtAllocator* allocator,
+                                                    OrtValue** out) {
+  using TKey = typename T::key_type;
+  const auto& keys = p_ml_value->Get<T>().Keys();
+  std::vector<size_t> dims{keys.size()};
+  OrtStatus* st = OrtCreateTensorAsOrtValue(allocator, dims.data(), dims.size(),
+                                            GetONNXTensorElementDataType<TKey>(), out);
+  return st ? st : PopulateTensorWithData<TKey>(*out, keys.data(), keys.size());
+}
+
+ORT_API_STATUS_IMPL(OrtGetColumnarMapSequenceKeys, const OrtValue* value, OrtAllocator* allocator,
+                    OrtValue** out) {
+  API_IMPL_BEGIN
+  auto p_ml_value = reinterpret_cast<const MLValue*>(value);
+  auto type = p_ml_value->Type();
+  if (type == DataTypeImpl::GetType<ColumnarMapStringToFloat>()) {
+    return OrtGetColumnarMapSequenceKeysImpl<ColumnarMapStringToFloat>(p_ml_value, allocator, out);
+  } else if (type == DataTypeImpl::GetType<ColumnarMapInt64ToFloat>()) {
+    return OrtGetColumnarMapSequenceKeysImpl<ColumnarMapInt64ToFloat>(p_ml_value, allocator, out);
+  }
+  return OrtCreateStatus(ORT_INVALID_ARGUMENT, "Input is not a columnar sequence of maps.");
+  API_IMPL_END
+}
+
+template <typename T>
+static void OrtGetColumnarMapSequenceValuesImpl(const MLValue* p_ml_value, const float** values,
+                                                size_t* num_rows, size_t* num_keys) {
+  const auto& data = p_ml_value->Get<T>();
+  *values = data.Values();
+  *num_rows = data.size();
+  *num_keys = data.NumKeys();
+}
+
+ORT_API_STATUS_IMPL(OrtGetColumnarMapSequenceValues, const OrtValue* value, const float** values,
+                    size_t* num_rows, size_t* num_keys) {
+  API_IMPL_BEGIN
+  auto p_ml_value = reinterpret_cast<const MLValue*>(value);
+  auto type = p_ml_value->Type();
+  if (type == DataTypeImpl::GetType<ColumnarMapStringToFloat>()) {
+    OrtGetColumnarMapSequenceValuesImpl<ColumnarMapStringToFloat>(p_ml_value, values, num_rows, num_keys);
+  } else if (type == DataTypeImpl::GetType<ColumnarMapInt64ToFloat>()) {
+    OrtGetColumnarMapSequenceValuesImpl<ColumnarMapInt64ToFloat>(p_ml_value, values, num_rows, num_keys);
+  } else {
+    return OrtCreateStatus(ORT_INVALID_ARGUMENT, "Input is not a columnar sequence of maps.");
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 ///////////////////
 // OrtCreateValue
 template <typename T>
@@ -7,6 +7,7 @@
 #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
 #define PY_ARRAY_UNIQUE_SYMBOL onnxruntime_python_ARRAY_API
 #include <numpy/arrayobject.h>
+#include <algorithm>
 
 #include "core/graph/graph.h"
 #include "core/framework/tensor_shape.h"
@@ -122,16 +123,16 @@ void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyAr
       // Copy string data which needs to be done after Tensor is allocated.
       // Strings are given as bytes (encoded strings).
       // NPY_VOID does not trim final 0.
-      // NPY_STRING assumes bytes string ends with a final 0.
+      // NPY_STRING pads shorter strings with 0 but a string filling the whole item has no final 0.
+      // Every string is assigned in one copy from the contiguous numpy buffer.
       std::string* dst = p_tensor->MutableData<std::string>();
       auto item_size = PyArray_ITEMSIZE(darray);
-      char* src = static_cast<char*>(PyArray_DATA(darray));
-      for (int i = 0; i < shape.Size(); i++, src += item_size) {
+      const char* src = static_cast<const char*>(PyArray_DATA(darray));
+      for (int64_t i = 0; i < shape.Size(); i++, src += item_size) {
         if (npy_type == NPY_STRING) {
-          dst[i] = src;
+          dst[i].assign(src, std::find(src, src + item_size, '\0'));
         } else {
-          dst[i].resize(item_size);
-          memcpy((void*)dst[i].c_str(), src, item_size);
+          dst[i].assign(src, item_size);
         }
       }
     } else if (npy_type == NPY_OBJECT) {
@@ -379,6 +380,39 @@ void CreateGenericIterableMLValue(PyObject* iterator, AllocatorPtr alloc, const
   }
 }
 
+bool CreatePackedStringMLValue(const std::string& name_input, py::object& value, MLValue* p_mlvalue) {
+  if (!PyObjectCheck_Array(value.ptr()) ||
+      PyArray_TYPE(reinterpret_cast<PyArrayObject*>(value.ptr())) != NPY_STRING) {
+    return false;
+  }
+  PyArrayObject* darray = PyArray_GETCONTIGUOUS(reinterpret_cast<PyArrayObject*>(value.ptr()));
+  if (darray == NULL) {
+    throw std::runtime_error(std::string("The object must be a contiguous array for input '") + name_input + std::string("'."));
+  }
+  int ndim = PyArray_NDIM(darray);
+  npy_intp* npy_dims = PyArray_DIMS(darray);
+  std::vector<int64_t> dims(npy_dims, npy_dims + ndim);
+  TensorShape shape(dims);
+
+  // the numpy buffer is copied as it is, each element starts at a multiple of the item size
+  // and ends at its first 0 or at the end of the item.
+  auto item_size = static_cast<size_t>(PyArray_ITEMSIZE(darray));
+  const char* src = static_cast<const char*>(PyArray_DATA(darray));
+  const auto len = static_cast<size_t>(shape.Size());
+  auto buffer = std::make_shared<const std::string>(src, item_size * len);
+  std::vector<PackedStringTensor::Element> elements(len);
+  for (size_t i = 0; i < len; ++i, src += item_size) {
+    elements[i] = {i * item_size, static_cast<size_t>(std::find(src, src + item_size, '\0') - src)};
+  }
+  Py_XDECREF(darray);
+
+  auto p_packed = std::make_unique<PackedStringTensor>();
+  p_packed->Reset(shape, std::move(buffer), std::move(elements));
+  auto packed_type = DataTypeImpl::GetType<PackedStringTensor>();
+  p_mlvalue->Init(p_packed.release(), packed_type, packed_type->GetDeleteFunc());
+  return true;
+}
+
 void CreateGenericMLValue(AllocatorPtr alloc, const std::string& name_input, py::object& value, MLValue* p_mlvalue) {
   if (PyObjectCheck_Array(value.ptr())) {
     // The most frequent case: input comes as an array.
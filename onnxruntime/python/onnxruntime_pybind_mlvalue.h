@@ -26,5 +26,9 @@ int OnnxRuntimeTensorToNumpyType(const DataTypeImpl* tensor_type);
 
 void CreateGenericMLValue(AllocatorPtr alloc, const std::string& name_input, py::object& value, MLValue* p_mlvalue);
 
+// Creates a PackedStringTensor from a numpy array of bytes (dtype 'S') with one copy of its buffer.
+// Returns false and leaves p_mlvalue unchanged if value is not such an array.
+bool CreatePackedStringMLValue(const std::string& name_input, py::object& value, MLValue* p_mlvalue);
+
 }  // namespace python
 }  // namespace onnxruntime
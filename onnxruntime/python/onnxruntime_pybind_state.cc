@@ -69,6 +69,7 @@ std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_BrainS
 #endif  // _MSC_VER
 
 #include <iterator>
+#include <stdexcept>
 
 #if defined(_MSC_VER)
 #pragma warning(disable : 4267 4996 4503 4003)
@@ -96,6 +97,38 @@ template <typename T>
 void AddNonTensor(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
   pyobjs.push_back(py::cast(val.Get<T>()));
 }
+// A columnar sequence of maps is returned as a (keys, values) tuple: the list of the keys shared by all
+// the maps and a float32 array of shape [rows, keys].
+template <typename T>
+void AddColumnarMapSequence(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
+  const T& seq = val.Get<T>();
+  std::vector<npy_intp> npy_dims{static_cast<npy_intp>(seq.size()), static_cast<npy_intp>(seq.NumKeys())};
+  py::object values = py::reinterpret_steal<py::object>(PyArray_SimpleNew(2, npy_dims.data(), NPY_FLOAT));
+  memcpy(PyArray_DATA(reinterpret_cast<PyArrayObject*>(values.ptr())), seq.Values(),
+         sizeof(float) * seq.size() * seq.NumKeys());
+  pyobjs.push_back(py::make_tuple(py::cast(seq.Keys()), values));
+}
+
+// A PackedStringTensor is returned as a numpy array of bytes (dtype 'S') as wide as its longest element.
+void AddPackedStringTensor(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
+  const auto& packed = val.Get<PackedStringTensor>();
+  const auto& dims = packed.Shape().GetDims();
+  std::vector<npy_intp> npy_dims(dims.cbegin(), dims.cend());
+  size_t item_size = 1;
+  for (size_t i = 0, end = packed.Size(); i < end; ++i) {
+    item_size = std::max(item_size, packed.ElementLength(i));
+  }
+  py::object obj = py::reinterpret_steal<py::object>(PyArray_New(
+      &PyArray_Type, static_cast<int>(npy_dims.size()), npy_dims.data(), NPY_STRING, NULL, NULL,
+      static_cast<int>(item_size), 0, NULL));
+  char* dst = static_cast<char*>(PyArray_DATA(reinterpret_cast<PyArrayObject*>(obj.ptr())));
+  memset(dst, 0, item_size * packed.Size());
+  for (size_t i = 0, end = packed.Size(); i < end; ++i, dst += item_size) {
+    memcpy(dst, packed.ElementData(i), packed.ElementLength(i));
+  }
+  pyobjs.push_back(obj);
+}
+
 void AddNonTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
   // Should be in sync with core/framework/datatypes.h
   if (val.Type() == DataTypeImpl::GetType<MapStringToString>()) {
@@ -126,6 +159,12 @@ void AddNonTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs)
     AddNonTensor<VectorMapStringToFloat>(val, pyobjs);
   } else if (val.Type() == DataTypeImpl::GetType<VectorMapInt64ToFloat>()) {
     AddNonTensor<VectorMapInt64ToFloat>(val, pyobjs);
+  } else if (val.Type() == DataTypeImpl::GetType<ColumnarMapStringToFloat>()) {
+    AddColumnarMapSequence<ColumnarMapStringToFloat>(val, pyobjs);
+  } else if (val.Type() == DataTypeImpl::GetType<ColumnarMapInt64ToFloat>()) {
+    AddColumnarMapSequence<ColumnarMapInt64ToFloat>(val, pyobjs);
+  } else if (val.Type() == DataTypeImpl::GetType<PackedStringTensor>()) {
+    AddPackedStringTensor(val, pyobjs);
   } else {
     throw std::runtime_error("Output is a non-tensor type which is not supported.");
   }
@@ -244,7 +283,18 @@ Set this option to false if you don't want it. Default is True.)pbdoc")
                      R"pbdoc(Applies to session load, initialization, etc. Default is 0.)pbdoc")
       .def_readwrite("session_thread_pool_size", &SessionOptions::session_thread_pool_size,
                      R"pbdoc(How many threads in the session thread pool. Default is 0 to let onnxruntime choose.
-This parameter is unused unless *enable_sequential_execution* is false.)pbdoc");
+This parameter is unused unless *enable_sequential_execution* is false.)pbdoc")
+      .def_property(
+          "intra_op_thread_pool_size",
+          [](const SessionOptions& options) { return options.intra_op_thread_pool_size; },
+          [](SessionOptions& options, int intra_op_thread_pool_size) {
+            if (intra_op_thread_pool_size <= 0)
+              throw std::invalid_argument("intra_op_thread_pool_size must be greater than 0");
+            options.intra_op_thread_pool_size = intra_op_thread_pool_size;
+          },
+          R"pbdoc(How many threads an operator that splits its own work (such as LSTM or GRU) may use,
+including the thread calling run. Default is 0 to share one pool sized to the hardware concurrency
+between all sessions.)pbdoc");
 
   py::class_<RunOptions>(m, "RunOptions", R"pbdoc(Configuration information for a single Run.)pbdoc")
       .def(py::init())
@@ -254,7 +304,14 @@ This parameter is unused unless *enable_sequential_execution* is false.)pbdoc");
                      "To identify logs generated by a particular Run() invocation.")
       .def_readwrite("terminate", &RunOptions::terminate,
                      R"pbdoc(Set to True to terminate any currently executing calls that are using this
-RunOptions instance. The individual calls will exit gracefully and return an error status.)pbdoc");
+RunOptions instance. The individual calls will exit gracefully and return an error status.)pbdoc")
+      .def_readwrite("columnar_map_sequences", &RunOptions::columnar_map_sequences,
+                     R"pbdoc(Set to True to return the sequences of maps produced by ZipMap as a tuple
+(keys, values) where values is a float32 array of shape [rows, len(keys)], instead of a list of dictionaries.)pbdoc")
+      .def_readwrite("packed_string_tensors", &RunOptions::packed_string_tensors,
+                     R"pbdoc(Set to True to feed the numpy arrays of bytes (dtype 'S') with a single copy of
+their buffer, and to return the string outputs of Identity, Gather and Slice that no other node reads
+as numpy arrays of bytes instead of arrays of objects.)pbdoc");
 
   py::class_<ModelMetadata>(m, "ModelMetadata", R"pbdoc(Pre-defined and custom metadata about the model.
 It is usually used to identify the model used to run the prediction and
@@ -348,7 +405,10 @@ including arg name, arg type (contains both type and shape).)pbdoc")
         NameMLValMap feeds;
         for (auto _ : pyfeeds) {
           MLValue ml_value;
-          CreateGenericMLValue(GetAllocator(), _.first, _.second, &ml_value);
+          if (run_options == nullptr || !run_options->packed_string_tensors ||
+              !CreatePackedStringMLValue(_.first, _.second, &ml_value)) {
+            CreateGenericMLValue(GetAllocator(), _.first, _.second, &ml_value);
+          }
           if (PyErr_Occurred()) {
             PyObject *ptype, *pvalue, *ptraceback;
             PyErr_Fetch(&ptype, &pvalue, &ptraceback);
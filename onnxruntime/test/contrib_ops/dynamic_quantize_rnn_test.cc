@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// with inputs and weights in [-1, 1], 8-bit inputs and weights keep the outputs of a few steps within about 0.015 of
+// the float results.
+static const float kQuantizationAbsErr = 0.025f;
+
+// random inputs and weights of a bidirectional LSTM (4 gates) or GRU (3 gates)
+struct RandomRnnData {
+  RandomRnnData(int64_t gates, unsigned seed) : num_gates(gates) {
+    std::default_random_engine generator(seed);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    auto random_values = [&](int64_t size) {
+      std::vector<float> values(static_cast<size_t>(size));
+      for (auto& value : values)
+        value = distribution(generator);
+      return values;
+    };
+
+    X = random_values(seq_length * batch_size * input_size);
+    W = random_values(num_directions * num_gates * hidden_size * input_size);
+    R = random_values(num_directions * num_gates * hidden_size * hidden_size);
+    B = random_values(num_directions * 2 * num_gates * hidden_size);
+  }
+
+  std::vector<int64_t> X_dims() const { return {seq_length, batch_size, input_size}; }
+  std::vector<int64_t> W_dims() const { return {num_directions, num_gates * hidden_size, input_size}; }
+  std::vector<int64_t> R_dims() const { return {num_directions, num_gates * hidden_size, hidden_size}; }
+  std::vector<int64_t> B_dims() const { return {num_directions, 2 * num_gates * hidden_size}; }
+
+  const int64_t seq_length = 5;
+  const int64_t batch_size = 3;
+  const int64_t input_size = 4;
+  const int64_t hidden_size = 5;
+  const int64_t num_directions = 2;
+  const int64_t num_gates;
+
+  std::vector<float> X;
+  std::vector<float> W;
+  std::vector<float> R;
+  std::vector<float> B;
+};
+
+// runs op on data with W, R and B as initializers and returns all its outputs
+static std::vector<MLValue> RunRnn(const char* op, int opset_version, const char* domain, const RandomRnnData& data,
+                                   const std::vector<std::string>& output_names, int64_t linear_before_reset = -1) {
+  SingleNodeSession session(op, opset_version, domain);
+  session.AddAttribute<std::string>("direction", "bidirectional");
+  session.AddAttribute<int64_t>("hidden_size", data.hidden_size);
+  if (linear_before_reset >= 0)
+    session.AddAttribute<int64_t>("linear_before_reset", linear_before_reset);
+
+  session.AddInput<float>("X");
+  session.AddInitializer<float>("W", data.W_dims(), data.W);
+  session.AddInitializer<float>("R", data.R_dims(), data.R);
+  session.AddInitializer<float>("B", data.B_dims(), data.B);
+  for (const auto& name : output_names)
+    session.AddOutput<float>(name.c_str());
+
+  std::unordered_map<std::string, MLValue> feeds;
+  feeds["X"] = SingleNodeSession::MakeValue(data.X_dims(), data.X);
+  return session.Run(feeds);
+}
+
+// checks the outputs of the quantized op against those of the float op, and records the largest difference in the
+// test's properties
+static void CheckQuantizationError(const std::string& name, const std::vector<std::string>& output_names,
+                                   const std::vector<MLValue>& expected, const std::vector<MLValue>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+
+  float max_abs_error = 0.f;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    const auto& expected_tensor = expected[i].Get<Tensor>();
+    const auto& actual_tensor = actual[i].Get<Tensor>();
+    ASSERT_EQ(expected_tensor.Shape(), actual_tensor.Shape()) << output_names[i];
+
+    const float* expected_data = expected_tensor.Data<float>();
+    const float* actual_data = actual_tensor.Data<float>();
+    for (int64_t j = 0; j < expected_tensor.Shape().Size(); ++j) {
+      const float error = std::abs(expected_data[j] - actual_data[j]);
+      EXPECT_LE(error, kQuantizationAbsErr) << output_names[i] << "[" << j << "]";
+      max_abs_error = std::max(max_abs_error, error);
+    }
+  }
+
+  ::testing::Test::RecordProperty(name + "_max_abs_error", std::to_string(max_abs_error));
+}
+
+TEST(DynamicQuantizeRNNTest, LSTMMatchesFloatLSTM) {
+  const RandomRnnData data(4, 1);
+  const std::vector<std::string> output_names{"Y", "Y_h", "Y_c"};
+
+  auto expected = RunRnn("LSTM", 7, onnxruntime::kOnnxDomain, data, output_names);
+  auto actual = RunRnn("DynamicQuantizeLSTM", 1, onnxruntime::kMSDomain, data, output_names);
+  CheckQuantizationError("DynamicQuantizeLSTM", output_names, expected, actual);
+}
+
+TEST(DynamicQuantizeRNNTest, GRUMatchesFloatGRU) {
+  const RandomRnnData data(3, 2);
+  const std::vector<std::string> output_names{"Y", "Y_h"};
+
+  for (int64_t linear_before_reset : {0, 1}) {
+    auto expected = RunRnn("GRU", 7, onnxruntime::kOnnxDomain, data, output_names, linear_before_reset);
+    auto actual = RunRnn("DynamicQuantizeGRU", 1, onnxruntime::kMSDomain, data, output_names, linear_before_reset);
+    CheckQuantizationError("DynamicQuantizeGRU_linear_before_reset_" + std::to_string(linear_before_reset),
+                           output_names, expected, actual);
+  }
+}
+
+// the weights are quantized once when the kernel is created, so W and R have to be initializers
+static void RunWithWeightsAsGraphInputs(const char* op, int64_t num_gates) {
+  const RandomRnnData data(num_gates, 3);
+
+  for (bool W_is_initializer : {false, true}) {
+    OpTester test(op, 1, onnxruntime::kMSDomain);
+    test.AddAttribute<std::string>("direction", "bidirectional");
+    test.AddAttribute<int64_t>("hidden_size", data.hidden_size);
+    test.AddInput<float>("X", data.X_dims(), data.X);
+    test.AddInput<float>("W", data.W_dims(), data.W, W_is_initializer);
+    test.AddInput<float>("R", data.R_dims(), data.R, !W_is_initializer);
+
+    const std::vector<int64_t> Y_dims{data.seq_length, data.num_directions, data.batch_size, data.hidden_size};
+    test.AddOutput<float>("Y", Y_dims, std::vector<float>(Y_dims[0] * Y_dims[1] * Y_dims[2] * Y_dims[3]));
+    test.Run(OpTester::ExpectResult::kExpectFailure, std::string(op) + " requires W and R to be float initializers");
+  }
+}
+
+TEST(DynamicQuantizeRNNTest, LSTMWeightsNotInitializers) {
+  RunWithWeightsAsGraphInputs("DynamicQuantizeLSTM", 4);
+}
+
+TEST(DynamicQuantizeRNNTest, GRUWeightsNotInitializers) {
+  RunWithWeightsAsGraphInputs("DynamicQuantizeGRU", 3);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include <limits>
 #include "test/providers/provider_test_utils.h"
 
 namespace onnxruntime {
@@ -80,5 +81,29 @@ TEST(ContribOpTest, MaxPoolWithMask) {
   test.Run();
 }
 
+TEST(ContribOpTest, MaxPoolWithMaskSkipsNaN) {
+  OpTester test("MaxpoolWithMask", 1, onnxruntime::kMSDomain);
+
+  test.AddAttribute("auto_pad", "");
+  test.AddAttribute("strides", std::vector<int64_t>{1, 1});
+  test.AddAttribute("pads", std::vector<int64_t>{0, 0, 0, 0});
+  test.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<int64_t> x_dims = {1, 1, 2, 4};
+  std::vector<float> x_vals = {nan, 1.f, 5.f, nan,
+                               2.f, nan, 3.f, nan};
+  std::vector<int32_t> m_vals(x_vals.size(), 1);
+
+  // NaN values are skipped, including one in the first position of a window
+  std::vector<int64_t> expected_dims = {1, 1, 1, 3};
+  std::vector<float> expected_vals = {2.f, 5.f, 5.f};
+
+  test.AddInput<float>("X", x_dims, x_vals);
+  test.AddInput<int32_t>("M", x_dims, m_vals);
+  test.AddOutput<float>("Y", expected_dims, expected_vals);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
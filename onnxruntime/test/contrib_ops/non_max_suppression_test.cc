@@ -239,5 +239,36 @@ TEST(NonMaxSuppressionOpTest, WithScoreThresholdPadToSixOutput) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, ManySelectedBoxesAndEqualScores) {
+  // 20 disjoint boxes with decreasing scores, then a box overlapping box 5 with a lower score,
+  // then a disjoint box with the same score as box 0 which is selected right after it.
+  std::vector<float> boxes;
+  std::vector<float> scores;
+  for (int i = 0; i < 20; ++i) {
+    boxes.insert(boxes.end(), {0.0f, 2.0f * i, 1.0f, 2.0f * i + 1.0f});
+    scores.push_back(0.99f - 0.01f * i);
+  }
+
+  boxes.insert(boxes.end(), {0.0f, 10.1f, 1.0f, 11.1f});
+  scores.push_back(0.5f);
+  boxes.insert(boxes.end(), {0.0f, 100.0f, 1.0f, 101.0f});
+  scores.push_back(0.99f);
+
+  std::vector<int32_t> expected{0, 21};
+  for (int32_t i = 1; i < 20; ++i) {
+    expected.push_back(i);
+  }
+
+  OpTester test("NonMaxSuppression", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("boxes", {22, 4}, boxes);
+  test.AddInput<float>("scores", {22}, scores);
+  test.AddAttribute<int64_t>("max_output_size", 30LL);
+  test.AddAttribute<float>("iou_threshold", 0.5f);
+  test.AddAttribute<float>("score_threshold", 0.0f);
+  test.AddOutput<int32_t>("selected_indices", {21}, expected);
+  test.AddOutput<int32_t>("valid_outputs", {1}, {21L});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -48,6 +48,55 @@ TEST(ROIAlignTest, AvgModePositive) {
   test.Run();
 }
 
+TEST(ROIAlignTest, AvgModeManyROIs) {
+  // enough samples per ROI that the interpolation tables of all ROIs don't fit in a single block.
+  // the input is linear in y and x, so the average of a bin is the value at its center.
+  const int64_t N = 2;
+  const int64_t C = 2;
+  const int64_t H = 16;
+  const int64_t W = 16;
+  const int64_t pooled_h = 4;
+  const int64_t pooled_w = 4;
+  const int64_t sampling_ratio = 32;
+
+  auto value = [](int64_t n, int64_t c, float y, float x) { return 2.f * n + c + 0.1f * y + 0.01f * x; };
+
+  std::vector<float> X;
+  for (int64_t n = 0; n < N; ++n)
+    for (int64_t c = 0; c < C; ++c)
+      for (int64_t y = 0; y < H; ++y)
+        for (int64_t x = 0; x < W; ++x)
+          X.push_back(value(n, c, static_cast<float>(y), static_cast<float>(x)));
+
+  const std::vector<float> rois{0.f, 1.f, 2.f, 9.f, 14.f,
+                                1.f, 0.f, 0.f, 15.f, 15.f,
+                                0.f, 3.5f, 1.25f, 12.f, 7.f,
+                                1.f, 2.f, 5.f, 6.f, 13.f,
+                                0.f, 7.f, 7.f, 15.f, 10.f};
+  const int64_t num_rois = static_cast<int64_t>(rois.size()) / 5;
+
+  std::vector<float> Y;
+  for (int64_t r = 0; r < num_rois; ++r) {
+    const float* roi = &rois[r * 5];
+    const float bin_h = (roi[4] - roi[2]) / pooled_h;
+    const float bin_w = (roi[3] - roi[1]) / pooled_w;
+    for (int64_t c = 0; c < C; ++c)
+      for (int64_t ph = 0; ph < pooled_h; ++ph)
+        for (int64_t pw = 0; pw < pooled_w; ++pw)
+          Y.push_back(value(static_cast<int64_t>(roi[0]), c, roi[2] + (ph + 0.5f) * bin_h, roi[1] + (pw + 0.5f) * bin_w));
+  }
+
+  OpTester test("ROIAlign", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("pooled_h", pooled_h);
+  test.AddAttribute<int64_t>("pooled_w", pooled_w);
+  test.AddAttribute<int64_t>("sampling_ratio", sampling_ratio);
+  test.AddAttribute<float>("spatial_scale", 1.0f);
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("rois", {num_rois, 5}, rois);
+  test.AddOutput<float>("Y", {num_rois, C, pooled_h, pooled_w}, Y);
+  test.Run();
+}
+
 TEST(ROIAlignTest, MaxModePositive) {
   OpTester test("ROIAlign", 1, onnxruntime::kMSDomain);
   test.AddAttribute<std::string>("mode", "max");
@@ -179,6 +179,27 @@ TEST(ContribOpTest, StringNormalizerTest) {
     test.AddOutput<std::string>("Y", {6}, output);
     test.Run(OpTester::ExpectResult::kExpectSuccess);
   }
+  // - case-INSENSETIVE approach
+  // - mixed case ASCII stopwords and input, longer than a word of 8 chars
+  // - LOWER
+  {
+    OpTester test("StringNormalizer", opset_ver, domain);
+    InitTestAttr(test, "LOWER", false, {u8"MONDAY", u8"Wednesday", u8"Понедельник"}, test_locale);
+    std::vector<int64_t> dims{1, 6};
+    std::vector<std::string> input = {std::string(u8"monDay"),
+                                      std::string(u8"Tuesday, 12 March [2019]"),
+                                      std::string(u8"WEDNESDAY"),
+                                      std::string(u8"ПОНЕДЕЛЬНИК"),
+                                      std::string(u8"École Élémentaire"),
+                                      std::string(u8"@Z[a`z{")};
+    test.AddInput<std::string>("T", dims, input);
+
+    std::vector<std::string> output = {std::string(u8"tuesday, 12 march [2019]"),
+                                       std::string(u8"école élémentaire"),
+                                       std::string(u8"@z[a`z{")};
+    test.AddOutput<std::string>("Y", {1, 3}, output);
+    test.Run(OpTester::ExpectResult::kExpectSuccess);
+  }
 
   // Empty output case
   // - casesensitive approach
@@ -693,6 +693,48 @@ TEST(ContribOpTest, TokenizerWithSeparators_MixCharCommonPrefixC) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(ContribOpTest, TokenizerWithSeparators_SharedInfixNC) {
+  // A separator that starts inside a partial match of another one
+  // [N][C] dimensions
+  // Output [N][C][D]
+  std::vector<std::string> separators = {
+      u8"bc",
+      u8"abcd",
+      u8"abd"};
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, false, separators, 1);
+
+  std::vector<int64_t> dims{2, 1};
+  std::vector<std::string> input{u8"xabcdy", u8"zabcx"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(2));
+  std::vector<std::string> output{u8"xa", u8"dy", u8"za", u8"x"};
+
+  test.AddOutput<std::string>("Y", output_dims, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
+TEST(ContribOpTest, TokenizerWithSeparators_InvalidUtf8NC) {
+  std::vector<std::string> separators = {u8";"};
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, false, separators, 1);
+
+  std::vector<int64_t> dims{2, 1};
+  std::vector<std::string> input{u8"a;b", "a;\xd0"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(2));
+  std::vector<std::string> output{u8"a", u8"b", u8"a", u8"b"};
+
+  test.AddOutput<std::string>("Y", output_dims, output);
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Input string contains invalid utf8 chars");
+}
+
 TEST(ContribOpTest, TokenizerExpression_SimpleSep) {
   OpTester test("Tokenizer", opset_ver, domain);
   const std::string tokenexp(";");
@@ -146,6 +146,7 @@ class PlannerTest : public ::testing::Test {
 
   // some standard components used to build test-cases:
   Type float_type_;
+  Type string_type_;
 
   std::unique_ptr<::onnxruntime::KernelDef> std_kernel_;       // a unary kernel with no-aliasing and no-in-place
   std::unique_ptr<::onnxruntime::KernelDef> in_place_kernel_;  // a unary kernel with in-place
@@ -163,6 +164,7 @@ class PlannerTest : public ::testing::Test {
   PlannerTest() : model_("test"), graph_{model_.MainGraph()}, state_{execution_providers_} {
     std_kernel_ = KernelDefBuilder().SetName("Transpose").Build();
     in_place_kernel_ = KernelDefBuilder().SetName("Clip").MayInplace(0, 0).Build();
+    string_type_.value.mutable_tensor_type()->set_elem_type(TensorProto_DataType_STRING);
     CPUExecutionProviderInfo epi;
     auto execution_provider = std::make_unique<CPUExecutionProvider>(epi);
     execution_providers_.Add("CPUExecutionProvider", std::move(execution_provider));
@@ -176,6 +178,12 @@ class PlannerTest : public ::testing::Test {
     return (name_to_arg_[name] = &graph_.GetOrCreateNodeArg(name, &float_type_.value));
   }
 
+  // a string tensor arg. call it before the arg is used by a node, which creates a float tensor arg otherwise.
+  onnxruntime::NodeArg* StringArg(const std::string& name) {
+    EXPECT_EQ(name_to_arg_.count(name), 0) << name << " already exists";
+    return (name_to_arg_[name] = &graph_.GetOrCreateNodeArg(name, &string_type_.value));
+  }
+
   onnxruntime::Node* AddNode(::onnxruntime::KernelDef& kernel_def, std::string& input, std::string& output) {
     auto node = std::make_unique<UnaryNode>(graph_, kernel_def.OpName(), Arg(input), Arg(output));
     auto* p_node = node->p_node;
@@ -251,6 +259,12 @@ class PlannerTest : public ::testing::Test {
     EXPECT_EQ(plan_->allocation_plan[id].alloc_kind, kind) << "Error in allocation kind for " << name;
   }
 
+  void CheckValueType(const std::string& name, MLDataType type) {
+    int id;
+    index(name, id);
+    EXPECT_EQ(plan_->allocation_plan[id].value_type, type) << "Error in value type for " << name;
+  }
+
   void CheckFreed(int step_number, std::initializer_list<std::string> freed_items) {
     // create set and check equality
     std::unordered_set<int> expected;
@@ -413,6 +427,38 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+// PackedStringsTest: Check that the string values only read by kernel inputs declared with PackedStrings
+// are planned as PackedStringTensor, and that graph outputs and values read by other kernels are not.
+TEST_F(PlannerTest, PackedStringsTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+  for (auto& name : {X1, X2, X3, X4, X5}) {
+    StringArg(name);
+  }
+
+  auto identity_kernel = KernelDefBuilder().SetName("Identity").Alias(0, 0).PackedStrings(0, 0).Build();
+  auto squeeze_kernel = KernelDefBuilder().SetName("Squeeze").Alias(0, 0).Build();
+
+  // graph structure:
+  AddNode(*identity_kernel, X1, X2);  // X1: input only read by Identity; X2: temporary
+  AddNode(*identity_kernel, X2, X3);  // X3: output
+  AddNode(*squeeze_kernel, X4, X5);   // X4: input read by Squeeze, which only reads tensors; X5: output
+
+  CreatePlan();
+
+  auto packed_type = DataTypeImpl::GetType<PackedStringTensor>();
+  auto string_tensor_type = DataTypeImpl::GetTensorType<std::string>();
+  CheckValueType(X1, packed_type);
+  CheckValueType(X2, packed_type);
+  CheckValueType(X3, string_tensor_type);
+  CheckValueType(X4, string_tensor_type);
+  CheckValueType(X5, string_tensor_type);
+
+  // a packed value has no tensor buffer to alias
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
@@ -155,6 +155,65 @@ TEST(ExecutionFrameTest, FeedInDataTest) {
   EXPECT_EQ(p_tensor_arg_0->MutableData<float>(), value.GetMutable<Tensor>()->MutableData<float>());
 }
 
+TEST(ExecutionFrameTest, ResetTest) {
+  onnxruntime::Model model("test");
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def("X", &tensor_float), output_def("Y", &tensor_float);
+
+  graph.AddNode("node1", "Clip", "Clip operator", ArgMap{&input_def}, ArgMap{&output_def});
+  graph.Resolve();
+  auto cpu_allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  auto element_type = DataTypeImpl::GetType<float>();
+  TensorShape shape({3, 2});
+
+  auto create_value = [&]() {
+    MLValue value;
+    value.Init(std::make_unique<Tensor>(element_type, shape, cpu_allocator).release(),
+               DataTypeImpl::GetType<Tensor>(),
+               DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+    return value;
+  };
+
+  MLValue value = create_value();
+  MLValue next_value = create_value();
+
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_typ = cpu_xp->Type();
+
+  KernelRegistryManager kernel_registry_manager;
+  ExecutionProviders execution_providers;
+  execution_providers.Add(xp_typ, std::move(cpu_xp));
+  EXPECT_TRUE(kernel_registry_manager.RegisterKernels(execution_providers).IsOK());
+
+  SessionState state{execution_providers};
+  state.SetGraphViewer(std::make_unique<GraphViewer>(graph));
+
+  MLValueNameIdxMap& mlvalue_name_idx_map{state.GetMLValueNameIdxMap()};
+  auto x_idx = mlvalue_name_idx_map.Add("X");
+  auto y_idx = mlvalue_name_idx_map.Add("Y");
+
+  state.CalculateNodeIndexInfo();
+
+  vector<MLValue> outputs;
+  ExecutionFrame frame({x_idx}, {value}, {y_idx}, outputs, {}, state);
+
+  // allocate the output as the first execution would
+  MLValue& y = *frame.GetMutableNodeInputOrOutputMLValue(1);
+  auto status = frame.AllocateMLValueTensorSelfOwnBuffer(y, y_idx, element_type, cpu_allocator->Info(), shape);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  // the next execution sees the new feed, and the output from the previous execution is released
+  status = frame.Reset({next_value}, outputs);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  const MLValue* x = frame.GetNodeInputOrOutputMLValue(0);
+  ASSERT_TRUE(x);
+  EXPECT_EQ(x->Get<Tensor>().Data<float>(), next_value.Get<Tensor>().Data<float>());
+  EXPECT_FALSE(frame.GetNodeInputOrOutputMLValue(1)->IsAllocated());
+}
+
 TEST(ExecutionFrameTest, MemPatternTest) {
   auto cpu_xp = CreateCPUExecutionProvider();
   auto xp_type = cpu_xp->Type();
@@ -950,6 +950,101 @@ TEST(InferenceSessionTests, TestOptionalInputs) {
   EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("Missing required input:"));
 }
 
+// data -> Identity -> Gather -> Slice -> output. every intermediate value is only read by kernels that support
+// PackedStringTensor, so they are all planned in that form.
+static ONNX_NAMESPACE::ModelProto CreateStringSelectionModel() {
+  std::unordered_map<std::string, int> domain_to_version{{onnxruntime::kOnnxDomain, 9}};
+  Model model("StringSelection", false, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  auto& graph = model.MainGraph();
+
+  TypeProto string_tensor;
+  string_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_STRING);
+  TypeProto int64_tensor;
+  int64_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+
+  auto& data = graph.GetOrCreateNodeArg("data", &string_tensor);
+  auto& indices = graph.GetOrCreateNodeArg("indices", &int64_tensor);
+  auto& copied = graph.GetOrCreateNodeArg("copied", &string_tensor);
+  auto& gathered = graph.GetOrCreateNodeArg("gathered", &string_tensor);
+  auto& sliced = graph.GetOrCreateNodeArg("sliced", &string_tensor);
+
+  graph.AddNode("identity", "Identity", "Identity", {&data}, {&copied});
+  graph.AddNode("gather", "Gather", "Gather", {&copied, &indices}, {&gathered});
+  auto& slice = graph.AddNode("slice", "Slice", "Slice", {&gathered}, {&sliced});
+  slice.AddAttribute("starts", std::vector<int64_t>{1});
+  slice.AddAttribute("ends", std::vector<int64_t>{3});
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  return model.ToProto();
+}
+
+TEST(InferenceSessionTests, PackedStringTensors) {
+  auto model_proto = CreateStringSelectionModel();
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.PackedStringTensors";
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+
+  std::stringstream s1;
+  model_proto.SerializeToOstream(&s1);
+  ASSERT_TRUE(session_object.Load(s1).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  const std::vector<std::string> data{"a", "bb", "ccc", "dddd", "eeeee"};
+  const std::vector<std::string> expected{"dddd", "bb"};
+
+  auto packed_type = DataTypeImpl::GetType<PackedStringTensor>();
+  auto packed_data = std::make_unique<PackedStringTensor>();
+  packed_data->Assign(TensorShape({5}), data.data());
+  const PackedStringTensor* p_packed_data = packed_data.get();
+  MLValue packed_data_mlvalue;
+  packed_data_mlvalue.Init(packed_data.release(), packed_type, packed_type->GetDeleteFunc());
+
+  auto string_tensor = std::make_unique<Tensor>(DataTypeImpl::GetType<std::string>(), TensorShape({5}),
+                                                TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault));
+  std::copy(data.cbegin(), data.cend(), string_tensor->MutableData<std::string>());
+  MLValue tensor_data_mlvalue;
+  tensor_data_mlvalue.Init(string_tensor.release(), DataTypeImpl::GetType<Tensor>(),
+                           DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+
+  MLValue indices_mlvalue;
+  CreateMLValue<int64_t>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {4}, {4, 3, 1, 0},
+                         &indices_mlvalue);
+
+  for (bool packed_feed : {true, false}) {
+    NameMLValMap feeds{{"data", packed_feed ? packed_data_mlvalue : tensor_data_mlvalue},
+                       {"indices", indices_mlvalue}};
+
+    // string tensor output
+    RunOptions run_options;
+    std::vector<MLValue> fetches;
+    ASSERT_TRUE(session_object.Run(run_options, feeds, {"sliced"}, &fetches).IsOK());
+    ASSERT_TRUE(fetches[0].IsTensor());
+    const auto& output_tensor = fetches[0].Get<Tensor>();
+    EXPECT_EQ(output_tensor.Shape(), TensorShape({2}));
+    EXPECT_EQ(std::vector<std::string>(output_tensor.Data<std::string>(), output_tensor.Data<std::string>() + 2),
+              expected);
+
+    // packed output
+    run_options.packed_string_tensors = true;
+    fetches.clear();
+    ASSERT_TRUE(session_object.Run(run_options, feeds, {"sliced"}, &fetches).IsOK());
+    ASSERT_EQ(fetches[0].Type(), packed_type);
+    const auto& output = fetches[0].Get<PackedStringTensor>();
+    EXPECT_EQ(output.Shape(), TensorShape({2}));
+    EXPECT_EQ(output.ElementString(0), expected[0]);
+    EXPECT_EQ(output.ElementString(1), expected[1]);
+    if (packed_feed) {
+      // no string was copied from the feed to the output
+      EXPECT_EQ(output.ElementData(0), p_packed_data->ElementData(3));
+      EXPECT_EQ(output.ElementData(1), p_packed_data->ElementData(1));
+    }
+  }
+}
+
 TEST(ExecutionProviderTest, FunctionTest) {
   onnxruntime::Model model("graph_1");
   auto& graph = model.MainGraph();
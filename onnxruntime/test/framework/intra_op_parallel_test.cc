@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "core/framework/intra_op_parallel.h"
+
+namespace onnxruntime {
+namespace test {
+
+static std::unique_ptr<IntraOpThreadPool> CreateThreadPool(int num_threads) {
+#ifdef USE_EIGEN_THREADPOOL
+  return std::make_unique<IntraOpThreadPool>(num_threads);
+#else
+  return std::make_unique<IntraOpThreadPool>(static_cast<size_t>(num_threads));
+#endif
+}
+
+TEST(IntraOpParallelTest, ExecuteLambdaInParallelSingleTask) {
+  auto pool = CreateThreadPool(2);
+  const auto& logger = logging::LoggingManager::DefaultLogger();
+
+  // a single chunk runs on the calling thread
+  std::thread::id caller = std::this_thread::get_id();
+  std::thread::id runner;
+  int calls = 0;
+  auto lambda = [&](int i) {
+    EXPECT_EQ(i, 0);
+    runner = std::this_thread::get_id();
+    ++calls;
+  };
+
+  ExecuteLambdaInParallel("single task", lambda, 3, 4, *pool, logger);
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(runner, caller);
+
+  // and nothing runs when there is no work
+  ExecuteLambdaInParallel("no task", [&](int) { ++calls; }, 0, 1, *pool, logger);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(IntraOpParallelTest, ExecuteLambdaInParallelRunsEveryChunkOnce) {
+  const auto& logger = logging::LoggingManager::DefaultLogger();
+  const int max = 1000;
+  const int step = 3;
+
+  // more chunks than threads, including a pool with a single thread
+  for (int num_threads : {1, 4}) {
+    auto pool = CreateThreadPool(num_threads);
+    std::vector<std::atomic<int>> visits(max);
+    for (auto& v : visits)
+      v = 0;
+
+    ExecuteLambdaInParallel("every chunk", [&](int i) { ++visits[i]; }, max, step, *pool, logger);
+
+    for (int i = 0; i < max; ++i) {
+      EXPECT_EQ(visits[i].load(), i % step == 0 ? 1 : 0) << "i=" << i << " num_threads=" << num_threads;
+    }
+  }
+}
+
+TEST(IntraOpParallelTest, ExecuteLambdaInParallelPropagatesException) {
+  auto pool = CreateThreadPool(2);
+  const auto& logger = logging::LoggingManager::DefaultLogger();
+  const int num_tasks = 16;
+
+  std::atomic<int> completed{0};
+  auto lambda = [&](int i) {
+    if (i == 5)
+      ORT_THROW("task ", i, " failed");
+    ++completed;
+  };
+
+  EXPECT_THROW(ExecuteLambdaInParallel("throwing", lambda, num_tasks, 1, *pool, logger), OnnxRuntimeException);
+
+  // the other chunks still ran, and nothing touches the lambda's state once the call returned
+  EXPECT_EQ(completed.load(), num_tasks - 1);
+}
+
+TEST(IntraOpParallelTest, ExecuteLambdaInParallelNestedOnSamePool) {
+  // fewer threads than outer chunks, so every pool thread can end up blocked in an outer chunk while the inner
+  // calls still need to make progress.
+  auto pool = CreateThreadPool(2);
+  const auto& logger = logging::LoggingManager::DefaultLogger();
+  const int outer_tasks = 8;
+  const int inner_tasks = 16;
+
+  std::atomic<int> total{0};
+  ExecuteLambdaInParallel(
+      "outer",
+      [&](int) {
+        ExecuteLambdaInParallel("inner", [&](int) { ++total; }, inner_tasks, 1, *pool, logger);
+      },
+      outer_tasks, 1, *pool, logger);
+
+  EXPECT_EQ(total.load(), outer_tasks * inner_tasks);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/packed_string_tensor.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(PackedStringTensorTest, AssignFromBuffer) {
+  const std::string buffer = "abcdkmp";
+  const std::vector<size_t> offsets{0, 3, 3};
+  PackedStringTensor t;
+  ASSERT_TRUE(t.Assign(TensorShape({3}), buffer.data(), buffer.size(), offsets.data()).IsOK());
+  EXPECT_EQ(t.Shape(), TensorShape({3}));
+  ASSERT_EQ(t.Size(), size_t(3));
+  EXPECT_EQ(t.ElementString(0), "abc");
+  EXPECT_EQ(t.ElementString(1), "");
+  EXPECT_EQ(t.ElementString(2), "dkmp");
+  EXPECT_EQ(t.DataLength(), buffer.size());
+
+  std::string s(t.DataLength(), '\0');
+  std::vector<size_t> result_offsets(t.Size());
+  t.CopyTo(&s[0], result_offsets.data());
+  EXPECT_EQ(s, buffer);
+  EXPECT_EQ(result_offsets, offsets);
+
+  // offsets must be increasing and within the buffer, the value is left unchanged otherwise
+  const std::vector<size_t> bad_offsets{0, 4, 3};
+  EXPECT_FALSE(t.Assign(TensorShape({3}), buffer.data(), buffer.size(), bad_offsets.data()).IsOK());
+  EXPECT_FALSE(t.Assign(TensorShape({3}), buffer.data(), 2, offsets.data()).IsOK());
+  EXPECT_EQ(t.ElementString(2), "dkmp");
+}
+
+TEST(PackedStringTensorTest, AssignFromStrings) {
+  const std::vector<std::string> strings{"this", "is", "a", "test"};
+  const std::vector<int64_t> indices{3, 0, 0};
+  PackedStringTensor t;
+  t.Assign(TensorShape({3}), strings.data(), indices.data());
+  std::vector<std::string> result(t.Size());
+  t.CopyTo(result.data());
+  EXPECT_EQ(result, std::vector<std::string>({"test", "this", "this"}));
+  EXPECT_EQ(t.DataLength(), size_t(12));
+}
+
+TEST(PackedStringTensorTest, Select) {
+  const std::vector<std::string> strings{"this", "is", "a", "test"};
+  PackedStringTensor source;
+  source.Assign(TensorShape({2, 2}), strings.data());
+
+  // the selected elements point into the buffer of the source
+  const std::vector<int64_t> indices{3, 1};
+  PackedStringTensor t;
+  t.Select(source, TensorShape({2}), indices.data());
+  ASSERT_EQ(t.Size(), size_t(2));
+  EXPECT_EQ(t.ElementData(0), source.ElementData(3));
+  EXPECT_EQ(t.ElementData(1), source.ElementData(1));
+
+  // elements that are not consecutive in the buffer are copied one by one
+  std::string s(t.DataLength(), '\0');
+  std::vector<size_t> offsets(t.Size());
+  t.CopyTo(&s[0], offsets.data());
+  EXPECT_EQ(s, "testis");
+  EXPECT_EQ(offsets, std::vector<size_t>({0, 4}));
+
+  // selecting from itself
+  const std::vector<int64_t> first{1};
+  t.Select(t, TensorShape({1}), first.data());
+  EXPECT_EQ(t.ElementString(0), "is");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
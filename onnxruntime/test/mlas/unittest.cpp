@@ -17,7 +17,9 @@ Abstract:
 #include <stdio.h>
 #include <memory.h>
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <vector>
 #include <mlas.h>
 
 #if defined(_WIN32)
@@ -1152,6 +1154,217 @@ ExecutePool3DTests(
     }
 }
 
+template<typename T>
+void
+TrialTranspose(
+    size_t M,
+    size_t N
+    )
+{
+    std::vector<T> Input(M * N);
+    std::vector<T> Output(M * N);
+
+    for (size_t i = 0; i < M * N; i++) {
+        Input[i] = T(i);
+    }
+
+    MlasTranspose(Input.data(), Output.data(), M, N);
+
+    for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+            if (Output[n * M + m] != Input[m * N + n]) {
+                printf("mismatch: transpose elementsize=%zd,M=%zd,N=%zd!!!\n", sizeof(T), M, N);
+                return;
+            }
+        }
+    }
+}
+
+void
+ExecuteTransposeTests(
+    void
+    )
+{
+    static const size_t ds[] = { 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 63, 64, 65, 127, 300 };
+
+    for (unsigned im = 0; im < _countof(ds); im++) {
+        for (unsigned in = 0; in < _countof(ds); in++) {
+            TrialTranspose<uint8_t>(ds[im], ds[in]);
+            TrialTranspose<uint16_t>(ds[im], ds[in]);
+            TrialTranspose<uint32_t>(ds[im], ds[in]);
+            TrialTranspose<uint64_t>(ds[im], ds[in]);
+            TrialTranspose<float>(ds[im], ds[in]);
+        }
+    }
+
+    TrialTranspose<float>(3, 1024 * 1024);
+    TrialTranspose<float>(1024 * 1024, 3);
+    TrialTranspose<float>(1021, 1027);
+    TrialTranspose<uint8_t>(2048, 2049);
+}
+
+bool
+CloseEnough(
+    float Actual,
+    float Expected,
+    float AbsoluteTolerance,
+    float RelativeTolerance
+    )
+{
+    if (std::isnan(Expected)) {
+        return std::isnan(Actual);
+    }
+
+    if (std::isinf(Expected)) {
+        return Actual == Expected;
+    }
+
+    float Difference = std::fabs(Actual - Expected);
+
+    return Difference <= AbsoluteTolerance || Difference <= std::fabs(Expected) * RelativeTolerance;
+}
+
+void
+TrialComputeElementwise(
+    const char* Name,
+    void (MLASCALL *ComputeRoutine)(const float*, float*, size_t),
+    double (*ReferenceRoutine)(double),
+    const std::vector<float>& Input,
+    size_t N,
+    float AbsoluteTolerance,
+    float RelativeTolerance
+    )
+{
+    std::vector<float> Output(Input.size(), -1.0f);
+
+    ComputeRoutine(Input.data(), Output.data(), N);
+
+    for (size_t i = 0; i < N; i++) {
+        float Expected = float(ReferenceRoutine(double(Input[i])));
+        if (!CloseEnough(Output[i], Expected, AbsoluteTolerance, RelativeTolerance)) {
+            printf("mismatch: %s(%.9g)=%.9g, expected %.9g!!!\n", Name, Input[i], Output[i], Expected);
+            return;
+        }
+    }
+
+    for (size_t i = N; i < Input.size(); i++) {
+        if (Output[i] != -1.0f) {
+            printf("mismatch: %s wrote past N=%zd!!!\n", Name, N);
+            return;
+        }
+    }
+}
+
+void
+TrialComputeElementwise(
+    const char* Name,
+    void (MLASCALL *ComputeRoutine)(const float*, float*, size_t),
+    double (*ReferenceRoutine)(double),
+    const std::vector<float>& Input,
+    float AbsoluteTolerance,
+    float RelativeTolerance
+    )
+{
+    //
+    // Run the routine over short prefixes of the buffer to exercise the vector
+    // remainder handling, then over the whole buffer.
+    //
+
+    for (size_t N = 0; N < 40; N++) {
+        TrialComputeElementwise(Name, ComputeRoutine, ReferenceRoutine, Input, N, AbsoluteTolerance, RelativeTolerance);
+    }
+
+    TrialComputeElementwise(Name, ComputeRoutine, ReferenceRoutine, Input, Input.size(), AbsoluteTolerance, RelativeTolerance);
+}
+
+void
+TrialSoftmax(
+    size_t N,
+    size_t D,
+    bool LogSoftmax
+    )
+{
+    std::vector<float> Input(N * D);
+    std::vector<float> Output(N * D);
+
+    for (size_t i = 0; i < N * D; i++) {
+        Input[i] = float(int(i * 7919 % 2003) - 1001) / 37.0f;
+    }
+
+    MlasComputeSoftmax(Input.data(), Output.data(), N, D, LogSoftmax);
+
+    for (size_t n = 0; n < N; n++) {
+
+        const float* x = Input.data() + n * D;
+
+        double Maximum = x[0];
+        for (size_t d = 1; d < D; d++) {
+            Maximum = (std::max)(Maximum, double(x[d]));
+        }
+
+        double Sum = 0.0;
+        for (size_t d = 0; d < D; d++) {
+            Sum += std::exp(double(x[d]) - Maximum);
+        }
+
+        for (size_t d = 0; d < D; d++) {
+            double Expected = LogSoftmax ? double(x[d]) - Maximum - std::log(Sum) :
+                std::exp(double(x[d]) - Maximum) / Sum;
+            if (!CloseEnough(Output[n * D + d], float(Expected), 1e-6f, 1e-5f)) {
+                printf("mismatch: softmax log=%d,N=%zd,D=%zd [%zd,%zd]=%.9g, expected %.9g!!!\n",
+                    int(LogSoftmax), N, D, n, d, Output[n * D + d], Expected);
+                return;
+            }
+        }
+    }
+}
+
+void
+ExecuteComputeTests(
+    void
+    )
+{
+    const float Infinity = std::numeric_limits<float>::infinity();
+    const float NaN = std::numeric_limits<float>::quiet_NaN();
+
+    std::vector<float> ExpInput;
+    for (float x = -110.0f; x <= 90.0f; x += 0.0137f) {
+        ExpInput.push_back(x);
+    }
+    ExpInput.insert(ExpInput.end(), { 0.0f, -0.0f, 1e-8f, -1e-8f, 88.7f, -87.3f, Infinity, -Infinity, NaN });
+
+    TrialComputeElementwise("exp", MlasComputeExp, std::exp, ExpInput, 0.0f, 1e-6f);
+
+    std::vector<float> LogInput;
+    for (float x = 1e-6f; x <= 1e6f; x *= 1.0013f) {
+        LogInput.push_back(x);
+    }
+    for (float x = 0.5f; x <= 2.0f; x += 0.00037f) {
+        LogInput.push_back(x);
+    }
+    LogInput.insert(LogInput.end(), { 1.0f, 1e-40f, 1.17549435e-38f, 3.4e38f, 0.0f, -0.0f, -1.0f, Infinity, -Infinity, NaN });
+
+    TrialComputeElementwise("log", MlasComputeLog, std::log, LogInput, 1e-7f, 1e-6f);
+
+    std::vector<float> ErfInput;
+    for (float x = -5.0f; x <= 5.0f; x += 0.00113f) {
+        ErfInput.push_back(x);
+    }
+    ErfInput.insert(ErfInput.end(), { 0.0f, -0.0f, 0.921875f, -0.921875f, 3.925f, 1e-20f, 10.0f, -10.0f, Infinity, -Infinity, NaN });
+
+    TrialComputeElementwise("erf", MlasComputeErf, std::erf, ErfInput, 2e-7f, 1e-6f);
+
+    static const size_t ns[] = { 1, 2, 3, 17, 160 };
+    static const size_t ds[] = { 1, 2, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000, 5003 };
+
+    for (unsigned in = 0; in < _countof(ns); in++) {
+        for (unsigned id = 0; id < _countof(ds); id++) {
+            TrialSoftmax(ns[in], ds[id], false);
+            TrialSoftmax(ns[in], ds[id], true);
+        }
+    }
+}
+
 #if 0
 #if defined(_WIN32)
 
@@ -1242,6 +1455,8 @@ main(
     ExecuteConvTests();
 //    ExecutePool2DTests();
 //    ExecutePool3DTests();
+    ExecuteTransposeTests();
+    ExecuteComputeTests();
 //    EvaluateThreadingPerformance();
 
     return 0;
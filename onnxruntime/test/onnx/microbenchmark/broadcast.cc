@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/framework/allocator.h>
+#include <core/framework/tensor.h>
+#include <core/providers/cpu/math/element_wise_ops.h>
+
+using namespace onnxruntime;
+
+// Adds input1 to input0 the same way as the Add kernel does.
+static void RunBroadcastAdd(benchmark::State& state, const std::vector<int64_t>& dims0,
+                            const std::vector<int64_t>& dims1) {
+  AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+  Tensor input0(DataTypeImpl::GetType<float>(), TensorShape(dims0), cpu_allocator);
+  Tensor input1(DataTypeImpl::GetType<float>(), TensorShape(dims1), cpu_allocator);
+  EigenMap<float>(input0).setConstant(1.0f);
+  EigenMap<float>(input1).setConstant(2.0f);
+
+  std::unique_ptr<Tensor> output;
+
+  for (auto _ : state) {
+    TBroadcaster<float, float> bc(input0, input1);
+    if (!output)
+      output = std::make_unique<Tensor>(DataTypeImpl::GetType<float>(), bc.GetOutputShape(), cpu_allocator);
+
+    ParallelBroadcastLoop<float>(
+        bc, *output,
+        [](EigenVectorMap<float> output, float input0, ConstEigenVectorMap<float> input1) { output = input0 + input1.array(); },
+        [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, float input1) { output = input0.array() + input1; },
+        [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, ConstEigenVectorMap<float> input1) { output = input0 + input1; });
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * output->Shape().Size());
+}
+
+// [N,C,H,W] + [C,1,1], e.g. a per-channel bias.
+static void BM_BroadcastAddPerChannel(benchmark::State& state) {
+  const int64_t C = state.range(1);
+  const int64_t HW = state.range(2);
+  RunBroadcastAdd(state, {state.range(0), C, HW, HW}, {C, 1, 1});
+}
+BENCHMARK(BM_BroadcastAddPerChannel)
+    ->Args({1, 64, 56})
+    ->Args({1, 256, 14})
+    ->Args({8, 32, 64})
+    ->Args({1, 1024, 7})
+    ->UseRealTime();
+
+// [N,C,H,W] + [N,C,H,W]
+static void BM_BroadcastAddSameShape(benchmark::State& state) {
+  const std::vector<int64_t> dims{state.range(0), state.range(1), state.range(2), state.range(2)};
+  RunBroadcastAdd(state, dims, dims);
+}
+BENCHMARK(BM_BroadcastAddSameShape)
+    ->Args({1, 64, 56})
+    ->Args({8, 32, 64})
+    ->UseRealTime();
+
+// [N,C,H,W] + scalar
+static void BM_BroadcastAddScalar(benchmark::State& state) {
+  RunBroadcastAdd(state, {state.range(0), state.range(1), state.range(2), state.range(2)}, {});
+}
+BENCHMARK(BM_BroadcastAddScalar)
+    ->Args({1, 64, 56})
+    ->Args({8, 32, 64})
+    ->UseRealTime();
+
+// [N,C,H,W] + [W], one short span per row.
+static void BM_BroadcastAddPerRow(benchmark::State& state) {
+  const int64_t W = state.range(2);
+  RunBroadcastAdd(state, {state.range(0), state.range(1), W, W}, {W});
+}
+BENCHMARK(BM_BroadcastAddPerRow)
+    ->Args({1, 64, 56})
+    ->Args({8, 32, 64})
+    ->UseRealTime();
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <random>
+#include <benchmark/benchmark.h>
+#include <contrib_ops/cpu/non_max_suppression.h>
+
+using namespace onnxruntime::contrib;
+
+// Selects up to range(1) of range(0) random boxes, which is in the range of the candidates SSD (about 2k to 9k)
+// and YOLO (about 10k to 20k) detectors produce.
+static void BM_NonMaxSuppression(benchmark::State& state) {
+  const int64_t num_boxes = state.range(0);
+  const int64_t max_output_size = state.range(1);
+
+  // boxes in a unit image, mostly small with some large ones so that many boxes overlap
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> position(0.f, 1.f);
+  std::exponential_distribution<float> size(20.f);
+  std::vector<float> boxes(num_boxes * 4);
+  std::vector<float> scores(num_boxes);
+  for (int64_t i = 0; i < num_boxes; ++i) {
+    const float y = position(rng);
+    const float x = position(rng);
+    boxes[4 * i + 0] = y;
+    boxes[4 * i + 1] = x;
+    boxes[4 * i + 2] = y + size(rng);
+    boxes[4 * i + 3] = x + size(rng);
+    scores[i] = position(rng);
+  }
+
+  std::vector<int32_t> selected_indices(max_output_size);
+  for (auto _ : state) {
+    auto num_selected = SelectBoxesWithNonMaxSuppression(boxes.data(), scores.data(), num_boxes, max_output_size,
+                                                         0.5f, 0.01f, selected_indices.data());
+    benchmark::DoNotOptimize(num_selected);
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * num_boxes);
+}
+
+static void NonMaxSuppressionShapes(benchmark::internal::Benchmark* b) {
+  for (int64_t num_boxes : {1917, 8732, 10647, 22743})
+    for (int64_t max_output_size : {100, 1000})
+      b->Args({num_boxes, max_output_size});
+}
+BENCHMARK(BM_NonMaxSuppression)->Apply(NonMaxSuppressionShapes);
@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/framework/allocator.h>
+#include <core/framework/tensor.h>
+#include <core/providers/cpu/tensor/transpose.h>
+
+using namespace onnxruntime;
+
+// Transposes a tensor of shape {range(0), range(1), range(2), range(3)} with the given permutation.
+static void RunTranspose(benchmark::State& state, const std::vector<int64_t>& perm) {
+  const std::vector<int64_t> dims{state.range(0), state.range(1), state.range(2), state.range(3)};
+  std::vector<int64_t> output_dims(dims.size());
+  for (size_t i = 0; i < perm.size(); ++i)
+    output_dims[i] = dims[perm[i]];
+
+  AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+  Tensor input(DataTypeImpl::GetType<float>(), TensorShape(dims), cpu_allocator);
+  Tensor output(DataTypeImpl::GetType<float>(), TensorShape(output_dims), cpu_allocator);
+
+  float* input_data = input.MutableData<float>();
+  const int64_t size = input.Shape().Size();
+  for (int64_t i = 0; i < size; ++i)
+    input_data[i] = static_cast<float>(i);
+
+  for (auto _ : state) {
+    auto status = TransposeBase::DoTranspose(perm, input, output);
+    if (!status.IsOK()) {
+      state.SkipWithError(status.ErrorMessage().c_str());
+      break;
+    }
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * size * sizeof(float));
+}
+
+static void TransposeShapes(benchmark::internal::Benchmark* b) {
+  b->Args({1, 3, 224, 224});
+  b->Args({1, 64, 56, 56});
+  b->Args({1, 256, 14, 14});
+  b->Args({8, 32, 64, 64});
+  b->Args({1, 1024, 7, 7});
+}
+
+static void BM_TransposeNCHWToNHWC(benchmark::State& state) {
+  RunTranspose(state, {0, 2, 3, 1});
+}
+BENCHMARK(BM_TransposeNCHWToNHWC)->Apply(TransposeShapes)->UseRealTime();
+
+static void BM_TransposeNHWCToNCHW(benchmark::State& state) {
+  RunTranspose(state, {0, 3, 1, 2});
+}
+BENCHMARK(BM_TransposeNHWCToNCHW)->Apply(TransposeShapes)->UseRealTime();
+
+static void BM_Transpose2D(benchmark::State& state) {
+  RunTranspose(state, {0, 1, 3, 2});
+}
+BENCHMARK(BM_Transpose2D)
+    ->Args({1, 1, 64, 64})
+    ->Args({1, 1, 512, 512})
+    ->Args({1, 1, 1000, 1024})
+    ->Args({1, 1, 4096, 4096})
+    ->Args({1, 1, 3, 100000})
+    ->UseRealTime();
+
+// Permutation that keeps a contiguous suffix and goes through the block copy path.
+static void BM_TransposeBlocks(benchmark::State& state) {
+  RunTranspose(state, {1, 0, 2, 3});
+}
+BENCHMARK(BM_TransposeBlocks)->Apply(TransposeShapes)->UseRealTime();
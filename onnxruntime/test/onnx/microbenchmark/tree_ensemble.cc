@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <random>
+#include <benchmark/benchmark.h>
+#include <core/providers/cpu/ml/tree_ensemble_common.h>
+
+using namespace onnxruntime::ml;
+
+// Builds an ensemble of complete binary trees of the given depth over num_features features,
+// with one weight per leaf spread over num_targets targets.
+static void BuildRandomEnsemble(TreeEnsembleCompiled& trees, int64_t num_trees, int64_t depth,
+                                int64_t num_features, int64_t num_targets) {
+  std::vector<int64_t> treeids, nodeids, featureids, truenodeids, falsenodeids;
+  std::vector<float> values;
+  std::vector<NODE_MODE> modes;
+  std::vector<int64_t> target_treeids, target_nodeids, target_ids;
+  std::vector<float> target_weights;
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> threshold(-1.f, 1.f);
+  const int64_t num_branches = (int64_t(1) << depth) - 1;
+  const int64_t num_nodes = 2 * num_branches + 1;
+  for (int64_t t = 0; t < num_trees; ++t) {
+    for (int64_t n = 0; n < num_nodes; ++n) {
+      treeids.push_back(t);
+      nodeids.push_back(n);
+      if (n < num_branches) {
+        featureids.push_back(rng() % num_features);
+        values.push_back(threshold(rng));
+        modes.push_back(NODE_MODE::BRANCH_LEQ);
+        truenodeids.push_back(2 * n + 1);
+        falsenodeids.push_back(2 * n + 2);
+      } else {
+        featureids.push_back(0);
+        values.push_back(0.f);
+        modes.push_back(NODE_MODE::LEAF);
+        truenodeids.push_back(0);
+        falsenodeids.push_back(0);
+        target_treeids.push_back(t);
+        target_nodeids.push_back(n);
+        target_ids.push_back(rng() % num_targets);
+        target_weights.push_back(threshold(rng));
+      }
+    }
+  }
+
+  trees.Initialize(num_targets, treeids, nodeids, featureids, values, modes, truenodeids, falsenodeids, {},
+                   target_treeids, target_nodeids, target_ids, target_weights);
+}
+
+// Scores range(0) rows with range(1) trees of depth 6 over 100 features on range(2) threads.
+static void BM_TreeEnsembleScore(benchmark::State& state) {
+  const int64_t N = state.range(0);
+  const int64_t num_features = 100;
+  const int64_t num_targets = 3;
+
+#ifdef USE_OPENMP
+  omp_set_num_threads(static_cast<int>(state.range(2)));
+#endif
+
+  TreeEnsembleCompiled trees;
+  BuildRandomEnsemble(trees, state.range(1), 6, num_features, num_targets);
+
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> feature(-1.f, 1.f);
+  std::vector<float> x(N * num_features);
+  for (auto& v : x) v = feature(rng);
+
+  std::vector<float> scores(N * trees.NumTargets());
+  std::vector<uint8_t> has_score(N * trees.NumTargets());
+  for (auto _ : state) {
+    std::fill(scores.begin(), scores.end(), 0.f);
+    std::fill(has_score.begin(), has_score.end(), uint8_t{0});
+    trees.ComputeScores(x.data(), N, num_features, scores.data(), has_score.data());
+    benchmark::DoNotOptimize(scores.data());
+  }
+
+  // reported as items per second, i.e. rows per second
+  state.SetItemsProcessed(int64_t(state.iterations()) * N);
+}
+
+static void TreeEnsembleShapes(benchmark::internal::Benchmark* b) {
+  for (int64_t rows : {1, 16, 1000, 100000})
+    for (int64_t trees : {100, 500})
+      for (int64_t threads : {1, 2, 4, 8})
+        b->Args({rows, trees, threads});
+}
+BENCHMARK(BM_TreeEnsembleScore)->Apply(TreeEnsembleShapes)->UseRealTime();
@@ -15,6 +15,7 @@
 #include "core/optimizer/conv_activation_fusion.h"
 #include "core/optimizer/matmul_add_fusion.h"
 #include "core/optimizer/gemm_activation_fusion.h"
+#include "core/optimizer/transpose_optimizer.h"
 #include "core/framework/data_types.h"
 #include "core/framework/ml_value.h"
 #include "core/util/math.h"
@@ -338,5 +339,160 @@ TEST(GraphTransformationTests, FuseConvBnAddMulFloat16) {
   ASSERT_EQ(expected_values_prod, found);
 }
 
+static NodeArg& AddFloatArg(Graph& graph, const std::string& name, const std::vector<int64_t>& dims) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+  return graph.GetOrCreateNodeArg(name, &type);
+}
+
+static void AddFloatInitializer(Graph& graph, const std::string& name, const std::vector<int64_t>& dims,
+                                const std::vector<float>& values) {
+  TensorProto tensor;
+  tensor.set_name(name);
+  tensor.set_data_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    tensor.add_dims(dim);
+  }
+  for (auto value : values) {
+    tensor.add_float_data(value);
+  }
+  graph.AddInitializedTensor(tensor);
+}
+
+static Node& AddTranspose(Graph& graph, NodeArg& input, NodeArg& output, const std::vector<int64_t>& perm) {
+  std::vector<NodeArg*> inputs{&input};
+  std::vector<NodeArg*> outputs{&output};
+  auto& node = graph.AddNode(graph.GenerateNodeName("transpose"), "Transpose", "", inputs, outputs);
+  node.AddAttribute("perm", perm);
+  return node;
+}
+
+static Status ApplyTransposeOptimizer(Graph& graph) {
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<TransposeOptimizer>());
+  return graph_transformation_mgr.ApplyAll(graph);
+}
+
+TEST(GraphTransformationTests, TransposeOptimizerSinksThroughUnaryOp) {
+  Model model("TransposeOptimizer");
+  Graph& graph = model.MainGraph();
+
+  auto& x = AddFloatArg(graph, "X", {1, 2, 3, 4});
+  auto& nhwc = graph.GetOrCreateNodeArg("nhwc", nullptr);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+
+  AddTranspose(graph, x, nhwc, {0, 2, 3, 1});
+  std::vector<NodeArg*> relu_inputs{&nhwc};
+  std::vector<NodeArg*> relu_outputs{&relu_out};
+  graph.AddNode("relu", "Relu", "", relu_inputs, relu_outputs);
+  AddTranspose(graph, relu_out, y, {0, 3, 1, 2});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  ASSERT_TRUE(ApplyTransposeOptimizer(graph).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Transpose"], 0);
+  ASSERT_EQ(op_to_count["Relu"], 1);
+  ASSERT_EQ(graph.GetOutputs().size(), 1u);
+  ASSERT_EQ(graph.GetOutputs()[0]->Name(), "Y");
+}
+
+TEST(GraphTransformationTests, TransposeOptimizerFoldsBroadcastInitializer) {
+  Model model("TransposeOptimizer");
+  Graph& graph = model.MainGraph();
+
+  auto& x = AddFloatArg(graph, "X", {1, 2, 3, 4});
+  AddFloatInitializer(graph, "bias", {2}, {1.f, 2.f});
+  auto& bias = *graph.GetNodeArg("bias");
+  auto& nhwc = graph.GetOrCreateNodeArg("nhwc", nullptr);
+  auto& add_out = graph.GetOrCreateNodeArg("add_out", nullptr);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+
+  AddTranspose(graph, x, nhwc, {0, 2, 3, 1});
+  std::vector<NodeArg*> add_inputs{&nhwc, &bias};
+  std::vector<NodeArg*> add_outputs{&add_out};
+  auto& add_node = graph.AddNode("add", "Add", "", add_inputs, add_outputs);
+  AddTranspose(graph, add_out, relu_out, {0, 3, 1, 2});
+  std::vector<NodeArg*> relu_inputs{&relu_out};
+  std::vector<NodeArg*> relu_outputs{&y};
+  graph.AddNode("relu", "Relu", "", relu_inputs, relu_outputs);
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  ASSERT_TRUE(ApplyTransposeOptimizer(graph).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Transpose"], 0);
+  ASSERT_EQ(add_node.InputDefs()[0]->Name(), "X");
+
+  // the per-channel bias now broadcasts over NCHW
+  const TensorProto* new_bias = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor(add_node.InputDefs()[1]->Name(), new_bias));
+  std::vector<int64_t> new_bias_dims(new_bias->dims().begin(), new_bias->dims().end());
+  ASSERT_EQ(new_bias_dims, std::vector<int64_t>({1, 2, 1, 1}));
+}
+
+TEST(GraphTransformationTests, TransposeOptimizerSinksThroughConcat) {
+  Model model("TransposeOptimizer");
+  Graph& graph = model.MainGraph();
+
+  auto& x1 = AddFloatArg(graph, "X1", {1, 2, 3, 4});
+  auto& x2 = AddFloatArg(graph, "X2", {1, 5, 3, 4});
+  auto& nhwc1 = graph.GetOrCreateNodeArg("nhwc1", nullptr);
+  auto& nhwc2 = graph.GetOrCreateNodeArg("nhwc2", nullptr);
+  auto& concat_out = graph.GetOrCreateNodeArg("concat_out", nullptr);
+  auto& nchw = graph.GetOrCreateNodeArg("nchw", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+
+  AddTranspose(graph, x1, nhwc1, {0, 2, 3, 1});
+  AddTranspose(graph, x2, nhwc2, {0, 2, 3, 1});
+  std::vector<NodeArg*> concat_inputs{&nhwc1, &nhwc2};
+  std::vector<NodeArg*> concat_outputs{&concat_out};
+  auto& concat_node = graph.AddNode("concat", "Concat", "", concat_inputs, concat_outputs);
+  concat_node.AddAttribute("axis", static_cast<int64_t>(-1));
+  AddTranspose(graph, concat_out, nchw, {0, 3, 1, 2});
+  std::vector<NodeArg*> relu_inputs{&nchw};
+  std::vector<NodeArg*> relu_outputs{&y};
+  graph.AddNode("relu", "Relu", "", relu_inputs, relu_outputs);
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  ASSERT_TRUE(ApplyTransposeOptimizer(graph).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Transpose"], 0);
+  ASSERT_EQ(concat_node.GetAttributes().at("axis").i(), 1);
+}
+
+TEST(GraphTransformationTests, TransposeOptimizerFoldsTransposedInitializer) {
+  Model model("TransposeOptimizer");
+  Graph& graph = model.MainGraph();
+
+  auto& x = AddFloatArg(graph, "X", {2, 3});
+  AddFloatInitializer(graph, "W", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  auto& w = *graph.GetNodeArg("W");
+  auto& w_t = graph.GetOrCreateNodeArg("W_t", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+
+  AddTranspose(graph, w, w_t, {1, 0});
+  std::vector<NodeArg*> matmul_inputs{&x, &w_t};
+  std::vector<NodeArg*> matmul_outputs{&y};
+  graph.AddNode("matmul", "MatMul", "", matmul_inputs, matmul_outputs);
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  ASSERT_TRUE(ApplyTransposeOptimizer(graph).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Transpose"], 0);
+
+  const TensorProto* folded = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("W_t", folded));
+  std::vector<float> folded_values(folded->float_data().begin(), folded->float_data().end());
+  ASSERT_EQ(folded_values, std::vector<float>({1.f, 4.f, 2.f, 5.f, 3.f, 6.f}));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -644,6 +644,42 @@ TEST(Scan8, MixedSequenceLens) {
              iteration_count_out, output_0, output_1, output_2, output_3);
 }
 
+// more batch entries than the other tests so that entries after the first one are run concurrently
+TEST(Scan8, MixedSequenceLensFourInBatch) {
+  const int64_t batch_size = 4;
+  const int64_t max_sequence_len = 3;
+  const int64_t input_size = 2;
+
+  std::vector<int64_t> sequence_lens{3, 1, 2, 3};
+
+  std::vector<float> iteration_count_in{0.f, 10.f, 20.f, 30.f};
+
+  // batch_size, max_sequence_len, input_size
+  std::vector<float> input_0{1.f, 2.f, 3.f, 4.f, 5.f, 6.f,
+                             7.f, 8.f, 900.f, 900.f, 900.f, 900.f,  // <- last two entries should be ignored
+                             9.f, 10.f, 11.f, 12.f, 900.f, 900.f,   // <- last entry should be ignored
+                             13.f, 14.f, 15.f, 16.f, 17.f, 18.f};
+
+  std::vector<float> input_1{-1.f, -2.f, -3.f, -4.f, -5.f, -6.f,
+                             -7.f, -8.f, -900.f, -900.f, -900.f, -900.f,
+                             -9.f, -10.f, -11.f, -12.f, -900.f, -900.f,
+                             -13.f, -14.f, -15.f, -16.f, -17.f, -18.f};
+
+  // iteration_count_in + 1 for each item in the sequence of that batch entry
+  std::vector<float> iteration_count_out{3.f, 11.f, 22.f, 33.f};
+
+  // batch_size, max_sequence_len, 1
+  std::vector<float> output_0{1.f, 3.f, 5.f, 7.f, 0.f, 0.f, 9.f, 11.f, 0.f, 13.f, 15.f, 17.f};
+  std::vector<float> output_1{2.f, 4.f, 6.f, 8.f, 0.f, 0.f, 10.f, 12.f, 0.f, 14.f, 16.f, 18.f};
+  std::vector<float> output_2{-1.f, -3.f, -5.f, -7.f, 0.f, 0.f, -9.f, -11.f, 0.f, -13.f, -15.f, -17.f};
+  std::vector<float> output_3{-2.f, -4.f, -6.f, -8.f, 0.f, 0.f, -10.f, -12.f, 0.f, -14.f, -16.f, -18.f};
+
+  RunTest_v8("MixedSequenceLensFourInBatch", batch_size, max_sequence_len, input_size,
+             nullptr, &sequence_lens,
+             iteration_count_in, input_0, input_1,
+             iteration_count_out, output_0, output_1, output_2, output_3);
+}
+
 TEST(Scan8, MixedSequenceLensReverse) {
   const int64_t batch_size = 2;
   const int64_t max_sequence_len = 2;
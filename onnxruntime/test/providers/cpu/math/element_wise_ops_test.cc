@@ -155,6 +155,52 @@ TEST(MathOpTest, Add_Broadcast_2x1x1_3x4) {
   test.Run();
 }
 
+// The outputs below are large enough to be split into several blocks of spans by the broadcast loop.
+TEST(MathOpTest, Add_Broadcast_NCHW_C11_Large) {
+  OpTester test("Add");
+
+  const int64_t N = 2, C = 3, HW = 72 * 72;
+  std::vector<float> A(N * C * HW);
+  std::vector<float> B(C);
+  std::vector<float> expected(A.size());
+  for (size_t i = 0; i < A.size(); ++i)
+    A[i] = static_cast<float>(i % 1000);
+  for (int64_t c = 0; c < C; ++c)
+    B[c] = static_cast<float>(c + 1) * 10000.0f;
+  for (int64_t n = 0; n < N; ++n)
+    for (int64_t c = 0; c < C; ++c)
+      for (int64_t i = 0; i < HW; ++i) {
+        int64_t index = (n * C + c) * HW + i;
+        expected[index] = A[index] + B[c];
+      }
+
+  test.AddInput<float>("A", {N, C, 72, 72}, A);
+  test.AddInput<float>("B", {C, 1, 1}, B);
+  test.AddOutput<float>("C", {N, C, 72, 72}, expected);
+  test.Run();
+}
+
+TEST(MathOpTest, Mul_Broadcast_Rows_Large) {
+  OpTester test("Mul");
+
+  const int64_t rows = 1000, cols = 37;
+  std::vector<float> A(cols);
+  std::vector<float> B(rows * cols);
+  std::vector<float> expected(B.size());
+  for (int64_t j = 0; j < cols; ++j)
+    A[j] = static_cast<float>(j - 18);
+  for (int64_t i = 0; i < rows; ++i)
+    for (int64_t j = 0; j < cols; ++j) {
+      B[i * cols + j] = static_cast<float>(i % 7);
+      expected[i * cols + j] = A[j] * B[i * cols + j];
+    }
+
+  test.AddInput<float>("A", {cols}, A);
+  test.AddInput<float>("B", {rows, cols}, B);
+  test.AddOutput<float>("C", {rows, cols}, expected);
+  test.Run();
+}
+
 TEST(MathOpTest, Sub_int32) {
   OpTester test("Sub");
   test.AddInput<int32_t>("A", {3}, {1, 4, 3});
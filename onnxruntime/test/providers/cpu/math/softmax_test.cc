@@ -174,6 +174,32 @@ TEST(SoftmaxOperator, ThreeDimsNegativeAxis) {
   RunTest(x_vals_3dims, expected_vals, three_dimensions, /*axis*/ -1);
 }
 
+// Rows long enough to use the vector kernels, enough of them to be split across threads.
+TEST(SoftmaxOperator, LargeRows) {
+  const int64_t N = 64;
+  const int64_t D = 1003;
+
+  std::vector<float> x_vals(N * D);
+  std::vector<float> expected_vals(N * D);
+  for (int64_t i = 0; i < N * D; ++i) {
+    x_vals[i] = static_cast<float>((i * 7919) % 2003 - 1001) / 97.0f;
+  }
+
+  for (int64_t n = 0; n < N; ++n) {
+    const float* x = x_vals.data() + n * D;
+    const double max_value = *std::max_element(x, x + D);
+    double sum = 0.0;
+    for (int64_t d = 0; d < D; ++d) {
+      sum += std::exp(x[d] - max_value);
+    }
+    for (int64_t d = 0; d < D; ++d) {
+      expected_vals[n * D + d] = static_cast<float>(std::exp(x[d] - max_value) / sum);
+    }
+  }
+
+  RunTest(x_vals, expected_vals, {N, D});
+}
+
 TEST(SoftmaxOperator, InvalidAxis) {
   std::vector<float> x_vals = {-1.0f, 0.0f, 1.0f};
   std::vector<float> expected_vals = {0.0f, 0.0f, 0.0f};
@@ -193,19 +219,19 @@ TEST(SoftmaxOperator, TestInputTooLarge) {
   // N > INT32_MAX
   int64_t N = int64_t(INT32_MAX) + 1;
   int64_t D = 1;
-  auto status = SoftmaxCPU(N, D, ignored, ignored, ignored, ignored, true, ignored);
+  auto status = SoftmaxCPU(N, D, ignored, ignored, true);
   EXPECT_EQ(status.Code(), common::INVALID_ARGUMENT);
 
   // D > INT32_MAX
   N = 1;
   D = int64_t(INT32_MAX) + 1;
-  status = SoftmaxCPU(N, D, ignored, ignored, ignored, ignored, true, ignored);
+  status = SoftmaxCPU(N, D, ignored, ignored, true);
   EXPECT_EQ(status.Code(), common::INVALID_ARGUMENT);
 
   // N * D > INT32_MAX
   N = int64_t(INT32_MAX) / 2;
   D = 3;
-  status = SoftmaxCPU(N, D, ignored, ignored, ignored, ignored, true, ignored);
+  status = SoftmaxCPU(N, D, ignored, ignored, true);
   EXPECT_EQ(status.Code(), common::INVALID_ARGUMENT);
 
   /*
@@ -213,10 +239,7 @@ TEST(SoftmaxOperator, TestInputTooLarge) {
                               const int64_t D,
                               const float* Xdata,
                               float* Ydata,
-                              float* scale,
-                              const float* sum_multiplier,
-                              bool logarithmic,
-                              float* rowmax)
+                              bool logarithmic)
     {
         // the Math functions SoftmaxCPU uses only support int32_t as input, so enforce that
         if (N * D > INT32_MAX || N > INT32_MAX || D > INT32_MAX)
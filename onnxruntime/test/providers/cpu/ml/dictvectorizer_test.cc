@@ -42,5 +42,23 @@ TEST(MLOpTest, DictVectorizerInt64Input) {
   test.Run();
 }
 
+TEST(MLOpTest, DictVectorizerDuplicatedVocabulary) {
+  OpTester test("DictVectorizer", 1, onnxruntime::kMLDomain);
+
+  // every occurrence of a key in the vocabulary gets its value
+  test.AddAttribute("string_vocabulary", std::vector<std::string>{"a", "b", "a", "c"});
+
+  std::map<std::string, float> map;
+  map["a"] = 1.5f;
+  map["c"] = 2.f;
+  map["e"] = 3.f;
+
+  test.AddInput<std::string, float>("X", map);
+
+  std::vector<int64_t> dims{1, 4};
+  test.AddOutput<float>("Y", dims, {1.5f, 0.f, 1.5f, 2.f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -143,5 +143,119 @@ TEST(MLOpTest, LinearClassifierMulticlassInt64Input) {
   test.Run();
 }
 
+TEST(MLOpTest, LinearClassifierMulticlassSoftmax) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {-0.22562418f, 0.34188559f, 0.68346153f, -0.68051993f, -0.1975279f, 0.03748541f};
+  std::vector<int64_t> classes = {1, 2, 3};
+  std::vector<float> X = {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f};
+
+  // softmax of the scores of LinearClassifierMulticlass
+  std::vector<float> predictions = {0.00398469481f, 0.760002176f, 0.236013129f,
+                                    0.999904471f, 3.41111787e-17f, 9.55286942e-05f,
+                                    1.12517811e-06f, 0.999994909f, 3.96602064e-06f};
+  std::vector<float> intercepts = {-3.91601811f, 0.42575697f, 0.13731251f};
+  std::vector<int64_t> predicted_class = {2, 1, 2};
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+  test.AddAttribute("post_transform", std::string("SOFTMAX"));
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<int64_t>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 3}, predictions);
+  test.SetOutputAbsErr("Z", 0.00001f);
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierMulticlassSoftmaxZero) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {-0.22562418f, 0.34188559f, 0.68346153f, -0.68051993f, -0.1975279f, 0.03748541f};
+  std::vector<int64_t> classes = {1, 2, 3};
+  // the second point scores exactly 0 for the second class, which SOFTMAX_ZERO keeps at 0
+  std::vector<float> X = {1.f, 0.f, 0.f, 0.f, 23.f, 11.3f};
+
+  std::vector<float> predictions = {0.00541039775f, 0.674132212f, 0.320457391f,
+                                    0.017068068f, 0.f, 0.982931932f,
+                                    1.72236104e-06f, 0.999992207f, 6.07096724e-06f};
+  std::vector<float> intercepts = {-3.91601811f, 0.f, 0.13731251f};
+  std::vector<int64_t> predicted_class = {2, 3, 2};
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+  test.AddAttribute("post_transform", std::string("SOFTMAX_ZERO"));
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<int64_t>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 3}, predictions);
+  test.SetOutputAbsErr("Z", 0.00001f);
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierBinaryWithLabelsLogistic) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {0.00085401f, -0.00314063f};
+  std::vector<float> X = {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f};
+  std::vector<float> intercepts = {0.03930598f};
+  std::vector<int64_t> labels = {0, 1};
+  std::vector<int64_t> predicted_class = {1, 0, 1};
+  // the single score s is expanded to {1 - s, s} before the transform, which is not applied to binary scores
+  std::vector<float> scores = {0.959840000f, 0.0401599929f, 1.09631968f, -0.0963197052f, 0.976540923f, 0.0234590918f};
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", labels);
+  test.AddAttribute("post_transform", std::string("LOGISTIC"));
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<int64_t>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 2}, scores);
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierMulticlassInt32Input) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {-0.22562418f, 0.34188559f, 0.68346153f, -0.68051993f, -0.1975279f, 0.03748541f};
+  std::vector<int64_t> classes = {1, 2, 3};
+  std::vector<int32_t> X = {1, 0, 3, 44, 23, 11};
+
+  std::vector<float> predictions = {-4.14164229f, 1.1092185f, -0.06021539f, 10.45007543f, -27.46673545f, 1.19408663f, -5.3446321487426758f, 8.6596536636352539f, -3.9934897422790527f};
+  std::vector<float> intercepts = {-3.91601811f, 0.42575697f, 0.13731251f};
+  std::vector<int64_t> predicted_class = {2, 1, 2};
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<int32_t>("X", {3, 2}, X);
+  test.AddOutput<int64_t>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 3}, predictions);
+
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierFeatureCountMismatch) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {-0.22562418f, 0.34188559f, 0.68346153f, -0.68051993f, -0.1975279f, 0.03748541f};
+  std::vector<int64_t> classes = {1, 2, 3};
+  std::vector<float> intercepts = {-3.91601811f, 0.42575697f, 0.13731251f};
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+
+  // the coefficients have 2 features
+  test.AddInput<float>("X", {2, 3}, {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f});
+  test.AddOutput<int64_t>("Y", {2}, {0, 0});
+  test.AddOutput<float>("Z", {2, 3}, std::vector<float>(6, 0.f));
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Input feature count does not match the coefficients.");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
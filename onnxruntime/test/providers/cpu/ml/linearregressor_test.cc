@@ -66,5 +66,33 @@ TEST(MLOpTest, LinearRegressorMultiTarget) {
   test.Run();
 }
 
+TEST(MLOpTest, LinearRegressorUniTargetProbit) {
+  OpTester test("LinearRegressor", 1, onnxruntime::kMLDomain);
+  std::vector<float> coefficients = {0.1f, 0.05f};
+  std::vector<float> intercepts = {0.2f};
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("post_transform", std::string("PROBIT"));
+
+  // the scores are 0.3, 0.7 and 0.45
+  test.AddInput<float>("X", {3, 2}, {1.f, 0.f, 3.f, 4.f, 2.f, 1.f});
+  test.AddOutput<float>("Y", {3, 1}, {-0.524445433f, 0.524445433f, -0.12566203f});
+  test.Run();
+}
+
+TEST(MLOpTest, LinearRegressorFeatureCountMismatch) {
+  OpTester test("LinearRegressor", 1, onnxruntime::kMLDomain);
+  std::vector<float> coefficients = {1.00000000f, -2.49500920e-17f, -9.00000000f, -1.99600736e-16f};
+  std::vector<float> intercepts = {2.22044605e-16f, 41.0000000f};
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("targets", static_cast<int64_t>(2));
+
+  // the coefficients have 2 features
+  test.AddInput<float>("X", {2, 3}, {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f});
+  test.AddOutput<float>("Y", {2, 2}, {0.f, 0.f, 0.f, 0.f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Input feature count does not match the coefficients.");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
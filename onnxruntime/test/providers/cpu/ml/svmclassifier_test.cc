@@ -1,12 +1,64 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
 namespace onnxruntime {
 namespace test {
 
+// Pairwise scores and voted labels of a multiclass RBF SVC without probabilities, computed directly from
+// exp(-gamma * |x - b|^2) in double.
+static void ComputeRBFSVCReference(const std::vector<float>& X, int64_t N, int64_t feature_count,
+                                   const std::vector<float>& support_vectors,
+                                   const std::vector<int64_t>& vectors_per_class,
+                                   const std::vector<float>& coefficients, const std::vector<float>& rho,
+                                   float gamma, const std::vector<int64_t>& classes,
+                                   std::vector<int64_t>& labels, std::vector<float>& scores) {
+  const int64_t class_count = static_cast<int64_t>(classes.size());
+  const int64_t vector_count = static_cast<int64_t>(support_vectors.size()) / feature_count;
+  std::vector<int64_t> starting_vector(class_count, 0);
+  for (int64_t i = 1; i < class_count; i++) {
+    starting_vector[i] = starting_vector[i - 1] + vectors_per_class[i - 1];
+  }
+
+  std::vector<double> kernels(vector_count);
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t v = 0; v < vector_count; v++) {
+      double distance = 0;
+      for (int64_t f = 0; f < feature_count; f++) {
+        const double d = static_cast<double>(X[n * feature_count + f]) - support_vectors[v * feature_count + f];
+        distance += d * d;
+      }
+      kernels[v] = std::exp(-gamma * distance);
+    }
+
+    std::vector<int64_t> votes(class_count, 0);
+    int64_t evals = 0;
+    for (int64_t i = 0; i < class_count; i++) {
+      for (int64_t j = i + 1; j < class_count; j++) {
+        double sum = rho[evals];
+        for (int64_t m = 0; m < vectors_per_class[i]; m++) {
+          sum += coefficients[vector_count * (j - 1) + starting_vector[i] + m] * kernels[starting_vector[i] + m];
+        }
+        for (int64_t m = 0; m < vectors_per_class[j]; m++) {
+          sum += coefficients[vector_count * i + starting_vector[j] + m] * kernels[starting_vector[j] + m];
+        }
+        scores.push_back(static_cast<float>(sum));
+        votes[sum > 0 ? i : j]++;
+        evals++;
+      }
+    }
+
+    int64_t maxclass = 0;
+    for (int64_t k = 1; k < class_count; k++) {
+      if (votes[k] > votes[maxclass]) maxclass = k;
+    }
+    labels.push_back(classes[maxclass]);
+  }
+}
+
 TEST(MLOpTest, SVMClassifierMulticlassSVC) {
   OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
 
@@ -115,5 +167,118 @@ TEST(MLOpTest, SVMClassifierSVCProbabilities) {
   test.Run();
 }
 
+TEST(MLOpTest, SVMClassifierRBFLargeMagnitudeFeatures) {
+  OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+
+  // unscaled features where the inputs are within a fraction of a unit of a support vector. the kernel values
+  // must match exp(-gamma * |x - b|^2) even though |x|^2 and |b|^2 are about 1e9.
+  const float gamma = 0.5f;
+  std::vector<float> support_vectors = {10000.f, -20000.f, 15000.f,
+                                        10000.5f, -20000.f, 15000.f,
+                                        -30000.f, 5000.f, 25000.f,
+                                        -30000.f, 5001.f, 25000.f};
+  std::vector<int64_t> vectors_per_class = {2, 1, 1};
+  std::vector<int64_t> classes = {0, 1, 2};
+  std::vector<float> coefficients = {1.f, -0.5f, 0.75f, -1.f,
+                                     0.25f, 1.f, -0.5f, 0.5f};
+  std::vector<float> rho = {-0.3f, 0.2f, -0.1f};
+  std::vector<float> kernel_params = {gamma, 0.f, 3.f};  //gamma, coef0, degree
+
+  std::vector<float> X = {10000.25f, -19999.875f, 15000.125f,
+                          10000.5f, -20000.f, 15000.f,
+                          -30000.125f, 5000.5f, 24999.75f,
+                          -29999.5f, 5001.25f, 25000.f};
+  std::vector<int64_t> predictions;
+  std::vector<float> scores;
+  ComputeRBFSVCReference(X, 4, 3, support_vectors, vectors_per_class, coefficients, rho, gamma, classes,
+                         predictions, scores);
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("vectors_per_class", vectors_per_class);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<float>("X", {4, 3}, X);
+  test.AddOutput<int64_t>("Y", {4}, predictions);
+  test.AddOutput<float>("Z", {4, 3}, scores);
+
+  test.Run();
+}
+
+TEST(MLOpTest, SVMClassifierRBFMultipleKernelBlocks) {
+  OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+
+  // 4096 support vectors limit a kernel block to 256 rows, so 600 rows take three blocks
+  const int64_t feature_count = 4;
+  const int64_t vector_count = 4096;
+  const int64_t N = 600;
+  const float gamma = 0.1f;
+
+  std::vector<float> support_vectors(vector_count * feature_count);
+  for (size_t i = 0; i < support_vectors.size(); i++) {
+    support_vectors[i] = static_cast<float>((i * 7919) % 1000) / 250.f - 2.f;
+  }
+  std::vector<int64_t> vectors_per_class = {1366, 1365, 1365};
+  std::vector<int64_t> classes = {0, 1, 2};
+  std::vector<float> coefficients(2 * vector_count);
+  for (size_t i = 0; i < coefficients.size(); i++) {
+    coefficients[i] = static_cast<float>((i * 104729) % 2001) / 1000.f - 1.f;
+  }
+  std::vector<float> rho = {0.5f, -0.75f, 0.25f};
+  std::vector<float> kernel_params = {gamma, 0.f, 3.f};  //gamma, coef0, degree
+
+  std::vector<float> X(N * feature_count);
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>((i * 3571) % 997) / 249.25f - 2.f;
+  }
+  std::vector<int64_t> predictions;
+  std::vector<float> scores;
+  ComputeRBFSVCReference(X, N, feature_count, support_vectors, vectors_per_class, coefficients, rho, gamma, classes,
+                         predictions, scores);
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("vectors_per_class", vectors_per_class);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<float>("X", {N, feature_count}, X);
+  test.AddOutput<int64_t>("Y", {N}, predictions);
+  test.AddOutput<float>("Z", {N, 3}, scores);
+
+  test.Run();
+}
+
+TEST(MLOpTest, SVMClassifierTooFewFeatures) {
+  OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> dual_coefficients = {1.14360327f, 1.95968249f, -1.175683f, -1.92760275f, -1.32575698f, -1.32575698f, 0.66332785f, 0.66242913f, 0.53120854f, 0.53510444f, -1.06631298f, -1.06631298f, 0.66332785f, 0.66242913f, 0.53120854f, 0.53510444f, 1.f, -1.f};
+  std::vector<float> support_vectors = {0.f, 0.5f, 32.f, 2.f, 2.9f, -32.f, 1.f, 1.5f, 1.f, 3.f, 13.3f, -11.f, 12.f, 12.9f, -312.f, 43.f, 413.3f, -114.f};
+  std::vector<int64_t> classes = {0, 1, 2, 3};
+  std::vector<int64_t> vectors_per_class = {2, 2, 1, 1};
+  std::vector<float> rho = {0.5279583f, 0.32605162f, 0.32605162f, 0.06663721f, 0.06663721f, 0.f};
+  std::vector<float> kernel_params = {0.001f, 0.f, 3.f};  //gamma, coef0, degree
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("vectors_per_class", vectors_per_class);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("classlabels_ints", classes);
+
+  // the model has 3 features
+  test.AddInput<float>("X", {2, 2}, {1.f, 0.f, 3.f, 44.f});
+  test.AddOutput<int64_t>("Y", {2}, {0, 0});
+  test.AddOutput<float>("Z", {2, 6}, std::vector<float>(12, 0.f));
+
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Input has fewer features than the model.");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
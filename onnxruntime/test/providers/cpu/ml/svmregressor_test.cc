@@ -1,12 +1,34 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
 namespace onnxruntime {
 namespace test {
 
+// Predictions of an RBF SVR computed directly from exp(-gamma * |x - b|^2) in double.
+static std::vector<float> ComputeRBFSVRReference(const std::vector<float>& X, int64_t N, int64_t feature_count,
+                                                 const std::vector<float>& support_vectors,
+                                                 const std::vector<float>& coefficients, float rho, float gamma) {
+  const int64_t vector_count = static_cast<int64_t>(support_vectors.size()) / feature_count;
+  std::vector<float> predictions;
+  for (int64_t n = 0; n < N; n++) {
+    double sum = rho;
+    for (int64_t v = 0; v < vector_count; v++) {
+      double distance = 0;
+      for (int64_t f = 0; f < feature_count; f++) {
+        const double d = static_cast<double>(X[n * feature_count + f]) - support_vectors[v * feature_count + f];
+        distance += d * d;
+      }
+      sum += coefficients[v] * std::exp(-gamma * distance);
+    }
+    predictions.push_back(static_cast<float>(sum));
+  }
+  return predictions;
+}
+
 TEST(MLOpTest, SVMRegressorSVC) {
   OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
 
@@ -104,5 +126,98 @@ TEST(MLOpTest, SVMRegressorLinear) {
   test.Run();
 }
 
+TEST(MLOpTest, SVMRegressorRBFLargeMagnitudeFeatures) {
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  // unscaled features where the inputs are within a fraction of a unit of a support vector. the kernel values
+  // must match exp(-gamma * |x - b|^2) even though |x|^2 and |b|^2 are about 1e9.
+  const float gamma = 0.5f;
+  std::vector<float> support_vectors = {10000.f, -20000.f, 15000.f,
+                                        10000.5f, -20000.f, 15000.f,
+                                        -30000.f, 5000.f, 25000.f};
+  std::vector<float> dual_coefficients = {1.f, -0.5f, 0.75f};
+  std::vector<float> rho = {0.1f};
+  std::vector<float> kernel_params = {gamma, 0.f, 3.f};  //gamma, coef0, degree
+
+  std::vector<float> X = {10000.25f, -19999.875f, 15000.125f,
+                          10000.5f, -20000.f, 15000.f,
+                          -30000.125f, 5000.5f, 24999.75f};
+  std::vector<float> predictions = ComputeRBFSVRReference(X, 3, 3, support_vectors, dual_coefficients, rho[0], gamma);
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("n_supports", static_cast<int64_t>(3));
+
+  test.AddInput<float>("X", {3, 3}, X);
+  test.AddOutput<float>("Y", {3, 1}, predictions);
+
+  test.Run();
+}
+
+TEST(MLOpTest, SVMRegressorRBFMultipleKernelBlocks) {
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  // 4096 support vectors limit a kernel block to 256 rows, so 600 rows take three blocks
+  const int64_t feature_count = 4;
+  const int64_t vector_count = 4096;
+  const int64_t N = 600;
+  const float gamma = 0.1f;
+
+  std::vector<float> support_vectors(vector_count * feature_count);
+  for (size_t i = 0; i < support_vectors.size(); i++) {
+    support_vectors[i] = static_cast<float>((i * 7919) % 1000) / 250.f - 2.f;
+  }
+  std::vector<float> dual_coefficients(vector_count);
+  for (size_t i = 0; i < dual_coefficients.size(); i++) {
+    dual_coefficients[i] = static_cast<float>((i * 104729) % 2001) / 1000.f - 1.f;
+  }
+  std::vector<float> rho = {0.5f};
+  std::vector<float> kernel_params = {gamma, 0.f, 3.f};  //gamma, coef0, degree
+
+  std::vector<float> X(N * feature_count);
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>((i * 3571) % 997) / 249.25f - 2.f;
+  }
+  std::vector<float> predictions = ComputeRBFSVRReference(X, N, feature_count, support_vectors, dual_coefficients,
+                                                          rho[0], gamma);
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("n_supports", vector_count);
+
+  test.AddInput<float>("X", {N, feature_count}, X);
+  test.AddOutput<float>("Y", {N, 1}, predictions);
+
+  test.Run();
+}
+
+TEST(MLOpTest, SVMRegressorTooFewFeatures) {
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> dual_coefficients = {-1.54236563f, 0.53485162f, -1.5170623f, 0.69771864f, 1.82685767f};
+  std::vector<float> support_vectors = {0.f, 0.5f, 32.f, 1.f, 1.5f, 1.f, 2.f, 2.9f, -32.f, 12.f, 12.9f, -312.f, 43.f, 413.3f, -114.f};
+  std::vector<float> rho = {1.96292297f};
+  std::vector<float> kernel_params = {0.001f, 0.f, 3.f};  //gamma, coef0, degree
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("n_supports", static_cast<int64_t>(5));
+
+  // the model has 3 features
+  test.AddInput<float>("X", {2, 2}, {1.f, 0.f, 3.f, 44.f});
+  test.AddOutput<float>("Y", {2, 1}, {0.f, 0.f});
+
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Input has fewer features than the model.");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
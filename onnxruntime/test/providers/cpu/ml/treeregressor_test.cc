@@ -50,5 +50,103 @@ TEST(MLOpTest, TreeRegressorMultiTarget) {
   test.Run();
 }
 
+TEST(MLOpTest, TreeRegressorSumMissingValues) {
+  OpTester test("TreeEnsembleRegressor", 1, onnxruntime::kMLDomain);
+
+  //tree 0 uses mixed branch modes and sends missing values to the true branch of its root, tree 1 is a single leaf
+  std::vector<int64_t> lefts = {1, -1, 3, -1, -1, -1};
+  std::vector<int64_t> rights = {2, -1, 4, -1, -1, -1};
+  std::vector<int64_t> treeids = {0, 0, 0, 0, 0, 1};
+  std::vector<int64_t> nodeids = {0, 1, 2, 3, 4, 0};
+  std::vector<int64_t> featureids = {0, -2, 1, -2, -2, -2};
+  std::vector<float> thresholds = {1.5f, -2.f, 0.f, -2.f, -2.f, -2.f};
+  std::vector<std::string> modes = {"BRANCH_LT", "LEAF", "BRANCH_GTE", "LEAF", "LEAF", "LEAF"};
+  std::vector<int64_t> missing_tracks_true = {1, 0, 0, 0, 0, 0};
+
+  std::vector<int64_t> target_treeids = {0, 0, 0, 0, 1};
+  std::vector<int64_t> target_nodeids = {1, 1, 3, 4, 0};
+  std::vector<int64_t> target_classids = {0, 1, 0, 1, 0};
+  std::vector<float> target_weights = {1.f, 10.f, 2.f, 3.f, 0.5f};
+  std::vector<float> base_values = {100.f, 200.f};
+
+  //test data
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> X = {1.f, 0.f, nan, -1.f, 2.f, 5.f, 2.f, -5.f, 2.f, nan};
+  std::vector<float> results = {101.5f, 210.f, 101.5f, 210.f, 102.5f, 200.f, 100.5f, 203.f, 100.5f, 203.f};
+
+  //add attributes
+  test.AddAttribute("nodes_truenodeids", lefts);
+  test.AddAttribute("nodes_falsenodeids", rights);
+  test.AddAttribute("nodes_treeids", treeids);
+  test.AddAttribute("nodes_nodeids", nodeids);
+  test.AddAttribute("nodes_featureids", featureids);
+  test.AddAttribute("nodes_values", thresholds);
+  test.AddAttribute("nodes_modes", modes);
+  test.AddAttribute("nodes_missing_value_tracks_true", missing_tracks_true);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_classids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("base_values", base_values);
+
+  test.AddAttribute("n_targets", (int64_t)2);
+  test.AddAttribute("aggregate_function", "SUM");
+  //fill input data
+  test.AddInput<float>("X", {5, 2}, X);
+  test.AddOutput<float>("Y", {5, 2}, results);
+  test.Run();
+}
+
+TEST(MLOpTest, TreeRegressorManyStumps) {
+  OpTester test("TreeEnsembleRegressor", 1, onnxruntime::kMLDomain);
+
+  //enough small BRANCH_LEQ trees to be scored with the leaf bitvectors rather than by walking the trees
+  std::vector<int64_t> lefts, rights, treeids, nodeids, featureids;
+  std::vector<float> thresholds;
+  std::vector<std::string> modes;
+  std::vector<int64_t> target_treeids, target_nodeids, target_classids;
+  std::vector<float> target_weights;
+  const int64_t num_trees = 32;
+  for (int64_t t = 0; t < num_trees; t++) {
+    // node 0 tests feature t % 2 against a threshold rising with t, node 1 is the true leaf, node 2 the false leaf
+    lefts.insert(lefts.end(), {1, -1, -1});
+    rights.insert(rights.end(), {2, -1, -1});
+    treeids.insert(treeids.end(), {t, t, t});
+    nodeids.insert(nodeids.end(), {0, 1, 2});
+    featureids.insert(featureids.end(), {t % 2, -2, -2});
+    thresholds.insert(thresholds.end(), {static_cast<float>(t / 2), -2.f, -2.f});
+    modes.insert(modes.end(), {"BRANCH_LEQ", "LEAF", "LEAF"});
+    target_treeids.insert(target_treeids.end(), {t, t});
+    target_nodeids.insert(target_nodeids.end(), {1, 2});
+    target_classids.insert(target_classids.end(), {0, 1});
+    target_weights.insert(target_weights.end(), {1.f, 1.f});
+  }
+
+  //test data, target 0 counts the trees answering true and target 1 those answering false
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> X = {-1.f, -1.f, 0.f, 15.f, 7.5f, 3.f, 100.f, nan};
+  std::vector<float> results = {32.f, 0.f, 17.f, 15.f, 21.f, 11.f, 0.f, 32.f};
+
+  //add attributes
+  test.AddAttribute("nodes_truenodeids", lefts);
+  test.AddAttribute("nodes_falsenodeids", rights);
+  test.AddAttribute("nodes_treeids", treeids);
+  test.AddAttribute("nodes_nodeids", nodeids);
+  test.AddAttribute("nodes_featureids", featureids);
+  test.AddAttribute("nodes_values", thresholds);
+  test.AddAttribute("nodes_modes", modes);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_classids);
+  test.AddAttribute("target_weights", target_weights);
+
+  test.AddAttribute("n_targets", (int64_t)2);
+  test.AddAttribute("aggregate_function", "SUM");
+  //fill input data
+  test.AddInput<float>("X", {4, 2}, X);
+  test.AddOutput<float>("Y", {4, 2}, results);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
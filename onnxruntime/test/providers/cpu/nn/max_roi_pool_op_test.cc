@@ -40,5 +40,39 @@ TEST(RoIPoolTest, MaxRoiPool) {
   test.Run();
 }
 
+TEST(RoIPoolTest, MaxRoiPoolMultipleBatchesAndBins) {
+  OpTester test("MaxRoiPool");
+
+  const int64_t pooled_height = 2, pooled_width = 2;
+  test.AddAttribute("pooled_shape", std::vector<int64_t>{pooled_height, pooled_width});
+  test.AddAttribute("spatial_scale", 1.0f);
+
+  const int N = 2, C = 2, H = 5, W = 5;
+  std::vector<float> input;
+  for (int i = 0; i < N * C * H * W; i++)
+    input.push_back(1.0f * i / 10);
+
+  // the whole image of the second batch, part of the first one, and a ROI outside the image
+  std::vector<float> rois = {
+      1, 0, 0, 4, 4,
+      0, 1, 2, 3, 3,
+      0, 10, 10, 12, 12};
+
+  test.AddInput<float>("X", {N, C, H, W}, input);
+  test.AddInput<float>("rois", {3, 5}, rois);
+
+  const std::vector<float> expected_vals = {
+      6.2f, 6.4f, 7.2f, 7.4f,
+      8.7f, 8.9f, 9.7f, 9.9f,
+
+      1.2f, 1.3f, 1.7f, 1.8f,
+      3.7f, 3.8f, 4.2f, 4.3f,
+
+      0.0f, 0.0f, 0.0f, 0.0f,
+      0.0f, 0.0f, 0.0f, 0.0f};
+  test.AddOutput<float>("Y", {3, C, pooled_height, pooled_width}, expected_vals);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <numeric>
 #include "core/providers/cpu/nn/pool.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
@@ -540,6 +542,40 @@ TEST(PoolTest, GlobalAveragePool) {
   test.Run();
 }
 
+TEST(PoolTest, GlobalPoolLargePlanes) {
+  // large enough to split the planes over several threads. each 17x17 plane covers the 16 and 4 wide vector
+  // loops of the global pooling kernel and the scalar tail.
+  const int64_t batch_size = 2;
+  const int64_t channels = 32;
+  const int64_t plane_size = 17 * 17;
+
+  std::vector<float> x_vals(batch_size * channels * plane_size);
+  for (size_t i = 0; i < x_vals.size(); ++i) {
+    x_vals[i] = static_cast<float>((i * 37) % 101) / 101.0f - 0.5f;
+  }
+
+  std::vector<float> max_vals(batch_size * channels);
+  std::vector<float> average_vals(batch_size * channels);
+  for (int64_t c = 0; c < batch_size * channels; ++c) {
+    const float* plane = x_vals.data() + c * plane_size;
+    max_vals[c] = *std::max_element(plane, plane + plane_size);
+    average_vals[c] = std::accumulate(plane, plane + plane_size, 0.0f) / plane_size;
+  }
+
+  std::vector<int64_t> x_dims = {batch_size, channels, 17, 17};
+  std::vector<int64_t> expected_dims = {batch_size, channels, 1, 1};
+
+  OpTester max_test("GlobalMaxPool");
+  max_test.AddInput<float>("X", x_dims, x_vals);
+  max_test.AddOutput<float>("Y", expected_dims, max_vals);
+  max_test.Run();
+
+  OpTester average_test("GlobalAveragePool");
+  average_test.AddInput<float>("X", x_dims, x_vals);
+  average_test.AddOutput<float>("Y", expected_dims, average_vals);
+  average_test.Run();
+}
+
 TEST(PoolTest, LpPool) {
   OpTester test("LpPool");
 
@@ -555,5 +555,31 @@ TEST(TfIdfVectorizerTest, String_TFIDFWeights_onlyBigrams_Skip5) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(TfIdfVectorizerTest, Int64_TF_BatchBiAndTrigrams_Skip1) {
+  OpTester test("TfIdfVectorizer", opset_ver, domain);
+  // s=1, Min=2, Max=3, weights empty, int64
+  // 1-grams are not loaded, (1, 2) is both a bigram and the prefix of a trigram
+  InitTestAttr(test, "TF", 2, 3, 1,
+               {0, 2, 4},
+               {0, 1, 2, 3, 4},  //5 output indexes
+               {},
+               {1, 2,               //1-grams
+                1, 2,               //bi-grams
+                1, 2, 3, 2, 1, 2},  //tri-grams
+               {});
+
+  std::vector<int64_t> dims{2, 6};
+  std::vector<int64_t> input{1, 2, 3, 1, 2, 3,
+                             2, 1, 2, 1, 2, 5};
+  test.AddInput<int64_t>("T", dims, input);
+
+  std::vector<int64_t> out_dims{2, 5};
+  std::vector<float> output = {0, 0, 2, 2, 0,
+                               0, 0, 2, 0, 2};
+  test.AddOutput<float>("Y", out_dims, output);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1103,5 +1103,73 @@ TEST(ReductionOpTest, ArgMin_int32) {
   test.Run();
 }
 
+// Reduce the channel axis of an NCHW tensor, which is reduced in place as [N, C, H*W].
+TEST(ReductionOpTest, ReduceMean_channel_axis) {
+  OpTester test("ReduceMean");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)1);
+  test.AddInput<float>("data", {2, 3, 1, 2},
+                       {1.0f, 2.0f,
+                        3.0f, 4.0f,
+                        5.0f, 6.0f,
+
+                        7.0f, 8.0f,
+                        9.0f, 10.0f,
+                        11.0f, 15.0f});
+  test.AddOutput<float>("reduced", {2, 1, 1, 2},
+                        {3.0f, 4.0f,
+                         9.0f, 11.0f});
+  test.Run();
+}
+
+// Reduce the spatial axes of an NCHW tensor, which is reduced in place as [N*C, H*W].
+TEST(ReductionOpTest, ReduceMax_spatial_axes) {
+  OpTester test("ReduceMax");
+  test.AddAttribute("axes", std::vector<int64_t>{2, 3});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {1, 2, 2, 2},
+                       {1.0f, 8.0f,
+                        3.0f, 4.0f,
+
+                        -5.0f, -6.0f,
+                        -7.0f, -2.0f});
+  test.AddOutput<float>("reduced", {1, 2}, {8.0f, -2.0f});
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceLogSumExp_middle_axis) {
+  OpTester test("ReduceLogSumExp");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {2, 2, 2},
+                       {0.0f, 1.0f,
+                        0.0f, 1.0f,
+
+                        2.0f, 100.0f,
+                        2.0f, 100.0f});
+  test.AddOutput<float>("reduced", {2, 2},
+                        {0.693147f, 1.693147f,
+                         2.693147f, 100.693147f});
+  test.Run();
+}
+
+TEST(ReductionOpTest, ArgMax_middle_axis) {
+  OpTester test("ArgMax");
+  test.AddAttribute("axis", (int64_t)1);
+  test.AddAttribute("keepdims", (int64_t)1);
+  test.AddInput<float>("data", {2, 3, 2},
+                       {1.0f, 6.0f,
+                        5.0f, 2.0f,
+                        5.0f, 6.0f,
+
+                        9.0f, 10.0f,
+                        7.0f, 12.0f,
+                        11.0f, 8.0f});
+  test.AddOutput<int64_t>("reduced", {2, 1, 2},
+                          {1, 0,
+                           2, 1});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
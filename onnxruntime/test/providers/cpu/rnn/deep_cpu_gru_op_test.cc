@@ -3,10 +3,14 @@
 
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <iterator>
+#include <random>
+#include <unordered_map>
 #include <vector>
 
 #include "core/providers/cpu/rnn/deep_cpu_gru.h"
+#include "core/session/inference_session.h"
 #include "test/providers/provider_test_utils.h"
 using namespace std;
 namespace onnxruntime {
@@ -195,6 +199,293 @@ TEST(GRUTest, BidirectionalDefaultActivationsSimpleWeightsNoBiasTwoRows) {
   DefaultActivationsSimpleWeightsNoBias("bidirectional", Y_data, Y_h_data);
 }
 
+// repeats the batch of data laid out as [outer, batch, inner] so it becomes [outer, batch * repeats, inner]
+static std::vector<float> RepeatBatch(const std::vector<float>& data, int64_t outer, int64_t batch, int64_t inner,
+                                      int repeats) {
+  std::vector<float> repeated;
+  repeated.reserve(data.size() * repeats);
+  for (int64_t o = 0; o < outer; ++o) {
+    auto begin = data.cbegin() + o * batch * inner;
+    for (int r = 0; r < repeats; ++r) {
+      repeated.insert(repeated.end(), begin, begin + batch * inner);
+    }
+  }
+  return repeated;
+}
+
+// the rows of BidirectionalDefaultActivationsSimpleWeightsNoBiasTwoRows repeated to a batch of 8, which is split
+// between threads and has the directions run concurrently when the session allows more than one intra-op thread.
+// every thread count must produce the serial results.
+TEST(GRUTest, BidirectionalIntraOpThreadPoolSizes) {
+  const int64_t seq_length = 2;
+  const int64_t batch_size = 2;
+  const int64_t input_size = 1;
+  const int64_t hidden_size = 3;
+  const int repeats = 4;
+
+  std::vector<float> X_data{1.f, 2.f,
+                            10.f, 11.f};
+
+  std::vector<float> W_data{0.1f, 0.2f, 0.3f,   // wz
+                            1.f, 2.f, 3.f,      // wr
+                            10.f, 11.f, 12.f};  // wh
+  W_data.insert(W_data.end(), W_data.begin(), W_data.end());
+
+  std::vector<float> R_data(2 * 3 * hidden_size * hidden_size, 0.1f);
+
+  std::vector<float> Y_data{
+      0.4750208f, 0.450166f, 0.4255575f,
+      0.45016602f, 0.40131235f, 0.35434368f,
+
+      0.6082785f, 0.50623393f, 0.4426924f,
+      0.5803454f, 0.4527356f, 0.36886263f,
+
+      0.6027093f, 0.5083023f, 0.44950223f,
+      0.5754369f, 0.45485455f, 0.3747841f,
+
+      0.26894143f, 0.11920292f, 0.04742587f,
+      0.24973989f, 0.09975048f, 0.03557118f};
+
+  std::vector<float> Y_h_data{
+      0.6027093f, 0.5083023f, 0.44950223f,
+      0.5754369f, 0.45485455f, 0.3747841f,
+
+      0.6082785f, 0.50623393f, 0.4426924f,
+      0.5803454f, 0.4527356f, 0.36886263f};
+
+  const int64_t repeated_batch_size = batch_size * repeats;
+
+  for (int intra_op_thread_pool_size : {1, 4}) {
+    OpTester test("GRU");
+    test.AddAttribute<std::string>("direction", "bidirectional");
+    test.AddAttribute<int64_t>("hidden_size", hidden_size);
+
+    test.AddInput<float>("X", {seq_length, repeated_batch_size, input_size},
+                         RepeatBatch(X_data, seq_length, batch_size, input_size, repeats));
+    test.AddInput<float>("W", {2, 3 * hidden_size, input_size}, W_data, true);
+    test.AddInput<float>("R", {2, 3 * hidden_size, hidden_size}, R_data, true);
+
+    test.AddOutput<float>("Y", {seq_length, 2, repeated_batch_size, hidden_size},
+                          RepeatBatch(Y_data, seq_length * 2, batch_size, hidden_size, repeats));
+    test.AddOutput<float>("Y_h", {2, repeated_batch_size, hidden_size},
+                          RepeatBatch(Y_h_data, 2, batch_size, hidden_size, repeats));
+
+    SessionOptions so;
+    so.intra_op_thread_pool_size = intra_op_thread_pool_size;
+    test.Run(so);
+  }
+}
+
+static std::vector<float> RandomValues(int64_t size, std::default_random_engine& generator) {
+  std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+  std::vector<float> values(static_cast<size_t>(size));
+  for (auto& value : values)
+    value = distribution(generator);
+  return values;
+}
+
+// GRU with the default activations, computed directly from the formulas in the ONNX spec
+static void ComputeReferenceGru(const std::vector<float>& X, const std::vector<float>& W, const std::vector<float>& R,
+                                const std::vector<float>& B, int64_t seq_length, int64_t batch_size,
+                                int64_t input_size, int64_t hidden_size, int64_t num_directions,
+                                bool linear_before_reset, std::vector<float>& Y, std::vector<float>& Y_h) {
+  const int64_t H = hidden_size;
+  auto sigmoid = [](float x) { return 1.f / (1.f + std::exp(-x)); };
+
+  Y.assign(seq_length * num_directions * batch_size * H, 0.f);
+  Y_h.assign(num_directions * batch_size * H, 0.f);
+
+  for (int64_t d = 0; d < num_directions; ++d) {
+    const float* Wz = W.data() + d * 3 * H * input_size;
+    const float* Wr = Wz + H * input_size;
+    const float* Wh = Wr + H * input_size;
+    const float* Rz = R.data() + d * 3 * H * H;
+    const float* Rr = Rz + H * H;
+    const float* Rh = Rr + H * H;
+    const float* Wbz = B.data() + d * 6 * H;
+    const float* Wbr = Wbz + H;
+    const float* Wbh = Wbr + H;
+    const float* Rbz = Wbh + H;
+    const float* Rbr = Rbz + H;
+    const float* Rbh = Rbr + H;
+
+    for (int64_t b = 0; b < batch_size; ++b) {
+      std::vector<float> h(H, 0.f);
+      std::vector<float> z(H), r(H), new_h(H);
+
+      for (int64_t step = 0; step < seq_length; ++step) {
+        const int64_t t = d == 0 ? step : seq_length - 1 - step;
+        const float* x = X.data() + (t * batch_size + b) * input_size;
+
+        for (int64_t j = 0; j < H; ++j) {
+          float z_sum = Wbz[j] + Rbz[j];
+          float r_sum = Wbr[j] + Rbr[j];
+          for (int64_t k = 0; k < input_size; ++k) {
+            z_sum += x[k] * Wz[j * input_size + k];
+            r_sum += x[k] * Wr[j * input_size + k];
+          }
+          for (int64_t k = 0; k < H; ++k) {
+            z_sum += h[k] * Rz[j * H + k];
+            r_sum += h[k] * Rr[j * H + k];
+          }
+          z[j] = sigmoid(z_sum);
+          r[j] = sigmoid(r_sum);
+        }
+
+        for (int64_t j = 0; j < H; ++j) {
+          float x_sum = Wbh[j];
+          for (int64_t k = 0; k < input_size; ++k)
+            x_sum += x[k] * Wh[j * input_size + k];
+
+          float h_sum = Rbh[j];
+          for (int64_t k = 0; k < H; ++k)
+            h_sum += (linear_before_reset ? h[k] : r[k] * h[k]) * Rh[j * H + k];
+          if (linear_before_reset)
+            h_sum *= r[j];
+
+          new_h[j] = (1.f - z[j]) * std::tanh(x_sum + h_sum) + z[j] * h[j];
+        }
+
+        h = new_h;
+        std::copy(h.cbegin(), h.cend(), Y.begin() + ((t * num_directions + d) * batch_size + b) * H);
+      }
+
+      std::copy(h.cbegin(), h.cend(), Y_h.begin() + (d * batch_size + b) * H);
+    }
+  }
+}
+
+// weights that are initializers are transposed once when the kernel is created, with R[zr] and R[h] transposed
+// separately as they are used by separate GEMMs. random weights make every element of them matter, so both that
+// and the path for weights that are graph inputs have to match the reference, for both reset behaviors and for
+// both the serial (one row) and the batch parallel path.
+TEST(GRUTest, BidirectionalRandomWeightsMatchReference) {
+  const int64_t num_directions = 2;
+  const int64_t seq_length = 3;
+  const int64_t input_size = 2;
+  const int64_t hidden_size = 3;
+
+  std::default_random_engine generator(4321);
+  const std::vector<float> W_data = RandomValues(num_directions * 3 * hidden_size * input_size, generator);
+  const std::vector<float> R_data = RandomValues(num_directions * 3 * hidden_size * hidden_size, generator);
+  const std::vector<float> B_data = RandomValues(num_directions * 6 * hidden_size, generator);
+
+  for (int64_t batch_size : {1, 3}) {
+    const std::vector<float> X_data = RandomValues(seq_length * batch_size * input_size, generator);
+
+    for (bool linear_before_reset : {false, true}) {
+      std::vector<float> Y_data;
+      std::vector<float> Y_h_data;
+      ComputeReferenceGru(X_data, W_data, R_data, B_data, seq_length, batch_size, input_size, hidden_size,
+                          num_directions, linear_before_reset, Y_data, Y_h_data);
+
+      for (bool weights_are_initializers : {true, false}) {
+        OpTester test("GRU");
+        test.AddAttribute<std::string>("direction", "bidirectional");
+        test.AddAttribute<int64_t>("hidden_size", hidden_size);
+        test.AddAttribute<int64_t>("linear_before_reset", linear_before_reset);
+        test.AddInput<float>("X", {seq_length, batch_size, input_size}, X_data);
+        test.AddInput<float>("W", {num_directions, 3 * hidden_size, input_size}, W_data, weights_are_initializers);
+        test.AddInput<float>("R", {num_directions, 3 * hidden_size, hidden_size}, R_data, weights_are_initializers);
+        test.AddInput<float>("B", {num_directions, 6 * hidden_size}, B_data, true);
+        test.AddOutput<float>("Y", {seq_length, num_directions, batch_size, hidden_size}, Y_data);
+        test.AddOutput<float>("Y_h", {num_directions, batch_size, hidden_size}, Y_h_data);
+        test.SetOutputAbsErr("Y", 1e-5f);
+        test.SetOutputAbsErr("Y_h", 1e-5f);
+        test.Run();
+      }
+    }
+  }
+}
+
+static std::vector<float> ToVector(const MLValue& value) {
+  const auto& tensor = value.Get<Tensor>();
+  return std::vector<float>(tensor.Data<float>(), tensor.Data<float>() + tensor.Shape().Size());
+}
+
+// runs one session for calls with longer and then shorter sequences, different initial states and different batch
+// sizes, so most calls reuse a per-direction instance the kernel cached in an earlier call. none of them may be
+// affected by what the earlier calls left in its buffers, so every call has to match a fresh kernel.
+TEST(GRUTest, ReusedKernelMatchesFreshKernel) {
+  const int64_t num_directions = 2;
+  const int64_t input_size = 2;
+  const int64_t hidden_size = 3;
+
+  std::default_random_engine generator(1234);
+  const std::vector<int64_t> W_dims{num_directions, 3 * hidden_size, input_size};
+  const std::vector<int64_t> R_dims{num_directions, 3 * hidden_size, hidden_size};
+  const std::vector<int64_t> B_dims{num_directions, 6 * hidden_size};
+  const std::vector<float> W_data = RandomValues(num_directions * 3 * hidden_size * input_size, generator);
+  const std::vector<float> R_data = RandomValues(num_directions * 3 * hidden_size * hidden_size, generator);
+  const std::vector<float> B_data = RandomValues(num_directions * 6 * hidden_size, generator);
+
+  // the batch size of a call is the number of sequence lengths. a batch of 1 runs the kernel's serial path and a
+  // batch of 3 its batch parallel one.
+  struct Call {
+    int64_t seq_length;
+    std::vector<int> sequence_lens;
+  };
+
+  const std::vector<Call> calls{{5, {5, 3, 4}}, {3, {3}}, {2, {2, 1, 2}}, {1, {1}},
+                                {4, {1, 4, 3}}, {4, {2}}, {1, {1, 1, 1}}};
+
+  for (bool linear_before_reset : {false, true}) {
+    for (bool use_sequence_lens : {false, true}) {
+      SingleNodeSession session("GRU");
+      session.AddAttribute<std::string>("direction", "bidirectional");
+      session.AddAttribute<int64_t>("hidden_size", hidden_size);
+      session.AddAttribute<int64_t>("linear_before_reset", linear_before_reset);
+      session.AddInput<float>("X");
+      session.AddInitializer<float>("W", W_dims, W_data);
+      session.AddInitializer<float>("R", R_dims, R_data);
+      session.AddInitializer<float>("B", B_dims, B_data);
+      if (use_sequence_lens)
+        session.AddInput<int>("sequence_lens");
+      else
+        session.AddMissingOptionalInput<int>();
+      session.AddInput<float>("initial_h");
+      session.AddOutput<float>("Y");
+      session.AddOutput<float>("Y_h");
+
+      for (const auto& call : calls) {
+        const int64_t seq_length = call.seq_length;
+        const int64_t batch_size = static_cast<int64_t>(call.sequence_lens.size());
+        const std::vector<int64_t> X_dims{seq_length, batch_size, input_size};
+        const std::vector<int64_t> state_dims{num_directions, batch_size, hidden_size};
+        const std::vector<int64_t> Y_dims{seq_length, num_directions, batch_size, hidden_size};
+        const std::vector<float> X_data = RandomValues(seq_length * batch_size * input_size, generator);
+        const std::vector<float> initial_h_data = RandomValues(num_directions * batch_size * hidden_size, generator);
+
+        std::unordered_map<std::string, MLValue> feeds;
+        feeds["X"] = SingleNodeSession::MakeValue(X_dims, X_data);
+        if (use_sequence_lens)
+          feeds["sequence_lens"] = SingleNodeSession::MakeValue(std::vector<int64_t>{batch_size}, call.sequence_lens);
+        feeds["initial_h"] = SingleNodeSession::MakeValue(state_dims, initial_h_data);
+        std::vector<MLValue> fetches = session.Run(feeds);
+
+        OpTester test("GRU");
+        test.AddAttribute<std::string>("direction", "bidirectional");
+        test.AddAttribute<int64_t>("hidden_size", hidden_size);
+        test.AddAttribute<int64_t>("linear_before_reset", linear_before_reset);
+        test.AddInput<float>("X", X_dims, X_data);
+        test.AddInput<float>("W", W_dims, W_data, true);
+        test.AddInput<float>("R", R_dims, R_data, true);
+        test.AddInput<float>("B", B_dims, B_data, true);
+        if (use_sequence_lens)
+          test.AddInput<int>("sequence_lens", {batch_size}, call.sequence_lens);
+        else
+          test.AddMissingOptionalInput<int>();
+        test.AddInput<float>("initial_h", state_dims, initial_h_data);
+        test.AddOutput<float>("Y", Y_dims, ToVector(fetches[0]));
+        test.AddOutput<float>("Y_h", state_dims, ToVector(fetches[1]));
+        test.SetOutputAbsErr("Y", 1e-5f);
+        test.SetOutputAbsErr("Y_h", 1e-5f);
+        test.Run();
+      }
+    }
+  }
+}
+
 void DefaultActivationsSimpleWeightsWithBias(std::string direction,
                                              const std::vector<float>& Y_data,
                                              bool linear_before_reset = false,
@@ -4,9 +4,13 @@
 #include "gtest/gtest.h"
 
 #include <iterator>
+#include <limits>
+#include <random>
+#include <unordered_map>
 #include <vector>
 
 #include "core/providers/cpu/rnn/deep_cpu_lstm.h"
+#include "core/session/inference_session.h"
 #include "test/providers/provider_test_utils.h"
 using namespace std;
 namespace onnxruntime {
@@ -45,7 +49,8 @@ static void RunLstmTest(const std::vector<float>& X_data,
                         // copy the following vectors as we may modify them
                         std::vector<string> activations = {},
                         std::vector<float> activation_alphas = {},
-                        std::vector<float> activation_betas = {}) {
+                        std::vector<float> activation_betas = {},
+                        bool weights_are_initializers = false) {
   OpTester test("LSTM");
 
   int num_directions = (direction == "bidirectional") ? 2 : 1;
@@ -75,8 +80,8 @@ static void RunLstmTest(const std::vector<float>& X_data,
   std::vector<int64_t> R_dims = {num_directions, 4 * hidden_size, hidden_size};
 
   test.AddInput<float>("X", X_dims, X_data);
-  test.AddInput<float>("W", W_dims, W_data);
-  test.AddInput<float>("R", R_dims, R_data);
+  test.AddInput<float>("W", W_dims, W_data, weights_are_initializers);
+  test.AddInput<float>("R", R_dims, R_data, weights_are_initializers);
 
   if (B_data) {
     std::vector<int64_t> B_dims = {num_directions, 8 * hidden_size};
@@ -252,6 +257,243 @@ TEST(LSTMTest, BidirectionalSimpleWeightsNoBiasTwoRows) {
   SimpleWeightsNoBiasTwoRows("bidirectional", Y_data, Y_h_data, Y_c_data);
 }
 
+// constant W and R are prepacked by the kernel, and without clipping the default activations are fused
+TEST(LSTMTest, BidirectionalSimpleWeightsNoBiasTwoRowsInitializerWeights) {
+  std::vector<float> Y_data{
+      0.28828835f, 0.36581863f, 0.45679406f,
+      0.34526032f, 0.47220859f, 0.55850911f,
+
+      0.55391603f, 0.69201493f, 0.82696019f,
+      0.64046413f, 0.82303363f, 0.91610711f,
+
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.85882828f, 0.90703777f, 0.92382453f,
+
+      0.61249432f, 0.70678632f, 0.74094619f,
+      0.62759886f, 0.71640738f, 0.74624585f};
+
+  std::vector<float> Y_h_data{
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.85882828f, 0.90703777f, 0.92382453f,
+
+      0.55391603f, 0.69201493f, 0.82696019f,
+      0.64046413f, 0.82303363f, 0.91610711f};
+
+  std::vector<float> Y_c_data{
+      1.27731147f, 1.44181041f, 1.53179041f,
+      1.3249796f, 1.51063104f, 1.61451544f,
+
+      1.27850552f, 1.46799496f, 1.57641257f,
+      1.34960834f, 1.54772296f, 1.65633056f};
+
+  int64_t seq_length = 2;
+  int batch_size = 2;
+  int64_t input_size = 1;
+  int64_t hidden_size = 3;
+
+  std::vector<float> X_data{1.f, 2.f, 10.f, 11.f};
+
+  std::vector<float> W_data = DuplicateContainer(std::vector<float>{
+      0.1f, 0.2f, 0.3f, 0.4f,
+      1.f, 2.f, 3.f, 4.f,
+      10.f, 11.f, 12.f, 13.f});
+
+  std::vector<float> R_data(2 * 4 * hidden_size * hidden_size, 0.1f);
+
+  RunLstmTest(X_data, W_data, R_data, Y_data, Y_h_data, Y_c_data,
+              input_size, batch_size, hidden_size, seq_length,
+              nullptr, nullptr, nullptr, nullptr, nullptr, "bidirectional",
+              std::numeric_limits<float>::max(), true, false, {}, {}, {}, /* weights_are_initializers */ true);
+}
+
+// repeats the batch of data laid out as [outer, batch, inner] so it becomes [outer, batch * repeats, inner]
+static std::vector<float> RepeatBatch(const std::vector<float>& data, int64_t outer, int64_t batch, int64_t inner,
+                                      int repeats) {
+  std::vector<float> repeated;
+  repeated.reserve(data.size() * repeats);
+  for (int64_t o = 0; o < outer; ++o) {
+    auto begin = data.cbegin() + o * batch * inner;
+    for (int r = 0; r < repeats; ++r) {
+      repeated.insert(repeated.end(), begin, begin + batch * inner);
+    }
+  }
+  return repeated;
+}
+
+// the rows of BidirectionalSimpleWeightsNoBiasTwoRows repeated to a batch of 8, which is split between threads and
+// has the directions run concurrently when the session allows more than one intra-op thread. every thread count
+// must produce the serial results.
+TEST(LSTMTest, BidirectionalIntraOpThreadPoolSizes) {
+  const int64_t seq_length = 2;
+  const int64_t batch_size = 2;
+  const int64_t input_size = 1;
+  const int64_t hidden_size = 3;
+  const int repeats = 4;
+
+  std::vector<float> X_data{1.f, 2.f, 10.f, 11.f};
+
+  std::vector<float> W_data = DuplicateContainer(std::vector<float>{
+      0.1f, 0.2f, 0.3f, 0.4f,
+      1.f, 2.f, 3.f, 4.f,
+      10.f, 11.f, 12.f, 13.f});
+
+  std::vector<float> R_data(2 * 4 * hidden_size * hidden_size, 0.1f);
+
+  std::vector<float> Y_data{
+      0.28828835f, 0.36581863f, 0.45679406f,
+      0.34526032f, 0.47220859f, 0.55850911f,
+
+      0.55391603f, 0.69201493f, 0.82696019f,
+      0.64046413f, 0.82303363f, 0.91610711f,
+
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.85882828f, 0.90703777f, 0.92382453f,
+
+      0.61249432f, 0.70678632f, 0.74094619f,
+      0.62759886f, 0.71640738f, 0.74624585f};
+
+  std::vector<float> Y_h_data{
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.85882828f, 0.90703777f, 0.92382453f,
+
+      0.55391603f, 0.69201493f, 0.82696019f,
+      0.64046413f, 0.82303363f, 0.91610711f};
+
+  std::vector<float> Y_c_data{
+      1.27731147f, 1.44181041f, 1.53179041f,
+      1.3249796f, 1.51063104f, 1.61451544f,
+
+      1.27850552f, 1.46799496f, 1.57641257f,
+      1.34960834f, 1.54772296f, 1.65633056f};
+
+  const int64_t repeated_batch_size = batch_size * repeats;
+
+  for (int intra_op_thread_pool_size : {1, 4}) {
+    OpTester test("LSTM");
+    test.AddAttribute<std::string>("direction", "bidirectional");
+    test.AddAttribute<int64_t>("hidden_size", hidden_size);
+
+    test.AddInput<float>("X", {seq_length, repeated_batch_size, input_size},
+                         RepeatBatch(X_data, seq_length, batch_size, input_size, repeats));
+    test.AddInput<float>("W", {2, 4 * hidden_size, input_size}, W_data, true);
+    test.AddInput<float>("R", {2, 4 * hidden_size, hidden_size}, R_data, true);
+
+    test.AddOutput<float>("Y", {seq_length, 2, repeated_batch_size, hidden_size},
+                          RepeatBatch(Y_data, seq_length * 2, batch_size, hidden_size, repeats));
+    test.AddOutput<float>("Y_h", {2, repeated_batch_size, hidden_size},
+                          RepeatBatch(Y_h_data, 2, batch_size, hidden_size, repeats));
+    test.AddOutput<float>("Y_c", {2, repeated_batch_size, hidden_size},
+                          RepeatBatch(Y_c_data, 2, batch_size, hidden_size, repeats));
+
+    SessionOptions so;
+    so.intra_op_thread_pool_size = intra_op_thread_pool_size;
+    test.Run(so);
+  }
+}
+
+static std::vector<float> ToVector(const MLValue& value) {
+  const auto& tensor = value.Get<Tensor>();
+  return std::vector<float>(tensor.Data<float>(), tensor.Data<float>() + tensor.Shape().Size());
+}
+
+// runs one session for calls with longer and then shorter sequences, different initial states and different batch
+// sizes, so most calls reuse a per-direction instance the kernel cached in an earlier call. none of them may be
+// affected by what the earlier calls left in its buffers, so every call has to match a fresh kernel.
+TEST(LSTMTest, ReusedKernelMatchesFreshKernel) {
+  const int64_t num_directions = 2;
+  const int64_t input_size = 2;
+  const int64_t hidden_size = 3;
+
+  std::default_random_engine generator(1234);
+  std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+  auto random_values = [&](int64_t size) {
+    std::vector<float> values(static_cast<size_t>(size));
+    for (auto& value : values)
+      value = distribution(generator);
+    return values;
+  };
+
+  const std::vector<int64_t> W_dims{num_directions, 4 * hidden_size, input_size};
+  const std::vector<int64_t> R_dims{num_directions, 4 * hidden_size, hidden_size};
+  const std::vector<int64_t> B_dims{num_directions, 8 * hidden_size};
+  const std::vector<int64_t> P_dims{num_directions, 3 * hidden_size};
+  const std::vector<float> W_data = random_values(num_directions * 4 * hidden_size * input_size);
+  const std::vector<float> R_data = random_values(num_directions * 4 * hidden_size * hidden_size);
+  const std::vector<float> B_data = random_values(num_directions * 8 * hidden_size);
+  const std::vector<float> P_data = random_values(num_directions * 3 * hidden_size);
+
+  // the batch size of a call is the number of sequence lengths. a batch of 1 runs the kernel's serial path and a
+  // batch of 3 its batch parallel one.
+  struct Call {
+    int64_t seq_length;
+    std::vector<int> sequence_lens;
+  };
+
+  const std::vector<Call> calls{{5, {5, 3, 4}}, {3, {3}}, {2, {2, 1, 2}}, {1, {1}},
+                                {4, {1, 4, 3}}, {4, {2}}, {1, {1, 1, 1}}};
+
+  for (bool use_sequence_lens : {false, true}) {
+    SingleNodeSession session("LSTM");
+    session.AddAttribute<std::string>("direction", "bidirectional");
+    session.AddAttribute<int64_t>("hidden_size", hidden_size);
+    session.AddInput<float>("X");
+    session.AddInitializer<float>("W", W_dims, W_data);
+    session.AddInitializer<float>("R", R_dims, R_data);
+    session.AddInitializer<float>("B", B_dims, B_data);
+    if (use_sequence_lens)
+      session.AddInput<int>("sequence_lens");
+    else
+      session.AddMissingOptionalInput<int>();
+    session.AddInput<float>("initial_h");
+    session.AddInput<float>("initial_c");
+    session.AddInitializer<float>("P", P_dims, P_data);
+    session.AddOutput<float>("Y");
+    session.AddOutput<float>("Y_h");
+    session.AddOutput<float>("Y_c");
+
+    for (const auto& call : calls) {
+      const int64_t seq_length = call.seq_length;
+      const int64_t batch_size = static_cast<int64_t>(call.sequence_lens.size());
+      const std::vector<int64_t> X_dims{seq_length, batch_size, input_size};
+      const std::vector<int64_t> state_dims{num_directions, batch_size, hidden_size};
+      const std::vector<int64_t> Y_dims{seq_length, num_directions, batch_size, hidden_size};
+      const std::vector<float> X_data = random_values(seq_length * batch_size * input_size);
+      const std::vector<float> initial_h_data = random_values(num_directions * batch_size * hidden_size);
+      const std::vector<float> initial_c_data = random_values(num_directions * batch_size * hidden_size);
+
+      std::unordered_map<std::string, MLValue> feeds;
+      feeds["X"] = SingleNodeSession::MakeValue(X_dims, X_data);
+      if (use_sequence_lens)
+        feeds["sequence_lens"] = SingleNodeSession::MakeValue(std::vector<int64_t>{batch_size}, call.sequence_lens);
+      feeds["initial_h"] = SingleNodeSession::MakeValue(state_dims, initial_h_data);
+      feeds["initial_c"] = SingleNodeSession::MakeValue(state_dims, initial_c_data);
+      std::vector<MLValue> fetches = session.Run(feeds);
+
+      OpTester test("LSTM");
+      test.AddAttribute<std::string>("direction", "bidirectional");
+      test.AddAttribute<int64_t>("hidden_size", hidden_size);
+      test.AddInput<float>("X", X_dims, X_data);
+      test.AddInput<float>("W", W_dims, W_data, true);
+      test.AddInput<float>("R", R_dims, R_data, true);
+      test.AddInput<float>("B", B_dims, B_data, true);
+      if (use_sequence_lens)
+        test.AddInput<int>("sequence_lens", {batch_size}, call.sequence_lens);
+      else
+        test.AddMissingOptionalInput<int>();
+      test.AddInput<float>("initial_h", state_dims, initial_h_data);
+      test.AddInput<float>("initial_c", state_dims, initial_c_data);
+      test.AddInput<float>("P", P_dims, P_data, true);
+      test.AddOutput<float>("Y", Y_dims, ToVector(fetches[0]));
+      test.AddOutput<float>("Y_h", state_dims, ToVector(fetches[1]));
+      test.AddOutput<float>("Y_c", state_dims, ToVector(fetches[2]));
+      test.SetOutputAbsErr("Y", 1e-5f);
+      test.SetOutputAbsErr("Y_h", 1e-5f);
+      test.SetOutputAbsErr("Y_c", 1e-5f);
+      test.Run();
+    }
+  }
+}
+
 TEST(LSTMTest, MixedSequenceLengths) {
   // we don't have numpy output for this, but by testing twice and swapping which batch is smaller
   // we can largely verify the behaviour by comparing to ForwardSimpleWeightsNoBiasTwoRows output.
@@ -105,5 +105,43 @@ TEST(TransposeOpTest, ThreeDim) {
   TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals);
 }
 
+// Test the NCHW <-> NHWC permutations, which are handled as batched 2 dimensional transposes.
+// The sizes are chosen so that both the vectorized blocks and the leftover rows and columns are used.
+static void TransposeChannelsTest(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perm) {
+  std::vector<float> input_vals(input_shape[0] * input_shape[1] * input_shape[2] * input_shape[3]);
+  for (size_t i = 0; i < input_vals.size(); ++i)
+    input_vals[i] = static_cast<float>(i);
+
+  std::vector<int64_t> expected_shape(4);
+  std::vector<int64_t> input_strides{input_shape[1] * input_shape[2] * input_shape[3],
+                                     input_shape[2] * input_shape[3], input_shape[3], 1};
+  for (size_t i = 0; i < 4; ++i)
+    expected_shape[i] = input_shape[perm[i]];
+
+  std::vector<float> expected_vals;
+  for (int64_t i0 = 0; i0 < expected_shape[0]; ++i0)
+    for (int64_t i1 = 0; i1 < expected_shape[1]; ++i1)
+      for (int64_t i2 = 0; i2 < expected_shape[2]; ++i2)
+        for (int64_t i3 = 0; i3 < expected_shape[3]; ++i3)
+          expected_vals.push_back(input_vals[i0 * input_strides[perm[0]] + i1 * input_strides[perm[1]] +
+                                             i2 * input_strides[perm[2]] + i3 * input_strides[perm[3]]]);
+
+  OpTester test("Transpose");
+  test.AddAttribute("perm", perm);
+  test.AddInput<float>("X", input_shape, input_vals);
+  test.AddOutput<float>("Y", expected_shape, expected_vals);
+  test.Run();
+}
+
+TEST(TransposeOpTest, NCHWToNHWC) {
+  TransposeChannelsTest({2, 7, 5, 3}, {0, 2, 3, 1});
+  TransposeChannelsTest({1, 16, 9, 9}, {0, 2, 3, 1});
+}
+
+TEST(TransposeOpTest, NHWCToNCHW) {
+  TransposeChannelsTest({2, 5, 3, 7}, {0, 3, 1, 2});
+  TransposeChannelsTest({1, 9, 9, 16}, {0, 3, 1, 2});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
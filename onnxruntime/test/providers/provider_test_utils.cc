@@ -359,6 +359,18 @@ void OpTester::Run(ExpectResult expect_result,
                    const std::unordered_set<std::string>& excluded_provider_types,
                    const RunOptions* run_options,
                    std::vector<std::unique_ptr<IExecutionProvider>>* execution_providers) {
+  SessionOptions so;
+  so.session_logid = op_;
+  so.session_log_verbosity_level = 1;
+  Run(so, expect_result, expected_failure_string, excluded_provider_types, run_options, execution_providers);
+}
+
+void OpTester::Run(SessionOptions so,
+                   ExpectResult expect_result,
+                   const std::string& expected_failure_string,
+                   const std::unordered_set<std::string>& excluded_provider_types,
+                   const RunOptions* run_options,
+                   std::vector<std::unique_ptr<IExecutionProvider>>* execution_providers) {
   try {
 #ifndef NDEBUG
     run_called_ = true;
@@ -398,10 +410,6 @@ void OpTester::Run(ExpectResult expect_result,
     FillFeedsAndOutputNames(feeds, output_names);
 
     // Run the model
-    SessionOptions so;
-    so.session_logid = op_;
-    so.session_log_verbosity_level = 1;
-
     static const std::string all_provider_types[] = {
         kCpuExecutionProvider,
         kCudaExecutionProvider,
@@ -486,5 +494,55 @@ void OpTester::Run(ExpectResult expect_result,
     throw;
   }
 }
+
+SingleNodeSession::~SingleNodeSession() = default;
+
+std::vector<MLValue> SingleNodeSession::Run(const std::unordered_map<std::string, MLValue>& feeds) {
+  if (!session_) {
+    std::unordered_map<std::string, int> domain_to_version;
+    domain_to_version[domain_] = opset_version_;
+    onnxruntime::Model model("test", false, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+    onnxruntime::Graph& graph = model.MainGraph();
+
+    std::vector<onnxruntime::NodeArg*> input_defs;
+    for (auto& input : inputs_)
+      input_defs.push_back(&graph.GetOrCreateNodeArg(input.first, input.second));
+
+    std::vector<onnxruntime::NodeArg*> output_defs;
+    for (auto& output : outputs_)
+      output_defs.push_back(&graph.GetOrCreateNodeArg(output.first, output.second));
+
+    auto& node = graph.AddNode("node1", op_, op_, input_defs, output_defs, nullptr, domain_);
+    for (auto& add_attribute_fn : add_attribute_funcs_)
+      add_attribute_fn(node);
+
+    for (auto& initializer : initializers_)
+      graph.AddInitializedTensor(initializer);
+
+    Status status = graph.Resolve();
+    ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+
+    SessionOptions so;
+    so.session_logid = op_;
+    session_ = std::make_unique<InferenceSession>(so);
+
+    std::stringstream model_stream;
+    model.ToProto().SerializeToOstream(&model_stream);
+    status = session_->Load(model_stream);
+    ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+    status = session_->Initialize();
+    ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+  }
+
+  std::vector<std::string> output_names;
+  for (auto& output : outputs_)
+    output_names.push_back(output.first);
+
+  std::vector<MLValue> fetches;
+  Status status = session_->Run(feeds, output_names, &fetches);
+  ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+  return fetches;
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -24,6 +24,7 @@
 
 namespace onnxruntime {
 class InferenceSession;
+struct SessionOptions;
 
 namespace test {
 // unfortunately std::optional is in C++17 so use a miniversion of it
@@ -245,6 +246,13 @@ class OpTester {
            const RunOptions* run_options = nullptr,
            std::vector<std::unique_ptr<IExecutionProvider>>* execution_providers = nullptr);
 
+  // run with the given session options instead of the default ones
+  void Run(SessionOptions session_options,
+           ExpectResult expect_result = ExpectResult::kExpectSuccess, const std::string& expected_failure_string = "",
+           const std::unordered_set<std::string>& excluded_provider_types = {},
+           const RunOptions* run_options = nullptr,
+           std::vector<std::unique_ptr<IExecutionProvider>>* execution_providers = nullptr);
+
   struct Data {
     onnxruntime::NodeArg def_;
     MLValue data_;
@@ -331,6 +339,87 @@ class OpTester {
   std::vector<std::shared_ptr<CustomRegistry>> custom_session_registries_;
 };
 
+// Runs a model with a single node in one session for as many calls to Run as a test needs, and returns the outputs
+// rather than checking them. Every call after the first one reuses the kernel instance, so a test can check that
+// state a kernel keeps between calls doesn't leak into later results, and a test can use the outputs of one op as the
+// reference for another.
+// To use SingleNodeSession:
+//  1. Create one with the op name
+//  2. Call AddAttribute with any attributes
+//  3. Call AddInitializer, AddInput or AddMissingOptionalInput for all the inputs, in order
+//  4. Call AddOutput for all the outputs, in order
+//  5. Call Run with the values of the inputs added by AddInput, using MakeValue to create them
+class SingleNodeSession {
+ public:
+  explicit SingleNodeSession(const char* op, int opset_version = 7, const char* domain = onnxruntime::kOnnxDomain)
+      : op_(op), domain_(domain), opset_version_(opset_version) {}
+
+  ~SingleNodeSession();
+
+  template <typename T>
+  void AddAttribute(std::string name, T value) {
+    add_attribute_funcs_.emplace_back(
+        [name = std::move(name), value = std::move(value)](onnxruntime::Node& node) { node.AddAttribute(name, value); });
+  }
+
+  // an input that is part of the model
+  template <typename T>
+  void AddInitializer(const char* name, const std::vector<int64_t>& dims, const std::vector<T>& values) {
+    ONNX_NAMESPACE::TensorProto tensor_proto;
+    for (auto dim : dims)
+      tensor_proto.add_dims(dim);
+    tensor_proto.set_data_type(TypeToDataType<T>());
+    tensor_proto.set_raw_data(values.data(), values.size() * sizeof(T));
+    tensor_proto.set_name(name);
+    initializers_.push_back(std::move(tensor_proto));
+    inputs_.emplace_back(name, &s_type_proto<T>);
+  }
+
+  // an input whose value is passed to every Run
+  template <typename T>
+  void AddInput(const char* name) {
+    inputs_.emplace_back(name, &s_type_proto<T>);
+  }
+
+  template <typename T>
+  void AddMissingOptionalInput() {
+    inputs_.emplace_back("", &s_type_proto<T>);
+  }
+
+  template <typename T>
+  void AddOutput(const char* name) {
+    outputs_.emplace_back(name, &s_type_proto<T>);
+  }
+
+  template <typename T>
+  static MLValue MakeValue(const std::vector<int64_t>& dims, const std::vector<T>& values) {
+    TensorShape shape{dims};
+    ORT_ENFORCE(shape.Size() == static_cast<int64_t>(values.size()), values.size(),
+                " values doesn't match tensor size of ", shape.Size());
+
+    auto allocator = test::AllocatorManager::Instance().GetAllocator(CPU);
+    auto p_tensor = std::make_unique<Tensor>(DataTypeImpl::GetType<T>(), shape, allocator);
+    std::copy(values.cbegin(), values.cend(), p_tensor->template MutableData<T>());
+
+    MLValue value;
+    value.Init(p_tensor.release(), DataTypeImpl::GetType<Tensor>(), DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+    return value;
+  }
+
+  // builds the model and initializes the session on the first call. returns the outputs in the order they were added.
+  std::vector<MLValue> Run(const std::unordered_map<std::string, MLValue>& feeds);
+
+ private:
+  const char* op_;
+  const char* domain_;
+  int opset_version_;
+  std::vector<std::pair<std::string, const ONNX_NAMESPACE::TypeProto*>> inputs_;
+  std::vector<std::pair<std::string, const ONNX_NAMESPACE::TypeProto*>> outputs_;
+  std::vector<ONNX_NAMESPACE::TensorProto> initializers_;
+  std::vector<std::function<void(onnxruntime::Node& node)>> add_attribute_funcs_;
+  std::unique_ptr<InferenceSession> session_;
+};
+
 template <typename TException>
 void ExpectThrow(OpTester& test, const std::string& error_msg) {
   try {
@@ -195,6 +195,16 @@ class TestInferenceSession(unittest.TestCase):
         res = sess.run([output_name], {x_name: x})
         np.testing.assert_equal(x, res[0].astype('|S8'))        
 
+    def testInputBytesPacked(self):
+        sess = onnxrt.InferenceSession(self.get_name("identity_string.pb"), modeltype="path")
+        x = np.array([b'this', b'is', b'identity', b'test']).reshape((2,2))
+
+        ro = onnxrt.RunOptions()
+        ro.packed_string_tensors = True
+        res = sess.run(["output:0"], {"input:0": x}, ro)
+        self.assertEqual(x.dtype, res[0].dtype)
+        np.testing.assert_equal(x, res[0])
+
     def testInputObject(self):
         sess = onnxrt.InferenceSession(self.get_name("identity_string.pb"), modeltype="path")
         x = np.array(['this', 'is', 'identity', 'test'], object).reshape((2,2))
@@ -285,6 +295,17 @@ class TestInferenceSession(unittest.TestCase):
         res = sess.run([output_name], {x_name: x})
         self.assertEqual(output_expected, res[0])
 
+    def testZipMapStringFloatColumnar(self):
+        sess = onnxrt.InferenceSession(self.get_name("zipmap_stringfloat.pb"), modeltype="path")
+        x = np.array([1.0, 0.0, 3.0, 44.0, 23.0, 11.0], dtype=np.float32).reshape((2,3))
+
+        ro = onnxrt.RunOptions()
+        ro.columnar_map_sequences = True
+        keys, values = sess.run(["Z"], {"X": x}, ro)[0]
+        self.assertEqual(['class1', 'class2', 'class3'], keys)
+        self.assertEqual(np.float32, values.dtype)
+        np.testing.assert_allclose(x, values)
+
     def testZipMapInt64Float(self):
         sess = onnxrt.InferenceSession(self.get_name("zipmap_int64float.pb"), modeltype="path")
         x = np.array([1.0, 0.0, 3.0, 44.0, 23.0, 11.0], dtype=np.float32).reshape((2,3))
@@ -303,6 +324,16 @@ class TestInferenceSession(unittest.TestCase):
         res = sess.run([output_name], {x_name: x})
         self.assertEqual(output_expected, res[0])
 
+    def testZipMapInt64FloatColumnar(self):
+        sess = onnxrt.InferenceSession(self.get_name("zipmap_int64float.pb"), modeltype="path")
+        x = np.array([1.0, 0.0, 3.0, 44.0, 23.0, 11.0], dtype=np.float32).reshape((2,3))
+
+        ro = onnxrt.RunOptions()
+        ro.columnar_map_sequences = True
+        keys, values = sess.run(["Z"], {"X": x}, ro)[0]
+        self.assertEqual([10, 20, 30], keys)
+        np.testing.assert_allclose(x, values)
+
     def testRaiseWrongNumInputs(self):
         with self.assertRaises(ValueError) as context:
             sess = onnxrt.InferenceSession(self.get_name("logicaland.pb"), modeltype="path")
@@ -362,6 +393,25 @@ class TestInferenceSession(unittest.TestCase):
                     self.assertTrue(tag in lines[i])
             self.assertTrue(']' in lines[8])
 
+    def testIntraOpThreadPoolSize(self):
+        so = onnxrt.SessionOptions()
+        self.assertEqual(so.intra_op_thread_pool_size, 0)
+        for invalid_size in [0, -1]:
+            with self.assertRaises(ValueError):
+                so.intra_op_thread_pool_size = invalid_size
+        self.assertEqual(so.intra_op_thread_pool_size, 0)
+
+        x = np.array([[[1.0, 2.0]], [[3.0, 4.0]]], dtype=np.float32)
+        sess = onnxrt.InferenceSession(self.get_name("lstm_1.onnx"), modeltype="path")
+        output_expected = sess.run([], {'X': x})[0]
+
+        for size in [1, 2]:
+            so.intra_op_thread_pool_size = size
+            self.assertEqual(so.intra_op_thread_pool_size, size)
+            sess = onnxrt.InferenceSession(self.get_name("lstm_1.onnx"), modeltype="path", sess_options=so)
+            res = sess.run([], {'X': x})
+            np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
     def testDictVectorizer(self):
         sess = onnxrt.InferenceSession(self.get_name("pipeline_vectorize.onnx"), modeltype="path")
         input_name = sess.get_inputs()[0].name
@@ -206,6 +206,102 @@ TEST_F(CApiTest, create_tensor) {
   }
 }
 
+TEST_F(CApiTest, fill_string_tensor_from_buffer) {
+  const char buffer[] = "abcdkmp";
+  const size_t buffer_len = sizeof(buffer) - 1;
+  const size_t offsets[] = {0, 3, 3};
+  const size_t expected_len = 3;
+  std::unique_ptr<MockedOrtAllocator> default_allocator(std::make_unique<MockedOrtAllocator>());
+  {
+    std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)> tensor(
+        OrtCreateTensorAsOrtValue(default_allocator.get(), {expected_len}, ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING),
+        OrtReleaseValue);
+    ORT_THROW_ON_ERROR(OrtFillStringTensorFromBuffer(tensor.get(), buffer, buffer_len, offsets, expected_len));
+
+    size_t data_len;
+    ORT_THROW_ON_ERROR(OrtGetStringTensorDataLength(tensor.get(), &data_len));
+    ASSERT_EQ(data_len, buffer_len);
+    std::string result(data_len, '\0');
+    std::vector<size_t> result_offsets(expected_len);
+    ORT_THROW_ON_ERROR(OrtGetStringTensorContent(tensor.get(), (void*)result.data(), data_len, result_offsets.data(),
+                                                 result_offsets.size()));
+    ASSERT_EQ(result, std::string(buffer));
+    ASSERT_EQ(result_offsets, std::vector<size_t>(std::begin(offsets), std::end(offsets)));
+
+    // offsets must be increasing and within the buffer. only the second string runs past the end of the buffer,
+    // and the tensor must be left unchanged.
+    const char other_buffer[] = "xyzuvwq";
+    const size_t bad_offsets[] = {0, 3, 4};
+    OrtStatus* st = OrtFillStringTensorFromBuffer(tensor.get(), other_buffer, 3, bad_offsets, expected_len);
+    ASSERT_NE(st, nullptr);
+    OrtReleaseStatus(st);
+
+    ORT_THROW_ON_ERROR(OrtGetStringTensorContent(tensor.get(), (void*)result.data(), data_len, result_offsets.data(),
+                                                 result_offsets.size()));
+    ASSERT_EQ(result, std::string(buffer));
+    ASSERT_EQ(result_offsets, std::vector<size_t>(std::begin(offsets), std::end(offsets)));
+  }
+}
+
+TEST_F(CApiTest, packed_string_tensor) {
+  const char buffer[] = "thisisidentitytest";
+  const size_t buffer_len = sizeof(buffer) - 1;
+  const size_t offsets[] = {0, 4, 6, 14};
+  const size_t shape[] = {2, 2};
+  OrtValue* packed_ptr = nullptr;
+  ORT_THROW_ON_ERROR(OrtCreatePackedStringTensorAsOrtValue(shape, 2, buffer, buffer_len, offsets, 4, &packed_ptr));
+  std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)> packed(packed_ptr, OrtReleaseValue);
+
+  int is_packed = 0;
+  ORT_THROW_ON_ERROR(OrtIsPackedStringTensor(packed.get(), &is_packed));
+  ASSERT_EQ(is_packed, 1);
+  ASSERT_EQ(OrtIsTensor(packed.get()), 1);
+  ASSERT_EQ(OrtGetValueType(packed.get()), ONNX_TYPE_TENSOR);
+  {
+    OrtTensorTypeAndShapeInfo* shape_info_ptr;
+    ORT_THROW_ON_ERROR(OrtGetTensorShapeAndType(packed.get(), &shape_info_ptr));
+    std::unique_ptr<OrtTensorTypeAndShapeInfo> shape_info(shape_info_ptr);
+    ASSERT_EQ(OrtGetTensorElementType(shape_info.get()), ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING);
+    ASSERT_EQ(OrtGetTensorShapeElementCount(shape_info.get()), 4);
+  }
+
+  // offsets must be increasing and within the buffer
+  const size_t bad_offsets[] = {0, 4, 3, 14};
+  OrtValue* bad_ptr = nullptr;
+  OrtStatus* st = OrtCreatePackedStringTensorAsOrtValue(shape, 2, buffer, buffer_len, bad_offsets, 4, &bad_ptr);
+  ASSERT_NE(st, nullptr);
+  OrtReleaseStatus(st);
+
+  OrtSession* session_ptr;
+  ORT_THROW_ON_ERROR(OrtCreateSession(env, TSTR("testdata/identity_string.pb"), nullptr, &session_ptr));
+  std::unique_ptr<OrtSession, decltype(&OrtReleaseSession)> session(session_ptr, OrtReleaseSession);
+  std::unique_ptr<OrtRunOptions, decltype(&OrtReleaseRunOptions)> run_options(OrtCreateRunOptions(),
+                                                                               OrtReleaseRunOptions);
+  const char* input_names[] = {"input:0"};
+  const char* output_names[] = {"output:0"};
+
+  // the output is a packed string tensor only if the run options ask for it, the content is the same
+  for (int packed_output : {1, 0}) {
+    OrtRunOptionsSetPackedStringTensorsEnabled(run_options.get(), packed_output);
+    OrtValue* output_ptr = nullptr;
+    ORT_THROW_ON_ERROR(OrtRun(session.get(), run_options.get(), input_names, &packed_ptr, 1, output_names, 1,
+                              &output_ptr));
+    std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)> output(output_ptr, OrtReleaseValue);
+    ORT_THROW_ON_ERROR(OrtIsPackedStringTensor(output.get(), &is_packed));
+    ASSERT_EQ(is_packed, packed_output);
+
+    size_t data_len;
+    ORT_THROW_ON_ERROR(OrtGetStringTensorDataLength(output.get(), &data_len));
+    ASSERT_EQ(data_len, buffer_len);
+    std::string result(data_len, '\0');
+    std::vector<size_t> result_offsets(4);
+    ORT_THROW_ON_ERROR(OrtGetStringTensorContent(output.get(), (void*)result.data(), data_len,
+                                                 result_offsets.data(), result_offsets.size()));
+    ASSERT_EQ(result, std::string(buffer));
+    ASSERT_EQ(result_offsets, std::vector<size_t>(std::begin(offsets), std::end(offsets)));
+  }
+}
+
 TEST_F(CApiTest, create_tensor_with_data) {
   float values[] = {3.0f, 1.0f, 2.f, 0.f};
   constexpr size_t values_length = sizeof(values) / sizeof(values[0]);
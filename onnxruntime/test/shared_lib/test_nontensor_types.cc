@@ -249,3 +249,68 @@ TEST_F(CApiTest, CreateGetVectorOfMapsStringFloat) {  // support zipmap output t
               std::set<float>(std::begin(values), std::end(values)));
   }
 }
+
+TEST_F(CApiTest, ColumnarZipMapInt64Float) {  // zipmap output seq(map(int64, float)) in columnar form
+  std::unique_ptr<MockedOrtAllocator> default_allocator(std::make_unique<MockedOrtAllocator>());
+  OrtAllocatorInfo* info;
+  ORT_THROW_ON_ERROR(OrtCreateAllocatorInfo("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault, &info));
+  std::unique_ptr<OrtAllocatorInfo, decltype(&OrtReleaseAllocatorInfo)> rel_info(info, OrtReleaseAllocatorInfo);
+
+  RelAllocations<OrtValue> rel(&OrtReleaseValue);
+  RelAllocations<OrtStatus> rels(&OrtReleaseStatus);
+
+  OrtSession* session_ptr;
+  ORT_THROW_ON_ERROR(OrtCreateSession(env, TSTR("testdata/zipmap_int64float.pb"), nullptr, &session_ptr));
+  std::unique_ptr<OrtSession, decltype(&OrtReleaseSession)> session(session_ptr, OrtReleaseSession);
+  std::unique_ptr<OrtRunOptions, decltype(&OrtReleaseRunOptions)> run_options(OrtCreateRunOptions(),
+                                                                               OrtReleaseRunOptions);
+  OrtRunOptionsSetColumnarMapSequencesEnabled(run_options.get(), 1);
+
+  std::vector<float> x{1.f, 0.f, 3.f, 44.f, 23.f, 11.f};
+  std::vector<size_t> dims{2, 3};
+  OrtValue* x_tensor = OrtCreateTensorWithDataAsOrtValue(info, x.data(), x.size() * sizeof(float), dims,
+                                                         ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
+  rel.add(x_tensor);
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Z"};
+  OrtValue* z = nullptr;
+  ORT_THROW_ON_ERROR(OrtRun(session.get(), run_options.get(), input_names, &x_tensor, 1, output_names, 1, &z));
+  rel.add(z);
+
+  int is_columnar = 0;
+  ORT_THROW_ON_ERROR(OrtIsColumnarMapSequence(z, &is_columnar));
+  ASSERT_EQ(is_columnar, 1);
+
+  const float* values = nullptr;
+  size_t num_rows = 0;
+  size_t num_keys = 0;
+  ORT_THROW_ON_ERROR(OrtGetColumnarMapSequenceValues(z, &values, &num_rows, &num_keys));
+  ASSERT_EQ(num_rows, size_t(2));
+  ASSERT_EQ(num_keys, size_t(3));
+  ASSERT_EQ(std::vector<float>(values, values + num_rows * num_keys), x);
+
+  OrtValue* keys_ort = nullptr;
+  ORT_THROW_ON_ERROR(OrtGetColumnarMapSequenceKeys(z, default_allocator.get(), &keys_ort));
+  rel.add(keys_ort);
+  int64_t* keys = nullptr;
+  ORT_THROW_ON_ERROR(OrtGetTensorMutableData(keys_ort, reinterpret_cast<void**>(&keys)));
+  ASSERT_EQ(std::vector<int64_t>(keys, keys + num_keys), std::vector<int64_t>({10, 20, 30}));
+
+  // the map form is still available element by element
+  size_t num_values = 0;
+  ORT_THROW_ON_ERROR(OrtGetValueCount(z, &num_values));
+  ASSERT_EQ(num_values, size_t(2));
+  OrtValue* map_out = nullptr;
+  OrtStatus* st = OrtGetValue(z, 1, default_allocator.get(), &map_out);
+  rel.add(map_out);
+  rels.add(st);
+  ASSERT_EQ(st, nullptr);
+  OrtValue* map_values = nullptr;
+  st = OrtGetValue(map_out, 1, default_allocator.get(), &map_values);
+  rel.add(map_values);
+  rels.add(st);
+  ASSERT_EQ(st, nullptr);
+  float* map_values_data = nullptr;
+  ORT_THROW_ON_ERROR(OrtGetTensorMutableData(map_values, reinterpret_cast<void**>(&map_values_data)));
+  ASSERT_EQ(std::vector<float>(map_values_data, map_values_data + 3), std::vector<float>({44.f, 23.f, 11.f}));
+}
@@ -15,4 +15,10 @@ TEST_F(CApiTest, run_options) {
   ASSERT_EQ(OrtRunOptionsGetCacheFeedsFetchesInfoEnabled(options.get()), int(0));
   OrtRunOptionsSetCacheFeedsFetchesInfoEnabled(options.get(), 3);  // any non-zero int should convert to true
   ASSERT_EQ(OrtRunOptionsGetCacheFeedsFetchesInfoEnabled(options.get()), int(true));
+  ASSERT_EQ(OrtRunOptionsGetColumnarMapSequencesEnabled(options.get()), int(0));
+  OrtRunOptionsSetColumnarMapSequencesEnabled(options.get(), 1);
+  ASSERT_EQ(OrtRunOptionsGetColumnarMapSequencesEnabled(options.get()), int(true));
+  ASSERT_EQ(OrtRunOptionsGetPackedStringTensorsEnabled(options.get()), int(0));
+  OrtRunOptionsSetPackedStringTensorsEnabled(options.get(), 1);
+  ASSERT_EQ(OrtRunOptionsGetPackedStringTensorsEnabled(options.get()), int(true));
 }
@@ -2,7 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/session/onnxruntime_cxx_api.h"
-
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "test_allocator.h"
 #include "test_fixture.h"
 using namespace onnxruntime;
 
@@ -10,3 +13,55 @@ TEST_F(CApiTest, session_options) {
   std::unique_ptr<OrtSessionOptions> options(OrtCreateSessionOptions());
   ASSERT_NE(options, nullptr);
 }
+
+TEST_F(CApiTest, intra_op_thread_pool_size) {
+  std::unique_ptr<OrtSessionOptions> options(OrtCreateSessionOptions());
+  ASSERT_NE(options, nullptr);
+  ASSERT_EQ(OrtSetIntraOpThreadPoolSize(options.get(), 0), -1);
+  ASSERT_EQ(OrtSetIntraOpThreadPoolSize(options.get(), -1), -1);
+  ASSERT_EQ(OrtSetIntraOpThreadPoolSize(options.get(), 1), 0);
+  ASSERT_EQ(OrtSetIntraOpThreadPoolSize(options.get(), 3), 0);
+}
+
+// runs the LSTM in testdata/lstm_1.onnx and returns Y
+static std::vector<float> RunLstm(OrtSession* session, OrtAllocator* allocator) {
+  const std::vector<size_t> dims_x{2, 1, 2};
+  const std::vector<float> values_x{1.f, 2.f, 3.f, 4.f};
+  std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)> value_x(
+      OrtCreateTensorAsOrtValue(allocator, dims_x, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT), OrtReleaseValue);
+  void* raw_data;
+  ORT_THROW_ON_ERROR(OrtGetTensorMutableData(value_x.get(), &raw_data));
+  memcpy(raw_data, values_x.data(), values_x.size() * sizeof(values_x[0]));
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  OrtValue* inputs[] = {value_x.get()};
+  OrtValue* output_tensor = nullptr;
+  ORT_THROW_ON_ERROR(OrtRun(session, nullptr, input_names, inputs, 1, output_names, 1, &output_tensor));
+  std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)> value_y(output_tensor, OrtReleaseValue);
+
+  float* f;
+  ORT_THROW_ON_ERROR(OrtGetTensorMutableData(value_y.get(), (void**)&f));
+  // Y is [seq_length, num_directions, batch_size, hidden_size] = [2, 1, 1, 2]
+  return std::vector<float>(f, f + 4);
+}
+
+TEST_F(CApiTest, run_with_intra_op_thread_pool_size) {
+  std::unique_ptr<MockedOrtAllocator> allocator(std::make_unique<MockedOrtAllocator>());
+
+  SessionOptionsWrapper default_options(env);
+  std::unique_ptr<OrtSession, decltype(&OrtReleaseSession)> default_session(
+      default_options.OrtCreateSession(TSTR("testdata/lstm_1.onnx")), OrtReleaseSession);
+  const std::vector<float> expected = RunLstm(default_session.get(), allocator.get());
+
+  for (int intra_op_thread_pool_size : {1, 3}) {
+    SessionOptionsWrapper options(env);
+    options.SetIntraOpThreadPoolSize(intra_op_thread_pool_size);
+    std::unique_ptr<OrtSession, decltype(&OrtReleaseSession)> session(
+        options.OrtCreateSession(TSTR("testdata/lstm_1.onnx")), OrtReleaseSession);
+    // run twice so the second run goes through the kernel's cached state
+    for (int i = 0; i != 2; ++i) {
+      ASSERT_EQ(RunLstm(session.get(), allocator.get()), expected);
+    }
+  }
+}